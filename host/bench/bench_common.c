@@ -0,0 +1,193 @@
+#include "bench_common.h"
+#include "can_logger.h"
+#include "can_simulator.h"
+#include "can_sniffer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+  char name[32];
+  const char *unit;
+  double value;
+} metric_t;
+
+static metric_t metrics[MAX_METRICS];
+static int metric_count = 0;
+
+double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+void add_metric(const char *name, const char *unit, double value) {
+  if (metric_count >= MAX_METRICS)
+    return;
+  metric_t *m = &metrics[metric_count++];
+  snprintf(m->name, sizeof(m->name), "%s", name);
+  m->unit = unit;
+  m->value = value;
+}
+
+void metrics_print(void) {
+  for (int i = 0; i < metric_count; i++)
+    printf("%-22s %10.2f %s\n", metrics[i].name, metrics[i].value,
+           metrics[i].unit);
+}
+
+// --- Trace sources ---
+
+trace_frame_t *trace_push(trace_t *t) {
+  if (t->count == t->capacity) {
+    size_t cap = t->capacity ? t->capacity * 2 : 4096;
+    trace_frame_t *p = realloc(t->frames, cap * sizeof(*p));
+    if (!p)
+      return NULL;
+    t->frames = p;
+    t->capacity = cap;
+  }
+  trace_frame_t *f = &t->frames[t->count++];
+  memset(f, 0, sizeof(*f));
+  return f;
+}
+
+// can_logger format: Timestamp,ID,Name,DLC,Data
+bool trace_load(trace_t *t, const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+
+  char line[160];
+  while (fgets(line, sizeof(line), f)) {
+    // Split in place; the Name field may be empty
+    char *field[5];
+    int n = 0;
+    char *p = line;
+    while (n < 5) {
+      field[n++] = p;
+      p = strchr(p, ',');
+      if (!p)
+        break;
+      *p++ = '\0';
+    }
+    if (n != 5)
+      continue;
+
+    char *end;
+    unsigned long ts = strtoul(field[0], &end, 10);
+    if (end == field[0])
+      continue; // Header or garbage
+    unsigned int id = (unsigned int)strtoul(field[1], NULL, 16);
+    unsigned int dlc = (unsigned int)strtoul(field[3], NULL, 10);
+    const char *data = field[4];
+
+    trace_frame_t *fr = trace_push(t);
+    if (!fr)
+      break;
+    fr->timestamp_ms = (uint32_t)ts;
+    fr->msg.identifier = id;
+    fr->msg.extd = id > 0x7FF || strlen(field[1]) > 3; // "%08X" = extended
+    fr->msg.data_length_code = dlc > 8 ? 8 : (uint8_t)dlc;
+    for (int i = 0; i < fr->msg.data_length_code; i++) {
+      unsigned int b = 0;
+      if (sscanf(&data[i * 2], "%2x", &b) == 1)
+        fr->msg.data[i] = (uint8_t)b;
+    }
+  }
+  fclose(f);
+  return t->count > 0;
+}
+
+bool trace_write(const trace_t *t, const char *path) {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return false;
+  char line[96];
+  fprintf(f, "Timestamp,ID,Name,DLC,Data\n");
+  for (size_t i = 0; i < t->count; i++) {
+    const trace_frame_t *fr = &t->frames[i];
+    uint32_t id = fr->msg.identifier | (fr->msg.extd ? CAN_SNIFFER_ID_EXT : 0);
+    if (can_logger_format_line(line, sizeof(line), fr->timestamp_ms, id,
+                               fr->msg.data, fr->msg.data_length_code))
+      fputs(line, f);
+  }
+  fclose(f);
+  return true;
+}
+
+typedef struct {
+  trace_t *trace;
+  const can_sim_t *sim;
+} sim_capture_t;
+
+static void sim_capture_cb(const twai_message_t *message, void *ctx) {
+  sim_capture_t *cap = ctx;
+  trace_frame_t *fr = trace_push(cap->trace);
+  if (!fr)
+    return;
+  fr->timestamp_ms = (uint32_t)(cap->sim->now_us / 1000);
+  fr->msg = *message;
+}
+
+void trace_generate(trace_t *t, CanPlatform platform, int seconds,
+                    int load_percent) {
+  can_sim_config_t cfg = CAN_SIM_CONFIG_DEFAULT();
+  cfg.platform = platform;
+  cfg.bus_load_percent = (uint8_t)load_percent;
+
+  static can_sim_t sim;
+  can_sim_init(&sim, &cfg);
+  sim_capture_t cap = {t, &sim};
+  for (int ms = 0; ms < seconds * 1000; ms += 10) {
+    can_sim_step(&sim, 10000, sim_capture_cb, &cap);
+  }
+  printf("Generated %zu frames: %s, %d s, %.1f%% bus load\n", t->count,
+         can_sim_scenario_name(cfg.scenario), seconds,
+         can_sim_get_bus_load(&sim));
+}
+
+void trace_free(trace_t *t) {
+  free(t->frames);
+  *t = (trace_t){0};
+}
+
+// --- Baseline ---
+
+bool baseline_save(const char *path) {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return false;
+  for (int i = 0; i < metric_count; i++)
+    fprintf(f, "%s %.3f\n", metrics[i].name, metrics[i].value);
+  fclose(f);
+  return true;
+}
+
+int baseline_compare(const char *path, double tolerance_pct) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return -1;
+
+  int regressions = 0;
+  char name[64];
+  double base;
+  printf("\n%-22s %12s %12s %8s\n", "metric", "baseline", "current",
+         "change");
+  while (fscanf(f, "%63s %lf", name, &base) == 2) {
+    for (int i = 0; i < metric_count; i++) {
+      if (strcmp(metrics[i].name, name) != 0)
+        continue;
+      double change = base > 0 ? 100.0 * (metrics[i].value - base) / base : 0;
+      bool regressed = change > tolerance_pct; // All metrics: lower is better
+      printf("%-22s %12.2f %12.2f %+7.1f%%%s\n", name, base, metrics[i].value,
+             change, regressed ? "  REGRESSION" : "");
+      regressions += regressed;
+    }
+  }
+  fclose(f);
+  return regressions;
+}
@@ -0,0 +1,46 @@
+// Shared by the host benchmarks: CAN traces (can_logger format or
+// generated by can_simulator), metrics, and baseline files for regression
+// checks.
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include "can_definitions.h"
+#include "driver/twai.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_METRICS 64
+
+typedef struct {
+  uint32_t timestamp_ms;
+  twai_message_t msg;
+} trace_frame_t;
+
+typedef struct {
+  trace_frame_t *frames;
+  size_t count;
+  size_t capacity;
+} trace_t;
+
+// --- Traces ---
+
+trace_frame_t *trace_push(trace_t *t);
+bool trace_load(trace_t *t, const char *path);
+bool trace_write(const trace_t *t, const char *path);
+void trace_generate(trace_t *t, CanPlatform platform, int seconds,
+                    int load_percent);
+void trace_free(trace_t *t);
+
+// --- Metrics (all: lower is better) ---
+
+double now_ns(void);
+void add_metric(const char *name, const char *unit, double value);
+void metrics_print(void);
+
+bool baseline_save(const char *path);
+// Returns the number of regressed metrics, or -1 if the file is unreadable
+int baseline_compare(const char *path, double tolerance_pct);
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,619 @@
+// Host benchmark for the CAN -> dashboard pipeline.
+//
+// Replays a trace (can_logger format, or one generated by can_simulator)
+// through the real modules and reports per-stage cost. With --baseline the
+// results are compared against a previous --save-baseline run and the exit
+// status is non-zero on regression. Derived channels are checked against
+// reference formulas on every replayed frame; a mismatch also fails the run.
+
+#include "bench_common.h"
+#include "can_filter.h"
+#include "can_logger.h"
+#include "can_parser.h"
+#include "can_simulator.h"
+#include "can_sniffer.h"
+#include "derived_channels.h"
+#include "ecu_data.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "gauge_filter.h"
+#include "session_stats.h"
+#include "signal_freshness.h"
+#include "signal_history.h"
+#include "signal_search.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_SIM_SECONDS 30
+#define DEFAULT_SIM_LOAD 60
+#define DEFAULT_REPEATS 5
+#define DEFAULT_TOLERANCE 15.0
+#define SNAPSHOT_OPS 200000
+
+static volatile uint32_t sink; // Defeats dead-code elimination
+
+// --- Stages ---
+
+// Best of `repeats` runs, in ns per item
+#define BEST_OF(repeats, items, body)                                          \
+  ({                                                                           \
+    double best_ = 1e300;                                                      \
+    for (int r_ = 0; r_ < (repeats); r_++) {                                   \
+      double t0_ = now_ns();                                                   \
+      body;                                                                    \
+      double dt_ = (now_ns() - t0_) / (double)(items);                         \
+      if (dt_ < best_)                                                         \
+        best_ = dt_;                                                           \
+    }                                                                          \
+    best_;                                                                     \
+  })
+
+static void bench_parse(const trace_t *t, int repeats) {
+  size_t decoded = 0;
+  double ns = BEST_OF(repeats, t->count, {
+    decoded = 0;
+    for (size_t i = 0; i < t->count; i++) {
+      if (parse_can_message(&t->frames[i].msg))
+        decoded++;
+    }
+  });
+  add_metric("parse_ns_per_frame", "ns", ns);
+  printf("  decoded %zu/%zu frames\n", decoded, t->count);
+}
+
+static void bench_snapshot(int repeats) {
+  ecu_data_t data;
+  ecu_data_get_copy(&data);
+
+  double read_ns = BEST_OF(repeats, SNAPSHOT_OPS, {
+    for (int i = 0; i < SNAPSHOT_OPS; i++) {
+      ecu_data_get_copy(&data);
+      sink += (uint32_t)data.engine_rpm;
+    }
+  });
+  add_metric("snapshot_read_ns", "ns", read_ns);
+
+  double write_ns = BEST_OF(repeats, SNAPSHOT_OPS, {
+    for (int i = 0; i < SNAPSHOT_OPS; i++) {
+      data.engine_rpm = (float)(i & 0x1FFF);
+      ecu_data_update(&data, ECU_SIG_BIT(ECU_SIG_RPM), (uint32_t)i);
+    }
+  });
+  add_metric("snapshot_write_ns", "ns", write_ns);
+}
+
+static void bench_freshness(int repeats) {
+  double ns = BEST_OF(repeats, SNAPSHOT_OPS, {
+    for (int i = 0; i < SNAPSHOT_OPS; i++)
+      sink += signal_freshness_sweep((uint32_t)i);
+  });
+  add_metric("freshness_sweep_ns", "ns", ns);
+}
+
+static void bench_logger(const trace_t *t, int repeats) {
+  char line[96];
+  size_t bytes = 0;
+  double ns = BEST_OF(repeats, t->count, {
+    bytes = 0;
+    for (size_t i = 0; i < t->count; i++) {
+      const trace_frame_t *f = &t->frames[i];
+      bytes += (size_t)can_logger_format_line(
+          line, sizeof(line), f->timestamp_ms, f->msg.identifier, f->msg.data,
+          f->msg.data_length_code);
+    }
+  });
+  add_metric("log_ns_per_frame", "ns", ns);
+  add_metric("log_bytes_per_frame", "B", (double)bytes / (double)t->count);
+}
+
+// Screen3 refresh: copy out and format the entries that changed
+static size_t sniffer_ui_tick(void) {
+  uint32_t dirty[CAN_SNIFFER_DIRTY_WORDS];
+  char hex[32];
+  char ascii[9];
+  size_t rows = 0;
+
+  can_sniffer_take_dirty(dirty);
+  for (int w = 0; w < CAN_SNIFFER_DIRTY_WORDS; w++) {
+    for (uint32_t bits = dirty[w]; bits; bits &= bits - 1) {
+      can_sniffer_entry_t e;
+      if (!can_sniffer_read(w * 32 + __builtin_ctz(bits), &e))
+        continue;
+      can_sniffer_format_hex(e.data, e.dlc, hex, sizeof(hex));
+      can_sniffer_format_ascii(e.data, e.dlc, ascii, sizeof(ascii));
+      sink += (uint32_t)hex[0] + (uint32_t)ascii[0];
+      rows++;
+    }
+  }
+  return rows;
+}
+
+// Replays the trace into the sniffer and checks its word-wise change
+// tracking against a byte-by-byte reference, with a toggled-bits reset
+// half way. Returns the number of mismatches.
+static int check_sniffer_changes(const trace_t *t) {
+  static uint8_t ref_data[CAN_SNIFFER_MAX_IDS][8];
+  static uint8_t ref_dlc[CAN_SNIFFER_MAX_IDS];
+  static uint8_t ref_toggled[CAN_SNIFFER_MAX_IDS][8];
+  static uint32_t ref_byte_ms[CAN_SNIFFER_MAX_IDS][8];
+  int mismatches = 0;
+
+  can_sniffer_clear();
+  memset(ref_toggled, 0, sizeof(ref_toggled));
+  memset(ref_byte_ms, 0, sizeof(ref_byte_ms));
+  for (size_t i = 0; i < t->count; i++) {
+    if (i == t->count / 2) {
+      can_sniffer_reset_changes();
+      memset(ref_toggled, 0, sizeof(ref_toggled));
+    }
+
+    const twai_message_t *m = &t->frames[i].msg;
+    uint32_t now = t->frames[i].timestamp_ms;
+    uint8_t dlc = m->data_length_code > 8 ? 8 : m->data_length_code;
+    bool is_new =
+        can_sniffer_find(m->identifier | (m->extd ? CAN_SNIFFER_ID_EXT : 0)) <
+        0;
+    int idx = can_sniffer_update(
+        m->identifier | (m->extd ? CAN_SNIFFER_ID_EXT : 0), m->data, dlc, now);
+    if (idx < 0)
+      continue;
+
+    uint8_t want_mask = 0;
+    for (int b = 0; b < 8; b++) {
+      uint8_t cur = b < dlc ? m->data[b] : 0;
+      uint8_t old = is_new ? cur : ref_data[idx][b];
+      if (cur != old)
+        want_mask |= (uint8_t)(1u << b);
+      ref_toggled[idx][b] |= cur ^ old;
+      ref_data[idx][b] = cur;
+    }
+    if (is_new || ref_dlc[idx] != dlc)
+      want_mask = 0xFF;
+    ref_dlc[idx] = dlc;
+    for (int b = 0; b < 8; b++) {
+      if (want_mask & (1u << b))
+        ref_byte_ms[idx][b] = now;
+    }
+
+    can_sniffer_entry_t e;
+    bool ok = can_sniffer_read(idx, &e) && e.change_mask == want_mask &&
+              memcmp(e.data, ref_data[idx], 8) == 0 &&
+              memcmp(e.byte_changed_ms, ref_byte_ms[idx],
+                     sizeof(e.byte_changed_ms)) == 0;
+    for (int b = 0; ok && b < 8; b++)
+      ok = (uint8_t)(e.toggled >> (8 * b)) == ref_toggled[idx][b];
+    if (!ok && mismatches++ < 5)
+      printf("  sniffer change tracking differs for ID %03lX (frame %zu)\n",
+             (unsigned long)m->identifier, i);
+  }
+  printf("  sniffer changes: %zu frames checked, %d mismatches\n", t->count,
+         mismatches);
+  return mismatches;
+}
+
+// Ingest-side model updates plus the UI refresh every SNIFFER_TICK_MS of
+// trace time, amortised per frame
+#define SNIFFER_TICK_MS 100
+
+static void bench_sniffer(const trace_t *t, int repeats) {
+  size_t ticks = 0;
+  size_t rows = 0;
+  double ns = BEST_OF(repeats, t->count, {
+    can_sniffer_clear();
+    ticks = rows = 0;
+    uint32_t next_tick = t->count ? t->frames[0].timestamp_ms : 0;
+    for (size_t i = 0; i < t->count; i++) {
+      const twai_message_t *m = &t->frames[i].msg;
+      can_sniffer_update(m->identifier | (m->extd ? CAN_SNIFFER_ID_EXT : 0),
+                         m->data, m->data_length_code,
+                         t->frames[i].timestamp_ms);
+      if ((int32_t)(t->frames[i].timestamp_ms - next_tick) >= 0) {
+        rows += sniffer_ui_tick();
+        ticks++;
+        next_tick += SNIFFER_TICK_MS;
+      }
+    }
+  });
+  add_metric("sniffer_ns_per_frame", "ns", ns);
+  printf("  sniffer tracks %d IDs, %.1f rows redrawn per refresh\n",
+         can_sniffer_get_count(), ticks ? (double)rows / (double)ticks : 0.0);
+}
+
+// Compiled search/filter: ID pattern, ID range, ASCII and unanchored bytes
+#define BENCH_FILTER "280:xx xx 1F | 440-44F: | \"ok\" | AABB"
+
+static void bench_filter(const trace_t *t, int repeats) {
+  can_filter_t filter;
+  if (can_filter_compile(BENCH_FILTER, &filter) != ESP_OK) {
+    printf("  filter: cannot compile %s\n", BENCH_FILTER);
+    return;
+  }
+
+  size_t hits = 0;
+  double ns = BEST_OF(repeats, t->count, {
+    hits = 0;
+    for (size_t i = 0; i < t->count; i++) {
+      const twai_message_t *m = &t->frames[i].msg;
+      hits += can_filter_match(
+          &filter, m->identifier | (m->extd ? CAN_SNIFFER_ID_EXT : 0),
+          m->data, m->data_length_code);
+    }
+  });
+  add_metric("filter_ns_per_frame", "ns", ns);
+  printf("  filter %s matches %zu of %zu frames\n", BENCH_FILTER, hits,
+         t->count);
+}
+
+// Signals the correlation search must locate on the replayed trace
+static const char *const search_refs[] = {"rpm", "speed"};
+
+// Capture the trace against a decoded reference signal
+static void search_capture(const trace_t *t, ecu_signal_id_t ref) {
+  ecu_data_t d;
+  signal_search_begin(ref);
+  for (size_t i = 0; i < t->count; i++) {
+    const twai_message_t *m = &t->frames[i].msg;
+    parse_can_message(m);
+    signal_freshness_t f;
+    signal_freshness_get(ref, 0, &f);
+    if (f.state == SIGNAL_STATE_NEVER)
+      continue;
+    ecu_data_get_copy(&d);
+    signal_search_capture(m->identifier | (m->extd ? CAN_SNIFFER_ID_EXT : 0),
+                          m->data, m->data_length_code,
+                          ecu_data_get_signal(&d, ref));
+  }
+}
+
+// Field by field: the struct has padding that memcmp would compare too
+static bool same_candidate(const signal_candidate_t *a,
+                           const signal_candidate_t *b) {
+  return a->id == b->id && a->start == b->start && a->length == b->length &&
+         a->big_endian == b->big_endian && a->is_signed == b->is_signed &&
+         a->correlation == b->correlation && a->scale == b->scale &&
+         a->offset == b->offset && a->samples == b->samples;
+}
+
+// Runs the search for each reference: synchronously (timed), then on the
+// worker tasks, which must rank the same best candidate. That candidate
+// must reproduce the reference on every frame of its ID. A reference the
+// platform never decodes is reported n/a. Returns the number of failed
+// references.
+static int check_signal_search(const trace_t *t) {
+  int failures = 0, searched = 0;
+  double total_ns = 0.0;
+  for (size_t r = 0; r < sizeof(search_refs) / sizeof(search_refs[0]); r++) {
+    ecu_signal_id_t ref = ecu_signal_find(search_refs[r]);
+    signal_candidate_t sync_best, best;
+
+    search_capture(t, ref);
+    signal_freshness_t f;
+    signal_freshness_get(ref, 0, &f);
+    if (f.state == SIGNAL_STATE_NEVER) {
+      signal_search_end();
+      printf("  search %s: n/a, not decoded on this platform\n",
+             search_refs[r]);
+      continue;
+    }
+    searched++;
+    double t0 = now_ns();
+    signal_search_run(0);
+    total_ns += now_ns() - t0;
+    int found = signal_search_get_results(&sync_best, 1);
+
+    search_capture(t, ref);
+    signal_search_run(SIGNAL_SEARCH_WORKERS);
+    while (signal_search_get_state() == SIGNAL_SEARCH_RUNNING)
+      vTaskDelay(1);
+    found = found && signal_search_get_results(&best, 1);
+    signal_search_end();
+
+    if (!found || !same_candidate(&best, &sync_best)) {
+      printf("  search %s: no candidate, or workers disagree\n",
+             search_refs[r]);
+      failures++;
+      continue;
+    }
+
+    // Replay and compare the candidate decode with the reference
+    float worst = 0.0f, lo = INFINITY, hi = -INFINITY;
+    ecu_data_t d;
+    for (size_t i = 0; i < t->count; i++) {
+      const twai_message_t *m = &t->frames[i].msg;
+      parse_can_message(m);
+      if ((m->identifier | (m->extd ? CAN_SNIFFER_ID_EXT : 0)) != best.id)
+        continue;
+      ecu_data_get_copy(&d);
+      float want = ecu_data_get_signal(&d, ref);
+      float got = signal_search_decode(&best, m->data, m->data_length_code);
+      worst = fmaxf(worst, fabsf(got - want));
+      lo = fminf(lo, want);
+      hi = fmaxf(hi, want);
+    }
+    char id[12];
+    can_sniffer_format_id(best.id, id, sizeof(id));
+    printf("  search %s: %s %s %u|%u%s r=%.4f scale=%g offset=%g, "
+           "max error %g\n",
+           search_refs[r], id, best.big_endian ? "BE" : "LE", best.start,
+           best.length, best.is_signed ? " signed" : "", best.correlation,
+           best.scale, best.offset, worst);
+    if (!(worst <= 0.01f * fmaxf(hi - lo, 1.0f)))
+      failures++;
+  }
+  if (searched)
+    add_metric("search_ms", "ms", total_ns / 1e6);
+  return failures;
+}
+
+static void bench_json(const trace_t *t, int repeats) {
+  // Fixed operating point so the cost does not depend on the trace
+  ecu_data_t data = {
+      .engine_rpm = 4250.0f,
+      .vehicle_speed = 123.4f,
+      .clt_temp = 91.5f,
+      .iat_temp = 34.0f,
+      .oil_temp = 104.2f,
+      .battery_voltage = 14.12f,
+      .gear = 4,
+      .map_kpa = 187.3f,
+      .tps_position = 78.4f,
+  };
+  char json[512];
+  size_t bytes = 0;
+  double ns = BEST_OF(repeats, t->count, {
+    for (size_t i = 0; i < t->count; i++) {
+      data.engine_rpm = 4250.0f + (float)(i & 0xFF);
+      bytes = ecu_data_to_json(&data, ECU_SIG_BIT(ECU_SIG_CLT), json,
+                               sizeof(json));
+      sink += (uint32_t)bytes;
+    }
+  });
+  add_metric("json_ns", "ns", ns);
+  add_metric("json_bytes", "B", (double)bytes);
+}
+
+// Reference formulas for the built-in derived channels
+static float derived_reference(const char *name, const ecu_data_t *d) {
+  if (!strcmp(name, "boost"))
+    return d->map_kpa - 101.3f;
+  if (!strcmp(name, "power"))
+    return d->eng_act_nm * d->engine_rpm / 9549.0f;
+  if (!strcmp(name, "wg_error"))
+    return d->wg_set_percent - d->wg_pos_percent;
+  if (!strcmp(name, "kmh_krpm"))
+    return d->engine_rpm != 0.0f ? d->vehicle_speed * 1000.0f / d->engine_rpm
+                                 : 0.0f;
+  return NAN;
+}
+
+// Replays the trace and checks every evaluated derived channel against its
+// reference after each frame. Returns the number of mismatches.
+static int check_derived(const trace_t *t) {
+  int mismatches = 0;
+  size_t checked = 0;
+  ecu_data_t d;
+
+  for (size_t i = 0; i < t->count; i++) {
+    parse_can_message(&t->frames[i].msg);
+    ecu_data_get_copy(&d);
+
+    for (int n = 0; n < derived_channels_count(); n++) {
+      ecu_signal_id_t sig = (ecu_signal_id_t)(ECU_SIG_DERIVED_0 + n);
+      signal_freshness_t f;
+      signal_freshness_get(sig, 0, &f);
+      if (f.state == SIGNAL_STATE_NEVER)
+        continue;
+
+      float want = derived_reference(ecu_signal_key(sig), &d);
+      float got = ecu_data_get_signal(&d, sig);
+      checked++;
+      if (fabsf(got - want) > 1e-4f * fmaxf(1.0f, fabsf(want))) {
+        if (mismatches++ < 5)
+          printf("  derived %s = %g, expected %g (frame %zu)\n",
+                 ecu_signal_key(sig), got, want, i);
+      }
+    }
+  }
+  printf("  derived: %zu values checked, %d mismatches\n", checked,
+         mismatches);
+  return mismatches;
+}
+
+static void bench_derived(int repeats) {
+  ecu_data_t data = {
+      .engine_rpm = 4250.0f,
+      .map_kpa = 187.3f,
+      .vehicle_speed = 123.4f,
+      .wg_set_percent = 62.0f,
+      .wg_pos_percent = 58.5f,
+      .eng_act_nm = 310.0f,
+  };
+  // Worst case: every input touched, every channel re-evaluated
+  double ns = BEST_OF(repeats, SNAPSHOT_OPS, {
+    for (int i = 0; i < SNAPSHOT_OPS; i++) {
+      data.engine_rpm = 4250.0f + (float)(i & 0xFF);
+      sink += derived_channels_evaluate(&data, ECU_SIG_MASK_ALL);
+    }
+  });
+  add_metric("derived_eval_ns", "ns", ns);
+}
+
+// One needle per display frame: a 20 ms sample stream stepped every 16 ms
+static void bench_gauge_filter(int repeats) {
+  gauge_filter_t damped = {0}, zero_lag = {0};
+  double ns = BEST_OF(repeats, SNAPSHOT_OPS, {
+    for (int i = 0; i < SNAPSHOT_OPS; i++) {
+      uint32_t now = (uint32_t)i * 16;
+      float rpm = 3000.0f + (float)((i * 37) & 0xFFF);
+      gauge_filter_sample(&damped, rpm, now - now % 20);
+      gauge_filter_sample(&zero_lag, rpm, now - now % 20);
+      sink += (uint32_t)gauge_filter_step(&damped, 120, now);
+      sink += (uint32_t)gauge_filter_step(&zero_lag, 0, now);
+    }
+  });
+  add_metric("gauge_filter_ns", "ns", ns / 2);
+}
+
+// Strip chart decimation: one 1280-column, 30 s window over a 100 Hz
+// signal, reduced column by column as the chart screen does
+#define HISTORY_RATE_MS 10
+#define HISTORY_WINDOW_MS 30000
+#define HISTORY_COLUMNS 1280
+
+static void bench_history(int repeats) {
+  ecu_data_t d;
+  ecu_data_get_copy(&d);
+  // After the replay's samples, which are stamped with the real clock
+  uint32_t base = (uint32_t)(esp_timer_get_time() / 1000) + 1000;
+  uint32_t end = base + HISTORY_WINDOW_MS + 5000;
+  for (uint32_t t = base; t < end; t += HISTORY_RATE_MS) {
+    d.engine_rpm = 3000.0f + (float)((t * 37) & 0xFFF);
+    signal_history_record(&d, ECU_SIG_BIT(ECU_SIG_RPM), t);
+  }
+
+  uint32_t start = end - HISTORY_WINDOW_MS;
+  double ns = BEST_OF(repeats, HISTORY_COLUMNS, {
+    uint32_t cursor = signal_history_seek(ECU_SIG_RPM, start);
+    for (int col = 0; col < HISTORY_COLUMNS; col++) {
+      signal_history_span_t span;
+      uint32_t until = start + (uint32_t)((uint64_t)(col + 1) *
+                                          HISTORY_WINDOW_MS / HISTORY_COLUMNS);
+      if (signal_history_reduce(ECU_SIG_RPM, &cursor, until, &span))
+        sink += (uint32_t)span.max;
+    }
+  });
+  add_metric("history_column_ns", "ns", ns);
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --trace FILE          replay a can_logger trace\n"
+          "  --write-trace FILE    save the replayed trace (can_logger format)\n"
+          "  --platform N          CanPlatform for decoding (default 0)\n"
+          "  --seconds N           simulated trace length (default %d)\n"
+          "  --load N              simulated bus load %% (default %d)\n"
+          "  --repeats N           runs per stage, best is kept (default %d)\n"
+          "  --baseline FILE       compare and fail on regression\n"
+          "  --save-baseline FILE  write results as a new baseline\n"
+          "  --tolerance PCT       allowed slowdown (default %.0f)\n",
+          argv0, DEFAULT_SIM_SECONDS, DEFAULT_SIM_LOAD, DEFAULT_REPEATS,
+          DEFAULT_TOLERANCE);
+}
+
+int main(int argc, char **argv) {
+  const char *trace_path = NULL;
+  const char *write_trace_path = NULL;
+  const char *baseline_path = NULL;
+  const char *save_path = NULL;
+  int platform = PLATFORM_VW_PQ35_46;
+  int seconds = DEFAULT_SIM_SECONDS;
+  int load = DEFAULT_SIM_LOAD;
+  int repeats = DEFAULT_REPEATS;
+  double tolerance = DEFAULT_TOLERANCE;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (!val) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (!strcmp(arg, "--trace"))
+      trace_path = val;
+    else if (!strcmp(arg, "--write-trace"))
+      write_trace_path = val;
+    else if (!strcmp(arg, "--platform"))
+      platform = atoi(val);
+    else if (!strcmp(arg, "--seconds"))
+      seconds = atoi(val);
+    else if (!strcmp(arg, "--load"))
+      load = atoi(val);
+    else if (!strcmp(arg, "--repeats"))
+      repeats = atoi(val);
+    else if (!strcmp(arg, "--baseline"))
+      baseline_path = val;
+    else if (!strcmp(arg, "--save-baseline"))
+      save_path = val;
+    else if (!strcmp(arg, "--tolerance"))
+      tolerance = atof(val);
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+    i++;
+  }
+  if (platform < 0 || platform >= PLATFORM_MAX || repeats < 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  esp_log_level_set("*", ESP_LOG_WARN);
+  ecu_data_init();
+  signal_freshness_init();
+  signal_history_init();
+  session_stats_init();
+  can_sniffer_init();
+  derived_channels_load_defaults();
+  can_parser_set_platform((CanPlatform)platform);
+
+  trace_t trace = {0};
+  if (trace_path) {
+    if (!trace_load(&trace, trace_path))
+      return 2;
+    printf("Loaded %zu frames from %s\n", trace.count, trace_path);
+  } else {
+    trace_generate(&trace, (CanPlatform)platform, seconds, load);
+  }
+  if (write_trace_path && !trace_write(&trace, write_trace_path)) {
+    fprintf(stderr, "cannot write trace %s\n", write_trace_path);
+    return 2;
+  }
+
+  int status = 0;
+  if (check_derived(&trace) != 0)
+    status = 1;
+  if (check_sniffer_changes(&trace) != 0)
+    status = 1;
+  if (check_signal_search(&trace) != 0)
+    status = 1;
+
+  printf("Running stages (best of %d)\n", repeats);
+  bench_parse(&trace, repeats);
+  bench_snapshot(repeats);
+  bench_freshness(repeats);
+  bench_logger(&trace, repeats);
+  bench_sniffer(&trace, repeats);
+  bench_filter(&trace, repeats);
+  bench_json(&trace, repeats);
+  bench_derived(repeats);
+  bench_gauge_filter(repeats);
+  bench_history(repeats);
+
+  printf("\n");
+  metrics_print();
+
+  if (baseline_path) {
+    int regressions = baseline_compare(baseline_path, tolerance);
+    if (regressions < 0) {
+      fprintf(stderr, "cannot read baseline %s\n", baseline_path);
+      status = 2;
+    } else if (regressions > 0) {
+      printf("\n%d metric(s) regressed by more than %.0f%%\n", regressions,
+             tolerance);
+      status = 1;
+    }
+  }
+  if (save_path && !baseline_save(save_path)) {
+    fprintf(stderr, "cannot write baseline %s\n", save_path);
+    status = 2;
+  }
+
+  trace_free(&trace);
+  return status;
+}
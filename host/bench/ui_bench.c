@@ -0,0 +1,490 @@
+// Headless render benchmark for the dashboard screens.
+//
+// Builds the real UI (main/ui) against LVGL with a display driver that
+// renders into an in-memory 1280x720 RGB565 frame, in bands of the same
+// height as the firmware's draw buffers. CAN data is replayed through the
+// parser in virtual time (a can_logger trace, or one generated by
+// can_simulator) while each screen is shown in turn; esp_timer_get_time()
+// follows the same clock, so the output does not depend on host speed.
+// Per screen it reports the build time and resident heap (screens outside
+// the pinned set are built on first visit), the first full render,
+// steady-state frame time, invalidated area and LVGL heap peak, and writes
+// a BMP snapshot. The boot figure is ui_init() plus the first render of the
+// gauge page.
+//
+// With --reference the snapshots are compared against a previous run and
+// a screen whose pixels changed by more than the tolerance fails the run:
+// layout breakage from a SquareLine regeneration shows up here before it
+// reaches the hardware. --baseline / --save-baseline work as in
+// pipeline_bench.
+
+#include "bench_common.h"
+#include "can_parser.h"
+#include "can_sniffer.h"
+#include "derived_channels.h"
+#include "ecu_data.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "lv_host_mem.h"
+#include "lvgl.h"
+#include "session_stats.h"
+#include "signal_freshness.h"
+#include "signal_history.h"
+#include "ui.h"
+#include "ui_gauge_layers.h"
+#include "ui_screen_manager.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define LCD_H_RES 1280
+#define LCD_V_RES 720
+#define DRAW_BUF_LINES 100 // CONFIG_DISPLAY_DRAW_BUF_LINES default
+#define TICK_MS 5
+
+#define DEFAULT_SIM_SECONDS 30
+#define DEFAULT_SIM_LOAD 60
+#define DEFAULT_SCREEN_MS 3000
+#define DEFAULT_TOLERANCE 15.0
+#define DEFAULT_SNAPSHOT_TOLERANCE 0.5 // % of pixels
+#define DEFAULT_SNAPSHOT_DIR "ui_snapshots"
+
+static const char *const screen_names[SCREEN_COUNT] = {
+    "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10",
+};
+
+// --- Headless display ---
+
+static lv_color_t *framebuffer;
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+// Set by monitor_cb when a refresh rendered something
+static struct {
+  bool rendered;
+  uint32_t px;
+} refr;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area,
+                     lv_color_t *color_p) {
+  int32_t w = lv_area_get_width(area);
+  for (int32_t y = area->y1; y <= area->y2; y++) {
+    memcpy(&framebuffer[y * LCD_H_RES + area->x1], color_p,
+           w * sizeof(lv_color_t));
+    color_p += w;
+  }
+  lv_disp_flush_ready(drv);
+}
+
+static void monitor_cb(lv_disp_drv_t *drv, uint32_t time_ms, uint32_t px) {
+  (void)drv;
+  (void)time_ms; // Virtual ticks; timed by the caller instead
+  refr.rendered = true;
+  refr.px += px;
+}
+
+static bool display_init(void) {
+  size_t buf_px = LCD_H_RES * DRAW_BUF_LINES;
+  framebuffer = calloc(LCD_H_RES * LCD_V_RES, sizeof(lv_color_t));
+  lv_color_t *buf1 = malloc(buf_px * sizeof(lv_color_t));
+  lv_color_t *buf2 = malloc(buf_px * sizeof(lv_color_t));
+  if (!framebuffer || !buf1 || !buf2)
+    return false;
+
+  lv_disp_draw_buf_init(&draw_buf, buf1, buf2, buf_px);
+  lv_disp_drv_init(&disp_drv);
+  disp_drv.hor_res = LCD_H_RES;
+  disp_drv.ver_res = LCD_V_RES;
+  disp_drv.flush_cb = flush_cb;
+  disp_drv.monitor_cb = monitor_cb;
+  disp_drv.draw_buf = &draw_buf;
+  return lv_disp_drv_register(&disp_drv) != NULL;
+}
+
+static uint32_t count_objects(lv_obj_t *obj) {
+  uint32_t n = 1;
+  uint32_t children = lv_obj_get_child_cnt(obj);
+  for (uint32_t i = 0; i < children; i++)
+    n += count_objects(lv_obj_get_child(obj, i));
+  return n;
+}
+
+// --- Snapshots: 24-bit top-down BMP ---
+
+#define BMP_HEADER_SIZE 54
+
+static void put_le(uint8_t *p, uint32_t v, int bytes) {
+  for (int i = 0; i < bytes; i++)
+    p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static bool snapshot_write(const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+
+  uint32_t row = LCD_H_RES * 3; // Already a multiple of 4
+  uint8_t h[BMP_HEADER_SIZE] = {'B', 'M'};
+  put_le(&h[2], BMP_HEADER_SIZE + row * LCD_V_RES, 4);
+  put_le(&h[10], BMP_HEADER_SIZE, 4);
+  put_le(&h[14], 40, 4);
+  put_le(&h[18], LCD_H_RES, 4);
+  put_le(&h[22], (uint32_t)-LCD_V_RES, 4); // Negative: top-down rows
+  put_le(&h[26], 1, 2);
+  put_le(&h[28], 24, 2);
+  put_le(&h[34], row * LCD_V_RES, 4);
+  fwrite(h, 1, sizeof(h), f);
+
+  uint8_t *line = malloc(row);
+  if (!line) {
+    fclose(f);
+    return false;
+  }
+  for (int y = 0; y < LCD_V_RES; y++) {
+    for (int x = 0; x < LCD_H_RES; x++) {
+      uint32_t c = lv_color_to32(framebuffer[y * LCD_H_RES + x]);
+      line[x * 3 + 0] = (uint8_t)c;         // B
+      line[x * 3 + 1] = (uint8_t)(c >> 8);  // G
+      line[x * 3 + 2] = (uint8_t)(c >> 16); // R
+    }
+    fwrite(line, 1, row, f);
+  }
+  free(line);
+  return fclose(f) == 0;
+}
+
+// Percentage of pixels that differ between two snapshots, or -1 if either
+// is missing or the sizes differ
+static double snapshot_diff(const char *a_path, const char *b_path) {
+  FILE *a = fopen(a_path, "rb");
+  FILE *b = fopen(b_path, "rb");
+  double result = -1;
+  uint8_t ha[BMP_HEADER_SIZE], hb[BMP_HEADER_SIZE];
+  if (!a || !b || fread(ha, 1, sizeof(ha), a) != sizeof(ha) ||
+      fread(hb, 1, sizeof(hb), b) != sizeof(hb) ||
+      memcmp(ha, hb, sizeof(ha)) != 0)
+    goto out;
+
+  uint64_t differing = 0, total = 0;
+  uint8_t pa[3], pb[3];
+  while (fread(pa, 1, 3, a) == 3 && fread(pb, 1, 3, b) == 3) {
+    total++;
+    differing += memcmp(pa, pb, 3) != 0;
+  }
+  if (total == (uint64_t)LCD_H_RES * LCD_V_RES)
+    result = 100.0 * (double)differing / (double)total;
+
+out:
+  if (a)
+    fclose(a);
+  if (b)
+    fclose(b);
+  return result;
+}
+
+// --- Replay ---
+
+// Trace frames in virtual time, looping when the trace runs out
+typedef struct {
+  const trace_t *trace;
+  size_t next;
+  uint32_t first_ms;
+  uint32_t span_ms;
+  uint32_t offset_ms;
+} replay_t;
+
+static void replay_init(replay_t *r, const trace_t *t) {
+  r->trace = t;
+  r->next = 0;
+  r->first_ms = t->frames[0].timestamp_ms;
+  uint32_t span = t->frames[t->count - 1].timestamp_ms - r->first_ms;
+  r->span_ms = span + 1;
+  r->offset_ms = 0;
+}
+
+// The can_manager_ingest() path minus the logger and signal search
+static void ingest(const twai_message_t *msg) {
+  parse_can_message(msg);
+  uint32_t id = msg->identifier | (msg->extd ? CAN_SNIFFER_ID_EXT : 0);
+  can_sniffer_update(id, msg->data, msg->data_length_code,
+                     (uint32_t)(esp_timer_get_time() / 1000));
+}
+
+static void replay_until(replay_t *r, uint32_t now_ms) {
+  for (;;) {
+    if (r->next == r->trace->count) {
+      r->next = 0;
+      r->offset_ms += r->span_ms;
+    }
+    const trace_frame_t *f = &r->trace->frames[r->next];
+    if (f->timestamp_ms - r->first_ms + r->offset_ms > now_ms)
+      return;
+    ingest(&f->msg);
+    r->next++;
+  }
+}
+
+// --- Screens ---
+
+typedef struct {
+  uint32_t objects;
+  double load_us;   // First render after loading: the whole screen
+  double frame_us;  // Steady state: lv_timer_handler() calls that rendered
+  double frame_max_us;
+  uint32_t frames;
+  double area_kpx;  // Invalidated per steady-state frame
+  double peak_kb;   // LVGL heap above the level when the screen loaded
+  double diff_pct;  // Against the reference snapshot, -1 if none
+} screen_result_t;
+
+static uint32_t virtual_ms = 0;
+
+static void run_screen(lv_obj_t *screen, replay_t *replay, int screen_ms,
+                       screen_result_t *res) {
+  memset(res, 0, sizeof(*res));
+  res->diff_pct = -1;
+
+  lv_disp_load_scr(screen);
+  res->objects = count_objects(screen) + count_objects(lv_layer_top());
+  lv_host_mem_reset_peak();
+  size_t base = lv_host_mem_used();
+
+  memset(&refr, 0, sizeof(refr));
+  double t0 = now_ns();
+  lv_refr_now(NULL);
+  res->load_us = (now_ns() - t0) / 1000.0;
+
+  double total_us = 0;
+  uint64_t total_px = 0;
+  for (int ms = 0; ms < screen_ms; ms += TICK_MS) {
+    virtual_ms += TICK_MS;
+    host_clock_set_virtual_us((int64_t)virtual_ms * 1000);
+    replay_until(replay, virtual_ms);
+    lv_tick_inc(TICK_MS);
+
+    memset(&refr, 0, sizeof(refr));
+    t0 = now_ns();
+    lv_timer_handler();
+    double us = (now_ns() - t0) / 1000.0;
+    if (!refr.rendered)
+      continue;
+    res->frames++;
+    total_us += us;
+    total_px += refr.px;
+    if (us > res->frame_max_us)
+      res->frame_max_us = us;
+  }
+
+  if (res->frames) {
+    res->frame_us = total_us / res->frames;
+    res->area_kpx = (double)total_px / res->frames / 1000.0;
+  }
+  res->peak_kb = (double)(lv_host_mem_peak() - base) / 1024.0;
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --trace FILE          replay a can_logger trace\n"
+          "  --platform N          CanPlatform for decoding (default 0)\n"
+          "  --seconds N           simulated trace length (default %d)\n"
+          "  --load N              simulated bus load %% (default %d)\n"
+          "  --screen-ms N         virtual time per screen (default %d)\n"
+          "  --snapshots DIR       where to write BMPs (default %s)\n"
+          "  --reference DIR       compare snapshots against a previous run\n"
+          "  --snapshot-tolerance PCT  allowed changed pixels (default %.1f)\n"
+          "  --baseline FILE       compare and fail on regression\n"
+          "  --save-baseline FILE  write results as a new baseline\n"
+          "  --tolerance PCT       allowed slowdown (default %.0f)\n",
+          argv0, DEFAULT_SIM_SECONDS, DEFAULT_SIM_LOAD, DEFAULT_SCREEN_MS,
+          DEFAULT_SNAPSHOT_DIR, DEFAULT_SNAPSHOT_TOLERANCE, DEFAULT_TOLERANCE);
+}
+
+int main(int argc, char **argv) {
+  const char *trace_path = NULL;
+  const char *snapshot_dir = DEFAULT_SNAPSHOT_DIR;
+  const char *reference_dir = NULL;
+  const char *baseline_path = NULL;
+  const char *save_path = NULL;
+  int platform = PLATFORM_VW_PQ35_46;
+  int seconds = DEFAULT_SIM_SECONDS;
+  int load = DEFAULT_SIM_LOAD;
+  int screen_ms = DEFAULT_SCREEN_MS;
+  double snapshot_tolerance = DEFAULT_SNAPSHOT_TOLERANCE;
+  double tolerance = DEFAULT_TOLERANCE;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (!val) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (!strcmp(arg, "--trace"))
+      trace_path = val;
+    else if (!strcmp(arg, "--platform"))
+      platform = atoi(val);
+    else if (!strcmp(arg, "--seconds"))
+      seconds = atoi(val);
+    else if (!strcmp(arg, "--load"))
+      load = atoi(val);
+    else if (!strcmp(arg, "--screen-ms"))
+      screen_ms = atoi(val);
+    else if (!strcmp(arg, "--snapshots"))
+      snapshot_dir = val;
+    else if (!strcmp(arg, "--reference"))
+      reference_dir = val;
+    else if (!strcmp(arg, "--snapshot-tolerance"))
+      snapshot_tolerance = atof(val);
+    else if (!strcmp(arg, "--baseline"))
+      baseline_path = val;
+    else if (!strcmp(arg, "--save-baseline"))
+      save_path = val;
+    else if (!strcmp(arg, "--tolerance"))
+      tolerance = atof(val);
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+    i++;
+  }
+  if (platform < 0 || platform >= PLATFORM_MAX || screen_ms < TICK_MS) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  esp_log_level_set("*", ESP_LOG_WARN);
+  ecu_data_init();
+  signal_freshness_init();
+  signal_history_init();
+  session_stats_init();
+  can_sniffer_init();
+  derived_channels_load_defaults();
+  can_parser_set_platform((CanPlatform)platform);
+
+  trace_t trace = {0};
+  if (trace_path) {
+    if (!trace_load(&trace, trace_path))
+      return 2;
+    printf("Loaded %zu frames from %s\n", trace.count, trace_path);
+  } else {
+    trace_generate(&trace, (CanPlatform)platform, seconds, load);
+  }
+  if (trace.count == 0) {
+    fprintf(stderr, "empty trace\n");
+    return 2;
+  }
+  replay_t replay;
+  replay_init(&replay, &trace);
+
+  lv_init();
+  if (!display_init()) {
+    fprintf(stderr, "cannot allocate the display buffers\n");
+    return 2;
+  }
+  if (mkdir(snapshot_dir, 0755) != 0 && errno != EEXIST) {
+    fprintf(stderr, "cannot create %s\n", snapshot_dir);
+    return 2;
+  }
+
+  // Everything the UI times runs on the replay clock
+  host_clock_set_virtual_us(0);
+  double t0 = now_ns();
+  ui_init();
+  add_metric("ui_init_ms", "ms", (now_ns() - t0) / 1e6);
+  add_metric("ui_heap_kb", "kB", (double)lv_host_mem_used() / 1024.0);
+  add_metric("gauge_layers_kb", "kB",
+             (double)ui_gauge_layers_get_bytes() / 1024.0);
+  lv_refr_now(NULL);
+  add_metric("first_gauge_ms", "ms", (now_ns() - t0) / 1e6);
+
+  int status = 0;
+  printf("\n%-6s %8s %9s %7s %9s %9s %9s %6s %10s %8s %8s\n", "screen",
+         "build_us", "resident", "objects", "load_us", "frame_us", "max_us",
+         "frames", "area_kpx", "peak_kb", "diff_%");
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    const char *screen_name = screen_names[i];
+    bool built = ui_screen_is_created((screen_id_t)i);
+    size_t mem_before = lv_host_mem_used();
+    t0 = now_ns();
+    lv_obj_t *screen = ui_screen_get((screen_id_t)i);
+    double build_us = built ? 0 : (now_ns() - t0) / 1000.0;
+    double resident_kb =
+        built ? 0 : (double)(lv_host_mem_used() - mem_before) / 1024.0;
+    if (!screen) {
+      printf("%-6s (not created)\n", screen_name);
+      continue;
+    }
+
+    screen_result_t res;
+    run_screen(screen, &replay, screen_ms, &res);
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.bmp", snapshot_dir, screen_name);
+    if (!snapshot_write(path)) {
+      fprintf(stderr, "cannot write %s\n", path);
+      status = 2;
+    }
+    if (reference_dir) {
+      char ref[256];
+      snprintf(ref, sizeof(ref), "%s/%s.bmp", reference_dir, screen_name);
+      res.diff_pct = snapshot_diff(path, ref);
+    }
+
+    if (built)
+      printf("%-6s %8s %9s", screen_name, "pinned", "-");
+    else
+      printf("%-6s %8.0f %8.1fk", screen_name, build_us, resident_kb);
+    printf(" %7lu %9.0f %9.0f %9.0f %6lu %10.1f %8.1f",
+           (unsigned long)res.objects, res.load_us, res.frame_us,
+           res.frame_max_us, (unsigned long)res.frames, res.area_kpx,
+           res.peak_kb);
+    if (res.diff_pct >= 0)
+      printf(" %8.2f%s\n", res.diff_pct,
+             res.diff_pct > snapshot_tolerance ? "  CHANGED" : "");
+    else
+      printf(" %8s\n", reference_dir ? "missing" : "-");
+    if (res.diff_pct > snapshot_tolerance && status == 0)
+      status = 1;
+
+    char name[32];
+    if (!built) {
+      snprintf(name, sizeof(name), "%s_build_us", screen_name);
+      add_metric(name, "us", build_us);
+      snprintf(name, sizeof(name), "%s_resident_kb", screen_name);
+      add_metric(name, "kB", resident_kb);
+    }
+    snprintf(name, sizeof(name), "%s_load_us", screen_name);
+    add_metric(name, "us", res.load_us);
+    snprintf(name, sizeof(name), "%s_frame_us", screen_name);
+    add_metric(name, "us", res.frame_us);
+    snprintf(name, sizeof(name), "%s_area_kpx", screen_name);
+    add_metric(name, "kpx", res.area_kpx);
+    snprintf(name, sizeof(name), "%s_peak_kb", screen_name);
+    add_metric(name, "kB", res.peak_kb);
+  }
+
+  printf("\n");
+  metrics_print();
+
+  if (baseline_path) {
+    int regressions = baseline_compare(baseline_path, tolerance);
+    if (regressions < 0) {
+      fprintf(stderr, "cannot read baseline %s\n", baseline_path);
+      status = 2;
+    } else if (regressions > 0) {
+      printf("\n%d metric(s) regressed by more than %.0f%%\n", regressions,
+             tolerance);
+      status = 1;
+    }
+  }
+  if (save_path && !baseline_save(save_path)) {
+    fprintf(stderr, "cannot write baseline %s\n", save_path);
+    status = 2;
+  }
+
+  trace_free(&trace);
+  return status;
+}
@@ -0,0 +1,37 @@
+// LVGL configuration for the host UI build (ui_bench). Mirrors the
+// firmware's sdkconfig.defaults: RGB565, DPI 130, the Montserrat sizes the
+// screens use, and LV_MEM_CUSTOM, here routed through a counting allocator
+// so the benchmark can report LVGL heap use. Everything else keeps the
+// LVGL 8.3 defaults, as on the device.
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 0
+
+#define LV_MEM_CUSTOM 1
+#define LV_MEM_CUSTOM_INCLUDE "lv_host_mem.h"
+#define LV_MEM_CUSTOM_ALLOC lv_host_malloc
+#define LV_MEM_CUSTOM_FREE lv_host_free
+#define LV_MEM_CUSTOM_REALLOC lv_host_realloc
+
+// Ticks come from the benchmark's virtual clock (lv_tick_inc)
+#define LV_TICK_CUSTOM 0
+
+#define LV_DPI_DEF 130
+
+#define LV_FONT_MONTSERRAT_10 1
+#define LV_FONT_MONTSERRAT_12 1
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_MONTSERRAT_48 1
+
+#define LV_USE_LOG 0
+#define LV_USE_PERF_MONITOR 0
+#define LV_USE_MEM_MONITOR 0
+
+#endif // LV_CONF_H
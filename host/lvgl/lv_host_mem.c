@@ -0,0 +1,49 @@
+#include "lv_host_mem.h"
+#include <stdlib.h>
+
+// Each block carries its size so frees can be counted
+typedef union {
+  size_t size;
+  max_align_t align;
+} block_t;
+
+static size_t used = 0;
+static size_t peak = 0;
+
+void *lv_host_malloc(size_t size) {
+  block_t *b = malloc(sizeof(block_t) + size);
+  if (!b)
+    return NULL;
+  b->size = size;
+  used += size;
+  if (used > peak)
+    peak = used;
+  return b + 1;
+}
+
+void lv_host_free(void *ptr) {
+  if (!ptr)
+    return;
+  block_t *b = (block_t *)ptr - 1;
+  used -= b->size;
+  free(b);
+}
+
+void *lv_host_realloc(void *ptr, size_t size) {
+  if (!ptr)
+    return lv_host_malloc(size);
+  block_t *b = (block_t *)ptr - 1;
+  size_t old = b->size;
+  block_t *nb = realloc(b, sizeof(block_t) + size);
+  if (!nb)
+    return NULL;
+  nb->size = size;
+  used = used - old + size;
+  if (used > peak)
+    peak = used;
+  return nb + 1;
+}
+
+size_t lv_host_mem_used(void) { return used; }
+size_t lv_host_mem_peak(void) { return peak; }
+void lv_host_mem_reset_peak(void) { peak = used; }
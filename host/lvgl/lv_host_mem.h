@@ -0,0 +1,14 @@
+// Counting allocator behind LVGL's LV_MEM_CUSTOM on the host
+#pragma once
+
+#include <stddef.h>
+
+void *lv_host_malloc(size_t size);
+void lv_host_free(void *ptr);
+void *lv_host_realloc(void *ptr, size_t size);
+
+// Bytes currently allocated by LVGL, and the high-water mark since the
+// last lv_host_mem_reset_peak()
+size_t lv_host_mem_used(void);
+size_t lv_host_mem_peak(void);
+void lv_host_mem_reset_peak(void);
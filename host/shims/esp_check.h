@@ -0,0 +1,14 @@
+// Host shim: ESP-IDF error check helpers
+#pragma once
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#define ESP_RETURN_ON_ERROR(x, tag, msg)                                       \
+  do {                                                                         \
+    esp_err_t err_rc_ = (x);                                                   \
+    if (err_rc_ != ESP_OK) {                                                   \
+      ESP_LOGE(tag, "%s", msg);                                                \
+      return err_rc_;                                                          \
+    }                                                                          \
+  } while (0)
@@ -0,0 +1,6 @@
+// Host shim: deterministic xorshift32 in place of the hardware RNG
+#pragma once
+
+#include <stdint.h>
+
+uint32_t esp_random(void);
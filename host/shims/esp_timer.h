@@ -0,0 +1,11 @@
+// Host shim: microsecond monotonic clock
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+// Host only: from the first call on, esp_timer_get_time() (and the tick
+// count) return `us` instead of the real clock, so a bench replaying in
+// virtual time gets the same output on any machine
+void host_clock_set_virtual_us(int64_t us);
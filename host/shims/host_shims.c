@@ -0,0 +1,303 @@
+// Host implementations of the FreeRTOS / ESP-IDF calls used by the
+// hardware-independent pipeline modules.
+
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "sd_card_manager.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+esp_log_level_t host_log_level = ESP_LOG_WARN;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level) {
+  if (tag && strcmp(tag, "*") == 0)
+    host_log_level = level;
+}
+
+const char *esp_err_to_name(esp_err_t code) {
+  switch (code) {
+  case ESP_OK:
+    return "ESP_OK";
+  case ESP_FAIL:
+    return "ESP_FAIL";
+  case ESP_ERR_NO_MEM:
+    return "ESP_ERR_NO_MEM";
+  case ESP_ERR_INVALID_ARG:
+    return "ESP_ERR_INVALID_ARG";
+  case ESP_ERR_INVALID_STATE:
+    return "ESP_ERR_INVALID_STATE";
+  case ESP_ERR_NOT_FOUND:
+    return "ESP_ERR_NOT_FOUND";
+  case ESP_ERR_TIMEOUT:
+    return "ESP_ERR_TIMEOUT";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+// Seeded once, so UI snapshots are reproducible
+uint32_t esp_random(void) {
+  static uint32_t state = 0x2545F491u;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// One heap on the host; capabilities are ignored
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  (void)caps;
+  return malloc(size);
+}
+
+void heap_caps_free(void *ptr) { free(ptr); }
+
+size_t heap_caps_get_free_size(uint32_t caps) { return 0; }
+
+static bool clock_virtual = false;
+static int64_t clock_virtual_us = 0;
+
+void host_clock_set_virtual_us(int64_t us) {
+  __atomic_store_n(&clock_virtual_us, us, __ATOMIC_RELAXED);
+  __atomic_store_n(&clock_virtual, true, __ATOMIC_RELEASE);
+}
+
+int64_t esp_timer_get_time(void) {
+  if (__atomic_load_n(&clock_virtual, __ATOMIC_ACQUIRE))
+    return __atomic_load_n(&clock_virtual_us, __ATOMIC_RELAXED);
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Absolute CLOCK_REALTIME deadline for pthread timed waits
+static struct timespec deadline_after(TickType_t ticks) {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  uint64_t ns = (uint64_t)ticks * (1000000000ULL / configTICK_RATE_HZ);
+  ts.tv_sec += ns / 1000000000ULL;
+  ts.tv_nsec += ns % 1000000000ULL;
+  if (ts.tv_nsec >= 1000000000L) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  return ts;
+}
+
+// --- Mutex ---
+
+struct host_mutex {
+  pthread_mutex_t mutex;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  SemaphoreHandle_t sem = calloc(1, sizeof(*sem));
+  if (sem)
+    pthread_mutex_init(&sem->mutex, NULL);
+  return sem;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+  if (!sem)
+    return pdFALSE;
+  if (ticks == portMAX_DELAY)
+    return pthread_mutex_lock(&sem->mutex) == 0 ? pdTRUE : pdFALSE;
+  if (ticks == 0)
+    return pthread_mutex_trylock(&sem->mutex) == 0 ? pdTRUE : pdFALSE;
+  struct timespec ts = deadline_after(ticks);
+  return pthread_mutex_timedlock(&sem->mutex, &ts) == 0 ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  if (!sem)
+    return pdFALSE;
+  return pthread_mutex_unlock(&sem->mutex) == 0 ? pdTRUE : pdFALSE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+  if (!sem)
+    return;
+  pthread_mutex_destroy(&sem->mutex);
+  free(sem);
+}
+
+// --- Queue ---
+
+struct host_queue {
+  pthread_mutex_t mutex;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+  UBaseType_t length;
+  UBaseType_t item_size;
+  UBaseType_t head;
+  UBaseType_t count;
+  uint8_t *items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+  QueueHandle_t q = calloc(1, sizeof(*q));
+  if (!q)
+    return NULL;
+  q->items = calloc(length, item_size);
+  if (!q->items) {
+    free(q);
+    return NULL;
+  }
+  q->length = length;
+  q->item_size = item_size;
+  pthread_mutex_init(&q->mutex, NULL);
+  pthread_cond_init(&q->not_empty, NULL);
+  pthread_cond_init(&q->not_full, NULL);
+  return q;
+}
+
+// Wait on cond until pred holds or the tick budget runs out
+#define QUEUE_WAIT(q, cond, pred, ticks, ok)                                   \
+  do {                                                                         \
+    struct timespec ts_ = deadline_after(ticks);                               \
+    ok = true;                                                                 \
+    while (!(pred)) {                                                          \
+      if ((ticks) == 0) {                                                      \
+        ok = false;                                                            \
+      } else if ((ticks) == portMAX_DELAY) {                                   \
+        pthread_cond_wait(cond, &(q)->mutex);                                  \
+        continue;                                                              \
+      } else if (pthread_cond_timedwait(cond, &(q)->mutex, &ts_) ==           \
+                 ETIMEDOUT) {                                                  \
+        ok = (pred);                                                           \
+      } else {                                                                 \
+        continue;                                                              \
+      }                                                                        \
+      break;                                                                   \
+    }                                                                          \
+  } while (0)
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks) {
+  if (!q || !item)
+    return pdFALSE;
+  bool ok;
+  pthread_mutex_lock(&q->mutex);
+  QUEUE_WAIT(q, &q->not_full, q->count < q->length, ticks, ok);
+  if (ok) {
+    UBaseType_t tail = (q->head + q->count) % q->length;
+    memcpy(q->items + (size_t)tail * q->item_size, item, q->item_size);
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks) {
+  if (!q || !item)
+    return pdFALSE;
+  bool ok;
+  pthread_mutex_lock(&q->mutex);
+  QUEUE_WAIT(q, &q->not_empty, q->count > 0, ticks, ok);
+  if (ok) {
+    memcpy(item, q->items + (size_t)q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    pthread_cond_signal(&q->not_full);
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return ok ? pdTRUE : pdFALSE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  if (!q)
+    return 0;
+  pthread_mutex_lock(&q->mutex);
+  UBaseType_t n = q->count;
+  pthread_mutex_unlock(&q->mutex);
+  return n;
+}
+
+void vQueueDelete(QueueHandle_t q) {
+  if (!q)
+    return;
+  pthread_mutex_destroy(&q->mutex);
+  pthread_cond_destroy(&q->not_empty);
+  pthread_cond_destroy(&q->not_full);
+  free(q->items);
+  free(q);
+}
+
+// --- Tasks ---
+
+struct host_task {
+  pthread_t thread;
+  TaskFunction_t fn;
+  void *arg;
+};
+
+static void *task_trampoline(void *p) {
+  struct host_task *t = p;
+  t->fn(t->arg);
+  return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name,
+                                   uint32_t stack, void *arg, UBaseType_t prio,
+                                   TaskHandle_t *handle, BaseType_t core) {
+  (void)name;
+  (void)stack;
+  (void)prio;
+  (void)core;
+
+  // Handles are never freed: tasks in this firmware live for the whole run
+  // or self-delete, and the host process is short-lived.
+  struct host_task *t = calloc(1, sizeof(*t));
+  if (!t)
+    return pdFAIL;
+  t->fn = fn;
+  t->arg = arg;
+  if (handle)
+    *handle = t;
+  if (pthread_create(&t->thread, NULL, task_trampoline, t) != 0) {
+    if (handle)
+      *handle = NULL;
+    free(t);
+    return pdFAIL;
+  }
+  pthread_detach(t->thread);
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack,
+                       void *arg, UBaseType_t prio, TaskHandle_t *handle) {
+  return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, 0);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task == NULL)
+    pthread_exit(NULL);
+}
+
+void vTaskDelay(TickType_t ticks) {
+  usleep((useconds_t)ticks * (1000000 / configTICK_RATE_HZ));
+}
+
+TickType_t xTaskGetTickCount(void) {
+  return (TickType_t)(esp_timer_get_time() / (1000000 / configTICK_RATE_HZ));
+}
+
+// --- SD card: a directory under the working directory ---
+
+bool sd_card_is_mounted(void) {
+  mkdir(SD_MOUNT_POINT, 0755);
+  return true;
+}
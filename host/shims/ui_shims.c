@@ -0,0 +1,61 @@
+// Host stand-ins for the firmware modules the UI calls into that are not
+// part of the host build (settings storage, CAN driver, Wi-Fi, AI, the
+// performance monitor). Settings live in memory with the firmware
+// defaults for the screens the benchmark shows.
+
+#include "ai_manager.h"
+#include "can_manager.h"
+#include "perf_monitor.h"
+#include "settings_config.h"
+#include "wifi_controller.h"
+#include <string.h>
+
+static bool demo_mode = false;
+static bool screen3 = true;
+static bool nav_buttons = true;
+static CanPlatform platform = PLATFORM_VW_PQ35_46;
+
+bool demo_mode_get_enabled(void) { return demo_mode; }
+void demo_mode_set_enabled(bool enabled) { demo_mode = enabled; }
+bool screen3_get_enabled(void) { return screen3; }
+void screen3_set_enabled(bool enabled) { screen3 = enabled; }
+bool nav_buttons_get_enabled(void) { return nav_buttons; }
+void nav_buttons_set_enabled(bool enabled) { nav_buttons = enabled; }
+CanPlatform settings_get_can_platform(void) { return platform; }
+void settings_set_can_platform(CanPlatform p) { platform = p; }
+void trigger_settings_save(void) {}
+void settings_reset_to_defaults(void) {}
+esp_err_t settings_load(void) { return ESP_OK; }
+
+// The benchmark feeds the parser directly; demo mode has nothing to start
+esp_err_t can_manager_set_demo_mode(bool enabled) {
+  demo_mode = enabled;
+  return ESP_OK;
+}
+
+void ai_manager_trigger_listening(void) {}
+
+void wifi_controller_get_state(game_controller_state_t *state) {
+  memset(state, 0, sizeof(*state));
+}
+
+// Single-threaded: the benchmark owns LVGL
+bool example_lvgl_lock(int timeout_ms) {
+  (void)timeout_ms;
+  return true;
+}
+void example_lvgl_unlock(void) {}
+
+// The HUD is never shown by the benchmark
+bool perf_monitor_active = false;
+void perf_monitor_set_enabled(bool enabled) { (void)enabled; }
+void perf_monitor_set_obj_count(uint16_t count) { (void)count; }
+void perf_monitor_latency_mark(int64_t sample_us) { (void)sample_us; }
+int perf_monitor_get_history(perf_frame_t *out, int max) {
+  (void)out;
+  (void)max;
+  return 0;
+}
+void perf_monitor_sample_system(perf_system_t *out) {
+  memset(out, 0, sizeof(*out));
+}
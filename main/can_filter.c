@@ -0,0 +1,252 @@
+#include "can_filter.h"
+#include "can_sniffer.h"
+#include <ctype.h>
+#include <string.h>
+
+static int hex_nibble(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  c = (char)tolower((unsigned char)c);
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+static const char *skip_space(const char *p, const char *end) {
+  while (p < end && isspace((unsigned char)*p))
+    p++;
+  return p;
+}
+
+static const char *trim_end(const char *p, const char *end) {
+  while (end > p && isspace((unsigned char)end[-1]))
+    end--;
+  return end;
+}
+
+// Hex number of 1..8 digits; advances *p
+static bool parse_hex(const char **p, const char *end, uint32_t *out) {
+  uint32_t value = 0;
+  int digits = 0;
+  for (; *p < end && hex_nibble(**p) >= 0; (*p)++, digits++)
+    value = (value << 4) | (uint32_t)hex_nibble(**p);
+  *out = value;
+  return digits > 0 && digits <= 8;
+}
+
+static uint32_t encode_id(uint32_t id, bool ext) {
+  return ext ? (id | CAN_SNIFFER_ID_EXT) : id;
+}
+
+// "280", "200-2FF" or "280/7F0"
+static bool parse_ids(const char *p, const char *end, can_filter_term_t *t) {
+  uint32_t lo, hi, mask = CAN_SNIFFER_ID_MASK;
+  p = skip_space(p, end);
+  end = trim_end(p, end);
+  if (!parse_hex(&p, end, &lo))
+    return false;
+  hi = lo;
+
+  if (p < end && *p == '-') {
+    p++;
+    if (!parse_hex(&p, end, &hi) || hi < lo)
+      return false;
+  } else if (p < end && *p == '/') {
+    p++;
+    if (!parse_hex(&p, end, &mask))
+      return false;
+    mask &= CAN_SNIFFER_ID_MASK;
+    lo = hi = lo & mask;
+  }
+  if (p != end || hi > CAN_SNIFFER_ID_MASK)
+    return false;
+
+  bool ext = hi > 0x7FF;
+  t->id_mask = mask | CAN_SNIFFER_ID_EXT;
+  t->id_lo = encode_id(lo, ext);
+  t->id_hi = encode_id(hi, ext);
+  return true;
+}
+
+// Quoted text: "abc" -> lower-case bytes
+static bool parse_text(const char *p, const char *end, can_filter_term_t *t) {
+  size_t len = (size_t)(end - p);
+  if (len == 0 || len > 8)
+    return false;
+  uint64_t value = 0;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = (unsigned char)p[i];
+    if (c < 32 || c > 126)
+      return false;
+    value |= (uint64_t)(unsigned char)tolower(c) << (8 * i);
+  }
+  t->text_value = value;
+  t->text_len = (uint8_t)len;
+  return true;
+}
+
+static bool is_quoted(const char *p, const char *end) {
+  return end - p >= 2 && *p == '"' && end[-1] == '"';
+}
+
+// Anchored pattern "xx xx 1F" / "AABB??"
+static bool parse_pattern(const char *p, const char *end,
+                          can_filter_term_t *t) {
+  int n = 0;
+  while ((p = skip_space(p, end)) < end) {
+    if (end - p < 2 || n >= 8)
+      return false;
+    char a = (char)tolower((unsigned char)p[0]);
+    char b = (char)tolower((unsigned char)p[1]);
+    if ((a == 'x' && b == 'x') || (a == '?' && b == '?')) {
+      // Any value
+    } else {
+      int hi = hex_nibble(a), lo = hex_nibble(b);
+      if (hi < 0 || lo < 0)
+        return false;
+      t->fixed_mask |= 0xFFull << (8 * n);
+      t->fixed_value |= (uint64_t)((hi << 4) | lo) << (8 * n);
+    }
+    p += 2;
+    n++;
+  }
+  t->min_dlc = (uint8_t)n;
+  return true;
+}
+
+// Unanchored bytes "AABB" / "AA BB"; false if not a whole-byte hex string
+static bool parse_hex_seq(const char *p, const char *end,
+                          can_filter_term_t *t) {
+  uint64_t value = 0;
+  int nibbles = 0;
+  for (; p < end; p++) {
+    if (isspace((unsigned char)*p))
+      continue;
+    int v = hex_nibble(*p);
+    if (v < 0 || nibbles >= 16)
+      return false;
+    // Nibbles fill each byte high then low, bytes in payload order
+    int byte = nibbles / 2;
+    value |= (uint64_t)v << (8 * byte + ((nibbles & 1) ? 0 : 4));
+    nibbles++;
+  }
+  if (nibbles == 0 || (nibbles & 1))
+    return false;
+  t->hex_value = value;
+  t->hex_len = (uint8_t)(nibbles / 2);
+  return true;
+}
+
+static bool parse_term(const char *p, const char *end, can_filter_term_t *t) {
+  memset(t, 0, sizeof(*t));
+  p = skip_space(p, end);
+  end = trim_end(p, end);
+
+  const char *colon = NULL;
+  bool quoted = false;
+  for (const char *q = p; q < end; q++) {
+    if (*q == '"')
+      quoted = !quoted;
+    else if (*q == ':' && !quoted) {
+      colon = q;
+      break;
+    }
+  }
+
+  if (colon) {
+    if (!parse_ids(p, colon, t))
+      return false;
+    p = skip_space(colon + 1, end);
+    if (is_quoted(p, end))
+      return parse_text(p + 1, end - 1, t);
+    return parse_pattern(p, end, t);
+  }
+
+  if (is_quoted(p, end))
+    return parse_text(p + 1, end - 1, t);
+
+  // Bare term: hex bytes and/or text, whichever readings are valid
+  bool hex = parse_hex_seq(p, end, t);
+  bool text = parse_text(p, end, t);
+  return hex || text;
+}
+
+esp_err_t can_filter_compile(const char *expr, can_filter_t *out) {
+  out->count = 0;
+  if (!expr)
+    return ESP_OK;
+
+  size_t len = strnlen(expr, CAN_FILTER_MAX_EXPR + 1);
+  if (len > CAN_FILTER_MAX_EXPR)
+    return ESP_ERR_INVALID_ARG;
+
+  const char *end = expr + len;
+  const char *start = expr;
+  bool quoted = false;
+  int count = 0;
+  for (const char *p = expr; p <= end; p++) {
+    if (p < end && *p == '"')
+      quoted = !quoted;
+    if (p < end && (quoted || (*p != '|' && *p != ';')))
+      continue;
+
+    if (skip_space(start, p) < p) {
+      if (count >= CAN_FILTER_MAX_TERMS ||
+          !parse_term(start, p, &out->terms[count]))
+        return ESP_ERR_INVALID_ARG;
+      count++;
+    }
+    start = p + 1;
+  }
+  out->count = (uint8_t)count;
+  return ESP_OK;
+}
+
+// Set bit 5 of the bytes holding 'A'..'Z' (high bit of each byte computes
+// the two range compares, carries never cross a byte)
+static uint64_t lower_ascii(uint64_t w) {
+  const uint64_t high = 0x8080808080808080ull;
+  uint64_t low7 = w & ~high;
+  uint64_t ge_a = low7 + 0x3F3F3F3F3F3F3F3Full;  // 0x80 - 'A'
+  uint64_t gt_z = low7 + 0x2525252525252525ull;  // 0x80 - 'Z' - 1
+  uint64_t upper = ge_a & ~gt_z & ~w & high;
+  return w | (upper >> 2);
+}
+
+// Does `len` bytes of `value` occur at any offset within the first dlc
+static bool find_seq(uint64_t word, uint8_t dlc, uint64_t value, uint8_t len) {
+  uint64_t mask = len >= 8 ? ~0ull : (1ull << (8 * len)) - 1;
+  bool hit = false;
+  for (int k = 0; k + len <= dlc; k++)
+    hit |= ((word >> (8 * k)) & mask) == value;
+  return hit;
+}
+
+bool can_filter_match(const can_filter_t *f, uint32_t id, const uint8_t *data,
+                      uint8_t dlc) {
+  if (f->count == 0)
+    return true;
+  if (dlc > 8)
+    dlc = 8;
+
+  uint64_t word = 0;
+  memcpy(&word, data, dlc);
+  uint64_t lower = lower_ascii(word);
+
+  for (int i = 0; i < f->count; i++) {
+    const can_filter_term_t *t = &f->terms[i];
+    uint32_t key = id & t->id_mask;
+    bool head = (key - t->id_lo <= t->id_hi - t->id_lo) &
+                (dlc >= t->min_dlc) &
+                ((word & t->fixed_mask) == t->fixed_value);
+    if (!head)
+      continue;
+    if (!t->hex_len && !t->text_len)
+      return true;
+    if (t->hex_len && find_seq(word, dlc, t->hex_value, t->hex_len))
+      return true;
+    if (t->text_len && find_seq(lower, dlc, t->text_value, t->text_len))
+      return true;
+  }
+  return false;
+}
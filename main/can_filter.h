@@ -0,0 +1,67 @@
+#ifndef CAN_FILTER_H
+#define CAN_FILTER_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame filter compiled once from a search expression, then matched per
+// frame with a few 64-bit mask compares (no parsing, no string building).
+// Shared by the Screen3 search box, the SD logger and /api/can-frames.
+//
+// Expression: terms separated by '|' or ';', a frame matches if any term
+// does. Each term is "[ids:] [payload]":
+//   ids      280          one ID (values above 7FF are extended IDs)
+//            200-2FF      inclusive range
+//            280/7F0      value/mask
+//   payload  xx xx 1F     bytes from byte 0, "xx" or "??" = any value
+//            "text"       ASCII substring, case-insensitive
+// Without "ids:", a bare payload is searched anywhere in the frame as hex
+// bytes ("AABB", "AA BB") if it reads as hex, and as ASCII text; either
+// match counts, so "ab" finds the byte 0xAB or the text "ab" (quote it for
+// text only). So "280:xx xx 1F" is ID 0x280 with byte 2 = 0x1F, and "rpm"
+// finds the text.
+//
+// IDs use the sniffer encoding: extended IDs carry CAN_SNIFFER_ID_EXT.
+
+#define CAN_FILTER_MAX_TERMS 8
+#define CAN_FILTER_MAX_EXPR 96
+
+typedef struct {
+  uint32_t id_mask; // 0 = any ID
+  uint32_t id_lo;   // Inclusive range of (id & id_mask)
+  uint32_t id_hi;
+  uint64_t fixed_mask; // Anchored payload pattern (bit 8*i = byte i)
+  uint64_t fixed_value;
+  uint8_t min_dlc; // Frames shorter than the anchored pattern never match
+  uint8_t hex_len; // Unanchored byte sequence, 0 = none
+  uint8_t text_len; // Unanchored lower-case ASCII, 0 = none
+  uint64_t hex_value;
+  uint64_t text_value;
+} can_filter_term_t;
+
+typedef struct {
+  can_filter_term_t terms[CAN_FILTER_MAX_TERMS];
+  uint8_t count; // 0 = match everything
+} can_filter_t;
+
+// Compile an expression. NULL or blank matches everything. On a syntax
+// error returns ESP_ERR_INVALID_ARG and leaves a match-everything filter.
+esp_err_t can_filter_compile(const char *expr, can_filter_t *out);
+
+static inline bool can_filter_is_empty(const can_filter_t *f) {
+  return f->count == 0;
+}
+
+bool can_filter_match(const can_filter_t *f, uint32_t id, const uint8_t *data,
+                      uint8_t dlc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CAN_FILTER_H
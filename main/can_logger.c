@@ -1,10 +1,14 @@
 #include "can_logger.h"
+#include "can_filter.h"
+#include "can_sniffer.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "sd_card_manager.h" // Use P4 SD manager
+#include "session_stats.h"
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -130,6 +134,17 @@ static size_t current_file_size = 0;
 static char log_buffer[LOG_BUFFER_SIZE];
 static size_t buffer_index = 0;
 static void (*stop_callback)(void) = NULL;
+#define LOG_FILENAME_FMT SD_MOUNT_POINT "/trace_%03d.txt"
+// The format plus the widest int the index can print as
+static char log_filename[sizeof(LOG_FILENAME_FMT) + 11];
+
+// Recording filter. The setter compiles into a local copy and installs it
+// behind a sequence counter (odd = install in progress); the CAN task
+// matches without a lock and retries if the counter moved. Setters (Screen3,
+// web) take filter_mutex, so there is one writer at a time.
+static can_filter_t filter;
+static uint32_t filter_seq = 0;
+static SemaphoreHandle_t filter_mutex = NULL;
 
 // Helper to flush buffer to file
 static void flush_buffer(void) {
@@ -140,37 +155,39 @@ static void flush_buffer(void) {
   }
 }
 
+// Format: Timestamp(ms),ID(hex),Name,DLC,Data(hex)\n
+int can_logger_format_line(char *buf, size_t size, uint32_t timestamp_ms,
+                           uint32_t id, const uint8_t *data, uint8_t dlc) {
+  static const char hex[] = "0123456789ABCDEF";
+  bool ext = (id & CAN_SNIFFER_ID_EXT) != 0;
+  id &= CAN_SNIFFER_ID_MASK;
+  const char *name = ext ? NULL : get_can_id_name(id);
+  if (dlc > 8)
+    dlc = 8;
+
+  int len = snprintf(buf, size, ext ? "%lu,%08X,%s,%d," : "%lu,%03X,%s,%d,",
+                     (unsigned long)timestamp_ms, (unsigned int)id,
+                     name ? name : "", dlc);
+  if (len < 0 || (size_t)len + dlc * 2 + 2 > size)
+    return 0; // Does not fit
+
+  for (int i = 0; i < dlc; i++) {
+    buf[len++] = hex[data[i] >> 4];
+    buf[len++] = hex[data[i] & 0x0F];
+  }
+  buf[len++] = '\n';
+  buf[len] = '\0';
+  return len;
+}
+
 static void can_logger_task(void *arg) {
   can_log_msg_t msg;
   while (1) {
     if (xQueueReceive(log_queue, &msg, pdMS_TO_TICKS(100)) == pdTRUE) {
       if (is_recording) {
-        // Format: Timestamp(ms),ID(hex),Name,DLC,Data(hex)\n
-        const char *name = get_can_id_name(msg.id);
-        int len;
-        if (name) {
-          len = snprintf(log_buffer + buffer_index,
-                         LOG_BUFFER_SIZE - buffer_index, "%lu,%03X,%s,%d,",
-                         (unsigned long)msg.timestamp, (unsigned int)msg.id,
-                         name, msg.dlc);
-        } else {
-          len = snprintf(log_buffer + buffer_index,
-                         LOG_BUFFER_SIZE - buffer_index, "%lu,%03X,,%d,",
-                         (unsigned long)msg.timestamp, (unsigned int)msg.id,
-                         msg.dlc);
-        }
-
-        buffer_index += len;
-
-        for (int i = 0; i < msg.dlc; i++) {
-          len = snprintf(log_buffer + buffer_index,
-                         LOG_BUFFER_SIZE - buffer_index, "%02X", msg.data[i]);
-          buffer_index += len;
-        }
-
-        len = snprintf(log_buffer + buffer_index,
-                       LOG_BUFFER_SIZE - buffer_index, "\n");
-        buffer_index += len;
+        buffer_index += can_logger_format_line(
+            log_buffer + buffer_index, LOG_BUFFER_SIZE - buffer_index,
+            msg.timestamp, msg.id, msg.data, msg.dlc);
 
         // Flush if buffer is full or nearly full
         if (buffer_index >= LOG_BUFFER_SIZE - 64) {
@@ -197,6 +214,7 @@ static void can_logger_task(void *arg) {
 
 void can_logger_init(void) {
   log_queue = xQueueCreate(LOG_QUEUE_SIZE, sizeof(can_log_msg_t));
+  filter_mutex = xSemaphoreCreateMutex();
   xTaskCreate(can_logger_task, "can_logger", 4096, NULL, 5, &log_task_handle);
 }
 
@@ -211,11 +229,11 @@ void can_logger_start(void) {
   }
 
   // Find next available filename
-  char filename[32];
+  char *filename = log_filename;
   int index = 1;
   struct stat st;
   do {
-    snprintf(filename, sizeof(filename), "/sdcard/trace_%03d.txt", index++);
+    snprintf(filename, sizeof(log_filename), LOG_FILENAME_FMT, index++);
   } while (stat(filename, &st) == 0);
 
   ESP_LOGI(TAG, "Starting log to %s", filename);
@@ -227,6 +245,9 @@ void can_logger_start(void) {
     current_file_size = 0;
     buffer_index = 0;
 
+    // Each trace gets its own statistics session
+    session_stats_reset();
+
     // Write header
     fprintf(log_file, "Timestamp,ID,Name,DLC,Data\n");
   } else {
@@ -249,11 +270,60 @@ void can_logger_stop(void) {
 
   is_recording = false;
   ESP_LOGI(TAG, "Logging stopped");
+
+  // Save session statistics next to the trace: trace_NNN.txt ->
+  // trace_NNN_stats.csv
+  char stats_path[sizeof(log_filename) + sizeof("_stats")];
+  size_t base_len = strlen(log_filename);
+  if (base_len > 4) {
+    snprintf(stats_path, sizeof(stats_path), "%.*s_stats.csv",
+             (int)(base_len - 4), log_filename);
+    session_stats_export_csv(stats_path);
+  }
+}
+
+esp_err_t can_logger_set_filter(const char *expr) {
+  can_filter_t next;
+  if (can_filter_compile(expr, &next) != ESP_OK) {
+    ESP_LOGW(TAG, "Invalid filter '%s', keeping the current one",
+             expr ? expr : "");
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!filter_mutex)
+    return ESP_ERR_INVALID_STATE;
+
+  xSemaphoreTake(filter_mutex, portMAX_DELAY);
+  __atomic_store_n(&filter_seq, filter_seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  filter = next;
+  __atomic_store_n(&filter_seq, filter_seq + 1, __ATOMIC_RELEASE);
+  xSemaphoreGive(filter_mutex);
+
+  if (!can_filter_is_empty(&next))
+    ESP_LOGI(TAG, "Recording filter: %s", expr);
+  return ESP_OK;
+}
+
+// True if the frame passes the recording filter. A setter that keeps racing
+// the read lets the frame through rather than dropping it.
+static bool filter_accepts(uint32_t id, const uint8_t *data, uint8_t dlc) {
+  for (int attempt = 0; attempt < 4; attempt++) {
+    uint32_t before = __atomic_load_n(&filter_seq, __ATOMIC_ACQUIRE);
+    if (before & 1u)
+      continue;
+    bool match = can_filter_match(&filter, id, data, dlc);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&filter_seq, __ATOMIC_RELAXED) == before)
+      return match;
+  }
+  return true;
 }
 
 void can_logger_log(uint32_t id, uint8_t *data, uint8_t dlc) {
   if (!is_recording)
     return;
+  if (!filter_accepts(id, data, dlc))
+    return;
 
   can_log_msg_t msg;
   msg.timestamp = (uint32_t)(esp_timer_get_time() / 1000);
@@ -265,6 +335,10 @@ void can_logger_log(uint32_t id, uint8_t *data, uint8_t dlc) {
   xQueueSend(log_queue, &msg, 0);
 }
 
+int can_logger_get_queue_depth(void) {
+  return log_queue ? (int)uxQueueMessagesWaiting(log_queue) : 0;
+}
+
 bool can_logger_is_recording(void) { return is_recording; }
 
 void can_logger_set_stop_callback(void (*cb)(void)) { stop_callback = cb; }
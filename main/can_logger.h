@@ -1,7 +1,9 @@
 #ifndef CAN_LOGGER_H
 #define CAN_LOGGER_H
 
+#include "esp_err.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 
@@ -14,9 +16,23 @@ void can_logger_start(void);
 // Stop recording
 void can_logger_stop(void);
 
-// Queue a CAN message for logging
+// Queue a CAN message for logging. `id` uses the sniffer encoding
+// (CAN_SNIFFER_ID_EXT marks extended IDs); frames outside the recording
+// filter are dropped before they reach the queue.
 void can_logger_log(uint32_t id, uint8_t *data, uint8_t dlc);
 
+// Only record frames matching a can_filter expression (NULL or "" = all).
+// Takes effect for the next frame; returns ESP_ERR_INVALID_ARG and keeps
+// the current filter if the expression does not compile.
+esp_err_t can_logger_set_filter(const char *expr);
+
+// Format one trace line into buf. Returns its length, or 0 if it does not fit.
+int can_logger_format_line(char *buf, size_t size, uint32_t timestamp_ms,
+                           uint32_t id, const uint8_t *data, uint8_t dlc);
+
+// Frames waiting for the writer task
+int can_logger_get_queue_depth(void);
+
 // Check if currently recording
 bool can_logger_is_recording(void);
 
@@ -1,23 +1,49 @@
 #include "can_manager.h"
+#include "can_logger.h"
 #include "can_parser.h"
+#include "can_simulator.h"
+#include "can_sniffer.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "sd_card_manager.h"
-#include "ui/screens/ui_Screen3.h" // Include Screen3 header
+#include "session_stats.h"
+#include "settings_config.h"
+#include "signal_freshness.h"
+#include "signal_history.h"
+#include "signal_search.h"
 #include <stdio.h>
 #include <time.h>
 
-// Extern LVGL lock functions (defined in main.c usually)
-extern bool example_lvgl_lock(int timeout_ms);
-extern void example_lvgl_unlock(void);
-
 static const char *TAG = "CAN_MGR";
 
-ecu_data_t g_ecu_data = {0};
+// The TWAI task and the simulator both ingest. The parser's read-modify-write
+// of the ECU snapshot, the sniffer, signal search, statistics and freshness
+// all assume a single writer, so frames go through one at a time.
+static SemaphoreHandle_t ingest_mutex = NULL;
 
 esp_err_t can_init(void) {
+  // 0. Data pipeline: shared ECU snapshot, signal freshness and history,
+  // session statistics, SD trace logger, sniffer model
+  ecu_data_init();
+  signal_freshness_init();
+  signal_history_init();
+  session_stats_init();
+  can_logger_init();
+  can_sniffer_init();
+  ingest_mutex = xSemaphoreCreateMutex();
+  ESP_RETURN_ON_FALSE(ingest_mutex, ESP_ERR_NO_MEM, TAG,
+                      "Ingest mutex creation failed");
+
+  // Demo mode: simulated frames share the ingest path with the bus, and keep
+  // working even if the transceiver below fails to come up
+  if (demo_mode_get_enabled()) {
+    can_manager_set_demo_mode(true);
+  }
+
   // 1. Initialize configuration structures
   // Using TWAI_MODE_NO_ACK allows the device to receive messages even if it's
   // the only node on the bus and prevents it from interfering with the
@@ -42,20 +68,64 @@ esp_err_t can_init(void) {
   return ESP_OK;
 }
 
+void can_manager_ingest(const twai_message_t *message) {
+  if (!ingest_mutex)
+    return;
+  xSemaphoreTake(ingest_mutex, portMAX_DELAY);
+
+  // Decode into ecu_data (also feeds session statistics)
+  parse_can_message(message);
+
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  uint32_t sniffer_id = message->identifier;
+  if (message->extd)
+    sniffer_id |= CAN_SNIFFER_ID_EXT;
+
+  // SD trace (no-op unless recording; applies the recording filter)
+  can_logger_log(sniffer_id, (uint8_t *)message->data,
+                 message->data_length_code);
+
+  // Sniffer model; Screen3 picks up changed IDs from its own timer, so the
+  // CAN task never waits on the LVGL lock
+  can_sniffer_update(sniffer_id, message->data,
+                     message->data_length_code, now_ms);
+
+  // Correlation capture (no-op unless a signal search is capturing)
+  signal_search_feed(sniffer_id, message->data, message->data_length_code,
+                     now_ms);
+  xSemaphoreGive(ingest_mutex);
+}
+
+static void sim_emit_cb(const twai_message_t *message, void *ctx) {
+  (void)ctx;
+  can_manager_ingest(message);
+}
+
+int can_manager_get_rx_pending(void) {
+  twai_status_info_t status;
+  if (twai_get_status_info(&status) != ESP_OK)
+    return 0;
+  return (int)status.msgs_to_rx;
+}
+
+esp_err_t can_manager_set_demo_mode(bool enabled) {
+  // Always restart so a platform change takes effect
+  can_simulator_stop();
+  if (!enabled) {
+    ESP_LOGI(TAG, "Demo mode off");
+    return ESP_OK;
+  }
+
+  can_sim_config_t cfg = CAN_SIM_CONFIG_DEFAULT();
+  cfg.platform = can_parser_get_platform();
+  return can_simulator_start(&cfg, sim_emit_cb, NULL);
+}
+
 void can_rx_task(void *pvParameters) {
   twai_message_t message;
   while (1) {
     if (twai_receive(&message, pdMS_TO_TICKS(1000)) == ESP_OK) {
-      // Process message using the powerful new parser
-      parse_can_message(&message);
-
-      // Send to UI Sniffer / Logger
-      // Must take LVGL lock because we are calling UI functions
-      if (example_lvgl_lock(10)) {
-        ui_process_real_can_message(message.identifier, message.data,
-                                    message.data_length_code);
-        example_lvgl_unlock();
-      }
+      can_manager_ingest(&message);
 
       // Log to SD Card (Legacy direct logging - REMOVED, handled by UI/Logger
       // now)
@@ -3,6 +3,7 @@
 #include "esp_err.h"
 #include "driver/twai.h"
 #include "ecu_data.h"
+#include <stdbool.h>
 
 // TWAI Pin Definitions (User provided)
 #define CAN_TX_IO           (20)
@@ -22,3 +23,28 @@ esp_err_t can_init(void);
  * @brief Task responsible for receiving and parsing CAN frames.
  */
 void can_rx_task(void *pvParameters);
+
+/**
+ * @brief Single ingest path for a received frame: parser, ECU snapshot,
+ * session statistics, sniffer and logger.
+ *
+ * Used by the TWAI receive task and by the CAN simulator; calls are
+ * serialised, so everything downstream sees a single writer.
+ */
+void can_manager_ingest(const twai_message_t *message);
+
+/**
+ * @brief Frames waiting in the TWAI driver's receive queue (0 if the driver
+ * is not running).
+ */
+int can_manager_get_rx_pending(void);
+
+/**
+ * @brief Start or stop the frame-level CAN simulator (demo mode).
+ *
+ * The simulator emits frames for the current parser platform. Calling this
+ * while enabled restarts it, e.g. after a platform change.
+ *
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t can_manager_set_demo_mode(bool enabled);
@@ -1,6 +1,11 @@
 #include "can_parser.h"
+#include "derived_channels.h"
 #include "ecu_data.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "session_stats.h"
+#include "signal_freshness.h"
+#include "signal_history.h"
 #include <math.h>
 #include <string.h>
 
@@ -28,10 +33,11 @@ void can_parser_set_max_torque(float max_torque) {
 }
 
 // --- Platform Parsers ---
+// Each parser returns the mask of signals the frame wrote (0 = not decoded).
 
 // 1. VW PQ35/PQ46 (Passat B6, Golf 5/6, etc.) - The original implementation
-static void parse_vw_pq35_46(const twai_message_t *message,
-                             ecu_data_t *ecu_data) {
+static ecu_signal_mask_t parse_vw_pq35_46(const twai_message_t *message,
+                                          ecu_data_t *ecu_data) {
   switch (message->identifier) {
   case 0x280: // Motor_1: RPM (0.25 scaling)
     ecu_data->engine_rpm =
@@ -39,146 +45,227 @@ static void parse_vw_pq35_46(const twai_message_t *message,
     ecu_data->eng_act_nm = message->data[1] * 0.39f;  // Inneres_Motormoment
     ecu_data->tps_position = message->data[5] * 0.4f; // Throttle
     ecu_data->eng_trg_nm = message->data[7] * 0.39f;  // Requested Torque
-    break;
+    return ECU_SIG_BIT(ECU_SIG_RPM) | ECU_SIG_BIT(ECU_SIG_ENG_ACT) |
+           ECU_SIG_BIT(ECU_SIG_TPS) | ECU_SIG_BIT(ECU_SIG_ENG_TRG);
 
   case 0x288: // Motor_2: Coolant (PQ35/46 uses this for Coolant, PQ25 might
               // differ)
     ecu_data->clt_temp = (message->data[1] * 0.75f) - 48.0f;
     ecu_data->limit_tq_nm = message->data[6] * 0.39f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_CLT) | ECU_SIG_BIT(ECU_SIG_LIMIT_TQ);
 
   case 0x380: // Motor_3: IAT
     ecu_data->iat_temp = (message->data[1] * 0.75f) - 48.0f;
     ecu_data->abs_pedal_pos = message->data[2] * 0.4f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_IAT) | ECU_SIG_BIT(ECU_SIG_PEDAL);
 
   case 0x588: // Motor_7: Oil Temp & Boost
     ecu_data->map_kpa = (message->data[4] * 0.01f) * 100.0f; // Bar -> kPa
     ecu_data->oil_temp = (message->data[7] * 1.0f) - 60.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_MAP) | ECU_SIG_BIT(ECU_SIG_OIL_TEMP);
 
   case 0x372: // Battery
     ecu_data->battery_voltage = (message->data[5] * 0.05f) + 5.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_BATTERY);
 
   case 0x540: // Gear (Getriebe_2)
     ecu_data->gear = (message->data[7] >> 4) & 0x0F;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_GEAR);
 
   case 0x1A0: // Speed source (Bremse_1) - ABS Wheel Speed
   {
     uint16_t raw_speed = ((uint16_t)message->data[3] << 8 | message->data[2]);
     raw_speed = (raw_speed >> 1) & 0x7FFF;
     ecu_data->vehicle_speed = raw_speed * 0.01f;
-  } break;
+  }
+    return ECU_SIG_BIT(ECU_SIG_SPEED);
 
     // Custom / Other
   case 0x390: // Wastegate (Custom)
     ecu_data->wg_set_percent = message->data[1] / 2.0f;
     ecu_data->wg_pos_percent = message->data[2] / 2.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_WG_SET) | ECU_SIG_BIT(ECU_SIG_WG_POS);
 
   case 0x394: // BOV (Custom)
     ecu_data->bov_percent = (message->data[0] * 50.0f) / 255.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_BOV);
 
   default:
-    break;
+    return 0;
   }
 }
 
 // 2. VW PQ25 (Polo 6R, Fabia 2)
-static void parse_vw_pq25(const twai_message_t *message, ecu_data_t *ecu_data) {
+static ecu_signal_mask_t parse_vw_pq25(const twai_message_t *message,
+                                       ecu_data_t *ecu_data) {
   switch (message->identifier) {
   case 0x280: // Same as PQ35
     ecu_data->engine_rpm =
         ((uint16_t)message->data[3] << 8 | message->data[2]) * 0.25f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_RPM);
 
   case 0x5A0: // Speed_1 (Dash Speed)
   {
     uint16_t raw_speed = get_u16_le(message->data, 1);
     ecu_data->vehicle_speed = raw_speed * 0.01f;
-  } break;
+  }
+    return ECU_SIG_BIT(ECU_SIG_SPEED);
 
   case 0x1A0: // ABS Speed (Fallback)
   {
     uint16_t raw_speed = ((uint16_t)message->data[3] << 8 | message->data[2]);
     raw_speed = (raw_speed >> 1) & 0x7FFF;
     ecu_data->vehicle_speed = raw_speed * 0.01f;
-  } break;
+  }
+    return ECU_SIG_BIT(ECU_SIG_SPEED);
 
   case 0x288:
     ecu_data->clt_temp = (message->data[1] * 0.75f) - 48.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_CLT);
 
   default:
-    break;
+    return 0;
   }
 }
 
 // 3. BMW E-Series (E90/E60)
-static void parse_bmw_e_series(const twai_message_t *message,
-                               ecu_data_t *ecu_data) {
+static ecu_signal_mask_t parse_bmw_e_series(const twai_message_t *message,
+                                            ecu_data_t *ecu_data) {
   switch (message->identifier) {
   case 0x0AA: // RPM (DME1)
   {
     uint16_t raw = get_u16_le(message->data, 4);
     ecu_data->engine_rpm = raw / 4.0f;
-  } break;
+  }
+    return ECU_SIG_BIT(ECU_SIG_RPM);
 
   case 0x1D0: // Engine Temp
     ecu_data->clt_temp = message->data[0] - 48.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_CLT);
 
   case 0x1A6: // Speed (Cluster Speed)
   {
     uint16_t raw = get_u16_le(message->data, 0);
     ecu_data->vehicle_speed = raw / 2.0f;
-  } break;
+  }
+    return ECU_SIG_BIT(ECU_SIG_SPEED);
 
   case 0x1D2: // Gear
     ecu_data->gear = message->data[0];
-    break;
+    return ECU_SIG_BIT(ECU_SIG_GEAR);
 
   default:
-    break;
+    return 0;
   }
 }
 
 // 4. BMW F-Series (F10/F30)
-static void parse_bmw_f_series(const twai_message_t *message,
-                               ecu_data_t *ecu_data) {
+static ecu_signal_mask_t parse_bmw_f_series(const twai_message_t *message,
+                                            ecu_data_t *ecu_data) {
   switch (message->identifier) {
   // Placeholder - BN2020 needs CRC validation for production
   default:
-    break;
+    return 0;
   }
 }
 
 // 5. VW MQB (Golf 7, Octavia A7)
-static void parse_vw_mqb(const twai_message_t *message, ecu_data_t *ecu_data) {
+static ecu_signal_mask_t parse_vw_mqb(const twai_message_t *message,
+                                      ecu_data_t *ecu_data) {
   switch (message->identifier) {
   case 0x280: // RPM
     ecu_data->engine_rpm =
         ((uint16_t)message->data[3] << 8 | message->data[2]) * 0.25f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_RPM);
 
   case 0x0FD: // ESP_21 : Speed
   {
     uint16_t raw_speed = get_u16_le(message->data, 1);
     ecu_data->vehicle_speed = raw_speed * 0.01f;
-  } break;
+  }
+    return ECU_SIG_BIT(ECU_SIG_SPEED);
 
   case 0x288: // Coolant
     ecu_data->clt_temp = (message->data[1] * 0.75f) - 48.0f;
-    break;
+    return ECU_SIG_BIT(ECU_SIG_CLT);
 
   default:
-    break;
+    return 0;
   }
 }
 
+// --- Nominal periods (staleness timeouts) ---
+// Signals not listed here fall back to the period learned from traffic.
+
+typedef struct {
+  ecu_signal_mask_t signals;
+  uint16_t period_ms;
+} signal_period_t;
+
+static const signal_period_t periods_vw_pq35_46[] = {
+    {ECU_SIG_BIT(ECU_SIG_RPM) | ECU_SIG_BIT(ECU_SIG_ENG_ACT) |
+         ECU_SIG_BIT(ECU_SIG_TPS) | ECU_SIG_BIT(ECU_SIG_ENG_TRG),
+     10}, // 0x280
+    {ECU_SIG_BIT(ECU_SIG_CLT) | ECU_SIG_BIT(ECU_SIG_LIMIT_TQ), 20}, // 0x288
+    {ECU_SIG_BIT(ECU_SIG_IAT) | ECU_SIG_BIT(ECU_SIG_PEDAL), 10},    // 0x380
+    {ECU_SIG_BIT(ECU_SIG_MAP) | ECU_SIG_BIT(ECU_SIG_OIL_TEMP), 20}, // 0x588
+    {ECU_SIG_BIT(ECU_SIG_BATTERY), 100},                            // 0x372
+    {ECU_SIG_BIT(ECU_SIG_GEAR), 20},                                // 0x540
+    {ECU_SIG_BIT(ECU_SIG_SPEED), 10},                               // 0x1A0
+    {ECU_SIG_BIT(ECU_SIG_WG_SET) | ECU_SIG_BIT(ECU_SIG_WG_POS), 20}, // 0x390
+    {ECU_SIG_BIT(ECU_SIG_BOV), 20},                                  // 0x394
+};
+
+static const signal_period_t periods_vw_pq25[] = {
+    {ECU_SIG_BIT(ECU_SIG_RPM), 10},   // 0x280
+    {ECU_SIG_BIT(ECU_SIG_SPEED), 50}, // 0x5A0 (0x1A0 fallback is faster)
+    {ECU_SIG_BIT(ECU_SIG_CLT), 20},   // 0x288
+};
+
+static const signal_period_t periods_vw_mqb[] = {
+    {ECU_SIG_BIT(ECU_SIG_RPM), 10},   // 0x280
+    {ECU_SIG_BIT(ECU_SIG_SPEED), 20}, // 0x0FD
+    {ECU_SIG_BIT(ECU_SIG_CLT), 20},   // 0x288
+};
+
+static const signal_period_t periods_bmw_e[] = {
+    {ECU_SIG_BIT(ECU_SIG_RPM), 10},    // 0x0AA
+    {ECU_SIG_BIT(ECU_SIG_CLT), 200},   // 0x1D0
+    {ECU_SIG_BIT(ECU_SIG_SPEED), 100}, // 0x1A6
+    {ECU_SIG_BIT(ECU_SIG_GEAR), 100},  // 0x1D2
+};
+
+#define PERIODS(table) {table, sizeof(table) / sizeof(table[0])}
+
+static const struct {
+  const signal_period_t *table;
+  size_t count;
+} platform_periods[PLATFORM_MAX] = {
+    [PLATFORM_VW_PQ35_46] = PERIODS(periods_vw_pq35_46),
+    [PLATFORM_VW_PQ25] = PERIODS(periods_vw_pq25),
+    [PLATFORM_VW_MQB] = PERIODS(periods_vw_mqb),
+    [PLATFORM_BMW_E9X] = PERIODS(periods_bmw_e),
+    [PLATFORM_BMW_E46] = PERIODS(periods_bmw_e),
+    [PLATFORM_BMW_F_SERIES] = {NULL, 0},
+};
+
+// Platform whose periods are loaded into signal_freshness (-1 = none yet).
+// Only touched from the ingest path, which owns signal_freshness writes.
+static int declared_platform = -1;
+
+static void declare_platform_periods(CanPlatform platform) {
+  signal_freshness_reset();
+  for (size_t i = 0; i < platform_periods[platform].count; i++) {
+    const signal_period_t *p = &platform_periods[platform].table[i];
+    ecu_signal_mask_t m = p->signals;
+    while (m) {
+      signal_freshness_declare((ecu_signal_id_t)__builtin_ctz(m), p->period_ms);
+      m &= m - 1;
+    }
+  }
+  declared_platform = platform;
+}
+
 // --- Main Dispatcher ---
 
 void can_parser_set_platform(CanPlatform platform) {
@@ -190,34 +277,49 @@ void can_parser_set_platform(CanPlatform platform) {
 
 CanPlatform can_parser_get_platform(void) { return g_current_platform; }
 
-void parse_can_message(const twai_message_t *message) {
+ecu_signal_mask_t parse_can_message(const twai_message_t *message) {
   if (!message)
-    return;
+    return 0;
+
+  // Platform changed (or first frame): reload the nominal periods
+  if (declared_platform != (int)g_current_platform)
+    declare_platform_periods(g_current_platform);
 
   ecu_data_t ecu_data;
   ecu_data_get_copy(&ecu_data);
 
+  ecu_signal_mask_t touched;
   switch (g_current_platform) {
   case PLATFORM_VW_PQ35_46:
-    parse_vw_pq35_46(message, &ecu_data);
+    touched = parse_vw_pq35_46(message, &ecu_data);
     break;
   case PLATFORM_VW_PQ25:
-    parse_vw_pq25(message, &ecu_data);
+    touched = parse_vw_pq25(message, &ecu_data);
     break;
   case PLATFORM_BMW_E9X:
   case PLATFORM_BMW_E46:
-    parse_bmw_e_series(message, &ecu_data);
+    touched = parse_bmw_e_series(message, &ecu_data);
     break;
   case PLATFORM_BMW_F_SERIES:
-    parse_bmw_f_series(message, &ecu_data);
+    touched = parse_bmw_f_series(message, &ecu_data);
     break;
   case PLATFORM_VW_MQB:
-    parse_vw_mqb(message, &ecu_data);
+    touched = parse_vw_mqb(message, &ecu_data);
     break;
   default:
-    parse_vw_pq35_46(message, &ecu_data);
+    touched = parse_vw_pq35_46(message, &ecu_data);
     break;
   }
 
-  ecu_data_update(&ecu_data);
+  // Frames we do not decode leave the shared snapshot untouched
+  if (touched == 0)
+    return 0;
+
+  touched |= derived_channels_evaluate(&ecu_data, touched);
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  ecu_data_update(&ecu_data, touched, now_ms);
+  signal_freshness_touch(touched, now_ms);
+  signal_history_record(&ecu_data, touched, now_ms);
+  session_stats_update(&ecu_data, touched);
+  return touched;
 }
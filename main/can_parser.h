@@ -3,6 +3,7 @@
 
 #include "can_definitions.h"
 #include "driver/twai.h"
+#include "ecu_data.h"
 
 
 #ifdef __cplusplus
@@ -20,7 +21,8 @@ void can_parser_set_platform(CanPlatform platform);
 CanPlatform can_parser_get_platform(void);
 
 // Function to parse a received CAN message and update the ECU data structure.
-void parse_can_message(const twai_message_t *message);
+// Returns the mask of signals the frame updated (0 if the ID is not decoded).
+ecu_signal_mask_t parse_can_message(const twai_message_t *message);
 
 // Function to set the configurable maximum torque value for calculations.
 void can_parser_set_max_torque(float max_torque);
@@ -0,0 +1,586 @@
+/*
+ * CAN bus simulator
+ * Scenario-driven vehicle model encoded into platform frames at their real
+ * IDs and periods, with optional filler traffic up to a target bus load.
+ */
+
+#include "can_simulator.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <math.h>
+#include <string.h>
+
+static const char *TAG = "CAN_SIM";
+
+// --- Vehicle model constants ---
+#define PHYSICS_STEP_US 5000
+#define GEAR_COUNT 6
+#define FINAL_DRIVE 3.65f
+#define WHEEL_RADIUS_M 0.32f
+#define VEHICLE_MASS_KG 1500.0f
+#define MAX_TORQUE_NM 400.0f
+#define IDLE_RPM 850.0f
+#define REDLINE_RPM 6800.0f
+#define SHIFT_TIME_S 0.15f
+
+static const float gear_ratio[GEAR_COUNT] = {3.46f, 2.05f, 1.30f,
+                                             1.03f, 0.84f, 0.69f};
+
+// --- Scenarios (scripted driver) ---
+typedef struct {
+  uint16_t duration_ms;
+  uint8_t pedal_pct;
+  uint8_t brake_pct;
+} scenario_seg_t;
+
+static const scenario_seg_t scen_idle[] = {{60000, 0, 0}};
+
+static const scenario_seg_t scen_city[] = {
+    {4000, 0, 30}, {8000, 30, 0}, {10000, 15, 0}, {5000, 0, 40},
+    {4000, 0, 20}, {6000, 45, 0}, {8000, 20, 0},  {6000, 0, 35},
+};
+
+static const scenario_seg_t scen_pull[] = {
+    {3000, 0, 30}, {15000, 100, 0}, {2000, 0, 0}, {8000, 0, 60}, {3000, 0, 30},
+};
+
+static const scenario_seg_t scen_track[] = {
+    {2000, 0, 20}, {7000, 100, 0}, {2500, 0, 80},
+    {3000, 40, 0}, {5000, 100, 0}, {2000, 0, 70},
+    {4000, 60, 0}, {3000, 0, 90},  {3000, 35, 0},
+};
+
+typedef struct {
+  const char *name;
+  const scenario_seg_t *segs;
+  uint32_t count;
+} scenario_def_t;
+
+#define SCENARIO(name, arr) {name, arr, sizeof(arr) / sizeof(arr[0])}
+
+static const scenario_def_t scenarios[CAN_SIM_SCENARIO_MAX] = {
+    [CAN_SIM_SCENARIO_IDLE] = SCENARIO("idle", scen_idle),
+    [CAN_SIM_SCENARIO_CITY] = SCENARIO("city", scen_city),
+    [CAN_SIM_SCENARIO_PULL] = SCENARIO("pull", scen_pull),
+    [CAN_SIM_SCENARIO_TRACK] = SCENARIO("track", scen_track),
+};
+
+// --- Platform frame tables (ID, period) ---
+typedef struct {
+  uint16_t id;
+  uint16_t period_ms;
+} frame_def_t;
+
+static const frame_def_t frames_pq35_46[] = {
+    {0x280, 10},  // Motor_1: RPM, torque, TPS
+    {0x1A0, 10},  // Bremse_1: wheel speed
+    {0x380, 10},  // Motor_3: IAT, pedal
+    {0x288, 20},  // Motor_2: coolant, torque limit
+    {0x540, 20},  // Getriebe_2: gear
+    {0x588, 20},  // Motor_7: MAP, oil temp
+    {0x390, 20},  // Wastegate (custom)
+    {0x394, 20},  // Blow-off (custom)
+    {0x372, 100}, // BEM_1: battery
+};
+
+static const frame_def_t frames_pq25[] = {
+    {0x280, 10},
+    {0x1A0, 10},
+    {0x288, 20},
+    {0x5A0, 50}, // Bremse_2 / dash speed
+};
+
+static const frame_def_t frames_mqb[] = {
+    {0x0FD, 20}, // ESP_21: speed
+    {0x280, 10},
+    {0x288, 20},
+};
+
+static const frame_def_t frames_bmw_e[] = {
+    {0x0AA, 10},  // DME: RPM
+    {0x1A6, 100}, // Cluster speed
+    {0x1D0, 200}, // Engine temp
+    {0x1D2, 100}, // Gear
+};
+
+// F-series frames are not decoded yet (see parse_bmw_f_series); they are
+// still generated so the sniffer and logger see representative traffic.
+static const frame_def_t frames_bmw_f[] = {
+    {0x0A5, 10},  // Engine RPM
+    {0x1A1, 20},  // Vehicle speed
+    {0x2C4, 200}, // Engine temperatures
+};
+
+typedef struct {
+  const frame_def_t *frames;
+  uint32_t count;
+} platform_def_t;
+
+#define PLATFORM_FRAMES(arr) {arr, sizeof(arr) / sizeof(arr[0])}
+
+static const platform_def_t platforms[PLATFORM_MAX] = {
+    [PLATFORM_VW_PQ35_46] = PLATFORM_FRAMES(frames_pq35_46),
+    [PLATFORM_VW_PQ25] = PLATFORM_FRAMES(frames_pq25),
+    [PLATFORM_VW_MQB] = PLATFORM_FRAMES(frames_mqb),
+    [PLATFORM_BMW_E9X] = PLATFORM_FRAMES(frames_bmw_e),
+    [PLATFORM_BMW_E46] = PLATFORM_FRAMES(frames_bmw_e),
+    [PLATFORM_BMW_F_SERIES] = PLATFORM_FRAMES(frames_bmw_f),
+};
+
+// Filler traffic uses IDs no platform parser decodes
+static const uint16_t filler_ids[] = {0x050, 0x320, 0x420, 0x44A, 0x470, 0x4A0,
+                                      0x4A8, 0x520, 0x570, 0x5C0, 0x65F, 0x7D0};
+#define FILLER_ID_COUNT (sizeof(filler_ids) / sizeof(filler_ids[0]))
+
+// --- Helpers ---
+
+static inline float clampf(float v, float lo, float hi) {
+  return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// First-order lag toward target with time constant tau
+static inline float lag(float x, float target, float tau_s, float dt_s) {
+  return x + (target - x) * (dt_s / (tau_s + dt_s));
+}
+
+static inline uint8_t u8(float v) { return (uint8_t)clampf(lrintf(v), 0, 255); }
+
+static inline uint16_t u16(float v) {
+  return (uint16_t)clampf(lrintf(v), 0, 65535);
+}
+
+static inline void put_u16_le(uint8_t *d, int offset, uint16_t v) {
+  d[offset] = (uint8_t)(v & 0xFF);
+  d[offset + 1] = (uint8_t)(v >> 8);
+}
+
+static inline uint32_t rng_next(can_sim_t *sim) {
+  // xorshift32
+  uint32_t x = sim->rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sim->rng = x;
+  return x;
+}
+
+// Uniform noise in [-amp, amp]
+static inline float noise(can_sim_t *sim, float amp) {
+  return amp * ((float)(rng_next(sim) & 0xFFFF) / 32767.5f - 1.0f);
+}
+
+uint32_t can_sim_frame_bits(uint8_t dlc) {
+  // SOF + 11-bit ID + RTR/IDE/r0 + DLC + data + CRC + ACK + EOF + IFS
+  return 47u + 8u * (dlc > 8 ? 8 : dlc);
+}
+
+const char *can_sim_scenario_name(can_sim_scenario_t scenario) {
+  return (unsigned)scenario < CAN_SIM_SCENARIO_MAX ? scenarios[scenario].name
+                                                   : "?";
+}
+
+// --- Vehicle model ---
+
+// Normalized full-load torque curve
+static float torque_curve(float rpm) {
+  if (rpm < 1000.0f)
+    return 0.55f;
+  if (rpm < 3000.0f)
+    return 0.55f + 0.45f * (rpm - 1000.0f) / 2000.0f;
+  if (rpm < 5000.0f)
+    return 1.0f;
+  return 1.0f - 0.15f * clampf((rpm - 5000.0f) / 1800.0f, 0.0f, 1.0f);
+}
+
+static void driver_step(can_sim_t *sim, uint32_t dt_ms) {
+  const scenario_def_t *sc = &scenarios[sim->cfg.scenario];
+  sim->segment_t_ms += dt_ms;
+  while (sim->segment_t_ms >= sc->segs[sim->segment].duration_ms) {
+    sim->segment_t_ms -= sc->segs[sim->segment].duration_ms;
+    sim->segment = (sim->segment + 1) % sc->count;
+  }
+  sim->veh.pedal = sc->segs[sim->segment].pedal_pct / 100.0f;
+  sim->veh.brake = sc->segs[sim->segment].brake_pct / 100.0f;
+}
+
+static void vehicle_step(can_sim_t *sim, float dt) {
+  can_sim_vehicle_t *v = &sim->veh;
+
+  v->throttle = lag(v->throttle, v->pedal, 0.08f, dt);
+
+  // Turbo spool needs both load and exhaust flow (RPM)
+  float spool_target =
+      v->throttle * clampf((v->rpm - 1800.0f) / 1700.0f, 0.0f, 1.0f);
+  v->spool =
+      lag(v->spool, spool_target, spool_target > v->spool ? 0.5f : 0.25f, dt);
+
+  // Torque
+  v->limit_tq_nm = MAX_TORQUE_NM * torque_curve(v->rpm);
+  v->eng_trg_nm = v->throttle * v->limit_tq_nm;
+  float tq = v->eng_trg_nm * (0.55f + 0.45f * v->spool);
+  if (v->shift_timer_s > 0.0f) {
+    v->shift_timer_s -= dt;
+    tq *= 0.2f; // Torque cut during the shift
+  }
+  v->eng_act_nm = lag(v->eng_act_nm, tq, 0.05f, dt);
+
+  // Longitudinal dynamics
+  float ratio = gear_ratio[v->gear - 1] * FINAL_DRIVE;
+  float f_drive = v->eng_act_nm * ratio / WHEEL_RADIUS_M * 0.9f;
+  float f_res = 0.5f * 1.2f * 0.65f * v->speed_mps * v->speed_mps +
+                v->brake * 9000.0f;
+  if (v->speed_mps > 0.1f)
+    f_res += 0.015f * VEHICLE_MASS_KG * 9.81f;
+  v->speed_mps += (f_drive - f_res) / VEHICLE_MASS_KG * dt;
+  if (v->speed_mps < 0.0f)
+    v->speed_mps = 0.0f;
+
+  // Engine speed: locked to the wheels, clutch slip near standstill
+  float rpm_wheel = v->speed_mps / WHEEL_RADIUS_M * ratio * 60.0f /
+                    (2.0f * (float)M_PI);
+  float rpm_slip = IDLE_RPM + v->throttle * 2200.0f *
+                                  (1.0f - clampf(v->speed_mps / 5.0f, 0, 1));
+  float rpm_target = clampf(fmaxf(rpm_wheel, rpm_slip), IDLE_RPM, REDLINE_RPM);
+  v->rpm = lag(v->rpm, rpm_target, 0.05f, dt);
+
+  // Gear selection
+  float upshift_rpm =
+      v->throttle > 0.8f ? 6500.0f : 2600.0f + v->throttle * 3000.0f;
+  if (v->speed_mps < 0.5f) {
+    v->gear = 1;
+  } else if (v->rpm > upshift_rpm && v->gear < GEAR_COUNT &&
+             v->shift_timer_s <= 0.0f) {
+    v->gear++;
+    v->shift_timer_s = SHIFT_TIME_S;
+  } else if (v->rpm < 1300.0f && v->gear > 1 && v->shift_timer_s <= 0.0f) {
+    v->gear--;
+    v->shift_timer_s = SHIFT_TIME_S;
+  }
+
+  // Intake side
+  float map_target = 30.0f + 70.0f * v->throttle + 150.0f * v->spool;
+  v->map_kpa = lag(v->map_kpa, map_target, 0.1f, dt);
+  v->wg_set_percent = 80.0f * v->spool * v->throttle;
+  v->wg_pos_percent = lag(v->wg_pos_percent, v->wg_set_percent, 0.15f, dt);
+  // Blow-off signal range on the bus is 0..50 %
+  float bov_target = (v->pedal < 0.1f && v->map_kpa > 130.0f) ? 50.0f : 0.0f;
+  v->bov_percent = lag(v->bov_percent, bov_target, 0.1f, dt);
+
+  // Thermals (slow)
+  float load = v->eng_act_nm / MAX_TORQUE_NM;
+  v->clt_temp = lag(v->clt_temp, 90.0f + 8.0f * load, 60.0f, dt);
+  v->oil_temp = lag(v->oil_temp, 95.0f + 25.0f * load, 90.0f, dt);
+  float iat_target = 25.0f + 0.12f * fmaxf(v->map_kpa - 100.0f, 0.0f) +
+                     (v->speed_mps < 3.0f ? 8.0f : 0.0f);
+  v->iat_temp = lag(v->iat_temp, iat_target, 5.0f, dt);
+  float oil_press_target =
+      (80.0f + v->rpm * 0.07f) * (v->oil_temp > 100.0f ? 0.9f : 1.0f);
+  v->oil_pressure = lag(v->oil_pressure, oil_press_target, 0.2f, dt);
+  v->battery_voltage = (v->rpm < 1000.0f ? 13.8f : 14.1f);
+}
+
+// --- Frame encoders (inverse of can_parser.c scaling) ---
+
+static inline float tq_pct(float nm) { return 100.0f * nm / MAX_TORQUE_NM; }
+
+static void encode_vw(can_sim_t *sim, const can_sim_slot_t *slot,
+                      twai_message_t *m) {
+  const can_sim_vehicle_t *v = &sim->veh;
+
+  switch (slot->id) {
+  case 0x280: // Motor_1 (torques are 0.39 % of max torque per bit)
+    m->data[1] = u8(tq_pct(v->eng_act_nm) / 0.39f);
+    put_u16_le(m->data, 2, u16((v->rpm + noise(sim, 5.0f)) / 0.25f));
+    m->data[5] = u8(v->throttle * 100.0f / 0.4f);
+    m->data[7] = u8(tq_pct(v->eng_trg_nm) / 0.39f);
+    break;
+
+  case 0x288: // Motor_2
+    m->data[1] = u8((v->clt_temp + 48.0f) / 0.75f);
+    m->data[6] = u8(tq_pct(v->limit_tq_nm) / 0.39f);
+    break;
+
+  case 0x380: // Motor_3
+    m->data[1] = u8((v->iat_temp + 48.0f) / 0.75f);
+    m->data[2] = u8(v->pedal * 100.0f / 0.4f);
+    break;
+
+  case 0x588: // Motor_7 (MAP byte is kPa)
+    m->data[4] = u8(v->map_kpa + noise(sim, 0.5f));
+    m->data[7] = u8(v->oil_temp + 60.0f);
+    break;
+
+  case 0x372: // BEM_1
+    m->data[5] = u8((v->battery_voltage + noise(sim, 0.05f) - 5.0f) / 0.05f);
+    break;
+
+  case 0x540: // Getriebe_2
+    m->data[7] = (uint8_t)((v->gear & 0x0F) << 4);
+    break;
+
+  case 0x1A0: // Bremse_1: speed in 0.01 km/h, shifted left by one bit
+  {
+    uint16_t raw = u16(v->speed_mps * 3.6f / 0.01f) & 0x7FFF;
+    put_u16_le(m->data, 2, (uint16_t)(raw << 1));
+  } break;
+
+  case 0x5A0: // Bremse_2 / dash speed, 0.01 km/h at byte 1
+    put_u16_le(m->data, 1, u16(v->speed_mps * 3.6f / 0.01f));
+    break;
+
+  case 0x0FD: // ESP_21 (MQB)
+    put_u16_le(m->data, 1, u16(v->speed_mps * 3.6f / 0.01f));
+    break;
+
+  case 0x390: // Wastegate (custom)
+    m->data[1] = u8(v->wg_set_percent * 2.0f);
+    m->data[2] = u8(v->wg_pos_percent * 2.0f);
+    break;
+
+  case 0x394: // Blow-off (custom)
+    m->data[0] = u8(v->bov_percent * 255.0f / 50.0f);
+    break;
+
+  default:
+    break;
+  }
+}
+
+static void encode_bmw(can_sim_t *sim, const can_sim_slot_t *slot,
+                       twai_message_t *m) {
+  const can_sim_vehicle_t *v = &sim->veh;
+
+  switch (slot->id) {
+  case 0x0AA: // DME RPM, 1/4 rpm at byte 4
+  case 0x0A5: // F-series RPM (same scaling, not decoded yet)
+    put_u16_le(m->data, 4, u16((v->rpm + noise(sim, 5.0f)) * 4.0f));
+    break;
+
+  case 0x1A6: // Cluster speed, 0.5 km/h
+  case 0x1A1:
+    put_u16_le(m->data, 0, u16(v->speed_mps * 3.6f * 2.0f));
+    break;
+
+  case 0x1D0: // Engine temp
+  case 0x2C4:
+    m->data[0] = u8(v->clt_temp + 48.0f);
+    break;
+
+  case 0x1D2: // Gear
+    m->data[0] = (uint8_t)v->gear;
+    break;
+
+  default:
+    break;
+  }
+}
+
+static void encode_frame(can_sim_t *sim, const can_sim_slot_t *slot,
+                         twai_message_t *m) {
+  memset(m, 0, sizeof(*m));
+  m->identifier = slot->id;
+  m->data_length_code = 8;
+
+  switch (sim->cfg.platform) {
+  case PLATFORM_BMW_E9X:
+  case PLATFORM_BMW_E46:
+  case PLATFORM_BMW_F_SERIES:
+    encode_bmw(sim, slot, m);
+    break;
+  default:
+    encode_vw(sim, slot, m);
+    break;
+  }
+}
+
+static void encode_filler(can_sim_t *sim, twai_message_t *m) {
+  memset(m, 0, sizeof(*m));
+  m->identifier = filler_ids[sim->filler_index % FILLER_ID_COUNT];
+  m->data_length_code = 8;
+  m->data[0] = (uint8_t)(sim->filler_index / FILLER_ID_COUNT);
+  uint32_t r = rng_next(sim);
+  memcpy(&m->data[1], &r, 4);
+  sim->filler_index++;
+}
+
+// --- Public instance API ---
+
+void can_sim_init(can_sim_t *sim, const can_sim_config_t *cfg) {
+  memset(sim, 0, sizeof(*sim));
+  sim->cfg = *cfg;
+  if ((unsigned)sim->cfg.platform >= PLATFORM_MAX)
+    sim->cfg.platform = PLATFORM_VW_PQ35_46;
+  if ((unsigned)sim->cfg.scenario >= CAN_SIM_SCENARIO_MAX)
+    sim->cfg.scenario = CAN_SIM_SCENARIO_IDLE;
+  if (sim->cfg.bitrate == 0)
+    sim->cfg.bitrate = 500000;
+  if (sim->cfg.bus_load_percent > 100)
+    sim->cfg.bus_load_percent = 100;
+  sim->rng = sim->cfg.seed ? sim->cfg.seed : 1;
+
+  // Cold-ish start at idle
+  sim->veh.gear = 1;
+  sim->veh.rpm = IDLE_RPM;
+  sim->veh.map_kpa = 35.0f;
+  sim->veh.clt_temp = 60.0f;
+  sim->veh.oil_temp = 55.0f;
+  sim->veh.iat_temp = 28.0f;
+  sim->veh.oil_pressure = 140.0f;
+  sim->veh.battery_voltage = 13.8f;
+
+  // Schedule, staggered so frames do not all fall on the same tick
+  const platform_def_t *pd = &platforms[sim->cfg.platform];
+  float native_bps = 0.0f;
+  for (uint32_t i = 0; i < pd->count && i < CAN_SIM_MAX_SLOTS; i++) {
+    can_sim_slot_t *slot = &sim->slots[sim->slot_count++];
+    slot->id = pd->frames[i].id;
+    slot->period_us = pd->frames[i].period_ms * 1000u;
+    slot->next_due_us = (i * 1370u) % slot->period_us;
+    native_bps += can_sim_frame_bits(8) * 1e6f / (float)slot->period_us;
+  }
+
+  // Filler frames make up the difference to the requested load
+  float target_bps = sim->cfg.bitrate * (sim->cfg.bus_load_percent / 100.0f);
+  if (target_bps > native_bps) {
+    float rate = (target_bps - native_bps) / (float)can_sim_frame_bits(8);
+    sim->filler_period_us = (uint32_t)fmaxf(1e6f / rate, 1.0f);
+  }
+
+  ESP_LOGI(TAG, "Simulator: platform %d, scenario %s, native load %.1f%%",
+           sim->cfg.platform, can_sim_scenario_name(sim->cfg.scenario),
+           100.0f * native_bps / sim->cfg.bitrate);
+}
+
+static void emit_frame(can_sim_t *sim, const twai_message_t *m,
+                       can_sim_emit_cb_t emit, void *ctx) {
+  sim->stats.frames++;
+  sim->stats.bits += can_sim_frame_bits(m->data_length_code);
+  if (emit)
+    emit(m, ctx);
+}
+
+uint32_t can_sim_step(can_sim_t *sim, uint32_t dt_us, can_sim_emit_cb_t emit,
+                      void *ctx) {
+  uint64_t end_us = sim->now_us + dt_us;
+  uint32_t emitted = 0;
+  twai_message_t m;
+
+  while (sim->now_us < end_us) {
+    // Jump to the next event: physics tick, frame due, or end of step
+    uint64_t next = sim->physics_us + PHYSICS_STEP_US;
+    if (end_us < next)
+      next = end_us;
+    for (int i = 0; i < sim->slot_count; i++) {
+      if (sim->slots[i].next_due_us < next)
+        next = sim->slots[i].next_due_us;
+    }
+    if (sim->filler_period_us && sim->filler_next_due_us < next)
+      next = sim->filler_next_due_us;
+    if (next > sim->now_us)
+      sim->now_us = next;
+
+    while (sim->physics_us + PHYSICS_STEP_US <= sim->now_us) {
+      driver_step(sim, PHYSICS_STEP_US / 1000);
+      vehicle_step(sim, PHYSICS_STEP_US / 1e6f);
+      sim->physics_us += PHYSICS_STEP_US;
+    }
+
+    for (int i = 0; i < sim->slot_count; i++) {
+      can_sim_slot_t *slot = &sim->slots[i];
+      if (slot->next_due_us <= sim->now_us) {
+        encode_frame(sim, slot, &m);
+        emit_frame(sim, &m, emit, ctx);
+        slot->next_due_us += slot->period_us;
+        emitted++;
+      }
+    }
+
+    if (sim->filler_period_us && sim->filler_next_due_us <= sim->now_us) {
+      encode_filler(sim, &m);
+      emit_frame(sim, &m, emit, ctx);
+      sim->stats.filler_frames++;
+      sim->filler_next_due_us += sim->filler_period_us;
+      emitted++;
+    }
+  }
+
+  sim->stats.elapsed_us += dt_us;
+  return emitted;
+}
+
+float can_sim_get_bus_load(const can_sim_t *sim) {
+  if (sim->stats.elapsed_us == 0)
+    return 0.0f;
+  return 100.0f * (float)sim->stats.bits * 1e6f /
+         ((float)sim->stats.elapsed_us * (float)sim->cfg.bitrate);
+}
+
+// --- Real-time runner ---
+
+#define SIM_TASK_PERIOD_MS 5
+
+static can_sim_t g_sim;
+static TaskHandle_t sim_task_handle = NULL;
+static volatile bool sim_running = false;
+static can_sim_emit_cb_t sim_emit = NULL;
+static void *sim_emit_ctx = NULL;
+
+static void can_sim_task(void *arg) {
+  TickType_t delay = pdMS_TO_TICKS(SIM_TASK_PERIOD_MS);
+  if (delay == 0)
+    delay = 1;
+
+  int64_t last_us = esp_timer_get_time();
+  while (sim_running) {
+    vTaskDelay(delay);
+    int64_t now_us = esp_timer_get_time();
+    can_sim_step(&g_sim, (uint32_t)(now_us - last_us), sim_emit, sim_emit_ctx);
+    last_us = now_us;
+  }
+
+  sim_task_handle = NULL;
+  vTaskDelete(NULL);
+}
+
+esp_err_t can_simulator_start(const can_sim_config_t *cfg,
+                              can_sim_emit_cb_t emit, void *ctx) {
+  if (!cfg || !emit)
+    return ESP_ERR_INVALID_ARG;
+  if (sim_running)
+    return ESP_ERR_INVALID_STATE;
+
+  // A previous runner may still be finishing its last step
+  for (int i = 0; i < 10 && sim_task_handle; i++) {
+    vTaskDelay(1);
+  }
+  if (sim_task_handle)
+    return ESP_ERR_INVALID_STATE;
+
+  can_sim_init(&g_sim, cfg);
+  sim_emit = emit;
+  sim_emit_ctx = ctx;
+  sim_running = true;
+
+  if (xTaskCreatePinnedToCore(can_sim_task, "can_sim", 4096, NULL, 5,
+                              &sim_task_handle, 0) != pdPASS) {
+    sim_running = false;
+    ESP_LOGE(TAG, "Failed to create simulator task");
+    return ESP_ERR_NO_MEM;
+  }
+
+  ESP_LOGI(TAG, "Simulator started");
+  return ESP_OK;
+}
+
+void can_simulator_stop(void) {
+  if (!sim_running)
+    return;
+  sim_running = false; // Task exits after its current step
+  ESP_LOGI(TAG, "Simulator stopped (%llu frames, %.1f%% load)",
+           (unsigned long long)g_sim.stats.frames,
+           can_sim_get_bus_load(&g_sim));
+}
+
+bool can_simulator_is_running(void) { return sim_running; }
@@ -0,0 +1,127 @@
+#ifndef CAN_SIMULATOR_H
+#define CAN_SIMULATOR_H
+
+#include "can_definitions.h"
+#include "driver/twai.h"
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame-level vehicle/bus simulator.
+// A simple longitudinal vehicle model is driven by a scripted driver
+// (scenario); its state is encoded into the real frames of the selected
+// CanPlatform at their bus periods, optionally topped up with filler traffic
+// to a target bus load. Frames are handed to a sink callback, normally
+// can_manager_ingest(), so they travel the same path as TWAI frames.
+
+typedef enum {
+  CAN_SIM_SCENARIO_IDLE = 0, // Engine idling, car stationary
+  CAN_SIM_SCENARIO_CITY,     // Gentle stop-and-go driving
+  CAN_SIM_SCENARIO_PULL,     // Full-throttle pulls through the gears
+  CAN_SIM_SCENARIO_TRACK,    // Mixed WOT / braking laps
+  CAN_SIM_SCENARIO_MAX
+} can_sim_scenario_t;
+
+typedef struct {
+  CanPlatform platform;
+  can_sim_scenario_t scenario;
+  uint8_t bus_load_percent; // Target total load incl. filler (0 = native only)
+  uint32_t bitrate;         // Bus bitrate used for load accounting (bit/s)
+  uint32_t seed;            // Noise / filler payload seed
+} can_sim_config_t;
+
+#define CAN_SIM_CONFIG_DEFAULT()                                               \
+  {                                                                            \
+      .platform = PLATFORM_VW_PQ35_46,                                         \
+      .scenario = CAN_SIM_SCENARIO_TRACK,                                      \
+      .bus_load_percent = 0,                                                   \
+      .bitrate = 500000,                                                       \
+      .seed = 1,                                                               \
+  }
+
+// Frame sink
+typedef void (*can_sim_emit_cb_t)(const twai_message_t *message, void *ctx);
+
+// Vehicle state (physical units, same as ecu_data_t)
+typedef struct {
+  float pedal;    // Driver demand 0..1
+  float throttle; // Throttle plate 0..1 (lags pedal)
+  float brake;    // 0..1
+  float speed_mps;
+  float rpm;
+  int8_t gear; // 1..6
+  float spool; // Turbo spool 0..1
+  float map_kpa;
+  float clt_temp;
+  float iat_temp;
+  float oil_temp;
+  float oil_pressure;
+  float battery_voltage;
+  float wg_set_percent;
+  float wg_pos_percent;
+  float bov_percent;
+  float eng_trg_nm;
+  float eng_act_nm;
+  float limit_tq_nm;
+  float shift_timer_s; // Torque cut remaining during a gear change
+} can_sim_vehicle_t;
+
+// Per-message schedule entry
+typedef struct {
+  uint32_t id;
+  uint32_t period_us;
+  uint64_t next_due_us;
+} can_sim_slot_t;
+
+#define CAN_SIM_MAX_SLOTS 16
+
+typedef struct {
+  uint64_t frames;        // Total frames emitted
+  uint64_t filler_frames; // Of which filler
+  uint64_t bits;          // Nominal bits on the wire
+  uint64_t elapsed_us;    // Virtual time simulated
+} can_sim_stats_t;
+
+typedef struct {
+  can_sim_config_t cfg;
+  can_sim_vehicle_t veh;
+  can_sim_slot_t slots[CAN_SIM_MAX_SLOTS];
+  int slot_count;
+  uint64_t now_us;
+  uint64_t physics_us;       // Time already integrated by the vehicle model
+  uint32_t segment;          // Current scenario segment
+  uint32_t segment_t_ms;     // Time spent in the segment
+  uint32_t filler_period_us; // 0 = no filler needed for the target load
+  uint64_t filler_next_due_us;
+  uint32_t filler_index;
+  uint32_t rng;
+  can_sim_stats_t stats;
+} can_sim_t;
+
+// Instance API (usable on the device and on a host)
+void can_sim_init(can_sim_t *sim, const can_sim_config_t *cfg);
+// Advance virtual time by dt_us and emit every frame that falls due.
+// Returns the number of frames emitted.
+uint32_t can_sim_step(can_sim_t *sim, uint32_t dt_us, can_sim_emit_cb_t emit,
+                      void *ctx);
+// Measured bus load so far (0..100 %)
+float can_sim_get_bus_load(const can_sim_t *sim);
+// Nominal frame length in bits (standard ID, no stuffing)
+uint32_t can_sim_frame_bits(uint8_t dlc);
+const char *can_sim_scenario_name(can_sim_scenario_t scenario);
+
+// Background runner on the device (real time)
+esp_err_t can_simulator_start(const can_sim_config_t *cfg,
+                              can_sim_emit_cb_t emit, void *ctx);
+void can_simulator_stop(void);
+bool can_simulator_is_running(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CAN_SIMULATOR_H
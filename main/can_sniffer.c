@@ -0,0 +1,237 @@
+#include "can_sniffer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Each entry is guarded by a sequence counter: odd while the producer is
+// writing it. Readers copy and retry if the counter moved, bounded because
+// the UI task may preempt the producer on the same core.
+#define READ_RETRIES 4
+
+typedef struct {
+  can_sniffer_entry_t e;
+  uint32_t seq;
+  uint32_t change_gen; // Reset generation e.toggled belongs to
+} sniffer_slot_t;
+
+// Extended ID hash: open addressing, twice the capacity so probes stay short
+#define EXT_HASH_BITS 9
+#define EXT_HASH_SIZE (1u << EXT_HASH_BITS)
+_Static_assert(EXT_HASH_SIZE >= 2 * CAN_SNIFFER_MAX_EXT, "hash too small");
+
+// Entry pool in arrival order, plus the ID -> index maps (index + 1, 0 = none)
+static sniffer_slot_t *slots = NULL;
+static uint16_t std_index[CAN_SNIFFER_MAX_STD];
+static uint32_t ext_keys[EXT_HASH_SIZE];
+static uint16_t ext_index[EXT_HASH_SIZE];
+static int ext_count = 0;
+static int entry_count = 0;      // Published with release after slot init
+static uint32_t total_frames = 0;
+static uint32_t dirty[CAN_SNIFFER_DIRTY_WORDS];
+static uint32_t change_gen = 0; // Bumped by can_sniffer_reset_changes()
+
+esp_err_t can_sniffer_init(void) {
+  if (slots)
+    return ESP_OK;
+  slots = calloc(CAN_SNIFFER_MAX_IDS, sizeof(*slots));
+  if (!slots)
+    return ESP_ERR_NO_MEM;
+  can_sniffer_clear();
+  return ESP_OK;
+}
+
+void can_sniffer_clear(void) {
+  if (slots)
+    memset(slots, 0, CAN_SNIFFER_MAX_IDS * sizeof(*slots));
+  memset(std_index, 0, sizeof(std_index));
+  memset(ext_index, 0, sizeof(ext_index));
+  ext_count = 0;
+  __atomic_store_n(&entry_count, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&total_frames, 0, __ATOMIC_RELAXED);
+  for (int i = 0; i < CAN_SNIFFER_DIRTY_WORDS; i++)
+    __atomic_store_n(&dirty[i], 0, __ATOMIC_RELAXED);
+}
+
+void can_sniffer_reset_changes(void) {
+  __atomic_fetch_add(&change_gen, 1, __ATOMIC_RELEASE);
+}
+
+// Payload as one little-endian word, bytes past dlc zero (data[] is kept
+// zero-padded, so the stored payload loads the same way)
+static uint64_t load_payload(const uint8_t *data, uint8_t dlc) {
+  uint64_t word = 0;
+  memcpy(&word, data, dlc);
+  return word;
+}
+
+uint8_t can_sniffer_byte_mask(uint64_t bits) {
+  // High bit of each byte := byte != 0, then gather the eight high bits
+  const uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+  uint64_t nonzero = (((bits & low7) + low7) | bits) & ~low7;
+  return (uint8_t)(((nonzero >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+static uint32_t ext_hash(uint32_t id) {
+  return (id * 2654435761u) >> (32 - EXT_HASH_BITS);
+}
+
+// Slot of an ID in its map; for extended IDs, the first free slot if absent
+static uint16_t *map_slot(uint32_t id) {
+  if (!(id & CAN_SNIFFER_ID_EXT))
+    return (id < CAN_SNIFFER_MAX_STD) ? &std_index[id] : NULL;
+
+  for (uint32_t h = ext_hash(id);; h = (h + 1) & (EXT_HASH_SIZE - 1)) {
+    if (ext_index[h] == 0 || ext_keys[h] == id)
+      return &ext_index[h];
+  }
+}
+
+int can_sniffer_find(uint32_t id) {
+  uint16_t *slot = map_slot(id);
+  return slot ? (int)*slot - 1 : -1;
+}
+
+void can_sniffer_mark_dirty(int index) {
+  if (index < 0 || index >= CAN_SNIFFER_MAX_IDS)
+    return;
+  __atomic_fetch_or(&dirty[index / 32], 1u << (index % 32), __ATOMIC_RELEASE);
+}
+
+int can_sniffer_update(uint32_t id, const uint8_t *data, uint8_t dlc,
+                       uint32_t now_ms) {
+  if (dlc > 8)
+    dlc = 8;
+
+  if (!slots)
+    return -1;
+
+  uint16_t *map = map_slot(id);
+  if (!map)
+    return -1; // Standard flag with an ID above 0x7FF
+
+  int idx = (int)*map - 1;
+  bool is_new = idx < 0;
+  if (is_new) {
+    bool ext = (id & CAN_SNIFFER_ID_EXT) != 0;
+    if (ext && ext_count >= CAN_SNIFFER_MAX_EXT)
+      return -1; // Extended table full
+    if (ext) {
+      ext_keys[map - ext_index] = id;
+      ext_count++;
+    }
+    idx = entry_count;
+    slots[idx].e.id = id;
+    *map = (uint16_t)(idx + 1);
+    __atomic_store_n(&entry_count, idx + 1, __ATOMIC_RELEASE);
+  }
+
+  sniffer_slot_t *slot = &slots[idx];
+  can_sniffer_entry_t *e = &slot->e;
+
+  uint64_t old_word = load_payload(e->data, 8);
+  uint64_t new_word = load_payload(data, dlc);
+  uint64_t diff = old_word ^ new_word;
+  uint8_t changed = can_sniffer_byte_mask(diff);
+  if (is_new) {
+    changed = 0xFF;
+    diff = 0; // The first frame sets the reference, nothing toggled yet
+  } else if (e->dlc != dlc) {
+    changed = 0xFF; // Length change: every byte counts as changed
+  }
+
+  uint32_t gen = __atomic_load_n(&change_gen, __ATOMIC_ACQUIRE);
+  uint32_t seq = slot->seq;
+  __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  if (!is_new)
+    e->period_ms = now_ms - e->last_ms;
+  e->dlc = dlc;
+  memcpy(e->data, &new_word, sizeof(e->data));
+  e->change_mask = changed;
+  if (slot->change_gen != gen) {
+    slot->change_gen = gen;
+    e->toggled = 0;
+  }
+  e->toggled |= diff;
+  if (changed) {
+    e->changed_ms = now_ms;
+    for (uint32_t m = changed; m; m &= m - 1)
+      e->byte_changed_ms[__builtin_ctz(m)] = now_ms;
+  }
+  e->count++;
+  e->last_ms = now_ms;
+
+  __atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+
+  if (changed)
+    can_sniffer_mark_dirty(idx);
+  __atomic_store_n(&total_frames, total_frames + 1, __ATOMIC_RELAXED);
+  return idx;
+}
+
+int can_sniffer_get_count(void) {
+  return __atomic_load_n(&entry_count, __ATOMIC_ACQUIRE);
+}
+
+uint32_t can_sniffer_get_total(void) {
+  return __atomic_load_n(&total_frames, __ATOMIC_RELAXED);
+}
+
+bool can_sniffer_read(int index, can_sniffer_entry_t *out) {
+  if (!out || !slots || index < 0 || index >= can_sniffer_get_count())
+    return false;
+
+  const sniffer_slot_t *slot = &slots[index];
+  for (int attempt = 0; attempt < READ_RETRIES; attempt++) {
+    uint32_t before = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    if (before & 1u)
+      continue;
+    memcpy(out, &slot->e, sizeof(*out));
+    uint32_t gen = slot->change_gen;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == before) {
+      if (gen != __atomic_load_n(&change_gen, __ATOMIC_ACQUIRE))
+        out->toggled = 0; // Reset since the entry was last written
+      return true;
+    }
+  }
+  return false;
+}
+
+void can_sniffer_take_dirty(uint32_t out[CAN_SNIFFER_DIRTY_WORDS]) {
+  for (int i = 0; i < CAN_SNIFFER_DIRTY_WORDS; i++)
+    out[i] = __atomic_exchange_n(&dirty[i], 0, __ATOMIC_ACQUIRE);
+}
+
+void can_sniffer_format_id(uint32_t id, char *buf, size_t size) {
+  if (id & CAN_SNIFFER_ID_EXT)
+    snprintf(buf, size, "%08lX", (unsigned long)(id & CAN_SNIFFER_ID_MASK));
+  else
+    snprintf(buf, size, "%03lX", (unsigned long)id);
+}
+
+void can_sniffer_format_hex(const uint8_t *data, uint8_t dlc, char *buf,
+                            size_t size) {
+  static const char hex[] = "0123456789ABCDEF";
+  size_t pos = 0;
+  if (size == 0)
+    return;
+  for (int i = 0; i < dlc && i < 8 && pos + 3 < size; i++) {
+    buf[pos++] = hex[data[i] >> 4];
+    buf[pos++] = hex[data[i] & 0x0F];
+    buf[pos++] = ' ';
+  }
+  buf[pos] = '\0';
+}
+
+void can_sniffer_format_ascii(const uint8_t *data, uint8_t dlc, char *buf,
+                              size_t size) {
+  size_t pos = 0;
+  if (size == 0)
+    return;
+  for (int i = 0; i < dlc && i < 8 && pos + 1 < size; i++) {
+    buf[pos++] = (data[i] >= 32 && data[i] <= 126) ? (char)data[i] : '.';
+  }
+  buf[pos] = '\0';
+}
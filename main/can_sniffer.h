@@ -0,0 +1,98 @@
+#ifndef CAN_SNIFFER_H
+#define CAN_SNIFFER_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sniffer data model: one entry per CAN ID with its latest payload.
+// Hardware/LVGL independent; Screen3 renders it.
+//
+// Single producer, single consumer, no lock: the ingest path records frames
+// with can_sniffer_update(); a UI timer collects the entries whose payload
+// changed with can_sniffer_take_dirty() and copies them out with
+// can_sniffer_read(). Entries are never removed, so indexes are stable.
+//
+// Change tracking for reverse-engineering: per entry, the bytes that
+// changed in the latest frame, when each byte last changed, and every bit
+// that toggled since the last can_sniffer_reset_changes(). All of it comes
+// from one 64-bit XOR of the old and new payload per frame.
+//
+// Every 11-bit ID has room (looked up through a direct table); extended IDs
+// go through a small hash. Pass extended IDs with CAN_SNIFFER_ID_EXT set.
+
+#define CAN_SNIFFER_MAX_STD 2048
+#define CAN_SNIFFER_MAX_EXT 256
+#define CAN_SNIFFER_MAX_IDS (CAN_SNIFFER_MAX_STD + CAN_SNIFFER_MAX_EXT)
+#define CAN_SNIFFER_DIRTY_WORDS ((CAN_SNIFFER_MAX_IDS + 31) / 32)
+
+#define CAN_SNIFFER_ID_EXT 0x80000000u
+#define CAN_SNIFFER_ID_MASK 0x1FFFFFFFu
+
+typedef struct {
+  uint32_t id;
+  uint8_t dlc;
+  uint8_t data[8];     // Bytes past dlc are zero
+  uint8_t change_mask; // Bytes that differed from the previous frame
+  uint32_t count;      // Frames seen since the last clear
+  uint32_t last_ms;    // Timestamp of the latest frame
+  uint32_t period_ms;  // Interval between the last two frames
+  uint32_t changed_ms; // Timestamp of the latest payload change
+  uint32_t byte_changed_ms[8]; // Per byte, timestamp of its latest change
+  uint64_t toggled; // Bits changed since the last reset, bit 8*i+b = data[i].b
+} can_sniffer_entry_t;
+
+// Allocate the entry pool (~150 KB, lands in PSRAM through malloc). Call
+// before the first update; until then the model reads as empty.
+esp_err_t can_sniffer_init(void);
+
+// Forget all IDs. Not safe against a concurrent can_sniffer_update().
+void can_sniffer_clear(void);
+
+// Start a new toggled-bits window for every entry. Safe from the consumer:
+// entries pick it up lazily, and reads report them as reset meanwhile.
+void can_sniffer_reset_changes(void);
+
+// Record a frame (producer). Marks the entry dirty if it is new or its
+// payload changed. Returns the entry index, or -1 if the table is full.
+int can_sniffer_update(uint32_t id, const uint8_t *data, uint8_t dlc,
+                       uint32_t now_ms);
+
+// Index of an ID, or -1 if not seen (producer side)
+int can_sniffer_find(uint32_t id);
+
+int can_sniffer_get_count(void);
+uint32_t can_sniffer_get_total(void);
+
+// Consistent copy of an entry (consumer). Returns false for an unknown index
+// or if the producer kept rewriting it; retry on the next refresh.
+bool can_sniffer_read(int index, can_sniffer_entry_t *out);
+
+// Move the dirty set into out (bit n = entry n) and reset it (consumer)
+void can_sniffer_take_dirty(uint32_t out[CAN_SNIFFER_DIRTY_WORDS]);
+
+// Put entries back into the dirty set, e.g. after a failed read
+void can_sniffer_mark_dirty(int index);
+
+// Bytes whose bits are set in a 64-bit payload word (bit i = byte i)
+uint8_t can_sniffer_byte_mask(uint64_t bits);
+
+// ID cell: "1A0" for 11-bit IDs, "18DAF110" for extended ones
+void can_sniffer_format_id(uint32_t id, char *buf, size_t size);
+
+// Cell formatters used by the table ("AA BB " / "ab..")
+void can_sniffer_format_hex(const uint8_t *data, uint8_t dlc, char *buf,
+                            size_t size);
+void can_sniffer_format_ascii(const uint8_t *data, uint8_t dlc, char *buf,
+                              size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CAN_SNIFFER_H
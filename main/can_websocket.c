@@ -5,7 +5,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
-#include "settings_config.h"
+#include "ecu_data.h"
 #include <string.h>
 
 static const char *TAG = "CAN_WS";
@@ -15,23 +15,6 @@ static can_websocket_data_t g_can_data = {0};
 static game_controller_state_t g_joystick_state = {0};
 static SemaphoreHandle_t data_mutex = NULL;
 static httpd_handle_t ws_server = NULL;
-static int g_demo_counter = 0;
-
-void generate_demo_can_data(demo_can_data_t *demo_data) {
-  if (!demo_data)
-    return;
-  g_demo_counter++;
-  int cycle = g_demo_counter % 100;
-  float phase = cycle / 100.0f;
-
-  demo_data->map_pressure =
-      120.0f + 30.0f * (cycle > 50 ? (100 - cycle) : cycle) / 50.0f;
-  demo_data->wastegate_pos = 45.0f + 25.0f * phase;
-  demo_data->tps_position = 35.0f + 30.0f * phase;
-  demo_data->engine_rpm = 2500.0f + 500.0f * phase;
-  demo_data->target_boost = 180.0f + 20.0f * phase;
-  demo_data->tcu_status = (g_demo_counter % 100 > 95) ? 1 : 0;
-}
 
 static esp_err_t ws_handler(httpd_req_t *req) {
   if (req->method == HTTP_GET) {
@@ -99,18 +82,19 @@ static const httpd_uri_t ws_uri = {.uri = "/ws",
                                    .is_websocket = true};
 
 static esp_err_t data_handler(httpd_req_t *req) {
-  bool demo_enabled = demo_mode_get_enabled();
   char json_data[256];
 
-  if (demo_enabled && !g_can_data.data_valid) {
-    demo_can_data_t demo;
-    generate_demo_can_data(&demo);
+  if (!g_can_data.data_valid) {
+    // No pushed broadcast data: serve the live ECU snapshot (real bus or the
+    // CAN simulator in demo mode). Target boost and TCU status have no source.
+    ecu_data_t ecu;
+    ecu_data_get_copy(&ecu);
     snprintf(
         json_data, sizeof(json_data),
         "{\"map_pressure\":%.1f,\"wastegate_pos\":%.1f,\"tps_position\":%.1f,"
-        "\"engine_rpm\":%.0f,\"target_boost\":%.1f,\"tcu_status\":%d}",
-        demo.map_pressure, demo.wastegate_pos, demo.tps_position,
-        demo.engine_rpm, demo.target_boost, demo.tcu_status);
+        "\"engine_rpm\":%.0f,\"target_boost\":%d,\"tcu_status\":%d}",
+        ecu.map_kpa, ecu.wg_pos_percent, ecu.tps_position, ecu.engine_rpm, 0,
+        0);
   } else {
     snprintf(json_data, sizeof(json_data),
              "{\"map_pressure\":%d,\"wastegate_pos\":%d,\"tps_position\":%d,"
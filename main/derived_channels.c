@@ -0,0 +1,426 @@
+// Derived channel compiler and evaluator
+//
+// Definitions are parsed by recursive descent straight into postfix code.
+// Evaluation runs on the ingest task only; channel tables are written while
+// compiling, before ingest starts, so the per-frame path takes no lock.
+
+#include "derived_channels.h"
+#include "esp_log.h"
+#include "sd_card_manager.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "DERIVED";
+
+typedef enum {
+  OP_CONST,
+  OP_SIG,
+  OP_ADD,
+  OP_SUB,
+  OP_MUL,
+  OP_DIV,
+  OP_NEG,
+  OP_MIN,
+  OP_MAX,
+  OP_ABS,
+} derived_op_t;
+
+typedef struct {
+  uint8_t op;
+  uint8_t sig; // OP_SIG
+  float k;     // OP_CONST
+} derived_instr_t;
+
+typedef struct {
+  derived_instr_t code[DERIVED_MAX_PROGRAM];
+  uint8_t len;
+  ecu_signal_mask_t inputs;
+  char expr[DERIVED_MAX_EXPR];
+} derived_channel_t;
+
+// Channel n lives in signal slot ECU_SIG_DERIVED_0 + n
+static derived_channel_t channels[ECU_DERIVED_MAX];
+static int channel_count = 0;
+
+static const struct {
+  const char *name;
+  const char *unit;
+  const char *expr;
+} default_channels[] = {
+    {"boost", "kPa", "map - 101.3"},
+    {"power", "kW", "eng_act * rpm / 9549"},
+    {"wg_error", "%", "wg_set - wg_pos"},
+    // Overall ratio as road speed per 1000 rpm; identifies the gear
+    {"kmh_krpm", "", "speed * 1000 / rpm"},
+};
+
+// ============================================================================
+// COMPILER
+// ============================================================================
+
+typedef struct {
+  const char *p;
+  derived_channel_t *ch;
+  ecu_signal_id_t self; // Slot being compiled; it and later ones are invalid
+  int depth;            // Stack depth after the code emitted so far
+  const char *error;
+} compiler_t;
+
+static void skip_space(compiler_t *c) {
+  while (isspace((unsigned char)*c->p))
+    c->p++;
+}
+
+static bool emit(compiler_t *c, derived_op_t op, int stack_delta) {
+  if (c->error)
+    return false;
+  if (c->ch->len >= DERIVED_MAX_PROGRAM) {
+    c->error = "expression too long";
+    return false;
+  }
+  c->depth += stack_delta;
+  if (c->depth > DERIVED_MAX_STACK) {
+    c->error = "expression nested too deeply";
+    return false;
+  }
+  derived_instr_t *in = &c->ch->code[c->ch->len++];
+  in->op = (uint8_t)op;
+  in->sig = 0;
+  in->k = 0.0f;
+  return true;
+}
+
+static bool expect(compiler_t *c, char ch) {
+  skip_space(c);
+  if (*c->p != ch) {
+    if (!c->error)
+      c->error = (ch == ')') ? "expected ')'" : "expected ','";
+    return false;
+  }
+  c->p++;
+  return true;
+}
+
+static void parse_expr(compiler_t *c);
+
+static void parse_call(compiler_t *c, derived_op_t op, int args) {
+  if (!expect(c, '('))
+    return;
+  for (int i = 0; i < args; i++) {
+    if (i > 0 && !expect(c, ','))
+      return;
+    parse_expr(c);
+  }
+  if (expect(c, ')'))
+    emit(c, op, 1 - args);
+}
+
+static void parse_primary(compiler_t *c) {
+  skip_space(c);
+  const char *start = c->p;
+
+  if (*c->p == '(') {
+    c->p++;
+    parse_expr(c);
+    expect(c, ')');
+    return;
+  }
+
+  if (isdigit((unsigned char)*c->p) || *c->p == '.') {
+    char *end;
+    float k = strtof(c->p, &end);
+    if (end == c->p) {
+      c->error = "bad number";
+      return;
+    }
+    c->p = end;
+    if (emit(c, OP_CONST, 1))
+      c->ch->code[c->ch->len - 1].k = k;
+    return;
+  }
+
+  if (isalpha((unsigned char)*c->p) || *c->p == '_') {
+    char ident[16];
+    size_t n = 0;
+    while (isalnum((unsigned char)*c->p) || *c->p == '_') {
+      if (n < sizeof(ident) - 1)
+        ident[n++] = *c->p;
+      c->p++;
+    }
+    ident[n] = '\0';
+
+    skip_space(c);
+    if (*c->p == '(') {
+      if (strcmp(ident, "min") == 0)
+        parse_call(c, OP_MIN, 2);
+      else if (strcmp(ident, "max") == 0)
+        parse_call(c, OP_MAX, 2);
+      else if (strcmp(ident, "abs") == 0)
+        parse_call(c, OP_ABS, 1);
+      else
+        c->error = "unknown function";
+      return;
+    }
+
+    ecu_signal_id_t sig = ecu_signal_find(ident);
+    if (sig >= ECU_SIG_COUNT || sig >= c->self) {
+      c->p = start;
+      c->error = "unknown signal";
+      return;
+    }
+    if (emit(c, OP_SIG, 1)) {
+      c->ch->code[c->ch->len - 1].sig = (uint8_t)sig;
+      c->ch->inputs |= ECU_SIG_BIT(sig);
+    }
+    return;
+  }
+
+  c->p = start;
+  c->error = *c->p ? "unexpected character" : "unexpected end";
+}
+
+static void parse_unary(compiler_t *c) {
+  skip_space(c);
+  if (*c->p == '-') {
+    c->p++;
+    parse_unary(c);
+    emit(c, OP_NEG, 0);
+    return;
+  }
+  if (*c->p == '+') {
+    c->p++;
+    parse_unary(c);
+    return;
+  }
+  parse_primary(c);
+}
+
+static void parse_term(compiler_t *c) {
+  parse_unary(c);
+  for (;;) {
+    skip_space(c);
+    char op = *c->p;
+    if (c->error || (op != '*' && op != '/'))
+      return;
+    c->p++;
+    parse_unary(c);
+    emit(c, op == '*' ? OP_MUL : OP_DIV, -1);
+  }
+}
+
+static void parse_expr(compiler_t *c) {
+  parse_term(c);
+  for (;;) {
+    skip_space(c);
+    char op = *c->p;
+    if (c->error || (op != '+' && op != '-'))
+      return;
+    c->p++;
+    parse_term(c);
+    emit(c, op == '+' ? OP_ADD : OP_SUB, -1);
+  }
+}
+
+static bool valid_name(const char *name) {
+  if (!name || !(isalpha((unsigned char)name[0]) || name[0] == '_'))
+    return false;
+  size_t n = 0;
+  for (; name[n]; n++) {
+    if (!isalnum((unsigned char)name[n]) && name[n] != '_')
+      return false;
+  }
+  return n < 16;
+}
+
+esp_err_t derived_channels_add(const char *name, const char *unit,
+                               const char *expr) {
+  if (!valid_name(name) || !expr) {
+    ESP_LOGE(TAG, "Invalid channel name '%s'", name ? name : "");
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (ecu_signal_find(name) != ECU_SIG_COUNT) {
+    ESP_LOGE(TAG, "%s: name already in use", name);
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (channel_count >= ECU_DERIVED_MAX) {
+    ESP_LOGE(TAG, "%s: all %d derived slots in use", name, ECU_DERIVED_MAX);
+    return ESP_ERR_NO_MEM;
+  }
+
+  while (isspace((unsigned char)*expr))
+    expr++;
+
+  derived_channel_t *ch = &channels[channel_count];
+  memset(ch, 0, sizeof(*ch));
+  compiler_t c = {
+      .p = expr,
+      .ch = ch,
+      .self = (ecu_signal_id_t)(ECU_SIG_DERIVED_0 + channel_count),
+  };
+
+  parse_expr(&c);
+  skip_space(&c);
+  if (!c.error && *c.p)
+    c.error = "trailing characters";
+  if (!c.error && c.depth != 1)
+    c.error = "empty expression";
+  if (c.error) {
+    ESP_LOGE(TAG, "%s: %s at column %d", name, c.error, (int)(c.p - expr) + 1);
+    memset(ch, 0, sizeof(*ch));
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  snprintf(ch->expr, sizeof(ch->expr), "%s", expr);
+  ecu_signal_set_derived_label(channel_count, name, unit);
+  channel_count++;
+  ESP_LOGI(TAG, "%s = %s (%d ops)", name, ch->expr, ch->len);
+  return ESP_OK;
+}
+
+void derived_channels_clear(void) {
+  for (int i = 0; i < ECU_DERIVED_MAX; i++)
+    ecu_signal_set_derived_label(i, NULL, NULL);
+  memset(channels, 0, sizeof(channels));
+  channel_count = 0;
+}
+
+void derived_channels_load_defaults(void) {
+  derived_channels_clear();
+  for (size_t i = 0; i < sizeof(default_channels) / sizeof(default_channels[0]);
+       i++) {
+    derived_channels_add(default_channels[i].name, default_channels[i].unit,
+                         default_channels[i].expr);
+  }
+}
+
+esp_err_t derived_channels_load(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return ESP_ERR_NOT_FOUND;
+
+  derived_channels_clear();
+
+  char line[160];
+  int line_no = 0;
+  int errors = 0;
+  while (fgets(line, sizeof(line), f)) {
+    line_no++;
+    line[strcspn(line, "\r\n#")] = '\0';
+
+    char *eq = strchr(line, '=');
+    if (!eq) {
+      if (strspn(line, " \t") != strlen(line)) {
+        ESP_LOGE(TAG, "%s:%d: expected 'name [unit] = expression'", path,
+                 line_no);
+        errors++;
+      }
+      continue;
+    }
+    *eq = '\0';
+
+    char name[16] = "", unit[8] = "";
+    if (sscanf(line, "%15s %7s", name, unit) < 1) {
+      ESP_LOGE(TAG, "%s:%d: missing channel name", path, line_no);
+      errors++;
+      continue;
+    }
+    if (derived_channels_add(name, unit, eq + 1) != ESP_OK)
+      errors++;
+  }
+  fclose(f);
+
+  ESP_LOGI(TAG, "Loaded %d derived channels from %s (%d errors)",
+           channel_count, path, errors);
+  return errors ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t derived_channels_init(void) {
+  if (derived_channels_load(DERIVED_CONFIG_PATH) == ESP_ERR_NOT_FOUND) {
+    derived_channels_load_defaults();
+    ESP_LOGI(TAG, "Using %d built-in derived channels", channel_count);
+  }
+  return ESP_OK;
+}
+
+int derived_channels_count(void) { return channel_count; }
+
+const char *derived_channels_expr(ecu_signal_id_t sig) {
+  int n = (int)sig - ECU_SIG_DERIVED_0;
+  if (n < 0 || n >= channel_count)
+    return "";
+  return channels[n].expr;
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+static float run(const derived_channel_t *ch, const ecu_data_t *data) {
+  float stack[DERIVED_MAX_STACK];
+  int sp = 0;
+
+  for (int i = 0; i < ch->len; i++) {
+    const derived_instr_t *in = &ch->code[i];
+    switch (in->op) {
+    case OP_CONST:
+      stack[sp++] = in->k;
+      break;
+    case OP_SIG:
+      stack[sp++] = ecu_data_get_signal(data, (ecu_signal_id_t)in->sig);
+      break;
+    case OP_ADD:
+      sp--;
+      stack[sp - 1] += stack[sp];
+      break;
+    case OP_SUB:
+      sp--;
+      stack[sp - 1] -= stack[sp];
+      break;
+    case OP_MUL:
+      sp--;
+      stack[sp - 1] *= stack[sp];
+      break;
+    case OP_DIV:
+      sp--;
+      stack[sp - 1] = (stack[sp] != 0.0f) ? stack[sp - 1] / stack[sp] : 0.0f;
+      break;
+    case OP_NEG:
+      stack[sp - 1] = -stack[sp - 1];
+      break;
+    case OP_MIN:
+      sp--;
+      stack[sp - 1] = fminf(stack[sp - 1], stack[sp]);
+      break;
+    case OP_MAX:
+      sp--;
+      stack[sp - 1] = fmaxf(stack[sp - 1], stack[sp]);
+      break;
+    case OP_ABS:
+      stack[sp - 1] = fabsf(stack[sp - 1]);
+      break;
+    }
+  }
+  return stack[0];
+}
+
+ecu_signal_mask_t derived_channels_evaluate(ecu_data_t *data,
+                                            ecu_signal_mask_t touched) {
+  ecu_signal_mask_t updated = 0;
+
+  // Definition order is topological: a channel's output bit joins `touched`
+  // before any later channel that reads it is considered.
+  for (int i = 0; i < channel_count; i++) {
+    const derived_channel_t *ch = &channels[i];
+    if (!(ch->inputs & touched))
+      continue;
+
+    data->derived[i] = run(ch, data);
+    ecu_signal_mask_t bit = ECU_SIG_BIT(ECU_SIG_DERIVED_0 + i);
+    touched |= bit;
+    updated |= bit;
+  }
+  return updated;
+}
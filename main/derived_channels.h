@@ -0,0 +1,66 @@
+#ifndef DERIVED_CHANNELS_H
+#define DERIVED_CHANNELS_H
+
+#include "ecu_data.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Derived channels: values computed from decoded signals (boost from MAP,
+// power from torque and RPM, ...). Each definition is compiled once into a
+// small stack program over signal inputs and assigned an ECU_SIG_DERIVED_n
+// slot, so gauges, statistics, freshness and logs treat the result like any
+// decoded signal.
+//
+// Expressions: numbers, signal keys (ecu_signal_key(), e.g. "map", "rpm", or
+// an earlier channel's name), + - * /, unary minus, parentheses, and
+// min(a,b), max(a,b), abs(x). Division by zero yields 0.
+//
+// A channel may only reference signals defined before it, so definition order
+// is a valid evaluation order and cycles cannot be expressed.
+
+// Default config file, one channel per line: "name [unit] = expression"
+#define DERIVED_CONFIG_PATH SD_MOUNT_POINT "/derived.cfg"
+
+// Bounds the per-frame cost: at most ECU_DERIVED_MAX programs of this length
+#define DERIVED_MAX_PROGRAM 24
+#define DERIVED_MAX_STACK 8
+#define DERIVED_MAX_EXPR 96
+
+// Load DERIVED_CONFIG_PATH if present, else the built-in defaults. Must run
+// before the CAN ingest path starts.
+esp_err_t derived_channels_init(void);
+
+// Drop all channels and free their signal slots
+void derived_channels_clear(void);
+
+// Built-in set: boost, power, wg_error, kmh_krpm
+void derived_channels_load_defaults(void);
+
+// Replace the current set with the definitions in a config file
+esp_err_t derived_channels_load(const char *path);
+
+// Compile one definition into the next free slot. Returns
+// ESP_ERR_INVALID_ARG on a syntax error or unknown signal, ESP_ERR_NO_MEM
+// when all slots are used.
+esp_err_t derived_channels_add(const char *name, const char *unit,
+                               const char *expr);
+
+int derived_channels_count(void);
+
+// Expression a derived signal was compiled from ("" if none)
+const char *derived_channels_expr(ecu_signal_id_t sig);
+
+// Re-evaluate the channels whose inputs intersect `touched`, writing results
+// into `data`. Returns the derived signals updated. Called from the ingest
+// path on the working copy, before it is published.
+ecu_signal_mask_t derived_channels_evaluate(ecu_data_t *data,
+                                            ecu_signal_mask_t touched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DERIVED_CHANNELS_H
@@ -7,6 +7,7 @@
 #include "esp_log.h"
 #include "esp_timer.h"
 #include <math.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,6 +19,13 @@ static const char *TAG = "ECU_DATA";
 // Global ECU data
 static ecu_data_t g_ecu_data = {0};
 static SemaphoreHandle_t ecu_data_mutex = NULL;
+// When each signal was last set (ms, 0 = never), under ecu_data_mutex
+static uint32_t signal_ms[ECU_SIG_COUNT];
+
+// Lock-free copy for ecu_data_get_fast(); written under ecu_data_mutex, so
+// there is one writer at a time. Odd `fast_seq` = write in progress.
+static ecu_fast_data_t fast_data;
+static uint32_t fast_seq = 0;
 
 // System settings
 static system_settings_t g_system_settings = {
@@ -25,9 +33,90 @@ static system_settings_t g_system_settings = {
     .max_rpm_limit = 7000.0f,
     .audio_alerts_enabled = true,
     .ecu_address = "192.168.4.1",
+    // Every stock gauge shown until the saved settings say otherwise
+    .show_map = true,
+    .show_wastegate = true,
+    .show_tps = true,
+    .show_rpm = true,
+    .show_boost = true,
+    .show_tcu = true,
+    .show_oil_press = true,
+    .show_oil_temp = true,
+    .show_water_temp = true,
+    .show_fuel_press = true,
+    .show_battery = true,
+    .show_pedal = true,
+    .show_wg_pos = true,
+    .show_bov = true,
+    .show_tcu_req = true,
+    .show_tcu_act = true,
+    .show_eng_req = true,
+    .show_eng_act = true,
+    .show_limit_tq = true,
     .screen_brightness = 80 // Default brightness
 };
 
+// Signal descriptor table, indexed by ecu_signal_id_t
+typedef struct {
+  const char *key;  // Identifier used by derived channel expressions
+  const char *name; // Display name
+  const char *unit;
+  uint16_t offset; // offsetof(ecu_data_t, field)
+  bool is_int8;    // Field is int8_t instead of float
+} ecu_signal_desc_t;
+
+#define SIG_F(field, key, name, unit)                                          \
+  {key, name, unit, offsetof(ecu_data_t, field), false}
+#define SIG_I8(field, key, name, unit)                                         \
+  {key, name, unit, offsetof(ecu_data_t, field), true}
+// Derived slots take key/name/unit from derived_label[]
+#define SIG_D(n) {NULL, NULL, NULL, offsetof(ecu_data_t, derived[n]), false}
+
+static const ecu_signal_desc_t signal_desc[ECU_SIG_COUNT] = {
+    [ECU_SIG_RPM] = SIG_F(engine_rpm, "rpm", "RPM", "rpm"),
+    [ECU_SIG_TPS] = SIG_F(tps_position, "tps", "TPS", "%"),
+    [ECU_SIG_PEDAL] = SIG_F(abs_pedal_pos, "pedal", "Pedal", "%"),
+    [ECU_SIG_MAP] = SIG_F(map_kpa, "map", "MAP", "kPa"),
+    [ECU_SIG_CLT] = SIG_F(clt_temp, "clt", "Coolant", "C"),
+    [ECU_SIG_IAT] = SIG_F(iat_temp, "iat", "IAT", "C"),
+    [ECU_SIG_OIL_TEMP] = SIG_F(oil_temp, "oil_temp", "Oil Temp", "C"),
+    [ECU_SIG_OIL_PRESS] = SIG_F(oil_pressure, "oil_press", "Oil Press", "kPa"),
+    [ECU_SIG_SPEED] = SIG_F(vehicle_speed, "speed", "Speed", "km/h"),
+    [ECU_SIG_BATTERY] = SIG_F(battery_voltage, "battery", "Battery", "V"),
+    [ECU_SIG_WG_SET] = SIG_F(wg_set_percent, "wg_set", "WG Set", "%"),
+    [ECU_SIG_WG_POS] = SIG_F(wg_pos_percent, "wg_pos", "WG Pos", "%"),
+    [ECU_SIG_BOV] = SIG_F(bov_percent, "bov", "BOV", "%"),
+    [ECU_SIG_TCU_TQ_REQ] = SIG_F(tcu_tq_req_nm, "tcu_req", "TCU Req", "Nm"),
+    [ECU_SIG_TCU_TQ_ACT] = SIG_F(tcu_tq_act_nm, "tcu_act", "TCU Act", "Nm"),
+    [ECU_SIG_ENG_TRG] = SIG_F(eng_trg_nm, "eng_req", "Eng Req", "Nm"),
+    [ECU_SIG_ENG_ACT] = SIG_F(eng_act_nm, "eng_act", "Eng Act", "Nm"),
+    [ECU_SIG_LIMIT_TQ] = SIG_F(limit_tq_nm, "limit_tq", "Limit TQ", "Nm"),
+    [ECU_SIG_GEAR] = SIG_I8(gear, "gear", "Gear", ""),
+    [ECU_SIG_SELECTOR] = SIG_I8(selector_position, "selector", "Selector", ""),
+    [ECU_SIG_DERIVED_0 + 0] = SIG_D(0),
+    [ECU_SIG_DERIVED_0 + 1] = SIG_D(1),
+    [ECU_SIG_DERIVED_0 + 2] = SIG_D(2),
+    [ECU_SIG_DERIVED_0 + 3] = SIG_D(3),
+    [ECU_SIG_DERIVED_0 + 4] = SIG_D(4),
+    [ECU_SIG_DERIVED_0 + 5] = SIG_D(5),
+    [ECU_SIG_DERIVED_0 + 6] = SIG_D(6),
+    [ECU_SIG_DERIVED_0 + 7] = SIG_D(7),
+};
+
+_Static_assert(ECU_SIG_COUNT <= 32, "ecu_signal_mask_t is 32 bits wide");
+_Static_assert(sizeof(((ecu_data_t *)0)->derived) ==
+                   ECU_DERIVED_MAX * sizeof(float),
+               "ecu_data_t.derived must have one slot per derived signal");
+
+// Names of derived slots. Written while compiling channels, before the
+// ingest path and UI read them; empty name = slot unused.
+typedef struct {
+  char name[16];
+  char unit[8];
+} derived_label_t;
+
+static derived_label_t derived_label[ECU_DERIVED_MAX];
+
 // Data stream (simple circular buffer)
 #define DATA_STREAM_SIZE 50
 static data_stream_entry_t data_stream[DATA_STREAM_SIZE] = {0};
@@ -52,13 +141,26 @@ void ecu_data_init(void) {
 }
 
 // Update ECU data (thread-safe)
-void ecu_data_update(ecu_data_t *data) {
+void ecu_data_update(ecu_data_t *data, ecu_signal_mask_t touched,
+                     uint32_t now_ms) {
   if (!data || !ecu_data_mutex)
     return;
 
   if (xSemaphoreTake(ecu_data_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    int64_t now_us = esp_timer_get_time();
     memcpy(&g_ecu_data, data, sizeof(ecu_data_t));
-    g_ecu_data.timestamp = esp_timer_get_time() / 1000; // milliseconds
+    g_ecu_data.timestamp = now_us / 1000; // milliseconds
+    for (ecu_signal_mask_t m = touched & ECU_SIG_MASK_ALL; m; m &= m - 1)
+      signal_ms[__builtin_ctz(m)] = now_ms;
+
+    if (data->engine_rpm != fast_data.rpm || data->gear != fast_data.gear) {
+      __atomic_store_n(&fast_seq, fast_seq + 1, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_RELEASE);
+      fast_data.rpm = data->engine_rpm;
+      fast_data.gear = data->gear;
+      fast_data.changed_us = now_us;
+      __atomic_store_n(&fast_seq, fast_seq + 1, __ATOMIC_RELEASE);
+    }
 
     xSemaphoreGive(ecu_data_mutex);
   }
@@ -81,12 +183,76 @@ void ecu_data_get_copy(ecu_data_t *data_copy) {
   }
 }
 
-// Convert ECU data to JSON string
-char *ecu_data_to_json(const ecu_data_t *data) {
-  // TODO: Update this function to serialize the new ecu_data_t struct if needed
-  // for the web server.
-  static char json_buffer[20] = "{}";
-  return json_buffer;
+void ecu_data_get_stamped(ecu_data_t *data_copy,
+                          uint32_t stamps_ms[ECU_SIG_COUNT]) {
+  if (!data_copy || !ecu_data_mutex)
+    return;
+
+  if (xSemaphoreTake(ecu_data_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    memcpy(data_copy, &g_ecu_data, sizeof(ecu_data_t));
+    memcpy(stamps_ms, signal_ms, sizeof(signal_ms));
+    xSemaphoreGive(ecu_data_mutex);
+  }
+}
+
+bool ecu_data_get_fast(ecu_fast_data_t *out) {
+  for (int attempt = 0; attempt < 4; attempt++) {
+    uint32_t before = __atomic_load_n(&fast_seq, __ATOMIC_ACQUIRE);
+    if (before & 1u)
+      continue;
+    *out = fast_data;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&fast_seq, __ATOMIC_RELAXED) == before)
+      return true;
+  }
+  return false;
+}
+
+// JSON keys of /api/ecu-data, in output order
+static const struct {
+  const char *key;
+  ecu_signal_id_t sig;
+} json_fields[] = {
+    {"rpm", ECU_SIG_RPM},       {"speed", ECU_SIG_SPEED},
+    {"clt", ECU_SIG_CLT},       {"iat", ECU_SIG_IAT},
+    {"oil", ECU_SIG_OIL_TEMP},  {"volt", ECU_SIG_BATTERY},
+    {"gear", ECU_SIG_GEAR},     {"boost", ECU_SIG_MAP},
+    {"tps", ECU_SIG_TPS},
+};
+
+// Serialize the dashboard fields served by /api/ecu-data, plus the keys of
+// the fields whose signal is in `stale`
+size_t ecu_data_to_json(const ecu_data_t *data, ecu_signal_mask_t stale,
+                        char *buf, size_t size) {
+  if (!data || !buf || size == 0)
+    return 0;
+
+  int len = snprintf(
+      buf, size,
+      "{\"rpm\":%.0f,\"speed\":%.1f,\"clt\":%.1f,\"iat\":%.1f,\"oil\":%.1f,"
+      "\"volt\":%.2f,\"gear\":%d,\"boost\":%.1f,\"tps\":%.1f,\"stale\":[",
+      data->engine_rpm, data->vehicle_speed, data->clt_temp, data->iat_temp,
+      data->oil_temp, data->battery_voltage, data->gear, data->map_kpa,
+      data->tps_position);
+
+  bool first = true;
+  for (size_t i = 0; i < sizeof(json_fields) / sizeof(json_fields[0]); i++) {
+    if (len < 0 || (size_t)len >= size)
+      break;
+    if (!(stale & ECU_SIG_BIT(json_fields[i].sig)))
+      continue;
+    len += snprintf(buf + len, size - len, "%s\"%s\"", first ? "" : ",",
+                    json_fields[i].key);
+    first = false;
+  }
+  if (len >= 0 && (size_t)len < size)
+    len += snprintf(buf + len, size - len, "]}");
+
+  if (len < 0 || (size_t)len >= size) {
+    buf[0] = '\0';
+    return 0; // Truncated
+  }
+  return (size_t)len;
 }
 
 // Parse ECU data from JSON string
@@ -95,32 +261,68 @@ bool ecu_data_from_json(const char *json_str, ecu_data_t *data) {
   return false;
 }
 
-// Simulate ECU data for testing
-void ecu_data_simulate(ecu_data_t *data) {
-  // TODO: Update this function to simulate the new data fields if needed for
-  // testing.
-  if (!data)
-    return;
+// ============================================================================
+// SIGNAL ACCESS
+// ============================================================================
 
-  static float sim_time = 0;
-  sim_time += 0.1f;
+float ecu_data_get_signal(const ecu_data_t *data, ecu_signal_id_t sig) {
+  if (!data || (unsigned)sig >= ECU_SIG_COUNT)
+    return 0.0f;
 
-  // Simulate realistic ECU data
-  data->engine_rpm =
-      800 + 3000 * (sin(sim_time * 0.5f) * 0.5f + 0.5f); // 800-3800 idle/rev
-  data->map_kpa = 100 + 50 * sin(sim_time * 0.8f) + 20 * sin(sim_time * 1.5f);
-  data->tps_position =
-      20 + 30 * sin(sim_time * 0.3f) + 10 * sin(sim_time * 1.2f);
+  const uint8_t *base = (const uint8_t *)data + signal_desc[sig].offset;
+  if (signal_desc[sig].is_int8)
+    return (float)*(const int8_t *)base;
+  return *(const float *)base;
+}
 
-  // Derived values
-  data->oil_pressure =
-      20.0f + (data->engine_rpm / 100.0f) * 4.0f; // Varies with RPM
-  data->oil_temp = 90.0f + 5.0f * sin(sim_time * 0.1f);
-  data->clt_temp = 85.0f + 3.0f * sin(sim_time * 0.15f);
-  data->iat_temp = 30.0f + 10.0f * sin(sim_time * 0.2f);
-  data->vehicle_speed = data->engine_rpm * 0.04f; // Fake speed from RPM
+static const derived_label_t *derived_slot(ecu_signal_id_t sig) {
+  if (sig < ECU_SIG_DERIVED_0 || sig > ECU_SIG_DERIVED_LAST)
+    return NULL;
+  return &derived_label[sig - ECU_SIG_DERIVED_0];
+}
 
-  data->timestamp = esp_timer_get_time() / 1000;
+const char *ecu_signal_name(ecu_signal_id_t sig) {
+  if ((unsigned)sig >= ECU_SIG_COUNT)
+    return "?";
+  const derived_label_t *d = derived_slot(sig);
+  return d ? d->name : signal_desc[sig].name;
+}
+
+const char *ecu_signal_unit(ecu_signal_id_t sig) {
+  if ((unsigned)sig >= ECU_SIG_COUNT)
+    return "";
+  const derived_label_t *d = derived_slot(sig);
+  return d ? d->unit : signal_desc[sig].unit;
+}
+
+const char *ecu_signal_key(ecu_signal_id_t sig) {
+  if ((unsigned)sig >= ECU_SIG_COUNT)
+    return "";
+  const derived_label_t *d = derived_slot(sig);
+  return d ? d->name : signal_desc[sig].key;
+}
+
+ecu_signal_id_t ecu_signal_find(const char *key) {
+  if (!key || !key[0])
+    return ECU_SIG_COUNT;
+  for (int i = 0; i < ECU_SIG_COUNT; i++) {
+    if (strcmp(ecu_signal_key((ecu_signal_id_t)i), key) == 0)
+      return (ecu_signal_id_t)i;
+  }
+  return ECU_SIG_COUNT;
+}
+
+bool ecu_signal_defined(ecu_signal_id_t sig) {
+  return (unsigned)sig < ECU_SIG_COUNT && ecu_signal_key(sig)[0] != '\0';
+}
+
+void ecu_signal_set_derived_label(int slot, const char *name,
+                                  const char *unit) {
+  if (slot < 0 || slot >= ECU_DERIVED_MAX)
+    return;
+  derived_label_t *d = &derived_label[slot];
+  snprintf(d->name, sizeof(d->name), "%s", name ? name : "");
+  snprintf(d->unit, sizeof(d->unit), "%s", (name && unit) ? unit : "");
 }
 
 // ============================================================================
@@ -202,7 +404,8 @@ char *data_stream_to_json(void) {
 
     ptr += sprintf(
         ptr, "{\"timestamp\":%llu,\"message\":\"%s\",\"type\":\"%s\"}",
-        data_stream[index].timestamp, data_stream[index].message, type_str);
+        (unsigned long long)data_stream[index].timestamp,
+        data_stream[index].message, type_str);
   }
 
   ptr += sprintf(ptr, "]");
@@ -231,7 +434,8 @@ char *data_stream_to_string(void) {
     if (data_stream[index].timestamp == 0)
       continue;
 
-    ptr += sprintf(ptr, "[%llu] %s\n", data_stream[index].timestamp,
+    ptr += sprintf(ptr, "[%llu] %s\n",
+                   (unsigned long long)data_stream[index].timestamp,
                    data_stream[index].message);
   }
 
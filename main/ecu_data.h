@@ -4,9 +4,9 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,10 +39,51 @@ typedef struct {
   int8_t gear;              // Gear Position
   int8_t selector_position; // Selector Lever Position
 
+  // Derived channels (see derived_channels.h), ECU_SIG_DERIVED_0 + n
+  float derived[8];
+
   // System
   uint64_t timestamp;
 } ecu_data_t;
 
+// Decoded signal identifiers. One entry per value field in ecu_data_t, so
+// consumers (statistics, staleness, derived channels) can address signals
+// generically and parsers can report which ones a frame touched as a bitmask.
+typedef enum {
+  ECU_SIG_RPM = 0,
+  ECU_SIG_TPS,
+  ECU_SIG_PEDAL,
+  ECU_SIG_MAP,
+  ECU_SIG_CLT,
+  ECU_SIG_IAT,
+  ECU_SIG_OIL_TEMP,
+  ECU_SIG_OIL_PRESS,
+  ECU_SIG_SPEED,
+  ECU_SIG_BATTERY,
+  ECU_SIG_WG_SET,
+  ECU_SIG_WG_POS,
+  ECU_SIG_BOV,
+  ECU_SIG_TCU_TQ_REQ,
+  ECU_SIG_TCU_TQ_ACT,
+  ECU_SIG_ENG_TRG,
+  ECU_SIG_ENG_ACT,
+  ECU_SIG_LIMIT_TQ,
+  ECU_SIG_GEAR,
+  ECU_SIG_SELECTOR,
+
+  // Slots for derived channels; named when a channel is compiled into them
+  ECU_SIG_DERIVED_0,
+  ECU_SIG_DERIVED_LAST = ECU_SIG_DERIVED_0 + 7,
+
+  ECU_SIG_COUNT
+} ecu_signal_id_t;
+
+// Bitmask of ecu_signal_id_t values (must fit in 32 bits)
+typedef uint32_t ecu_signal_mask_t;
+#define ECU_SIG_BIT(sig) ((ecu_signal_mask_t)1u << (sig))
+#define ECU_SIG_MASK_ALL (ECU_SIG_BIT(ECU_SIG_COUNT) - 1u)
+#define ECU_DERIVED_MAX (ECU_SIG_DERIVED_LAST - ECU_SIG_DERIVED_0 + 1)
+
 // System settings
 typedef struct {
   float max_boost_limit; // Maximum boost limit
@@ -51,7 +92,8 @@ typedef struct {
   bool audio_alerts_enabled; // Audio alerts enabled
   char ecu_address[32];      // ECU address
 
-  // Gauge Visibility Settings (Screen 1)
+  // Gauge visibility of the stock layout (ui_layout_manager.h)
+  // Screen 1
   bool show_map;
   bool show_wastegate;
   bool show_tps;
@@ -78,47 +120,10 @@ typedef struct {
   bool show_eng_act;
   bool show_limit_tq;
 
-  // Dynamic Layout Settings
-  int active_gauge_ids[24]; // Ordered list of enabled gauge IDs
-  int active_gauge_count;   // Number of active gauges
   bool screen3_enabled;
   uint32_t screen_brightness; // Added for P4 compatibility
 } system_settings_t;
 
-// Gauge IDs for dynamic layout
-typedef enum {
-  GAUGE_NONE = -1,
-
-  // Screen 1 Gauges
-  GAUGE_MAP = 0,
-  GAUGE_WASTEGATE,
-  GAUGE_TPS,
-  GAUGE_RPM,
-  GAUGE_BOOST,
-  GAUGE_TCU,
-
-  // Screen 2 Gauges
-  GAUGE_OIL_PRESS,
-  GAUGE_OIL_TEMP,
-  GAUGE_WATER_TEMP,
-  GAUGE_FUEL_PRESS,
-  GAUGE_BATTERY,
-
-  // Screen 4 Gauges
-  GAUGE_PEDAL,
-  GAUGE_WG_POS,
-  GAUGE_BOV,
-  GAUGE_TCU_REQ,
-  GAUGE_TCU_ACT,
-  GAUGE_ENG_REQ,
-
-  // Screen 5 Gauges
-  GAUGE_ENG_ACT,
-  GAUGE_LIMIT_TQ,
-
-  GAUGE_MAX
-} gauge_id_t;
-
 // Connection status
 typedef struct {
   bool connected;
@@ -136,12 +141,48 @@ typedef struct {
 
 // Function prototypes
 void ecu_data_init(void);
-void ecu_data_update(ecu_data_t *data);
+// Publish a snapshot. The signals in `touched` are stamped `now_ms` in the
+// same critical section, so readers get each value with the time of the
+// update that set it.
+void ecu_data_update(ecu_data_t *data, ecu_signal_mask_t touched,
+                     uint32_t now_ms);
 ecu_data_t *ecu_data_get(void);                // Unsafe, for internal use
 void ecu_data_get_copy(ecu_data_t *data_copy); // Thread-safe getter
-char *ecu_data_to_json(const ecu_data_t *data);
+// Copy plus when each signal was last set (ms, 0 = never), consistent with
+// each other
+void ecu_data_get_stamped(ecu_data_t *data_copy,
+                          uint32_t stamps_ms[ECU_SIG_COUNT]);
+
+// The few fields the shift light reads at display rate. ecu_data_update()
+// publishes them behind a sequence counter, so readers retry instead of
+// waiting for the data mutex.
+typedef struct {
+  float rpm;
+  int8_t gear;
+  int64_t changed_us; // esp_timer time of the update that changed rpm/gear
+} ecu_fast_data_t;
+
+// Lock-free; false only if the writer kept racing the read
+bool ecu_data_get_fast(ecu_fast_data_t *out);
 bool ecu_data_from_json(const char *json_str, ecu_data_t *data);
-void ecu_data_simulate(ecu_data_t *data);
+
+// Serialize for /api/ecu-data; keys of signals in `stale` are listed in
+// "stale". Returns the JSON length, or 0 if buf is too small.
+size_t ecu_data_to_json(const ecu_data_t *data, ecu_signal_mask_t stale,
+                        char *buf, size_t size);
+
+// Generic signal access
+float ecu_data_get_signal(const ecu_data_t *data, ecu_signal_id_t sig);
+const char *ecu_signal_name(ecu_signal_id_t sig); // Short name, e.g. "MAP"
+const char *ecu_signal_unit(ecu_signal_id_t sig); // Unit, e.g. "kPa"
+const char *ecu_signal_key(ecu_signal_id_t sig);  // Identifier, e.g. "map"
+// Look up a signal by key; returns ECU_SIG_COUNT if unknown
+ecu_signal_id_t ecu_signal_find(const char *key);
+// Unnamed derived slots are undefined; every decoded signal is defined
+bool ecu_signal_defined(ecu_signal_id_t sig);
+// Name a derived slot (NULL name frees it). Call before the ingest path runs.
+void ecu_signal_set_derived_label(int slot, const char *name,
+                                  const char *unit);
 
 // System settings functions
 void system_settings_init(void);
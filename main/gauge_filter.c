@@ -0,0 +1,65 @@
+#include "gauge_filter.h"
+#include <string.h>
+
+void gauge_filter_reset(gauge_filter_t *f) { memset(f, 0, sizeof(*f)); }
+
+void gauge_filter_sample(gauge_filter_t *f, float value, uint32_t sample_ms) {
+  if (!f->primed) {
+    memset(f, 0, sizeof(*f));
+    f->out = value;
+    f->sample = value;
+    f->sample_ms = sample_ms;
+    f->step_ms = sample_ms;
+    f->primed = true;
+    return;
+  }
+  if (sample_ms != f->sample_ms) {
+    uint32_t interval = sample_ms - f->sample_ms;
+    if (interval <= GAUGE_FILTER_MAX_PREDICT_MS) {
+      f->slope = (value - f->sample) / (float)interval;
+      f->period_ms = (uint16_t)interval;
+    } else {
+      f->slope = 0.0f;
+      f->period_ms = 0;
+    }
+    f->sample_ms = sample_ms;
+  }
+  f->sample = value;
+}
+
+float gauge_filter_step(gauge_filter_t *f, uint16_t smooth_ms,
+                        uint32_t now_ms) {
+  if (!f->primed)
+    return f->out;
+
+  uint32_t dt_ms = now_ms - f->step_ms;
+  f->step_ms = now_ms;
+  if (dt_ms > GAUGE_FILTER_RESYNC_MS) {
+    f->out = f->sample;
+    f->vel = 0.0f;
+    return f->out;
+  }
+
+  if (smooth_ms == 0) {
+    int32_t age = (int32_t)(now_ms - f->sample_ms);
+    if (age < 0)
+      age = 0;
+    if (age > f->period_ms)
+      age = f->period_ms;
+    f->out = f->sample + f->slope * (float)age;
+    return f->out;
+  }
+
+  // Closed-form step of a critically damped spring (the usual SmoothDamp
+  // approximation of exp), stable for any frame time. omega = 4 / smooth
+  // leaves about 10% of a step after smooth_ms.
+  float omega = 4000.0f / (float)smooth_ms;
+  float dt = (float)dt_ms / 1000.0f;
+  float x = omega * dt;
+  float decay = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+  float change = f->out - f->sample;
+  float temp = (f->vel + omega * change) * dt;
+  f->vel = (f->vel - omega * temp) * decay;
+  f->out = f->sample + (change + temp) * decay;
+  return f->out;
+}
@@ -0,0 +1,56 @@
+#ifndef GAUGE_FILTER_H
+#define GAUGE_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Display-rate interpolation for one gauge. Samples arrive at the signal's
+// CAN rate, stamped with the time the ingest path stored them; the gauge
+// timer steps the filter once per display refresh and draws its output.
+//
+// smooth_ms > 0: critically damped follower of the newest sample. The
+// needle covers about 90% of a step in smooth_ms, never overshoots and
+// rides over noise.
+//
+// smooth_ms == 0: zero lag. The newest sample is shown as soon as it
+// arrives, then extrapolated along the slope of the last two samples for at
+// most one sample interval, so motion is continuous between samples
+// without ever trailing the data (shift-critical RPM).
+
+// A filter not stepped for this long (gauge off screen) jumps to the data
+#define GAUGE_FILTER_RESYNC_MS 250
+// No extrapolation across a sample gap longer than this
+#define GAUGE_FILTER_MAX_PREDICT_MS 200
+
+typedef struct {
+  float out;          // Value shown
+  float vel;          // Damped mode: units per second
+  float sample;       // Newest sample
+  float slope;        // Zero-lag mode: units per ms over the last interval
+  uint32_t sample_ms; // Timestamp of the newest sample
+  uint32_t step_ms;   // Time of the last step
+  uint16_t period_ms; // Interval between the two newest samples
+  bool primed;        // out / sample hold real data
+} gauge_filter_t;
+
+// Forget the state; the next sample is shown as is. A zeroed struct is
+// already reset.
+void gauge_filter_reset(gauge_filter_t *f);
+
+// Feed the signal's current value and the time it was stored. A repeated
+// timestamp is not a new sample.
+void gauge_filter_sample(gauge_filter_t *f, float value, uint32_t sample_ms);
+
+// Advance to now_ms and return the value to display
+float gauge_filter_step(gauge_filter_t *f, uint16_t smooth_ms,
+                        uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GAUGE_FILTER_H
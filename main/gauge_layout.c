@@ -0,0 +1,284 @@
+// Gauge layout parsing
+//
+// Pure data: parsed on whatever task loads the file, then handed to the
+// layout manager, which copies it under the LVGL lock.
+
+#include "gauge_layout.h"
+#include "esp_log.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "GAUGE_LAYOUT";
+
+#define DEFAULT_COLOR 0x00D4FF
+
+// The stock pages, in the file format so this doubles as its reference
+static const char *const default_layout[] = {
+    "map arc sig=map min=100 max=250 warn=1500 crit=1800 smooth=60 "
+    "title=MAP_Pressure",
+    "wastegate arc sig=wg_pos min=0 max=100 warn=110 crit=120 dp=1 smooth=80 "
+    "title=Wastegate",
+    "tps arc sig=tps min=0 max=100 warn=80 crit=90 dp=1 smooth=40 "
+    "title=TPS_Position",
+    "rpm arc sig=rpm min=0 max=8000 warn=7500 crit=9000 "
+    "title=Engine_RPM unit=RPM",
+    "boost arc sig=map min=100 max=250 warn=200 crit=230 smooth=60 "
+    "title=Target_Boost",
+    "tcu tcu title=TCU_Status",
+
+    "oil_press arc sig=none min=0 max=10 warn=2 crit=1 low dp=1 smooth=150 "
+    "title=Oil_Pressure unit=bar color=FF6B35",
+    "oil_temp arc sig=oil_temp min=60 max=140 warn=110 crit=120 smooth=400 "
+    "title=Oil_Temp unit=°C color=FFD700",
+    "water_temp arc sig=clt min=60 max=120 warn=105 crit=115 smooth=400 "
+    "title=Water_Temp unit=°C",
+    "fuel_press arc sig=none min=0 max=8 warn=3 crit=2 low dp=1 smooth=150 "
+    "title=Fuel_Pressure unit=bar color=00FF88",
+    "battery arc sig=battery min=11 max=15 warn=12 crit=11.5 low dp=1 "
+    "smooth=400 title=Battery color=FFD700",
+
+    "pedal arc sig=pedal min=0 max=100 warn=110 crit=120 dp=1 smooth=40 "
+    "title=Abs._Pedal_Pos",
+    "wg_pos arc sig=wg_pos min=0 max=100 warn=110 crit=120 dp=1 smooth=80 "
+    "title=Wastegate_Pos color=00FF88",
+    "bov arc sig=bov min=0 max=100 warn=110 crit=120 dp=1 smooth=80 "
+    "title=BOV color=FFD700",
+    "tcu_req arc sig=tcu_req min=0 max=500 warn=450 crit=500 smooth=80 "
+    "title=TCU_Tq_Req color=FF6B35",
+    "tcu_act arc sig=tcu_act min=0 max=500 warn=450 crit=500 smooth=80 "
+    "title=TCU_Tq_Act color=FF3366",
+    "eng_req arc sig=eng_req min=0 max=500 warn=450 crit=500 smooth=80 "
+    "title=Eng_Tq_Req color=8A2BE2",
+
+    "eng_act arc sig=eng_act min=0 max=500 warn=450 crit=500 smooth=80 "
+    "title=Eng_Tq_Act",
+    "limit_tq arc sig=limit_tq min=0 max=500 warn=450 crit=500 smooth=80 "
+    "title=Torque_Limit color=00FF88",
+};
+
+static bool parse_float(const char *s, float *out) {
+  char *end;
+  float v = strtof(s, &end);
+  if (end == s || *end != '\0' || !isfinite(v))
+    return false;
+  *out = v;
+  return true;
+}
+
+static bool parse_uint(const char *s, int base, unsigned long max,
+                       unsigned long *out) {
+  char *end;
+  unsigned long v = strtoul(s, &end, base);
+  if (end == s || *end != '\0' || v > max)
+    return false;
+  *out = v;
+  return true;
+}
+
+// Copy with '_' as space
+static void copy_text(char *dst, size_t size, const char *src) {
+  snprintf(dst, size, "%s", src);
+  for (char *p = dst; *p; p++) {
+    if (*p == '_')
+      *p = ' ';
+  }
+}
+
+static bool parse_option(gauge_layout_entry_t *e, const char *name,
+                         const char *value, bool *have_warn, bool *have_crit) {
+  unsigned long u;
+  if (!value) {
+    if (strcmp(name, "low") == 0)
+      e->invert = true;
+    else if (strcmp(name, "hidden") == 0)
+      e->hidden = true;
+    else
+      return false;
+    return true;
+  }
+
+  if (strcmp(name, "sig") == 0) {
+    e->sig = strcmp(value, "none") == 0 ? ECU_SIG_COUNT
+                                        : ecu_signal_find(value);
+    return strcmp(value, "none") == 0 || e->sig != ECU_SIG_COUNT;
+  }
+  if (strcmp(name, "min") == 0)
+    return parse_float(value, &e->min);
+  if (strcmp(name, "max") == 0)
+    return parse_float(value, &e->max);
+  if (strcmp(name, "warn") == 0)
+    return (*have_warn = parse_float(value, &e->warn));
+  if (strcmp(name, "crit") == 0)
+    return (*have_crit = parse_float(value, &e->crit));
+  if (strcmp(name, "dp") == 0) {
+    if (!parse_uint(value, 10, 2, &u))
+      return false;
+    e->decimals = (uint8_t)u;
+    return true;
+  }
+  if (strcmp(name, "smooth") == 0) {
+    if (!parse_uint(value, 10, UINT16_MAX, &u))
+      return false;
+    e->smooth_ms = (uint16_t)u;
+    return true;
+  }
+  if (strcmp(name, "color") == 0) {
+    if (!parse_uint(value, 16, 0xFFFFFF, &u))
+      return false;
+    e->color = (uint32_t)u;
+    return true;
+  }
+  if (strcmp(name, "title") == 0) {
+    copy_text(e->title, sizeof(e->title), value);
+    return true;
+  }
+  if (strcmp(name, "unit") == 0) {
+    copy_text(e->unit, sizeof(e->unit), value);
+    return true;
+  }
+  if (strcmp(name, "at") == 0) {
+    int page, slot;
+    char tail;
+    if (sscanf(value, "%d.%d%c", &page, &slot, &tail) != 2 || page < 1 ||
+        page > GAUGE_LAYOUT_PAGES || slot < 1 || slot > GAUGE_LAYOUT_SLOTS)
+      return false;
+    e->at = (int8_t)((page - 1) * GAUGE_LAYOUT_SLOTS + slot - 1);
+    return true;
+  }
+  return false;
+}
+
+esp_err_t gauge_layout_parse_line(const char *line, gauge_layout_entry_t *out) {
+  char buf[192];
+  snprintf(buf, sizeof(buf), "%s", line);
+  buf[strcspn(buf, "\r\n#")] = '\0';
+
+  char *save;
+  const char *key = strtok_r(buf, " \t", &save);
+  if (!key)
+    return ESP_ERR_NOT_FOUND;
+  const char *type = strtok_r(NULL, " \t", &save);
+
+  // Zeroed padding too: the layout manager compares entries with memcmp
+  gauge_layout_entry_t e;
+  memset(&e, 0, sizeof(e));
+  e.sig = ECU_SIG_COUNT;
+  e.max = 100.0f;
+  e.color = DEFAULT_COLOR;
+  e.at = -1;
+  snprintf(e.key, sizeof(e.key), "%s", key);
+  if (!type) {
+    ESP_LOGE(TAG, "%s: missing widget type", key);
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (strcmp(type, "arc") == 0) {
+    e.type = GAUGE_WIDGET_ARC;
+  } else if (strcmp(type, "tcu") == 0) {
+    e.type = GAUGE_WIDGET_TCU;
+  } else {
+    ESP_LOGE(TAG, "%s: unknown widget type '%s'", key, type);
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  bool have_warn = false, have_crit = false;
+  char *opt;
+  while ((opt = strtok_r(NULL, " \t", &save)) != NULL) {
+    char *value = strchr(opt, '=');
+    if (value)
+      *value++ = '\0';
+    if (!parse_option(&e, opt, value, &have_warn, &have_crit)) {
+      ESP_LOGE(TAG, "%s: bad option '%s%s%s'", key, opt, value ? "=" : "",
+               value ? value : "");
+      return ESP_ERR_INVALID_ARG;
+    }
+  }
+  if (e.type == GAUGE_WIDGET_ARC && e.min >= e.max) {
+    ESP_LOGE(TAG, "%s: min must be below max", key);
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  // A missing threshold never trips
+  float never = e.invert ? -INFINITY : INFINITY;
+  if (!have_warn)
+    e.warn = have_crit ? e.crit : never;
+  if (!have_crit)
+    e.crit = never;
+
+  if (!e.title[0]) {
+    snprintf(e.title, sizeof(e.title), "%s",
+             e.sig != ECU_SIG_COUNT ? ecu_signal_name(e.sig) : e.key);
+  }
+  if (!e.unit[0] && e.sig != ECU_SIG_COUNT)
+    snprintf(e.unit, sizeof(e.unit), "%s", ecu_signal_unit(e.sig));
+
+  *out = e;
+  return ESP_OK;
+}
+
+int gauge_layout_find(const gauge_layout_t *layout, const char *key) {
+  for (int i = 0; i < layout->count; i++) {
+    if (strcmp(layout->entries[i].key, key) == 0)
+      return i;
+  }
+  return -1;
+}
+
+// Append e unless the table is full or it clashes with an earlier entry
+static bool layout_add(gauge_layout_t *layout, const gauge_layout_entry_t *e) {
+  if (layout->count == GAUGE_LAYOUT_MAX) {
+    ESP_LOGE(TAG, "%s: more than %d gauges", e->key, GAUGE_LAYOUT_MAX);
+    return false;
+  }
+  if (gauge_layout_find(layout, e->key) >= 0) {
+    ESP_LOGE(TAG, "%s: duplicate key", e->key);
+    return false;
+  }
+  for (int i = 0; i < layout->count; i++) {
+    if (e->type == GAUGE_WIDGET_TCU &&
+        layout->entries[i].type == GAUGE_WIDGET_TCU) {
+      ESP_LOGE(TAG, "%s: only one tcu card", e->key);
+      return false;
+    }
+  }
+  layout->entries[layout->count++] = *e;
+  return true;
+}
+
+void gauge_layout_defaults(gauge_layout_t *out) {
+  out->count = 0;
+  for (size_t i = 0; i < sizeof(default_layout) / sizeof(default_layout[0]);
+       i++) {
+    gauge_layout_entry_t e;
+    if (gauge_layout_parse_line(default_layout[i], &e) == ESP_OK)
+      layout_add(out, &e);
+  }
+}
+
+esp_err_t gauge_layout_load(const char *path, gauge_layout_t *out) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return ESP_ERR_NOT_FOUND;
+
+  out->count = 0;
+  char line[192];
+  int line_no = 0;
+  int errors = 0;
+  while (fgets(line, sizeof(line), f)) {
+    line_no++;
+    gauge_layout_entry_t e;
+    esp_err_t err = gauge_layout_parse_line(line, &e);
+    if (err == ESP_ERR_NOT_FOUND)
+      continue;
+    if (err != ESP_OK || !layout_add(out, &e)) {
+      ESP_LOGE(TAG, "%s:%d: gauge skipped", path, line_no);
+      errors++;
+    }
+  }
+  fclose(f);
+
+  ESP_LOGI(TAG, "Loaded %d gauges from %s (%d errors)", out->count, path,
+           errors);
+  return errors ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
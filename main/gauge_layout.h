@@ -0,0 +1,86 @@
+#ifndef GAUGE_LAYOUT_H
+#define GAUGE_LAYOUT_H
+
+#include "ecu_data.h"
+#include "esp_err.h"
+#include "sd_card_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Gauge layout: what the gauge pages (Screens 1, 2, 4 and 5) show. Each
+// entry describes one widget; the layout manager instantiates it from a
+// pool of cards and flows the visible ones into the pages in table order.
+//
+// Config file, one gauge per line: "key type [option=value ...]"
+//   key     unique name, e.g. "oil_temp"
+//   type    arc | tcu (TCU status card, at most one)
+//   sig=    signal key (ecu_signal_key() or a derived channel), or "none"
+//   min= max=          arc range
+//   warn= crit=        thresholds; upper limits unless "low" is given
+//   low                thresholds are lower limits (pressures, voltage)
+//   dp=     digits after the point in the value, 0..2
+//   smooth= needle settle time in ms (gauge_filter.h)
+//   color=  accent as RRGGBB
+//   title= unit=       '_' stands for a space; default to the signal's
+//   at=     page.slot, page 1..4, slot 1..6 (left to right, top row first);
+//           other gauges flow around it
+//   hidden             not shown until enabled in Settings
+// Lines are '#'-commented. Unknown keys are errors, so typos show in the log.
+
+#define GAUGE_LAYOUT_PATH SD_MOUNT_POINT "/layout.cfg"
+#define GAUGE_LAYOUT_PAGES 4
+#define GAUGE_LAYOUT_SLOTS 6 // 3x2 grid per page
+#define GAUGE_LAYOUT_MAX (GAUGE_LAYOUT_PAGES * GAUGE_LAYOUT_SLOTS)
+
+typedef enum {
+  GAUGE_WIDGET_ARC = 0,
+  GAUGE_WIDGET_TCU,
+  GAUGE_WIDGET_COUNT
+} gauge_widget_t;
+
+typedef struct {
+  char key[16];
+  char title[24];
+  char unit[8];
+  gauge_widget_t type;
+  ecu_signal_id_t sig; // ECU_SIG_COUNT = not fed, drawn as 0
+  float min;
+  float max;
+  float warn;
+  float crit;
+  bool invert; // Thresholds are lower limits
+  bool hidden; // Default visibility
+  uint8_t decimals;
+  uint16_t smooth_ms;
+  uint32_t color;
+  int8_t at; // Fixed page * GAUGE_LAYOUT_SLOTS + slot, -1 = flow
+} gauge_layout_entry_t;
+
+typedef struct {
+  gauge_layout_entry_t entries[GAUGE_LAYOUT_MAX];
+  int count;
+} gauge_layout_t;
+
+// Built-in layout: the four stock gauge pages
+void gauge_layout_defaults(gauge_layout_t *out);
+
+// Parse a layout file into *out. ESP_ERR_NOT_FOUND leaves *out untouched;
+// otherwise *out holds every valid line and ESP_ERR_INVALID_ARG reports
+// that some were skipped.
+esp_err_t gauge_layout_load(const char *path, gauge_layout_t *out);
+
+// Parse one config line. ESP_ERR_NOT_FOUND for a blank or comment line.
+esp_err_t gauge_layout_parse_line(const char *line, gauge_layout_entry_t *out);
+
+// Index of the entry with this key, -1 if none
+int gauge_layout_find(const gauge_layout_t *layout, const char *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GAUGE_LAYOUT_H
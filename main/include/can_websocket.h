@@ -44,16 +44,4 @@ void websocket_get_joystick_state(game_controller_state_t *state);
 // Data broadcast task
 void websocket_broadcast_task(void *pvParameters);
 
-// Demo data generation
-typedef struct {
-  float map_pressure;
-  float wastegate_pos;
-  float tps_position;
-  float engine_rpm;
-  float target_boost;
-  int tcu_status;
-} demo_can_data_t;
-
-void generate_demo_can_data(demo_can_data_t *demo_data);
-
 #endif // CAN_WEBSOCKET_H
@@ -2,6 +2,7 @@
 #include "audio_manager.h"
 #include "background_task.h"
 #include "can_manager.h"
+#include "derived_channels.h"
 #include "display_init.h"
 #include "driver/gpio.h"
 #include "driver/i2c_master.h"
@@ -15,6 +16,7 @@
 #include "main_gui.h"
 #include "sd_card_manager.h"
 #include "settings_manager.h"
+#include "shift_points.h"
 #include "wifi_init.h"
 #include <dirent.h>
 #include <stdio.h>
@@ -155,6 +157,11 @@ void app_main(void) {
     ESP_LOGE(TAG, "SD Card initialization failed!");
   }
 
+  // Derived channels name their signal slots and the shift light reads its
+  // thresholds; both must be in place before the UI starts
+  derived_channels_init();
+  shift_points_init();
+
   // 6. Initialize WiFi
   ESP_LOGI(TAG, "Initializing WiFi...");
   wifi_init_sta(WIFI_SSID, WIFI_PASS);
@@ -2,6 +2,7 @@
 #include "display_init.h"
 #include "driver/i2c_master.h"
 #include "driver/ppa.h"
+#include "esp_attr.h"
 #include "esp_heap_caps.h"
 #include "esp_lcd_mipi_dsi.h"
 #include "esp_lcd_panel_ops.h"
@@ -13,9 +14,12 @@
 #include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "lvgl.h"
+#include "perf_monitor.h"
 #include "ui/ui.h"
 #include "ui/ui_screen_manager.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static const char *TAG = "MAIN_GUI";
 
@@ -24,13 +28,102 @@ static const char *TAG = "MAIN_GUI";
 #define LVGL_TASK_PRIORITY (5)
 #define LVGL_TICK_MS (5)
 
+// Touch reader task configuration
+#define TOUCH_TASK_STACK_SIZE (4 * 1024)
+#define TOUCH_TASK_PRIORITY (LVGL_TASK_PRIORITY + 1)
+// Both controllers pulse INT once per report (~100 Hz while a finger is
+// down), so a held touch that goes quiet this long has been released
+#define TOUCH_HELD_TIMEOUT_MS 100
+#define TOUCH_POLL_MS 15 // Without an INT line
+// LVGL indev read period; the read is a memory copy now, so keep it short
+#define TOUCH_READ_PERIOD_MS 10
+#define FT5x06_REG_G_MODE 0xA4 // 1 = pulse INT per report, not hold it low
+// Gesture thresholds, in touch coordinates (pixels)
+#define TOUCH_TAP_SLOP_PX 20
+#define TOUCH_TAP_MAX_MS 300
+#define TOUCH_SWIPE_MIN_PX 120
+#define TOUCH_SWIPE_MAX_MS 800
+
+#define DRAW_BUF_LINES CONFIG_DISPLAY_DRAW_BUF_LINES
+#define FB_BYTES_PER_PIXEL 2
+
+#if CONFIG_DISPLAY_FLUSH_BLOCKING
+#define FLUSH_MODE_NAME "blocking"
+#elif CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+#define FLUSH_MODE_NAME "double-fb"
+#else
+#define FLUSH_MODE_NAME "async"
+#endif
+
+// Flush statistics are logged and published once per window
+#define FLUSH_STATS_WINDOW_US (5 * 1000 * 1000)
+// Bound on waits for hardware events, so a lost interrupt cannot hang LVGL
+#define FLUSH_EVENT_TIMEOUT_MS 100
+
 static lv_disp_draw_buf_t disp_buf;
 static lv_disp_drv_t disp_drv;
 static ppa_client_handle_t ppa_srm_handle = NULL;
-static void *dsi_fb = NULL;
+static void *dsi_fb = NULL; // Framebuffer the PPA writes into
 extern i2c_master_bus_handle_t i2c1_bus;
 static SemaphoreHandle_t lvgl_mux = NULL;
 
+// Signalled from the PPA ISR when a band is done
+static SemaphoreHandle_t band_done_sem = NULL;
+
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+// Bands handed to the PPA and bands it finished. The frame is complete when
+// they are equal; a late signal from an earlier band cannot end that wait.
+static uint32_t bands_submitted = 0;
+static uint32_t bands_done = 0;
+
+// Physical rectangle in the portrait framebuffer
+typedef struct {
+  int x, y, w, h;
+} fb_rect_t;
+
+#define SYNC_MAX_RECTS 16
+
+static esp_lcd_panel_handle_t panel = NULL;
+static void *dsi_fbs[2];
+// Framebuffer copies get their own client: the band client's completion
+// callback belongs to LVGL's flush
+static ppa_client_handle_t ppa_copy_handle = NULL;
+static int back_fb = 0;
+static SemaphoreHandle_t vsync_sem = NULL;
+static bool swap_pending = false;
+// Areas written this frame; after the swap the new back buffer still holds
+// the frame before, so they are copied over from the front before reuse
+static fb_rect_t frame_rects[SYNC_MAX_RECTS];
+static int frame_rect_count = 0;
+static bool frame_full = false; // Too many rects: copy the whole buffer
+#endif
+
+// Frame timing, written by the flush path and the PPA ISR
+static struct {
+  bool in_frame;
+  bool frame_done;      // Last band finished in the ISR, stats not yet taken
+  int64_t frame_done_us;
+  int64_t frame_start_us;
+  int64_t band_submit_us;
+  int64_t window_start_us;
+  uint32_t frames;
+  uint32_t bands;
+  int64_t frame_us;
+  int64_t ppa_us;
+  int64_t wait_us;
+} flush_acc;
+static main_gui_flush_stats_t flush_stats = {.mode = FLUSH_MODE_NAME};
+
+// Latest touch report. The touch task is the only writer, so no lock is
+// needed. Odd `touch_seq` = write in progress.
+static main_gui_touch_t touch_box;
+static uint32_t touch_seq = 0;
+static bool touch_ready = false; // A touch task is publishing
+static TaskHandle_t touch_task_handle = NULL;
+// Re-read interval for a held touch; short if INT is held low while touched
+static TickType_t touch_held_wait = pdMS_TO_TICKS(TOUCH_HELD_TIMEOUT_MS);
+static lv_indev_drv_t indev_drv; // LVGL keeps a pointer to it
+
 bool example_lvgl_lock(int timeout_ms) {
   assert(lvgl_mux && "LVGL mutex not initialized");
   if (xSemaphoreTake(lvgl_mux, pdMS_TO_TICKS(timeout_ms)) == pdTRUE) {
@@ -44,6 +137,153 @@ void example_lvgl_unlock(void) {
   xSemaphoreGive(lvgl_mux);
 }
 
+void main_gui_get_flush_stats(main_gui_flush_stats_t *out) {
+  *out = flush_stats;
+}
+
+// Called with the last band of each frame done
+static void flush_stats_frame_done(int64_t now_us) {
+  static bool first_frame_logged = false;
+  if (!first_frame_logged) {
+    first_frame_logged = true; // The gauge page is the first screen shown
+    ESP_LOGI(TAG, "First frame on the panel %lld ms after boot",
+             (long long)(now_us / 1000));
+  }
+  flush_acc.frames++;
+  flush_acc.frame_us += now_us - flush_acc.frame_start_us;
+  perf_monitor_flush_done(flush_acc.frame_start_us, now_us);
+  flush_acc.in_frame = false;
+
+  int64_t window_us = now_us - flush_acc.window_start_us;
+  if (window_us < FLUSH_STATS_WINDOW_US)
+    return;
+
+  uint32_t n = flush_acc.frames;
+  flush_stats.fps = (float)n * 1e6f / (float)window_us;
+  flush_stats.frame_ms = (float)flush_acc.frame_us / (float)n / 1000.0f;
+  flush_stats.ppa_ms = (float)flush_acc.ppa_us / (float)n / 1000.0f;
+  flush_stats.wait_ms = (float)flush_acc.wait_us / (float)n / 1000.0f;
+  flush_stats.bands = (float)flush_acc.bands / (float)n;
+  ESP_LOGI(TAG,
+           "Flush %s: %.1f fps, frame %.2f ms, PPA %.2f ms, LVGL waited "
+           "%.2f ms, %.1f bands/frame",
+           FLUSH_MODE_NAME, flush_stats.fps, flush_stats.frame_ms,
+           flush_stats.ppa_ms, flush_stats.wait_ms, flush_stats.bands);
+
+  memset(&flush_acc, 0, sizeof(flush_acc));
+  flush_acc.window_start_us = now_us;
+}
+
+#if !CONFIG_DISPLAY_FLUSH_BLOCKING
+static bool IRAM_ATTR ppa_done_cb(ppa_client_handle_t client,
+                                  ppa_event_data_t *event, void *user_data) {
+  lv_disp_drv_t *drv = user_data;
+  int64_t now_us = esp_timer_get_time();
+  flush_acc.ppa_us += now_us - flush_acc.band_submit_us;
+
+  BaseType_t woken = pdFALSE;
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+  // The last band is released by the flush after the swap
+  if (!lv_disp_flush_is_last(drv))
+    lv_disp_flush_ready(drv);
+  __atomic_fetch_add(&bands_done, 1, __ATOMIC_RELEASE);
+#else
+  if (lv_disp_flush_is_last(drv)) {
+    flush_acc.frame_done_us = now_us;
+    flush_acc.frame_done = true; // Accounted by the next flush
+  }
+  lv_disp_flush_ready(drv);
+#endif
+  xSemaphoreGiveFromISR(band_done_sem, &woken);
+  return woken == pdTRUE;
+}
+
+// LVGL spins on wait_cb while the other draw buffer is still being
+// flushed; block on the PPA interrupt instead
+static void flush_wait_cb(lv_disp_drv_t *drv) {
+  int64_t t0 = esp_timer_get_time();
+  xSemaphoreTake(band_done_sem, pdMS_TO_TICKS(FLUSH_EVENT_TIMEOUT_MS));
+  int64_t waited_us = esp_timer_get_time() - t0;
+  flush_acc.wait_us += waited_us;
+  perf_monitor_flush_wait((uint32_t)waited_us);
+}
+#endif
+
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+// DSI interrupts are IRAM-safe in this build (CONFIG_LCD_DSI_ISR_IRAM_SAFE)
+static bool IRAM_ATTR vsync_cb(esp_lcd_panel_handle_t p,
+                     esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx) {
+  BaseType_t woken = pdFALSE;
+  xSemaphoreGiveFromISR(vsync_sem, &woken);
+  return woken == pdTRUE;
+}
+
+// Unrotated PPA copy of one rectangle between the two framebuffers
+static void fb_copy_rect(void *dst, const void *src, const fb_rect_t *r) {
+  ppa_srm_oper_config_t copy = {
+      .in.buffer = src,
+      .in.pic_w = LCD_PHYS_H_RES,
+      .in.pic_h = LCD_PHYS_V_RES,
+      .in.block_w = r->w,
+      .in.block_h = r->h,
+      .in.block_offset_x = r->x,
+      .in.block_offset_y = r->y,
+      .in.srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+
+      .out.buffer = dst,
+      .out.buffer_size = LCD_PHYS_H_RES * LCD_PHYS_V_RES * FB_BYTES_PER_PIXEL,
+      .out.pic_w = LCD_PHYS_H_RES,
+      .out.pic_h = LCD_PHYS_V_RES,
+      .out.block_offset_x = r->x,
+      .out.block_offset_y = r->y,
+      .out.srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+
+      .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+      .scale_x = 1.0,
+      .scale_y = 1.0,
+      .mode = PPA_TRANS_MODE_BLOCKING,
+  };
+  ppa_do_scale_rotate_mirror(ppa_copy_handle, &copy);
+}
+
+// First band of a frame: wait until the previous swap is on screen, then
+// bring the new back buffer up to date
+static void begin_back_frame(void) {
+  if (!swap_pending)
+    return;
+  xSemaphoreTake(vsync_sem, pdMS_TO_TICKS(FLUSH_EVENT_TIMEOUT_MS));
+  swap_pending = false;
+
+  const void *front = dsi_fbs[back_fb ^ 1];
+  if (frame_full) {
+    fb_rect_t all = {0, 0, LCD_PHYS_H_RES, LCD_PHYS_V_RES};
+    fb_copy_rect(dsi_fbs[back_fb], front, &all);
+  } else {
+    for (int i = 0; i < frame_rect_count; i++)
+      fb_copy_rect(dsi_fbs[back_fb], front, &frame_rects[i]);
+  }
+  frame_rect_count = 0;
+  frame_full = false;
+}
+
+static void note_frame_rect(int x, int y, int w, int h) {
+  if (frame_rect_count < SYNC_MAX_RECTS)
+    frame_rects[frame_rect_count++] = (fb_rect_t){x, y, w, h};
+  else
+    frame_full = true;
+}
+
+// Last band rotated: show the back buffer from the next vsync on
+static void swap_frame(void) {
+  xSemaphoreTake(vsync_sem, 0); // Only a vsync after the swap counts
+  esp_lcd_panel_draw_bitmap(panel, 0, 0, LCD_PHYS_H_RES, LCD_PHYS_V_RES,
+                            dsi_fbs[back_fb]);
+  swap_pending = true;
+  back_fb ^= 1;
+  dsi_fb = dsi_fbs[back_fb];
+}
+#endif
+
 // LVGL flush callback using PPA for hardware rotation
 static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
                            lv_color_t *color_map) {
@@ -60,6 +300,26 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
   int phys_x = offsety1;
   int phys_y = LCD_PHYS_V_RES - 1 - offsetx2;
 
+  int64_t now_us = esp_timer_get_time();
+  if (flush_acc.frame_done) {
+    flush_acc.frame_done = false;
+    flush_stats_frame_done(flush_acc.frame_done_us);
+  }
+  if (!flush_acc.in_frame) {
+    flush_acc.in_frame = true;
+    flush_acc.frame_start_us = now_us;
+    if (flush_acc.window_start_us == 0)
+      flush_acc.window_start_us = now_us;
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+    begin_back_frame();
+#endif
+  }
+  flush_acc.bands++;
+
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+  note_frame_rect(phys_x, phys_y, h, w);
+#endif
+
   ppa_srm_oper_config_t srm_config = {
       .in.buffer = color_map,
       .in.pic_w = w,
@@ -70,7 +330,8 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
       .in.block_offset_y = 0,
       .in.srm_cm = PPA_SRM_COLOR_MODE_RGB565,
 
-      .out.buffer = dsi_fb + (phys_y * LCD_PHYS_H_RES + phys_x) * 2,
+      .out.buffer =
+          dsi_fb + (phys_y * LCD_PHYS_H_RES + phys_x) * FB_BYTES_PER_PIXEL,
       .out.pic_w = LCD_PHYS_H_RES,
       .out.pic_h = LCD_PHYS_V_RES,
       .out.block_offset_x = 0,
@@ -80,21 +341,73 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
       .rotation_angle = PPA_SRM_ROTATION_ANGLE_90,
       .scale_x = 1.0,
       .scale_y = 1.0,
+#if CONFIG_DISPLAY_FLUSH_BLOCKING
       .mode = PPA_TRANS_MODE_BLOCKING,
+#else
+      .mode = PPA_TRANS_MODE_NON_BLOCKING,
+      .user_data = drv,
+#endif
   };
 
+  flush_acc.band_submit_us = now_us;
+#if CONFIG_DISPLAY_FLUSH_BLOCKING
   ppa_do_scale_rotate_mirror(ppa_srm_handle, &srm_config);
-
+  int64_t done_us = esp_timer_get_time();
+  flush_acc.ppa_us += done_us - now_us;
+  flush_acc.wait_us += done_us - now_us;
+  perf_monitor_flush_wait((uint32_t)(done_us - now_us));
+  if (lv_disp_flush_is_last(drv))
+    flush_stats_frame_done(done_us);
   lv_disp_flush_ready(drv);
+#else
+  if (ppa_do_scale_rotate_mirror(ppa_srm_handle, &srm_config) != ESP_OK) {
+    lv_disp_flush_ready(drv); // Drop the band rather than stall LVGL
+    return;
+  }
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+  bands_submitted++;
+  if (lv_disp_flush_is_last(drv)) {
+    // The frame is complete once every band submitted so far has landed
+    int64_t t0 = esp_timer_get_time();
+    while ((int32_t)(__atomic_load_n(&bands_done, __ATOMIC_ACQUIRE) -
+                     bands_submitted) < 0) {
+      if (xSemaphoreTake(band_done_sem,
+                         pdMS_TO_TICKS(FLUSH_EVENT_TIMEOUT_MS)) != pdTRUE) {
+        // Lost interrupt: resync so later frames do not wait on it too
+        bands_submitted = __atomic_load_n(&bands_done, __ATOMIC_ACQUIRE);
+        break;
+      }
+    }
+    int64_t done_us = esp_timer_get_time();
+    flush_acc.wait_us += done_us - t0;
+    perf_monitor_flush_wait((uint32_t)(done_us - t0));
+    swap_frame();
+    flush_stats_frame_done(done_us);
+    lv_disp_flush_ready(drv);
+  }
+#endif
+#endif
 }
 
 static void lvgl_tick_cb(void *arg) { lv_tick_inc(LVGL_TICK_MS); }
 
+// Render profiling hooks (no-ops unless the performance HUD is shown)
+static void render_start_cb(lv_disp_drv_t *drv) { perf_monitor_render_start(); }
+
+static void render_monitor_cb(lv_disp_drv_t *drv, uint32_t time_ms,
+                              uint32_t px) {
+  perf_monitor_render_done(px);
+}
+
 static void lvgl_port_task(void *arg) {
   ESP_LOGI(TAG, "Starting LVGL task");
   while (1) {
     if (example_lvgl_lock(100)) {
+      bool profile = perf_monitor_enabled();
+      int64_t t0 = profile ? esp_timer_get_time() : 0;
       uint32_t delay_ms = lv_timer_handler();
+      if (profile)
+        perf_monitor_handler_done((uint32_t)(esp_timer_get_time() - t0));
       example_lvgl_unlock();
       vTaskDelay(pdMS_TO_TICKS(delay_ms));
     } else {
@@ -103,22 +416,137 @@ static void lvgl_port_task(void *arg) {
   }
 }
 
-// Touchscreen read callback
-static void touch_callback(lv_indev_drv_t *drv, lv_indev_data_t *data) {
-  esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)drv->user_data;
-  uint16_t x[1], y[1];
-  uint8_t cnt;
+// Touch INT: only wakes the reader task, the I2C read happens there
+static void IRAM_ATTR touch_isr(esp_lcd_touch_handle_t tp) {
+  BaseType_t woken = pdFALSE;
+  if (touch_task_handle)
+    vTaskNotifyGiveFromISR(touch_task_handle, &woken);
+  portYIELD_FROM_ISR(woken);
+}
 
-  esp_lcd_touch_read_data(tp);
-  bool touched = esp_lcd_touch_get_coordinates(tp, x, y, NULL, &cnt, 1);
+static void touch_publish(const main_gui_touch_t *t) {
+  __atomic_store_n(&touch_seq, touch_seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  touch_box = *t;
+  __atomic_store_n(&touch_seq, touch_seq + 1, __ATOMIC_RELEASE);
+}
 
-  if (touched && cnt > 0) {
-    data->point.x = x[0];
-    data->point.y = y[0];
-    data->state = LV_INDEV_STATE_PRESSED;
-  } else {
-    data->state = LV_INDEV_STATE_RELEASED;
+bool main_gui_get_touch(main_gui_touch_t *out) {
+  if (!touch_ready)
+    return false;
+  for (int attempt = 0; attempt < 4; attempt++) {
+    uint32_t before = __atomic_load_n(&touch_seq, __ATOMIC_ACQUIRE);
+    if (before & 1u)
+      continue;
+    *out = touch_box;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&touch_seq, __ATOMIC_RELAXED) == before)
+      return true;
   }
+  return false;
+}
+
+// One finger, lifted: a short touch that stayed put is a tap, a quick
+// mostly straight stroke a swipe along its longer axis
+static main_gui_gesture_t classify_gesture(main_gui_touch_point_t from,
+                                           main_gui_touch_point_t to,
+                                           int64_t duration_us) {
+  int dx = (int)to.x - from.x;
+  int dy = (int)to.y - from.y;
+  int adx = abs(dx), ady = abs(dy);
+  int64_t ms = duration_us / 1000;
+
+  if (adx <= TOUCH_TAP_SLOP_PX && ady <= TOUCH_TAP_SLOP_PX &&
+      ms <= TOUCH_TAP_MAX_MS)
+    return MAIN_GUI_GESTURE_TAP;
+  if (ms > TOUCH_SWIPE_MAX_MS || (adx < TOUCH_SWIPE_MIN_PX &&
+                                  ady < TOUCH_SWIPE_MIN_PX))
+    return MAIN_GUI_GESTURE_NONE;
+  if (adx >= ady)
+    return dx < 0 ? MAIN_GUI_GESTURE_SWIPE_LEFT : MAIN_GUI_GESTURE_SWIPE_RIGHT;
+  return dy < 0 ? MAIN_GUI_GESTURE_SWIPE_UP : MAIN_GUI_GESTURE_SWIPE_DOWN;
+}
+
+// Reads the controller when it has a report and publishes every point. The
+// I2C bus is shared with the backlight and the codec, so it is only touched
+// when INT says there is something to read, and never under the LVGL lock.
+static void touch_task(void *arg) {
+  esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)arg;
+  bool irq = TOUCH_INT_IO >= 0;
+  main_gui_touch_t t = {0};
+  main_gui_touch_point_t start = {0};
+  int64_t start_us = 0;
+  bool multi = false; // More than one finger since the press: no gesture
+
+  while (1) {
+    if (irq) {
+      // A held touch is re-read when INT goes quiet, so a missed release
+      // edge cannot leave LVGL pressed
+      ulTaskNotifyTake(pdTRUE, t.count ? touch_held_wait : portMAX_DELAY);
+    } else {
+      vTaskDelay(pdMS_TO_TICKS(TOUCH_POLL_MS));
+    }
+    if (esp_lcd_touch_read_data(tp) != ESP_OK)
+      continue;
+
+    uint16_t x[MAIN_GUI_TOUCH_MAX_POINTS], y[MAIN_GUI_TOUCH_MAX_POINTS];
+    uint16_t strength[MAIN_GUI_TOUCH_MAX_POINTS];
+    uint8_t cnt = 0;
+    if (!esp_lcd_touch_get_coordinates(tp, x, y, strength, &cnt,
+                                       MAIN_GUI_TOUCH_MAX_POINTS))
+      cnt = 0;
+    if (cnt == 0 && t.count == 0)
+      continue; // Still released: nothing to publish
+
+    int64_t now_us = esp_timer_get_time();
+    bool pressed = cnt > 0 && t.count == 0;
+    bool released = cnt == 0;
+    // On release the points keep the last position for LVGL
+    for (uint8_t i = 0; i < cnt; i++) {
+      t.points[i].x = x[i];
+      t.points[i].y = y[i];
+      t.points[i].strength = strength[i];
+    }
+    if (pressed) {
+      t.presses++;
+      start = t.points[0];
+      start_us = now_us;
+      multi = false;
+    }
+    multi |= cnt > 1;
+    if (released && !multi) {
+      main_gui_gesture_t g =
+          classify_gesture(start, t.points[0], now_us - start_us);
+      if (g != MAIN_GUI_GESTURE_NONE) {
+        t.gesture = g;
+        t.gestures++;
+      }
+    }
+    t.count = cnt;
+    t.stamp_us = now_us;
+    touch_publish(&t);
+  }
+}
+
+// Touchscreen read callback: consumes the mailbox, no bus access
+static void touch_callback(lv_indev_drv_t *drv, lv_indev_data_t *data) {
+  static uint32_t seen_presses = 0;
+  static lv_point_t point;
+  static lv_indev_state_t state = LV_INDEV_STATE_RELEASED;
+  main_gui_touch_t t;
+  // A read that lost the race with the writer repeats the last state, so a
+  // drag does not see a spurious release
+  if (main_gui_get_touch(&t)) {
+    point.x = t.points[0].x;
+    point.y = t.points[0].y;
+    // A tap that came and went between two reads still reaches LVGL as one
+    // pressed read; the release follows on the next
+    bool pressed = t.count > 0 || t.presses != seen_presses;
+    seen_presses = t.presses;
+    state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+  }
+  data->point = point;
+  data->state = state;
 }
 
 static bool i2c_probe(uint8_t addr) {
@@ -143,10 +571,11 @@ esp_err_t main_gui_init(esp_lcd_panel_handle_t panel_handle) {
 
   // 1. Initialize LVGL
   lv_init();
+  perf_monitor_init();
 
   // 2. Allocate draw buffers
   // Use internal RAM for speed if possible
-  size_t buf_size = LCD_H_RES * 100 * sizeof(lv_color_t);
+  size_t buf_size = LCD_H_RES * DRAW_BUF_LINES * sizeof(lv_color_t);
   lv_color_t *buf1 =
       heap_caps_malloc(buf_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
   lv_color_t *buf2 =
@@ -158,29 +587,72 @@ esp_err_t main_gui_init(esp_lcd_panel_handle_t panel_handle) {
   ESP_LOGI(TAG, "LVGL using fast internal DMA RAM: 2 x %d KB",
            (int)(buf_size / 1024));
 
-  lv_disp_draw_buf_init(&disp_buf, buf1, buf2, LCD_H_RES * 100);
+  lv_disp_draw_buf_init(&disp_buf, buf1, buf2, LCD_H_RES * DRAW_BUF_LINES);
 
   // 3. Initialize Display Driver
   lv_disp_drv_init(&disp_drv);
   disp_drv.hor_res = LCD_H_RES;
   disp_drv.ver_res = LCD_V_RES;
   disp_drv.flush_cb = flush_callback;
+#if !CONFIG_DISPLAY_FLUSH_BLOCKING
+  disp_drv.wait_cb = flush_wait_cb;
+#endif
+  disp_drv.render_start_cb = render_start_cb;
+  disp_drv.monitor_cb = render_monitor_cb;
   disp_drv.draw_buf = &disp_buf;
   disp_drv.user_data = panel_handle;
   lv_disp_drv_register(&disp_drv);
 
   // 4. Initialize PPA for hardware rotation
   // For DPI panels, we get the framebuffer using DPI specific call
+  band_done_sem = xSemaphoreCreateBinary();
+  if (!band_done_sem) {
+    ESP_LOGE(TAG, "Failed to create flush semaphore");
+    return ESP_ERR_NO_MEM;
+  }
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+  panel = panel_handle;
+  ESP_ERROR_CHECK(esp_lcd_dpi_panel_get_frame_buffer(panel_handle, 2,
+                                                     &dsi_fbs[0], &dsi_fbs[1]));
+  // fb0 is on screen after init; draw into fb1 first
+  back_fb = 1;
+  dsi_fb = dsi_fbs[back_fb];
+  vsync_sem = xSemaphoreCreateBinary();
+  if (!vsync_sem) {
+    ESP_LOGE(TAG, "Failed to create vsync semaphore");
+    return ESP_ERR_NO_MEM;
+  }
+  esp_lcd_dpi_panel_event_callbacks_t dpi_cbs = {
+      .on_refresh_done = vsync_cb,
+  };
+  ESP_ERROR_CHECK(
+      esp_lcd_dpi_panel_register_event_callbacks(panel_handle, &dpi_cbs, NULL));
+  ESP_LOGI(TAG, "DPI Framebuffers @%p / @%p, swapped at vsync", dsi_fbs[0],
+           dsi_fbs[1]);
+#else
   uint32_t fb_num = 1;
   ESP_ERROR_CHECK(
       esp_lcd_dpi_panel_get_frame_buffer(panel_handle, fb_num, &dsi_fb));
   ESP_LOGI(TAG, "DPI Framebuffer(s) found. Using base @%p", dsi_fb);
+#endif
 
   ppa_client_config_t ppa_cfg = {
       .oper_type = PPA_OPERATION_SRM,
+      .max_pending_trans_num = 1, // LVGL has one band in flight at a time
   };
   ESP_ERROR_CHECK(ppa_register_client(&ppa_cfg, &ppa_srm_handle));
-  ESP_LOGI(TAG, "PPA SRM client registered");
+#if CONFIG_DISPLAY_FLUSH_DOUBLE_FB
+  ESP_ERROR_CHECK(ppa_register_client(&ppa_cfg, &ppa_copy_handle));
+#endif
+#if !CONFIG_DISPLAY_FLUSH_BLOCKING
+  ppa_event_callbacks_t ppa_cbs = {
+      .on_trans_done = ppa_done_cb,
+  };
+  ESP_ERROR_CHECK(
+      ppa_client_register_event_callbacks(ppa_srm_handle, &ppa_cbs));
+#endif
+  ESP_LOGI(TAG, "PPA SRM client registered, %s flush, %d-line bands",
+           FLUSH_MODE_NAME, DRAW_BUF_LINES);
 
   // 5. Initialize Touchscreen
   ESP_LOGI(TAG, "Initializing touchscreen...");
@@ -210,7 +682,8 @@ esp_err_t main_gui_init(esp_lcd_panel_handle_t panel_handle) {
           .x_max = LCD_H_RES,
           .y_max = LCD_V_RES,
           .rst_gpio_num = -1, // Reset handled in main.c
-          .int_gpio_num = -1,
+          .int_gpio_num = TOUCH_INT_IO,
+          .interrupt_callback = touch_isr,
           .flags =
               {
                   .swap_xy = 0,
@@ -233,24 +706,41 @@ esp_err_t main_gui_init(esp_lcd_panel_handle_t panel_handle) {
           .x_max = LCD_H_RES,
           .y_max = LCD_V_RES,
           .rst_gpio_num = -1,
-          .int_gpio_num = -1,
+          .int_gpio_num = TOUCH_INT_IO,
+          .interrupt_callback = touch_isr,
       };
       if (esp_lcd_touch_new_i2c_ft5x06(tp_io_handle, &tp_cfg, &tp_handle) ==
           ESP_OK) {
+        // The default mode holds INT low while touched, one edge per touch
+        uint8_t mode = 1;
+        if (esp_lcd_panel_io_tx_param(tp_io_handle, FT5x06_REG_G_MODE, &mode,
+                                      1) != ESP_OK) {
+          ESP_LOGW(TAG, "FT5x06 INT mode not set, polling held touches");
+          touch_held_wait = pdMS_TO_TICKS(TOUCH_POLL_MS);
+        }
         touch_found = true;
       }
     }
   }
 
+  if (touch_found &&
+      xTaskCreatePinnedToCore(touch_task, "touch", TOUCH_TASK_STACK_SIZE,
+                              tp_handle, TOUCH_TASK_PRIORITY,
+                              &touch_task_handle, 0) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create touch task");
+    touch_found = false;
+  }
+
   if (touch_found) {
-    lv_indev_drv_t indev_drv;
+    touch_ready = true;
     lv_indev_drv_init(&indev_drv);
     indev_drv.type = LV_INDEV_TYPE_POINTER;
     indev_drv.disp = lv_disp_get_default();
     indev_drv.read_cb = touch_callback;
-    indev_drv.user_data = tp_handle;
-    lv_indev_drv_register(&indev_drv);
-    ESP_LOGI(TAG, "Touchscreen registered successfully");
+    lv_indev_t *indev = lv_indev_drv_register(&indev_drv);
+    lv_timer_set_period(indev->driver->read_timer, TOUCH_READ_PERIOD_MS);
+    ESP_LOGI(TAG, "Touchscreen registered successfully (%s)",
+             TOUCH_INT_IO >= 0 ? "INT driven" : "polled");
   } else {
     ESP_LOGW(TAG,
              "Touchscreen not detected - continuing without touch support");
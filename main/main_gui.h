@@ -2,6 +2,8 @@
 
 #include "esp_err.h"
 #include "esp_lcd_panel_ops.h"
+#include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief Initialize LVGL and the UI
@@ -11,6 +13,54 @@
  */
 esp_err_t main_gui_init(esp_lcd_panel_handle_t panel_handle);
 
+/**
+ * @brief Display flush timing, averaged per frame over the last window
+ */
+typedef struct {
+  const char *mode; // "blocking", "async" or "double-fb"
+  float fps;        // Frames flushed per second
+  float frame_ms;   // First band submitted -> last band on the framebuffer
+  float ppa_ms;     // PPA rotation time, summed over the bands
+  float wait_ms;    // Time LVGL was blocked waiting for the flush
+  float bands;      // Bands (PPA jobs) per frame
+} main_gui_flush_stats_t;
+
+void main_gui_get_flush_stats(main_gui_flush_stats_t *out);
+
+// GT911 and FT5x06 both report up to five points
+#define MAIN_GUI_TOUCH_MAX_POINTS 5
+
+typedef struct {
+  uint16_t x, y;
+  uint16_t strength;
+} main_gui_touch_point_t;
+
+// Classified when the last finger lifts
+typedef enum {
+  MAIN_GUI_GESTURE_NONE = 0,
+  MAIN_GUI_GESTURE_TAP,
+  MAIN_GUI_GESTURE_SWIPE_LEFT,
+  MAIN_GUI_GESTURE_SWIPE_RIGHT,
+  MAIN_GUI_GESTURE_SWIPE_UP,
+  MAIN_GUI_GESTURE_SWIPE_DOWN,
+} main_gui_gesture_t;
+
+/**
+ * @brief Latest touch report, published by the touch task
+ */
+typedef struct {
+  uint8_t count; // Points down, 0 = released (points[0] keeps the last one)
+  main_gui_touch_point_t points[MAIN_GUI_TOUCH_MAX_POINTS];
+  uint32_t presses; // Released -> pressed transitions since boot
+  int64_t stamp_us; // When the report was read from the controller
+  main_gui_gesture_t gesture; // Of the last completed touch
+  uint32_t gestures;          // Bumped with each classified gesture
+} main_gui_touch_t;
+
+// Lock-free copy of the latest report, for LVGL and gesture code alike.
+// False without a touchscreen, or if the writer kept it busy.
+bool main_gui_get_touch(main_gui_touch_t *out);
+
 // LVGL Locking mechanism for FreeRTOS tasks
 bool example_lvgl_lock(int timeout_ms);
 void example_lvgl_unlock(void);
@@ -0,0 +1,282 @@
+#include "perf_monitor.h"
+#include "background_task.h"
+#include "can_logger.h"
+#include "can_manager.h"
+#include "can_sniffer.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "PERF";
+
+// Task slots queried from FreeRTOS per sample
+#define TASK_QUERY_SLOTS 40
+
+bool perf_monitor_active = false;
+
+// Frame being assembled; LVGL task only
+static struct {
+  int64_t render_start_us;
+  uint32_t wait_us;
+  uint32_t render_us;
+  uint32_t area_px;
+  uint32_t flush_us;
+  uint16_t obj_count;
+  bool rendered;
+  int64_t mark_sample_us; // Pending latency mark, 0 = none
+  int64_t mark_us;        // When it was marked
+  uint32_t latency_us;
+} cur;
+
+// History ring: the LVGL task writes, readers copy and retry if `seq`
+// moved (odd while a frame is being stored)
+static perf_frame_t history[PERF_HISTORY_FRAMES];
+static uint32_t history_head = 0; // Frames stored since enabling
+static uint32_t seq = 0;
+
+// System sample, shared by the HUD and the API
+static SemaphoreHandle_t sample_lock = NULL;
+static perf_system_t last_sample;
+static int64_t last_sample_us = 0;
+static uint32_t last_can_total = 0;
+static uint32_t last_frames = 0;
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+static TaskStatus_t *task_status = NULL;
+static struct {
+  UBaseType_t number;
+  configRUN_TIME_COUNTER_TYPE runtime;
+} prev_runtime[TASK_QUERY_SLOTS];
+static int prev_count = 0;
+static configRUN_TIME_COUNTER_TYPE prev_total = 0;
+#endif
+
+void perf_monitor_init(void) {
+  if (!sample_lock)
+    sample_lock = xSemaphoreCreateMutex();
+}
+
+void perf_monitor_set_enabled(bool enabled) {
+  if (enabled && !perf_monitor_enabled()) {
+    memset(&cur, 0, sizeof(cur));
+    __atomic_store_n(&seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&history_head, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&seq, seq + 1, __ATOMIC_RELEASE);
+  }
+  __atomic_store_n(&perf_monitor_active, enabled, __ATOMIC_RELAXED);
+  ESP_LOGI(TAG, "Profiling %s", enabled ? "on" : "off");
+}
+
+// --- Hooks ---
+
+void perf_monitor_render_start(void) {
+  if (!perf_monitor_enabled())
+    return;
+  cur.render_start_us = esp_timer_get_time();
+  cur.wait_us = 0;
+}
+
+void perf_monitor_render_done(uint32_t area_px) {
+  if (!perf_monitor_enabled() || cur.render_start_us == 0)
+    return;
+  uint32_t elapsed = (uint32_t)(esp_timer_get_time() - cur.render_start_us);
+  cur.render_us = elapsed > cur.wait_us ? elapsed - cur.wait_us : 0;
+  cur.area_px += area_px;
+  cur.rendered = true;
+}
+
+void perf_monitor_flush_wait(uint32_t us) {
+  if (perf_monitor_enabled())
+    cur.wait_us += us;
+}
+
+void perf_monitor_flush_done(int64_t start_us, int64_t done_us) {
+  if (!perf_monitor_enabled())
+    return;
+  cur.flush_us = (uint32_t)(done_us - start_us);
+  // Rendering runs on the LVGL task, as do the marks: a mark older than
+  // the frame's first band was rendered into this frame
+  if (cur.mark_sample_us != 0 && cur.mark_us < start_us) {
+    cur.latency_us = (uint32_t)(done_us - cur.mark_sample_us);
+    cur.mark_sample_us = 0;
+  }
+}
+
+void perf_monitor_latency_mark(int64_t sample_us) {
+  // Keep the oldest unshown update: that is the latency the driver sees
+  if (!perf_monitor_enabled() || cur.mark_sample_us != 0 || sample_us == 0)
+    return;
+  cur.mark_sample_us = sample_us;
+  cur.mark_us = esp_timer_get_time();
+}
+
+void perf_monitor_set_obj_count(uint16_t count) { cur.obj_count = count; }
+
+void perf_monitor_handler_done(uint32_t handler_us) {
+  if (!perf_monitor_enabled() || !cur.rendered)
+    return;
+
+  perf_frame_t f = {
+      .t_ms = (uint32_t)(esp_timer_get_time() / 1000),
+      .render_us = cur.render_us,
+      .flush_us = cur.flush_us,
+      .area_px = cur.area_px,
+      .handler_us = handler_us,
+      .obj_count = cur.obj_count,
+      .latency_us = cur.latency_us,
+  };
+  cur.rendered = false;
+  cur.area_px = 0;
+  cur.latency_us = 0;
+
+  uint32_t head = history_head;
+  __atomic_store_n(&seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  history[head % PERF_HISTORY_FRAMES] = f;
+  __atomic_store_n(&history_head, head + 1, __ATOMIC_RELEASE);
+  __atomic_store_n(&seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+// --- Readers ---
+
+int perf_monitor_get_history(perf_frame_t *out, int max) {
+  for (int attempt = 0; attempt < 4; attempt++) {
+    uint32_t before = __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+    if (before & 1u)
+      continue;
+    uint32_t head = __atomic_load_n(&history_head, __ATOMIC_ACQUIRE);
+    uint32_t n = head < PERF_HISTORY_FRAMES ? head : PERF_HISTORY_FRAMES;
+    if (n > (uint32_t)max)
+      n = (uint32_t)max;
+    for (uint32_t i = 0; i < n; i++)
+      out[i] = history[(head - n + i) % PERF_HISTORY_FRAMES];
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&seq, __ATOMIC_RELAXED) == before)
+      return (int)n;
+  }
+  return 0;
+}
+
+bool perf_monitor_get_last_frame(perf_frame_t *out) {
+  return perf_monitor_get_history(out, 1) == 1;
+}
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+static configRUN_TIME_COUNTER_TYPE prev_task_runtime(UBaseType_t number) {
+  for (int i = 0; i < prev_count; i++) {
+    if (prev_runtime[i].number == number)
+      return prev_runtime[i].runtime;
+  }
+  return 0; // New task: count it from creation
+}
+
+static int sample_tasks(perf_task_t *out) {
+  if (!task_status)
+    task_status = malloc(TASK_QUERY_SLOTS * sizeof(*task_status));
+  if (!task_status)
+    return 0;
+
+  configRUN_TIME_COUNTER_TYPE total;
+  int n = (int)uxTaskGetSystemState(task_status, TASK_QUERY_SLOTS, &total);
+  configRUN_TIME_COUNTER_TYPE span = total - prev_total;
+
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    const TaskStatus_t *s = &task_status[i];
+    configRUN_TIME_COUNTER_TYPE delta =
+        s->ulRunTimeCounter - prev_task_runtime(s->xTaskNumber);
+    uint32_t pct = span ? (uint32_t)((uint64_t)delta * 100 / span) : 0;
+
+    perf_task_t t = {.cpu_pct = (uint8_t)(pct > 100 ? 100 : pct)};
+    strncpy(t.name, s->pcTaskName, sizeof(t.name) - 1);
+#if configTASKLIST_INCLUDE_COREID
+    t.core = (s->xCoreID == tskNO_AFFINITY) ? 2 : (uint8_t)s->xCoreID;
+#else
+    t.core = 2;
+#endif
+
+    // Insert busiest first, keeping the top PERF_MAX_TASKS
+    int pos = count;
+    while (pos > 0 && out[pos - 1].cpu_pct < t.cpu_pct)
+      pos--;
+    if (pos < PERF_MAX_TASKS) {
+      int tail = count < PERF_MAX_TASKS ? count : PERF_MAX_TASKS - 1;
+      memmove(&out[pos + 1], &out[pos], (tail - pos) * sizeof(*out));
+      out[pos] = t;
+      if (count < PERF_MAX_TASKS)
+        count++;
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    prev_runtime[i].number = task_status[i].xTaskNumber;
+    prev_runtime[i].runtime = task_status[i].ulRunTimeCounter;
+  }
+  prev_count = n;
+  prev_total = total;
+  return count;
+}
+#endif
+
+void perf_monitor_sample_system(perf_system_t *out) {
+  xSemaphoreTake(sample_lock, portMAX_DELAY);
+
+  int64_t now_us = esp_timer_get_time();
+  int64_t elapsed_us = now_us - last_sample_us;
+  if (last_sample_us == 0 || elapsed_us >= PERF_SYSTEM_PERIOD_MS * 1000) {
+    perf_system_t *s = &last_sample;
+    uint32_t can_total = can_sniffer_get_total();
+    uint32_t frames = __atomic_load_n(&history_head, __ATOMIC_ACQUIRE);
+    float secs = (float)elapsed_us / 1e6f;
+    bool have_window = last_sample_us != 0 && secs > 0.0f;
+
+    s->t_ms = (uint32_t)(now_us / 1000);
+    s->fps = (have_window && frames >= last_frames)
+                 ? (float)(frames - last_frames) / secs
+                 : 0.0f;
+    s->can_fps =
+        have_window ? (float)(can_total - last_can_total) / secs : 0.0f;
+    last_can_total = can_total;
+    last_frames = frames;
+
+    UBaseType_t bg = 0;
+    background_task_get_status(&bg);
+    s->bg_pending = (uint16_t)bg;
+    s->log_pending = (uint16_t)can_logger_get_queue_depth();
+    s->can_rx_pending = (uint16_t)can_manager_get_rx_pending();
+
+    s->internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    s->internal_min = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    s->psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+    s->task_count = sample_tasks(s->tasks);
+#else
+    s->task_count = 0;
+#endif
+    last_sample_us = now_us;
+  }
+  *out = last_sample;
+  xSemaphoreGive(sample_lock);
+}
+
+int perf_monitor_format_csv_header(char *buf, size_t size) {
+  return snprintf(buf, size,
+                  "t_ms,render_us,flush_us,area_px,handler_us,obj_count,"
+                  "latency_us\n");
+}
+
+int perf_monitor_format_csv_row(char *buf, size_t size,
+                                const perf_frame_t *f) {
+  return snprintf(buf, size, "%lu,%lu,%lu,%lu,%lu,%u,%lu\n",
+                  (unsigned long)f->t_ms, (unsigned long)f->render_us,
+                  (unsigned long)f->flush_us, (unsigned long)f->area_px,
+                  (unsigned long)f->handler_us, f->obj_count,
+                  (unsigned long)f->latency_us);
+}
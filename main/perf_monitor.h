@@ -0,0 +1,102 @@
+#ifndef PERF_MONITOR_H
+#define PERF_MONITOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-frame render profiler and system sampler behind the performance HUD
+// and /api/perf.
+//
+// The LVGL task and the flush path call the hooks below on every frame;
+// each returns after one flag test unless profiling is enabled. System
+// figures (CAN rate, queues, per-task CPU, heap) are sampled on demand,
+// at most once per PERF_SYSTEM_PERIOD_MS.
+
+#define PERF_HISTORY_FRAMES 256
+#define PERF_MAX_TASKS 24
+#define PERF_SYSTEM_PERIOD_MS 1000
+
+typedef struct {
+  uint32_t t_ms;       // Frame end (ms since boot)
+  uint32_t render_us;  // LVGL refresh, minus time blocked on the flush
+  uint32_t flush_us;   // Last completed flush: first band -> last band done
+  uint32_t area_px;    // Pixels redrawn
+  uint32_t handler_us; // lv_timer_handler() call that rendered the frame
+  uint16_t obj_count;  // Objects on the active screen and layers
+  uint32_t latency_us; // Last CAN update -> panel latency measured, 0 = none
+} perf_frame_t;
+
+typedef struct {
+  char name[16];
+  uint8_t core;    // 0/1, 2 = not pinned
+  uint8_t cpu_pct; // Share of one core over the last sample period
+} perf_task_t;
+
+typedef struct {
+  uint32_t t_ms;
+  float fps;       // Rendered frames per second
+  float can_fps;   // CAN frames ingested per second
+  uint16_t can_rx_pending;  // TWAI driver RX queue
+  uint16_t log_pending;     // SD logger queue
+  uint16_t bg_pending;      // Background task queue
+  uint32_t internal_free;   // Bytes
+  uint32_t internal_min;    // Low-water mark since boot
+  uint32_t psram_free;
+  int task_count;           // 0 without FreeRTOS run-time stats
+  perf_task_t tasks[PERF_MAX_TASKS]; // Busiest first
+} perf_system_t;
+
+void perf_monitor_init(void);
+
+// Profiling on/off (the HUD enables it while shown). Enabling clears the
+// frame history.
+void perf_monitor_set_enabled(bool enabled);
+
+static inline bool perf_monitor_enabled(void) {
+  extern bool perf_monitor_active;
+  return __atomic_load_n(&perf_monitor_active, __ATOMIC_RELAXED);
+}
+
+// --- Hooks (LVGL task / flush path) ---
+void perf_monitor_render_start(void);
+void perf_monitor_render_done(uint32_t area_px);
+void perf_monitor_flush_wait(uint32_t us);
+// Last band of a frame on the panel; the frame's first band was flushed at
+// start_us
+void perf_monitor_flush_done(int64_t start_us, int64_t done_us);
+void perf_monitor_handler_done(uint32_t handler_us);
+
+// A widget was invalidated to show data the ingest path published at
+// sample_us (the shift light). The first frame flushed after this reaches
+// the panel gives the CAN-to-pixels latency.
+void perf_monitor_latency_mark(int64_t sample_us);
+
+// Object count for the following frames (counted by the HUD under the
+// LVGL lock; walking the tree per frame would cost more than it reports)
+void perf_monitor_set_obj_count(uint16_t count);
+
+// --- Readers (any task) ---
+
+// Most recent frame; false if none since enabling
+bool perf_monitor_get_last_frame(perf_frame_t *out);
+
+// Frame history, oldest first. Returns the number written.
+int perf_monitor_get_history(perf_frame_t *out, int max);
+
+// System figures; recomputed if the last sample is older than the period
+void perf_monitor_sample_system(perf_system_t *out);
+
+// CSV header and one row per frame, for exporting the history
+int perf_monitor_format_csv_header(char *buf, size_t size);
+int perf_monitor_format_csv_row(char *buf, size_t size, const perf_frame_t *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PERF_MONITOR_H
@@ -19,7 +19,9 @@
 #define SD_PIN_D3 44
 #define SD_FREQ_KHZ SDMMC_FREQ_DEFAULT // 20MHz for stability
 
+#ifndef SD_MOUNT_POINT // Overridden by the host build
 #define SD_MOUNT_POINT "/sdcard"
+#endif
 
 /**
  * @brief Initialize and mount SD card
@@ -0,0 +1,274 @@
+/*
+ * Session statistics and peak-hold for decoded ECU signals
+ * Tracks min/max (with time and operating point), running mean/variance and
+ * time over threshold per signal. Updates are O(1) per touched signal.
+ */
+
+#include "session_stats.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "SESSION_STATS";
+
+// Gaps longer than this (bus silent, logger paused) are not counted as time
+// over threshold.
+#define MAX_INTEGRATION_GAP_MS 1000
+
+static session_signal_stats_t stats[ECU_SIG_COUNT];
+static uint32_t session_start_ms = 0;
+static SemaphoreHandle_t stats_mutex = NULL;
+
+// Default thresholds, applied at init
+typedef struct {
+  ecu_signal_id_t sig;
+  session_thresh_dir_t dir;
+  float threshold;
+} default_threshold_t;
+
+static const default_threshold_t default_thresholds[] = {
+    {ECU_SIG_RPM, SESSION_THRESH_ABOVE, 6000.0f},
+    {ECU_SIG_MAP, SESSION_THRESH_ABOVE, 200.0f}, // ~1 bar boost
+    {ECU_SIG_CLT, SESSION_THRESH_ABOVE, 105.0f},
+    {ECU_SIG_IAT, SESSION_THRESH_ABOVE, 50.0f},
+    {ECU_SIG_OIL_TEMP, SESSION_THRESH_ABOVE, 130.0f},
+    {ECU_SIG_OIL_PRESS, SESSION_THRESH_BELOW, 100.0f},
+    {ECU_SIG_BATTERY, SESSION_THRESH_BELOW, 12.0f},
+};
+
+static inline uint32_t now_ms(void) {
+  return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static inline int32_t clamp_i32(float v, int32_t lo, int32_t hi) {
+  if (v <= (float)lo)
+    return lo;
+  if (v >= (float)hi)
+    return hi;
+  return (int32_t)lrintf(v);
+}
+
+static void capture_context(const ecu_data_t *d, session_context_t *ctx) {
+  ctx->rpm = (uint16_t)clamp_i32(d->engine_rpm, 0, UINT16_MAX);
+  ctx->speed_x10 = (uint16_t)clamp_i32(d->vehicle_speed * 10.0f, 0, UINT16_MAX);
+  ctx->map_x10 = (uint16_t)clamp_i32(d->map_kpa * 10.0f, 0, UINT16_MAX);
+  ctx->clt_x10 = (int16_t)clamp_i32(d->clt_temp * 10.0f, INT16_MIN, INT16_MAX);
+  ctx->iat_x10 = (int16_t)clamp_i32(d->iat_temp * 10.0f, INT16_MIN, INT16_MAX);
+  ctx->tps = (uint8_t)clamp_i32(d->tps_position, 0, UINT8_MAX);
+  ctx->gear = d->gear;
+}
+
+// Clear accumulated values of one entry, keeping its threshold config
+static void clear_entry(session_signal_stats_t *st) {
+  float threshold = st->threshold;
+  uint8_t dir = st->thresh_dir;
+  memset(st, 0, sizeof(*st));
+  st->threshold = threshold;
+  st->thresh_dir = dir;
+}
+
+void session_stats_init(void) {
+  if (stats_mutex == NULL) {
+    stats_mutex = xSemaphoreCreateMutex();
+  }
+
+  memset(stats, 0, sizeof(stats));
+  for (size_t i = 0;
+       i < sizeof(default_thresholds) / sizeof(default_thresholds[0]); i++) {
+    stats[default_thresholds[i].sig].thresh_dir = default_thresholds[i].dir;
+    stats[default_thresholds[i].sig].threshold =
+        default_thresholds[i].threshold;
+  }
+  session_start_ms = now_ms();
+
+  ESP_LOGI(TAG, "Session statistics initialized (%d signals)", ECU_SIG_COUNT);
+}
+
+void session_stats_reset(void) {
+  if (!stats_mutex)
+    return;
+
+  if (xSemaphoreTake(stats_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    for (int i = 0; i < ECU_SIG_COUNT; i++) {
+      clear_entry(&stats[i]);
+    }
+    session_start_ms = now_ms();
+    xSemaphoreGive(stats_mutex);
+    ESP_LOGI(TAG, "Session statistics reset");
+  }
+}
+
+void session_stats_update(const ecu_data_t *data, ecu_signal_mask_t touched) {
+  if (!data || !stats_mutex || touched == 0)
+    return;
+
+  uint32_t t = now_ms();
+
+  // Called from the CAN receive path: never wait long for a reader
+  if (xSemaphoreTake(stats_mutex, pdMS_TO_TICKS(5)) != pdTRUE)
+    return;
+
+  bool ctx_valid = false;
+  session_context_t ctx;
+
+  while (touched) {
+    int sig = __builtin_ctz(touched);
+    touched &= touched - 1;
+    if (sig >= ECU_SIG_COUNT)
+      break;
+
+    session_signal_stats_t *st = &stats[sig];
+    float v = ecu_data_get_signal(data, (ecu_signal_id_t)sig);
+    if (!isfinite(v))
+      continue;
+
+    bool new_min = (st->count == 0) || (v < st->min);
+    bool new_max = (st->count == 0) || (v > st->max);
+    if ((new_min || new_max) && !ctx_valid) {
+      capture_context(data, &ctx);
+      ctx_valid = true;
+    }
+    if (new_min) {
+      st->min = v;
+      st->min_ms = t;
+      st->min_ctx = ctx;
+    }
+    if (new_max) {
+      st->max = v;
+      st->max_ms = t;
+      st->max_ctx = ctx;
+    }
+
+    // Welford running mean / M2
+    st->count++;
+    float delta = v - st->mean;
+    st->mean += delta / (float)st->count;
+    st->m2 += delta * (v - st->mean);
+
+    // Time over threshold: the previous value is held until this sample
+    if (st->thresh_dir != SESSION_THRESH_NONE) {
+      if (st->last_over && st->count > 1) {
+        uint32_t dt = t - st->last_ms;
+        st->time_over_ms +=
+            dt > MAX_INTEGRATION_GAP_MS ? MAX_INTEGRATION_GAP_MS : dt;
+      }
+      st->last_over = (st->thresh_dir == SESSION_THRESH_ABOVE)
+                          ? (v > st->threshold)
+                          : (v < st->threshold);
+    }
+    st->last_ms = t;
+  }
+
+  xSemaphoreGive(stats_mutex);
+}
+
+bool session_stats_get(ecu_signal_id_t sig, session_signal_stats_t *out) {
+  if (!out || (unsigned)sig >= ECU_SIG_COUNT || !stats_mutex)
+    return false;
+
+  if (xSemaphoreTake(stats_mutex, pdMS_TO_TICKS(100)) != pdTRUE)
+    return false;
+  *out = stats[sig];
+  xSemaphoreGive(stats_mutex);
+  return true;
+}
+
+uint32_t session_stats_get_start_ms(void) { return session_start_ms; }
+
+uint32_t session_stats_get_duration_ms(void) {
+  return now_ms() - session_start_ms;
+}
+
+float session_stats_stddev(const session_signal_stats_t *st) {
+  if (!st || st->count < 2)
+    return 0.0f;
+  float var = st->m2 / (float)(st->count - 1);
+  return var > 0.0f ? sqrtf(var) : 0.0f;
+}
+
+void session_stats_set_threshold(ecu_signal_id_t sig, session_thresh_dir_t dir,
+                                 float threshold) {
+  if ((unsigned)sig >= ECU_SIG_COUNT || !stats_mutex)
+    return;
+
+  if (xSemaphoreTake(stats_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    stats[sig].thresh_dir = dir;
+    stats[sig].threshold = threshold;
+    stats[sig].last_over = false;
+    xSemaphoreGive(stats_mutex);
+  }
+}
+
+static const char *thresh_dir_str(uint8_t dir) {
+  switch (dir) {
+  case SESSION_THRESH_ABOVE:
+    return ">";
+  case SESSION_THRESH_BELOW:
+    return "<";
+  default:
+    return "";
+  }
+}
+
+static void write_context(FILE *f, const session_context_t *c) {
+  fprintf(f, ",%u,%.1f,%d,%.1f,%.1f,%.1f,%u", c->rpm, c->speed_x10 / 10.0f,
+          c->gear, c->map_x10 / 10.0f, c->clt_x10 / 10.0f, c->iat_x10 / 10.0f,
+          c->tps);
+}
+
+esp_err_t session_stats_export_csv(const char *path) {
+  if (!path || !stats_mutex)
+    return ESP_ERR_INVALID_ARG;
+
+  // Snapshot under the lock, write without it (SD writes are slow)
+  static session_signal_stats_t snap[ECU_SIG_COUNT];
+  uint32_t start;
+  if (xSemaphoreTake(stats_mutex, pdMS_TO_TICKS(100)) != pdTRUE)
+    return ESP_ERR_TIMEOUT;
+  memcpy(snap, stats, sizeof(snap));
+  start = session_start_ms;
+  xSemaphoreGive(stats_mutex);
+
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    ESP_LOGE(TAG, "Failed to open %s", path);
+    return ESP_FAIL;
+  }
+
+  fprintf(f, "# Session start %lu ms, duration %lu ms\n", (unsigned long)start,
+          (unsigned long)(now_ms() - start));
+  fprintf(f, "Signal,Unit,Count,Mean,StdDev,"
+             "Min,Min_ms,Min_RPM,Min_Speed,Min_Gear,Min_MAP,Min_CLT,Min_IAT,"
+             "Min_TPS,"
+             "Max,Max_ms,Max_RPM,Max_Speed,Max_Gear,Max_MAP,Max_CLT,Max_IAT,"
+             "Max_TPS,"
+             "Threshold,TimeOver_ms\n");
+
+  for (int i = 0; i < ECU_SIG_COUNT; i++) {
+    const session_signal_stats_t *st = &snap[i];
+    if (st->count == 0)
+      continue;
+
+    fprintf(f, "%s,%s,%lu,%.3f,%.3f", ecu_signal_name((ecu_signal_id_t)i),
+            ecu_signal_unit((ecu_signal_id_t)i), (unsigned long)st->count,
+            st->mean, session_stats_stddev(st));
+    fprintf(f, ",%.3f,%lu", st->min, (unsigned long)st->min_ms);
+    write_context(f, &st->min_ctx);
+    fprintf(f, ",%.3f,%lu", st->max, (unsigned long)st->max_ms);
+    write_context(f, &st->max_ctx);
+    if (st->thresh_dir != SESSION_THRESH_NONE) {
+      fprintf(f, ",%s%.1f,%lu\n", thresh_dir_str(st->thresh_dir),
+              st->threshold, (unsigned long)st->time_over_ms);
+    } else {
+      fprintf(f, ",,\n");
+    }
+  }
+
+  fclose(f);
+  ESP_LOGI(TAG, "Session statistics exported to %s", path);
+  return ESP_OK;
+}
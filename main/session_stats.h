@@ -0,0 +1,84 @@
+#ifndef SESSION_STATS_H
+#define SESSION_STATS_H
+
+#include "ecu_data.h"
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Threshold direction for time-over-threshold accounting
+typedef enum {
+  SESSION_THRESH_NONE = 0,
+  SESSION_THRESH_ABOVE, // Count time while value > threshold (e.g. IAT)
+  SESSION_THRESH_BELOW, // Count time while value < threshold (e.g. oil press)
+} session_thresh_dir_t;
+
+// Operating point captured when a new extremum is recorded (12 bytes)
+typedef struct {
+  uint16_t rpm;
+  uint16_t speed_x10; // km/h * 10
+  uint16_t map_x10;   // kPa * 10
+  int16_t clt_x10;    // C * 10
+  int16_t iat_x10;    // C * 10
+  uint8_t tps;        // %
+  int8_t gear;
+} session_context_t;
+
+// Per-signal statistics for the current session
+typedef struct {
+  uint32_t count; // Samples since reset (0 = signal never seen)
+  float min;
+  float max;
+  uint32_t min_ms; // Time of extremum (ms since boot, same base as traces)
+  uint32_t max_ms;
+  session_context_t min_ctx;
+  session_context_t max_ctx;
+
+  // Running mean / variance (Welford)
+  float mean;
+  float m2;
+
+  // Time over threshold
+  float threshold;
+  uint8_t thresh_dir; // session_thresh_dir_t
+  bool last_over;
+  uint32_t last_ms;
+  uint32_t time_over_ms;
+} session_signal_stats_t;
+
+// Initialize the statistics engine (call after ecu_data_init)
+void session_stats_init(void);
+
+// Start a new session: clears all statistics, keeps thresholds
+void session_stats_reset(void);
+
+// Fold the signals in 'touched' from 'data' into the statistics.
+// Cost is constant per touched signal.
+void session_stats_update(const ecu_data_t *data, ecu_signal_mask_t touched);
+
+// Thread-safe copy of one signal's statistics. Returns false if sig is invalid.
+bool session_stats_get(ecu_signal_id_t sig, session_signal_stats_t *out);
+
+// Session start time and duration (ms)
+uint32_t session_stats_get_start_ms(void);
+uint32_t session_stats_get_duration_ms(void);
+
+// Sample standard deviation of a statistics entry
+float session_stats_stddev(const session_signal_stats_t *st);
+
+// Configure the threshold used for time-over-threshold accounting
+void session_stats_set_threshold(ecu_signal_id_t sig, session_thresh_dir_t dir,
+                                 float threshold);
+
+// Write the current statistics as CSV
+esp_err_t session_stats_export_csv(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SESSION_STATS_H
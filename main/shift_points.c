@@ -0,0 +1,122 @@
+// Shift light thresholds
+//
+// Written at boot (and from a config reload) before the UI reads them; the
+// shift light timer only ever reads whole 32-bit entries.
+
+#include "shift_points.h"
+#include "esp_log.h"
+#include "sd_card_manager.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "SHIFT_POINTS";
+
+// [platform][gear], gear 0 = fallback
+static shift_point_t points[PLATFORM_MAX][SHIFT_MAX_GEAR + 1];
+
+// Start and shift RPM per platform; 1st and 2nd gear come in 200 RPM
+// earlier so the driver's reaction time is spent before the limiter
+static const shift_point_t platform_defaults[PLATFORM_MAX] = {
+    [PLATFORM_VW_PQ35_46] = {5000, 6300},
+    [PLATFORM_VW_PQ25] = {4800, 6000},
+    [PLATFORM_VW_MQB] = {5000, 6300},
+    [PLATFORM_BMW_E9X] = {5500, 6800},
+    [PLATFORM_BMW_E46] = {5500, 7000},
+    [PLATFORM_BMW_F_SERIES] = {5200, 6500},
+};
+#define LOW_GEAR_ADVANCE_RPM 200
+
+void shift_points_load_defaults(void) {
+  for (int p = 0; p < PLATFORM_MAX; p++) {
+    for (int g = 0; g <= SHIFT_MAX_GEAR; g++) {
+      shift_point_t sp = platform_defaults[p];
+      if (g == 1 || g == 2) {
+        sp.start_rpm -= LOW_GEAR_ADVANCE_RPM;
+        sp.shift_rpm -= LOW_GEAR_ADVANCE_RPM;
+      }
+      points[p][g] = sp;
+    }
+  }
+}
+
+esp_err_t shift_points_set(CanPlatform platform, int gear, shift_point_t p) {
+  if ((unsigned)platform >= PLATFORM_MAX || gear < 0 ||
+      gear > SHIFT_MAX_GEAR || p.start_rpm >= p.shift_rpm)
+    return ESP_ERR_INVALID_ARG;
+  points[platform][gear] = p;
+  return ESP_OK;
+}
+
+shift_point_t shift_points_get(CanPlatform platform, int gear) {
+  if ((unsigned)platform >= PLATFORM_MAX)
+    platform = PLATFORM_VW_PQ35_46;
+  if (gear < 1 || gear > SHIFT_MAX_GEAR)
+    gear = 0;
+  return points[platform][gear];
+}
+
+// "*" or a number in [0, max]; -1 for '*', -2 if invalid
+static int parse_index(const char *s, int max) {
+  if (strcmp(s, "*") == 0)
+    return -1;
+  char *end;
+  long v = strtol(s, &end, 10);
+  if (*end != '\0' || v < 0 || v > max)
+    return -2;
+  return (int)v;
+}
+
+esp_err_t shift_points_load(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return ESP_ERR_NOT_FOUND;
+
+  char line[96];
+  int line_no = 0;
+  int loaded = 0;
+  int errors = 0;
+  while (fgets(line, sizeof(line), f)) {
+    line_no++;
+    line[strcspn(line, "\r\n#")] = '\0';
+    if (strspn(line, " \t") == strlen(line))
+      continue;
+
+    char plat_s[8], gear_s[8];
+    unsigned start, shift;
+    int platform = -2, gear = -2;
+    if (sscanf(line, "%7s %7s %u %u", plat_s, gear_s, &start, &shift) == 4) {
+      platform = parse_index(plat_s, PLATFORM_MAX - 1);
+      gear = parse_index(gear_s, SHIFT_MAX_GEAR);
+    }
+    if (platform == -2 || gear == -2 || start >= shift || shift > UINT16_MAX) {
+      ESP_LOGE(TAG, "%s:%d: expected 'platform gear start_rpm shift_rpm'",
+               path, line_no);
+      errors++;
+      continue;
+    }
+
+    shift_point_t sp = {(uint16_t)start, (uint16_t)shift};
+    for (int p = 0; p < PLATFORM_MAX; p++) {
+      if (platform >= 0 && p != platform)
+        continue;
+      for (int g = 0; g <= SHIFT_MAX_GEAR; g++) {
+        if (gear < 0 || g == gear)
+          points[p][g] = sp;
+      }
+    }
+    loaded++;
+  }
+  fclose(f);
+
+  ESP_LOGI(TAG, "Loaded %d shift point entries from %s (%d errors)", loaded,
+           path, errors);
+  return errors ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t shift_points_init(void) {
+  shift_points_load_defaults();
+  if (shift_points_load(SHIFT_POINTS_PATH) == ESP_ERR_NOT_FOUND)
+    ESP_LOGI(TAG, "Using built-in shift points");
+  return ESP_OK;
+}
@@ -0,0 +1,50 @@
+#ifndef SHIFT_POINTS_H
+#define SHIFT_POINTS_H
+
+#include "can_definitions.h"
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Shift light thresholds per CAN platform and gear. The LEDs start filling
+// at start_rpm and are all lit, flashing, from shift_rpm.
+//
+// Config file, one entry per line: "platform gear start_rpm shift_rpm".
+// platform is a CanPlatform index, gear 1..SHIFT_MAX_GEAR; either may be
+// '*' for all. Gear 0 is the fallback used in P, N, R or an unknown gear.
+// Later lines override earlier ones, so a '*' line can be refined below it.
+
+#define SHIFT_POINTS_PATH SD_MOUNT_POINT "/shift.cfg"
+#define SHIFT_MAX_GEAR 8
+
+typedef struct {
+  uint16_t start_rpm;
+  uint16_t shift_rpm;
+} shift_point_t;
+
+// Load SHIFT_POINTS_PATH over the built-in defaults. Must run before the UI
+// starts reading the table.
+esp_err_t shift_points_init(void);
+
+// Built-in table: per platform, earlier in 1st and 2nd gear where the RPM
+// climbs fastest
+void shift_points_load_defaults(void);
+
+esp_err_t shift_points_load(const char *path);
+
+// Gear 0 = fallback. Returns ESP_ERR_INVALID_ARG if out of range or
+// start_rpm >= shift_rpm.
+esp_err_t shift_points_set(CanPlatform platform, int gear, shift_point_t p);
+
+// Gear as decoded (ecu_data_t.gear); gears outside 1..SHIFT_MAX_GEAR use
+// the platform's fallback
+shift_point_t shift_points_get(CanPlatform platform, int gear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHIFT_POINTS_H
@@ -0,0 +1,136 @@
+// Signal freshness tracking
+//
+// Single writer per field: the CAN ingest task stamps last_ms / learned
+// periods, the sweep publishes stale_mask with one 32-bit store. Readers only
+// ever see a whole mask, so no lock is needed on the per-frame path.
+
+#include "signal_freshness.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "SIG_FRESH";
+
+typedef struct {
+  uint32_t last_ms;
+  uint16_t declared_ms; // 0 = not declared
+  uint16_t learned_ms;  // EWMA of observed intervals, 0 = unknown
+  uint8_t samples;      // Saturates at 2 (enough to learn a period)
+} fresh_entry_t;
+
+static volatile fresh_entry_t entries[ECU_SIG_COUNT];
+static volatile ecu_signal_mask_t stale_mask = ECU_SIG_MASK_ALL;
+
+void signal_freshness_init(void) {
+  signal_freshness_reset();
+  ESP_LOGI(TAG, "Signal freshness initialized");
+}
+
+void signal_freshness_reset(void) {
+  memset((void *)entries, 0, sizeof(entries));
+  stale_mask = ECU_SIG_MASK_ALL;
+}
+
+void signal_freshness_declare(ecu_signal_id_t sig, uint16_t period_ms) {
+  if ((unsigned)sig < ECU_SIG_COUNT)
+    entries[sig].declared_ms = period_ms;
+}
+
+void signal_freshness_touch(ecu_signal_mask_t touched, uint32_t now_ms) {
+  touched &= ECU_SIG_MASK_ALL;
+  while (touched) {
+    int sig = __builtin_ctz(touched);
+    touched &= touched - 1;
+
+    volatile fresh_entry_t *e = &entries[sig];
+    if (e->samples > 0) {
+      uint32_t interval = now_ms - e->last_ms;
+      if (interval > UINT16_MAX)
+        interval = UINT16_MAX;
+      // First interval seeds the average, then 1/8 weight per sample
+      e->learned_ms = (e->samples < 2)
+                          ? (uint16_t)interval
+                          : (uint16_t)((e->learned_ms * 7u + interval) / 8u);
+      if (e->samples < 2)
+        e->samples++;
+    } else {
+      e->samples = 1;
+    }
+    e->last_ms = now_ms;
+  }
+}
+
+static uint32_t entry_period(const volatile fresh_entry_t *e) {
+  return e->declared_ms ? e->declared_ms : e->learned_ms;
+}
+
+static uint32_t entry_timeout(const volatile fresh_entry_t *e) {
+  uint32_t period = entry_period(e);
+  if (period == 0)
+    return SIGNAL_STALE_DEFAULT_MS;
+
+  uint32_t timeout = period * SIGNAL_STALE_PERIOD_MULT;
+  if (timeout < SIGNAL_STALE_MIN_MS)
+    timeout = SIGNAL_STALE_MIN_MS;
+  if (timeout > SIGNAL_STALE_MAX_MS)
+    timeout = SIGNAL_STALE_MAX_MS;
+  return timeout;
+}
+
+// The CAN task may stamp last_ms after the caller read now_ms; that counts
+// as age 0, not as a wrap to ~4e9 ms
+static uint32_t entry_age(const volatile fresh_entry_t *e, uint32_t now_ms) {
+  int32_t age = (int32_t)(now_ms - e->last_ms);
+  return age > 0 ? (uint32_t)age : 0;
+}
+
+ecu_signal_mask_t signal_freshness_sweep(uint32_t now_ms) {
+  ecu_signal_mask_t mask = 0;
+  for (int sig = 0; sig < ECU_SIG_COUNT; sig++) {
+    const volatile fresh_entry_t *e = &entries[sig];
+    if (e->samples == 0 || entry_age(e, now_ms) > entry_timeout(e))
+      mask |= ECU_SIG_BIT(sig);
+  }
+  stale_mask = mask;
+  return mask;
+}
+
+ecu_signal_mask_t signal_freshness_get_stale_mask(void) { return stale_mask; }
+
+bool signal_freshness_get(ecu_signal_id_t sig, uint32_t now_ms,
+                          signal_freshness_t *out) {
+  if ((unsigned)sig >= ECU_SIG_COUNT || !out)
+    return false;
+
+  const volatile fresh_entry_t *e = &entries[sig];
+  out->last_ms = e->last_ms;
+  out->period_ms = (uint16_t)entry_period(e);
+  out->timeout_ms = (uint16_t)entry_timeout(e);
+  out->period_declared = e->declared_ms != 0;
+
+  if (e->samples == 0) {
+    out->state = SIGNAL_STATE_NEVER;
+    out->age_ms = 0;
+  } else {
+    out->age_ms = entry_age(e, now_ms);
+    out->state = (out->age_ms > out->timeout_ms) ? SIGNAL_STATE_STALE
+                                                 : SIGNAL_STATE_FRESH;
+  }
+  return true;
+}
+
+uint32_t signal_freshness_last_ms(ecu_signal_id_t sig) {
+  if ((unsigned)sig >= ECU_SIG_COUNT)
+    return 0;
+  return entries[sig].last_ms;
+}
+
+const char *signal_state_name(signal_state_t state) {
+  switch (state) {
+  case SIGNAL_STATE_FRESH:
+    return "fresh";
+  case SIGNAL_STATE_STALE:
+    return "stale";
+  default:
+    return "never";
+  }
+}
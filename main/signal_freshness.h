@@ -0,0 +1,71 @@
+#ifndef SIGNAL_FRESHNESS_H
+#define SIGNAL_FRESHNESS_H
+
+#include "ecu_data.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-signal freshness. The ingest path stamps the signals a frame touched;
+// a periodic sweep (gauge timer, API handlers) turns ages into a stale mask
+// so readers test one bit instead of scanning timestamps per frame.
+
+// Timeout = period * multiplier, clamped to [MIN, MAX]
+#define SIGNAL_STALE_PERIOD_MULT 5
+#define SIGNAL_STALE_MIN_MS 250
+#define SIGNAL_STALE_MAX_MS 5000
+// Used until a period is declared or learned (needs two samples)
+#define SIGNAL_STALE_DEFAULT_MS 1000
+
+typedef enum {
+  SIGNAL_STATE_NEVER = 0, // Not received since reset
+  SIGNAL_STATE_FRESH,
+  SIGNAL_STATE_STALE,
+} signal_state_t;
+
+typedef struct {
+  signal_state_t state;
+  uint32_t last_ms;     // Last update (ms since boot, esp_timer base)
+  uint32_t age_ms;      // At the time of the query
+  uint16_t period_ms;   // Declared, else learned (0 = unknown)
+  uint16_t timeout_ms;  // Effective staleness timeout
+  bool period_declared; // From the platform table rather than learned
+} signal_freshness_t;
+
+void signal_freshness_init(void);
+
+// Forget all timestamps and periods (e.g. platform change)
+void signal_freshness_reset(void);
+
+// Declare the nominal update period of a signal (0 = learn from traffic)
+void signal_freshness_declare(ecu_signal_id_t sig, uint16_t period_ms);
+
+// Stamp the signals a frame updated. Called from the ingest path.
+void signal_freshness_touch(ecu_signal_mask_t touched, uint32_t now_ms);
+
+// Recompute the stale mask from signal ages. Cheap; call periodically.
+ecu_signal_mask_t signal_freshness_sweep(uint32_t now_ms);
+
+// Mask from the last sweep. Never-seen signals count as stale.
+ecu_signal_mask_t signal_freshness_get_stale_mask(void);
+
+static inline bool signal_freshness_is_stale(ecu_signal_id_t sig) {
+  return (signal_freshness_get_stale_mask() & ECU_SIG_BIT(sig)) != 0;
+}
+
+bool signal_freshness_get(ecu_signal_id_t sig, uint32_t now_ms,
+                          signal_freshness_t *out);
+
+// Time of the signal's last update, for timestamping samples (0 = never)
+uint32_t signal_freshness_last_ms(ecu_signal_id_t sig);
+
+const char *signal_state_name(signal_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIGNAL_FRESHNESS_H
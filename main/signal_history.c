@@ -0,0 +1,146 @@
+// Per-signal sample rings for time-series views
+//
+// can_manager_ingest() serialises the CAN task and the simulator; writers
+// still take a mutex so record() stays safe for any other caller.
+// Readers are lock-free: the writer fills a slot, then publishes it by
+// advancing head with a release store, and a reader only looks at slots
+// below the head it loaded.
+
+#include "signal_history.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <math.h>
+#include <string.h>
+
+static const char *TAG = "SIGNAL_HISTORY";
+
+#define RING_MASK (SIGNAL_HISTORY_SAMPLES - 1u)
+// Slots a lagging reader leaves between itself and the writer when it skips
+// ahead, so the writer cannot lap it mid-reduce
+#define OVERRUN_MARGIN 64u
+
+_Static_assert((SIGNAL_HISTORY_SAMPLES & RING_MASK) == 0,
+               "SIGNAL_HISTORY_SAMPLES must be a power of two");
+
+typedef struct {
+  uint32_t ms;
+  float value;
+} history_sample_t;
+
+static history_sample_t *rings; // [ECU_SIG_COUNT][SIGNAL_HISTORY_SAMPLES]
+static uint32_t head[ECU_SIG_COUNT]; // Samples written
+static SemaphoreHandle_t write_mutex = NULL;
+
+static inline history_sample_t *ring(ecu_signal_id_t sig) {
+  return rings + (size_t)sig * SIGNAL_HISTORY_SAMPLES;
+}
+
+void signal_history_init(void) {
+  if (rings)
+    return;
+  size_t bytes = sizeof(history_sample_t) * SIGNAL_HISTORY_SAMPLES *
+                 ECU_SIG_COUNT;
+  rings = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+  if (!rings)
+    rings = heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+  if (!rings) {
+    ESP_LOGE(TAG, "No memory for %u KB of signal history",
+             (unsigned)(bytes / 1024));
+    return;
+  }
+  write_mutex = xSemaphoreCreateMutex();
+  memset(head, 0, sizeof(head));
+  ESP_LOGI(TAG, "Signal history: %d samples x %d signals, %u KB",
+           SIGNAL_HISTORY_SAMPLES, ECU_SIG_COUNT, (unsigned)(bytes / 1024));
+}
+
+void signal_history_record(const ecu_data_t *data, ecu_signal_mask_t touched,
+                           uint32_t now_ms) {
+  if (!rings || !data || touched == 0)
+    return;
+
+  // Called from the CAN receive path: never wait long for the other writer
+  if (xSemaphoreTake(write_mutex, pdMS_TO_TICKS(5)) != pdTRUE)
+    return;
+
+  touched &= ECU_SIG_MASK_ALL;
+  while (touched) {
+    int sig = __builtin_ctz(touched);
+    touched &= touched - 1;
+
+    float v = ecu_data_get_signal(data, (ecu_signal_id_t)sig);
+    if (!isfinite(v))
+      continue;
+    uint32_t h = head[sig];
+    history_sample_t *s = &ring((ecu_signal_id_t)sig)[h & RING_MASK];
+    s->ms = now_ms;
+    s->value = v;
+    __atomic_store_n(&head[sig], h + 1, __ATOMIC_RELEASE);
+  }
+  xSemaphoreGive(write_mutex);
+}
+
+// Clamp a cursor to the retained samples below h
+static uint32_t clamp_cursor(uint32_t c, uint32_t h) {
+  uint32_t first = 0;
+  if (h > SIGNAL_HISTORY_SAMPLES - OVERRUN_MARGIN)
+    first = h - (SIGNAL_HISTORY_SAMPLES - OVERRUN_MARGIN);
+  if ((int32_t)(c - first) < 0)
+    return first;
+  if ((int32_t)(c - h) > 0)
+    return h;
+  return c;
+}
+
+uint32_t signal_history_seek(ecu_signal_id_t sig, uint32_t since_ms) {
+  if (!rings || (unsigned)sig >= ECU_SIG_COUNT)
+    return 0;
+  uint32_t h = __atomic_load_n(&head[sig], __ATOMIC_ACQUIRE);
+  uint32_t lo = clamp_cursor(h - SIGNAL_HISTORY_SAMPLES, h);
+  uint32_t n = h - lo;
+  const history_sample_t *r = ring(sig);
+
+  // Samples are in time order: first one not before since_ms
+  while (n > 0) {
+    uint32_t half = n / 2;
+    uint32_t mid = lo + half;
+    if ((int32_t)(r[mid & RING_MASK].ms - since_ms) < 0) {
+      lo = mid + 1;
+      n -= half + 1;
+    } else {
+      n = half;
+    }
+  }
+  return lo;
+}
+
+uint32_t signal_history_reduce(ecu_signal_id_t sig, uint32_t *cursor,
+                               uint32_t until_ms, signal_history_span_t *out) {
+  out->count = 0;
+  if (!rings || (unsigned)sig >= ECU_SIG_COUNT)
+    return 0;
+
+  uint32_t h = __atomic_load_n(&head[sig], __ATOMIC_ACQUIRE);
+  uint32_t c = clamp_cursor(*cursor, h);
+  const history_sample_t *r = ring(sig);
+
+  for (; c != h; c++) {
+    const history_sample_t *s = &r[c & RING_MASK];
+    if ((int32_t)(s->ms - until_ms) >= 0)
+      break;
+    if (out->count == 0) {
+      out->min = out->max = s->value;
+    } else if (s->value < out->min) {
+      out->min = s->value;
+    } else if (s->value > out->max) {
+      out->max = s->value;
+    }
+    out->last = s->value;
+    out->last_ms = s->ms;
+    out->count++;
+  }
+  *cursor = c;
+  return out->count;
+}
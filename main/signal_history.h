@@ -0,0 +1,54 @@
+#ifndef SIGNAL_HISTORY_H
+#define SIGNAL_HISTORY_H
+
+#include "ecu_data.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Recent samples of every signal, for time-series views. The ingest path
+// appends the signals each frame touched; readers walk a signal's ring with
+// their own cursor and never block the writer.
+//
+// A cursor is a running sample count, not a ring index. A reader that falls
+// more than SIGNAL_HISTORY_SAMPLES behind skips to the oldest retained
+// sample.
+
+// Per signal, power of two. 4096 keeps ~40 s of a 100 Hz signal (32 KB).
+#define SIGNAL_HISTORY_SAMPLES 4096
+
+// Samples folded into one span (e.g. one pixel column of a chart)
+typedef struct {
+  uint32_t count; // 0 = no sample in the span; the rest is undefined
+  float min;
+  float max;
+  float last;
+  uint32_t last_ms;
+} signal_history_span_t;
+
+// Allocate the rings (PSRAM when available). Call before the ingest path
+// starts.
+void signal_history_init(void);
+
+// Append the signals in 'touched' from 'data', stamped now_ms. Called from
+// the ingest path.
+void signal_history_record(const ecu_data_t *data, ecu_signal_mask_t touched,
+                           uint32_t now_ms);
+
+// Cursor of the first retained sample stamped at or after since_ms
+uint32_t signal_history_seek(ecu_signal_id_t sig, uint32_t since_ms);
+
+// Fold the samples from *cursor stamped before until_ms into *out and
+// advance *cursor past them. Cost is linear in the samples folded. Returns
+// out->count.
+uint32_t signal_history_reduce(ecu_signal_id_t sig, uint32_t *cursor,
+                               uint32_t until_ms, signal_history_span_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIGNAL_HISTORY_H
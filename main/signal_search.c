@@ -0,0 +1,500 @@
+// Bit-field correlation search
+//
+// Capture: one producer (the CAN ingest task) appends samples and publishes
+// them with a release store of sample_count. A capture counts itself in
+// captures_in_flight before it checks the state, so signal_search_run() and
+// signal_search_end() flip the state first and then wait for the count to
+// drain; after that no capture can touch the buffers.
+//
+// Scoring: per (ID, byte order) unit, every field of SEARCH_MIN_BITS to
+// SEARCH_MAX_BITS at every start bit is read from the 64-bit payload word
+// with one shift and mask, unsigned and sign-extended. The reference is
+// normalised per ID and quantised to int32, so the Pearson sums for all
+// candidates are exact 64-bit integer arithmetic; only the final r, scale
+// and offset use floating point.
+
+#include "signal_search.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "signal_freshness.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "SIG_SEARCH";
+
+#define SEARCH_MIN_BITS 8
+#define SEARCH_MAX_BITS 16
+// Candidates per unit: (65 - len) start bits for each length
+#define UNIT_CANDIDATES                                                        \
+  ((SEARCH_MAX_BITS - SEARCH_MIN_BITS + 1) *                                   \
+   (65 - (SEARCH_MIN_BITS + SEARCH_MAX_BITS) / 2))
+
+// Reference in units of 1/Z_SCALE standard deviations, clamped to +-8 sigma:
+// fine enough to resolve the LSB of a 16-bit field, small enough that the
+// sums over SIGNAL_SEARCH_MAX_SAMPLES stay within int64
+#define Z_SCALE (1 << 20)
+#define Z_LIMIT (8 * Z_SCALE)
+
+#define ID_HASH_BITS 8
+#define ID_HASH_SIZE (1u << ID_HASH_BITS)
+_Static_assert(ID_HASH_SIZE >= 2 * SIGNAL_SEARCH_MAX_IDS, "hash too small");
+#define SEARCH_TASK_PRIORITY 1
+#define SEARCH_TASK_STACK 4096
+
+typedef struct {
+  uint64_t payload; // Little-endian word, bytes past dlc zero
+  float reference;
+  uint16_t id_slot;
+  uint8_t dlc;
+} search_sample_t;
+
+typedef struct {
+  int64_t sx, sxx, sxz;
+} search_accum_t;
+
+static signal_search_state_t state = SIGNAL_SEARCH_IDLE;
+static ecu_signal_id_t reference_sig = ECU_SIG_COUNT;
+
+// Capture
+static search_sample_t *samples = NULL;
+static uint32_t sample_count = 0;
+static uint32_t ids[SIGNAL_SEARCH_MAX_IDS];
+static uint8_t id_max_dlc[SIGNAL_SEARCH_MAX_IDS];
+static int id_count = 0;
+static uint32_t hash_keys[ID_HASH_SIZE];
+static uint8_t hash_slots[ID_HASH_SIZE]; // slot + 1, 0 = empty
+static uint32_t captures_in_flight = 0;
+
+// Job
+static uint32_t *order = NULL; // Sample indices grouped by ID
+static uint32_t id_first[SIGNAL_SEARCH_MAX_IDS + 1];
+static int job_units = 0;
+static int next_unit = 0;
+static int done_units = 0;
+static int active_workers = 0;
+static bool cancel = false;
+
+static signal_candidate_t results[SIGNAL_SEARCH_TOP];
+static int result_count = 0;
+static SemaphoreHandle_t results_lock = NULL;
+
+// --- Capture ---
+
+static int id_slot(uint32_t id) {
+  for (uint32_t h = (id * 2654435761u) >> (32 - ID_HASH_BITS);;
+       h = (h + 1) & (ID_HASH_SIZE - 1)) {
+    if (hash_slots[h] == 0) {
+      if (id_count >= SIGNAL_SEARCH_MAX_IDS)
+        return -1;
+      int slot = id_count;
+      ids[slot] = id;
+      id_max_dlc[slot] = 0;
+      hash_keys[h] = id;
+      hash_slots[h] = (uint8_t)(slot + 1);
+      __atomic_store_n(&id_count, slot + 1, __ATOMIC_RELEASE);
+      return slot;
+    }
+    if (hash_keys[h] == id)
+      return hash_slots[h] - 1;
+  }
+}
+
+esp_err_t signal_search_begin(ecu_signal_id_t reference) {
+  signal_search_end();
+
+  samples = malloc(SIGNAL_SEARCH_MAX_SAMPLES * sizeof(*samples));
+  if (!samples)
+    return ESP_ERR_NO_MEM;
+
+  memset(hash_slots, 0, sizeof(hash_slots));
+  id_count = 0;
+  sample_count = 0;
+  reference_sig = reference;
+  __atomic_store_n(&state, SIGNAL_SEARCH_CAPTURING, __ATOMIC_RELEASE);
+  ESP_LOGI(TAG, "Capturing against %s",
+           reference < ECU_SIG_COUNT ? ecu_signal_key(reference) : "external");
+  return ESP_OK;
+}
+
+// Called once the state has left CAPTURING (sequentially consistent store)
+static void wait_for_captures(void) {
+  while (__atomic_load_n(&captures_in_flight, __ATOMIC_SEQ_CST) != 0)
+    vTaskDelay(1);
+}
+
+static void store_sample(uint32_t id, const uint8_t *data, uint8_t dlc,
+                         float reference) {
+  uint32_t n = sample_count;
+  if (n >= SIGNAL_SEARCH_MAX_SAMPLES || !isfinite(reference))
+    return;
+
+  int slot = id_slot(id);
+  if (slot < 0)
+    return;
+  if (dlc > 8)
+    dlc = 8;
+  if (dlc > id_max_dlc[slot])
+    id_max_dlc[slot] = dlc;
+
+  search_sample_t *s = &samples[n];
+  s->payload = 0;
+  memcpy(&s->payload, data, dlc);
+  s->reference = reference;
+  s->id_slot = (uint16_t)slot;
+  s->dlc = dlc;
+  __atomic_store_n(&sample_count, n + 1, __ATOMIC_RELEASE);
+}
+
+void signal_search_capture(uint32_t id, const uint8_t *data, uint8_t dlc,
+                           float reference) {
+  __atomic_add_fetch(&captures_in_flight, 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&state, __ATOMIC_SEQ_CST) == SIGNAL_SEARCH_CAPTURING)
+    store_sample(id, data, dlc, reference);
+  __atomic_sub_fetch(&captures_in_flight, 1, __ATOMIC_RELEASE);
+}
+
+void signal_search_feed(uint32_t id, const uint8_t *data, uint8_t dlc,
+                        uint32_t now_ms) {
+  if (__atomic_load_n(&state, __ATOMIC_RELAXED) != SIGNAL_SEARCH_CAPTURING ||
+      reference_sig >= ECU_SIG_COUNT)
+    return;
+
+  // A held value would pair frames with a reference that no longer applies
+  signal_freshness_t f;
+  if (!signal_freshness_get(reference_sig, now_ms, &f) ||
+      f.state != SIGNAL_STATE_FRESH)
+    return;
+
+  ecu_data_t d;
+  ecu_data_get_copy(&d);
+  signal_search_capture(id, data, dlc, ecu_data_get_signal(&d, reference_sig));
+}
+
+// --- Results ---
+
+// Payload bits a candidate reads, in little-endian word numbering
+static uint64_t candidate_bits(const signal_candidate_t *c) {
+  uint64_t mask = (1ull << c->length) - 1;
+  if (!c->big_endian)
+    return mask << c->start;
+  return __builtin_bswap64(mask << (64 - c->start - c->length));
+}
+
+// Ranking: |r|, and within rounding of each other the wider field, which
+// keeps the low bits a narrower window would drop. Dropping or adding one
+// noisy LSB moves r by ~1e-9 on a 16-bit field, hence r in double.
+#define SCORE_TIE 1e-12
+
+static bool ranks_above(const signal_candidate_t *a,
+                        const signal_candidate_t *b) {
+  double d = fabs(a->correlation) - fabs(b->correlation);
+  if (fabs(d) > SCORE_TIE)
+    return d > 0.0;
+  return a->length > b->length;
+}
+
+// Insert into a ranked list. Overlapping fields of one ID are the same
+// signal seen through different windows, so only the best of them stays.
+static void insert_candidate(signal_candidate_t *list, int *count,
+                             const signal_candidate_t *c) {
+  uint64_t bits = candidate_bits(c);
+  for (int i = 0; i < *count; i++) {
+    if (list[i].id == c->id && (candidate_bits(&list[i]) & bits) &&
+        !ranks_above(c, &list[i]))
+      return;
+  }
+  for (int i = 0; i < *count;) {
+    if (list[i].id == c->id && (candidate_bits(&list[i]) & bits)) {
+      memmove(&list[i], &list[i + 1], (*count - i - 1) * sizeof(*list));
+      (*count)--;
+    } else {
+      i++;
+    }
+  }
+
+  int pos = *count;
+  while (pos > 0 && ranks_above(c, &list[pos - 1]))
+    pos--;
+  if (pos >= SIGNAL_SEARCH_TOP)
+    return;
+  int tail = (*count < SIGNAL_SEARCH_TOP ? *count : SIGNAL_SEARCH_TOP - 1);
+  memmove(&list[pos + 1], &list[pos], (tail - pos) * sizeof(*list));
+  list[pos] = *c;
+  if (*count < SIGNAL_SEARCH_TOP)
+    (*count)++;
+}
+
+// --- Scoring ---
+
+static void run_unit(int unit, search_accum_t *acc, int32_t *z) {
+  int slot = unit / 2;
+  bool big_endian = unit & 1;
+  uint32_t first = id_first[slot];
+  uint32_t n = id_first[slot + 1] - first;
+  int bits = id_max_dlc[slot] * 8;
+  if (n < SIGNAL_SEARCH_MIN_SAMPLES || bits < SEARCH_MIN_BITS)
+    return;
+
+  // Normalise the reference over this ID's samples
+  float mean = 0.0f;
+  for (uint32_t i = 0; i < n; i++)
+    mean += samples[order[first + i]].reference;
+  mean /= (float)n;
+  float var = 0.0f;
+  for (uint32_t i = 0; i < n; i++) {
+    float d = samples[order[first + i]].reference - mean;
+    var += d * d;
+  }
+  float sd = sqrtf(var / (float)n);
+  if (!(sd > 1e-6f * (fabsf(mean) + 1.0f)))
+    return; // Reference constant while this ID was seen
+
+  int64_t sz = 0, szz = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    float q = (samples[order[first + i]].reference - mean) / sd * Z_SCALE;
+    if (q > Z_LIMIT)
+      q = Z_LIMIT;
+    if (q < -Z_LIMIT)
+      q = -Z_LIMIT;
+    z[i] = (int32_t)lroundf(q);
+    sz += z[i];
+    szz += (int64_t)z[i] * z[i];
+  }
+
+  // Accumulate: acc[2k] unsigned, acc[2k + 1] signed, k = candidate
+  memset(acc, 0, 2 * UNIT_CANDIDATES * sizeof(*acc));
+  for (uint32_t i = 0; i < n; i++) {
+    uint64_t w = samples[order[first + i]].payload;
+    if (big_endian)
+      w = __builtin_bswap64(w); // data[0] becomes the top byte
+    int64_t zi = z[i];
+    search_accum_t *a = acc;
+    for (int len = SEARCH_MIN_BITS; len <= SEARCH_MAX_BITS; len++) {
+      uint64_t mask = (1ull << len) - 1;
+      int64_t sign = 1ll << (len - 1);
+      for (int start = 0; start + len <= 64; start++, a += 2) {
+        if (start + len > bits)
+          continue;
+        int shift = big_endian ? 64 - start - len : start;
+        int64_t x = (int64_t)((w >> shift) & mask);
+        int64_t sx = (x ^ sign) - sign;
+        a[0].sx += x;
+        a[0].sxx += x * x;
+        a[0].sxz += x * zi;
+        a[1].sx += sx;
+        a[1].sxx += sx * sx;
+        a[1].sxz += sx * zi;
+      }
+    }
+  }
+
+  double dn = (double)n;
+  double den_z = dn * (double)szz - (double)sz * (double)sz;
+  signal_candidate_t local[SIGNAL_SEARCH_TOP];
+  int local_count = 0;
+  const search_accum_t *a = acc;
+  for (int len = SEARCH_MIN_BITS; len <= SEARCH_MAX_BITS; len++) {
+    for (int start = 0; start + len <= 64; start++, a += 2) {
+      if (start + len > bits)
+        continue;
+      for (int s = 0; s < 2; s++) {
+        const search_accum_t *c = &a[s];
+        double num = dn * (double)c->sxz - (double)c->sx * (double)sz;
+        double den_x = dn * (double)c->sxx - (double)c->sx * (double)c->sx;
+        if (den_x <= 0.0 || den_z <= 0.0)
+          continue; // Field constant over the capture
+        double slope = num / den_x * sd / Z_SCALE;
+        signal_candidate_t cand = {
+            .id = ids[slot],
+            .start = (uint8_t)start,
+            .length = (uint8_t)len,
+            .big_endian = big_endian,
+            .is_signed = s == 1,
+            .correlation = num / sqrt(den_x * den_z),
+            .scale = (float)slope,
+            .offset = (float)(mean + (double)sd / Z_SCALE * (double)sz / dn -
+                              slope * (double)c->sx / dn),
+            .samples = n,
+        };
+        insert_candidate(local, &local_count, &cand);
+      }
+    }
+  }
+
+  if (results_lock)
+    xSemaphoreTake(results_lock, portMAX_DELAY);
+  for (int i = 0; i < local_count; i++)
+    insert_candidate(results, &result_count, &local[i]);
+  if (results_lock)
+    xSemaphoreGive(results_lock);
+}
+
+// Pull units until none are left; `yield` between units when running as a
+// background task
+static void process_units(bool yield) {
+  search_accum_t *acc = malloc(2 * UNIT_CANDIDATES * sizeof(*acc));
+  int32_t *z = malloc(SIGNAL_SEARCH_MAX_SAMPLES * sizeof(*z));
+  if (!acc || !z) {
+    ESP_LOGE(TAG, "No memory for a search worker");
+  } else {
+    int unit;
+    while (!__atomic_load_n(&cancel, __ATOMIC_RELAXED) &&
+           (unit = __atomic_fetch_add(&next_unit, 1, __ATOMIC_RELAXED)) <
+               job_units) {
+      run_unit(unit, acc, z);
+      __atomic_fetch_add(&done_units, 1, __ATOMIC_RELEASE);
+      if (yield)
+        vTaskDelay(1); // Let the UI and CAN tasks on this core run
+    }
+  }
+  free(acc);
+  free(z);
+}
+
+static void worker_done(void) {
+  if (__atomic_sub_fetch(&active_workers, 1, __ATOMIC_ACQ_REL) == 0) {
+    __atomic_store_n(&state, SIGNAL_SEARCH_DONE, __ATOMIC_RELEASE);
+    ESP_LOGI(TAG, "Search done: %d candidates", result_count);
+  }
+}
+
+static void search_worker(void *arg) {
+  (void)arg;
+  process_units(true);
+  worker_done();
+  vTaskDelete(NULL);
+}
+
+esp_err_t signal_search_run(int workers) {
+  if (__atomic_load_n(&state, __ATOMIC_ACQUIRE) != SIGNAL_SEARCH_CAPTURING)
+    return ESP_ERR_INVALID_STATE;
+  __atomic_store_n(&state, SIGNAL_SEARCH_RUNNING, __ATOMIC_SEQ_CST);
+  wait_for_captures();
+
+  uint32_t n = __atomic_load_n(&sample_count, __ATOMIC_ACQUIRE);
+  int slots = __atomic_load_n(&id_count, __ATOMIC_ACQUIRE);
+
+  // Group the sample indices by ID (counting sort)
+  order = malloc((n ? n : 1) * sizeof(*order));
+  if (!order) {
+    __atomic_store_n(&state, SIGNAL_SEARCH_DONE, __ATOMIC_RELEASE);
+    return ESP_ERR_NO_MEM;
+  }
+  uint32_t cursor[SIGNAL_SEARCH_MAX_IDS + 1];
+  memset(id_first, 0, sizeof(id_first));
+  for (uint32_t i = 0; i < n; i++)
+    id_first[samples[i].id_slot + 1]++;
+  for (int s = 0; s < slots; s++)
+    id_first[s + 1] += id_first[s];
+  memcpy(cursor, id_first, sizeof(cursor));
+  for (uint32_t i = 0; i < n; i++)
+    order[cursor[samples[i].id_slot]++] = i;
+
+  result_count = 0;
+  next_unit = 0;
+  done_units = 0;
+  job_units = slots * 2;
+  cancel = false;
+  ESP_LOGI(TAG, "Scoring %lu samples over %d IDs", (unsigned long)n, slots);
+
+  if (workers <= 0) {
+    active_workers = 1;
+    process_units(false);
+    worker_done();
+    return ESP_OK;
+  }
+
+  if (!results_lock)
+    results_lock = xSemaphoreCreateMutex();
+  // One extra reference held while spawning, so an early finisher cannot
+  // mark the job done before every worker exists
+  active_workers = workers + 1;
+  for (int i = 0; i < workers; i++) {
+    if (xTaskCreatePinnedToCore(search_worker, "sig_search", SEARCH_TASK_STACK,
+                                NULL, SEARCH_TASK_PRIORITY, NULL,
+                                i % 2) != pdPASS) {
+      ESP_LOGE(TAG, "Failed to start search worker %d", i);
+      worker_done();
+    }
+  }
+  worker_done();
+  return ESP_OK;
+}
+
+void signal_search_end(void) {
+  __atomic_store_n(&cancel, true, __ATOMIC_RELAXED);
+  while (__atomic_load_n(&state, __ATOMIC_ACQUIRE) == SIGNAL_SEARCH_RUNNING)
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+  __atomic_store_n(&state, SIGNAL_SEARCH_IDLE, __ATOMIC_SEQ_CST);
+  wait_for_captures();
+  free(samples);
+  samples = NULL;
+  free(order);
+  order = NULL;
+  sample_count = 0;
+  id_count = 0;
+  result_count = 0;
+  job_units = 0;
+  reference_sig = ECU_SIG_COUNT;
+}
+
+signal_search_state_t signal_search_get_state(void) {
+  return __atomic_load_n(&state, __ATOMIC_ACQUIRE);
+}
+
+ecu_signal_id_t signal_search_get_reference(void) { return reference_sig; }
+
+uint32_t signal_search_get_sample_count(void) {
+  return __atomic_load_n(&sample_count, __ATOMIC_ACQUIRE);
+}
+
+int signal_search_get_progress(void) {
+  signal_search_state_t s = signal_search_get_state();
+  if (s == SIGNAL_SEARCH_DONE)
+    return 100;
+  if (s != SIGNAL_SEARCH_RUNNING || job_units == 0)
+    return 0;
+  return __atomic_load_n(&done_units, __ATOMIC_ACQUIRE) * 100 / job_units;
+}
+
+int signal_search_get_results(signal_candidate_t *out, int max) {
+  if (signal_search_get_state() != SIGNAL_SEARCH_DONE)
+    return 0;
+  int n = result_count < max ? result_count : max;
+  memcpy(out, results, n * sizeof(*out));
+  return n;
+}
+
+float signal_search_decode(const signal_candidate_t *c, const uint8_t *data,
+                           uint8_t dlc) {
+  uint64_t w = 0;
+  memcpy(&w, data, dlc > 8 ? 8 : dlc);
+  int shift = c->start;
+  if (c->big_endian) {
+    w = __builtin_bswap64(w);
+    shift = 64 - c->start - c->length;
+  }
+  int64_t x = (int64_t)((w >> shift) & ((1ull << c->length) - 1));
+  if (c->is_signed) {
+    int64_t sign = 1ll << (c->length - 1);
+    x = (x ^ sign) - sign;
+  }
+  return (float)x * c->scale + c->offset;
+}
+
+const char *signal_search_state_name(signal_search_state_t s) {
+  switch (s) {
+  case SIGNAL_SEARCH_CAPTURING:
+    return "capturing";
+  case SIGNAL_SEARCH_RUNNING:
+    return "running";
+  case SIGNAL_SEARCH_DONE:
+    return "done";
+  default:
+    return "idle";
+  }
+}
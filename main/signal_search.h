@@ -0,0 +1,98 @@
+#ifndef SIGNAL_SEARCH_H
+#define SIGNAL_SEARCH_H
+
+#include "ecu_data.h"
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bit-field correlation search: finds where an unknown signal lives on a
+// new car by scoring every candidate decode (ID, start bit, length, byte
+// order, signedness) against a reference channel.
+//
+// 1. signal_search_begin() starts a capture. Each frame is stored with the
+//    reference value at that moment: from a decoded signal through
+//    signal_search_feed() on the ingest path, or from any other source
+//    (e.g. a recorded segment) through signal_search_capture().
+// 2. signal_search_run() ends the capture and scores the candidates as a
+//    background job: one unit per (ID, byte order), pulled by a worker task
+//    on each core, yielding between units.
+// 3. signal_search_get_results() returns the best candidates by |Pearson r|,
+//    at most one per overlapping bit range of an ID, with the linear scale
+//    and offset that map the raw field onto the reference.
+//
+// Hardware independent; runs unchanged on the host against recorded logs.
+
+#define SIGNAL_SEARCH_MAX_SAMPLES 32768 // 16 B each, allocated per capture
+#define SIGNAL_SEARCH_MAX_IDS 128
+#define SIGNAL_SEARCH_MIN_SAMPLES 32 // Per ID, fewer are not scored
+#define SIGNAL_SEARCH_TOP 16
+#define SIGNAL_SEARCH_WORKERS 2
+
+typedef enum {
+  SIGNAL_SEARCH_IDLE = 0,
+  SIGNAL_SEARCH_CAPTURING,
+  SIGNAL_SEARCH_RUNNING,
+  SIGNAL_SEARCH_DONE,
+} signal_search_state_t;
+
+typedef struct {
+  uint32_t id;      // Sniffer encoding (CAN_SNIFFER_ID_EXT for extended)
+  uint8_t start;    // Little endian: LSB bit index (DBC Intel start bit).
+                    // Big endian: MSB position counting from data[0] bit 7.
+  uint8_t length;   // Bits
+  bool big_endian;
+  bool is_signed;
+  double correlation; // Pearson r against the reference, -1..1
+  float scale;       // reference ~= raw * scale + offset
+  float offset;
+  uint32_t samples;
+} signal_candidate_t;
+
+// Drop any previous capture/results and start capturing. `reference` is
+// the decoded signal signal_search_feed() samples (ECU_SIG_COUNT if the
+// caller supplies values through signal_search_capture() instead).
+esp_err_t signal_search_begin(ecu_signal_id_t reference);
+
+// Ingest hook: captures the frame with the current value of the reference
+// signal, unless it is stale. No-op unless capturing.
+void signal_search_feed(uint32_t id, const uint8_t *data, uint8_t dlc,
+                        uint32_t now_ms);
+
+// Store one frame with an explicit reference value (single producer)
+void signal_search_capture(uint32_t id, const uint8_t *data, uint8_t dlc,
+                           float reference);
+
+// End the capture and start the scoring job on `workers` tasks (one per
+// core: SIGNAL_SEARCH_WORKERS). 0 scores synchronously in the caller,
+// for host tools.
+esp_err_t signal_search_run(int workers);
+
+// Free the capture and results
+void signal_search_end(void);
+
+signal_search_state_t signal_search_get_state(void);
+ecu_signal_id_t signal_search_get_reference(void);
+uint32_t signal_search_get_sample_count(void);
+
+// Job progress in percent (100 once done)
+int signal_search_get_progress(void);
+
+// Ranked candidates, best first. Returns the number written.
+int signal_search_get_results(signal_candidate_t *out, int max);
+
+// Apply a candidate to a payload: raw field * scale + offset
+float signal_search_decode(const signal_candidate_t *c, const uint8_t *data,
+                           uint8_t dlc);
+
+const char *signal_search_state_name(signal_search_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIGNAL_SEARCH_H
@@ -0,0 +1,278 @@
+#include "ui_Screen10.h"
+#include "../ui.h"
+#include "../ui_screen_manager.h"
+#include "../ui_strip_chart.h"
+#include "esp_log.h"
+#include "session_stats.h"
+#include "signal_freshness.h"
+#include <stdio.h>
+
+lv_obj_t *ui_Screen10 = NULL;
+
+LV_FONT_DECLARE(lv_font_montserrat_14);
+LV_FONT_DECLARE(lv_font_montserrat_20);
+
+#define PLOT_W 1280
+#define PLOT_H 300
+#define PLOT_Y 190
+#define LEGEND_REFRESH_MS 250
+
+// Plot scale per signal; {0, 0} = from the session's observed range
+typedef struct {
+  float min;
+  float max;
+} chart_range_t;
+
+static const chart_range_t signal_ranges[ECU_SIG_COUNT] = {
+    [ECU_SIG_RPM] = {0, 8000},         [ECU_SIG_TPS] = {0, 100},
+    [ECU_SIG_PEDAL] = {0, 100},        [ECU_SIG_MAP] = {0, 300},
+    [ECU_SIG_CLT] = {-20, 130},        [ECU_SIG_IAT] = {-20, 80},
+    [ECU_SIG_OIL_TEMP] = {0, 150},     [ECU_SIG_OIL_PRESS] = {0, 700},
+    [ECU_SIG_SPEED] = {0, 280},        [ECU_SIG_BATTERY] = {8, 16},
+    [ECU_SIG_WG_SET] = {0, 100},       [ECU_SIG_WG_POS] = {0, 100},
+    [ECU_SIG_BOV] = {0, 100},          [ECU_SIG_TCU_TQ_REQ] = {0, 600},
+    [ECU_SIG_TCU_TQ_ACT] = {0, 600},   [ECU_SIG_ENG_TRG] = {0, 600},
+    [ECU_SIG_ENG_ACT] = {0, 600},      [ECU_SIG_LIMIT_TQ] = {0, 600},
+    [ECU_SIG_GEAR] = {-1, 8},          [ECU_SIG_SELECTOR] = {0, 8},
+};
+
+static const uint32_t series_colors[UI_STRIP_CHART_MAX_SERIES] = {
+    0x00D4FF, 0xFFAA00, 0x00FF88, 0xFF4081};
+
+// Boost against wastegate by default
+static const ecu_signal_id_t default_series[UI_STRIP_CHART_MAX_SERIES] = {
+    ECU_SIG_MAP, ECU_SIG_WG_SET, ECU_SIG_WG_POS, ECU_SIG_COUNT};
+
+static const uint32_t window_options_ms[] = {10000, 20000, 30000};
+#define WINDOW_OPTION_COUNT                                                    \
+  (sizeof(window_options_ms) / sizeof(window_options_ms[0]))
+#define DEFAULT_WINDOW_OPTION 2
+
+typedef struct {
+  lv_obj_t *dropdown;
+  lv_obj_t *legend;
+  ecu_signal_id_t sig; // ECU_SIG_COUNT = off
+  chart_range_t range;
+} chart_slot_t;
+
+static chart_slot_t slots[UI_STRIP_CHART_MAX_SERIES];
+// Dropdown option -> signal (option 0 is "Off")
+static ecu_signal_id_t option_signal[ECU_SIG_COUNT + 1];
+static int option_count = 0;
+static lv_obj_t *time_labels[3];
+static lv_timer_t *legend_timer = NULL;
+
+static chart_range_t range_for(ecu_signal_id_t sig) {
+  chart_range_t r = signal_ranges[sig];
+  if (r.max > r.min)
+    return r;
+
+  // Derived channels have no fixed scale: fit what the session has seen
+  session_signal_stats_t st;
+  if (session_stats_get(sig, &st) && st.count > 0) {
+    float pad = (st.max - st.min) * 0.1f;
+    if (pad <= 0.0f)
+      pad = 1.0f;
+    r.min = st.min - pad;
+    r.max = st.max + pad;
+  } else {
+    r.min = 0.0f;
+    r.max = 100.0f;
+  }
+  return r;
+}
+
+static void format_value(char *buf, size_t len, float v) {
+  if (v >= 1000.0f || v <= -1000.0f)
+    snprintf(buf, len, "%.0f", v);
+  else
+    snprintf(buf, len, "%.1f", v);
+}
+
+static void update_legend(void) {
+  ecu_data_t data;
+  ecu_data_get_copy(&data);
+
+  for (int i = 0; i < UI_STRIP_CHART_MAX_SERIES; i++) {
+    chart_slot_t *slot = &slots[i];
+    if (slot->sig == ECU_SIG_COUNT) {
+      lv_label_set_text(slot->legend, "");
+      continue;
+    }
+    char value[16];
+    if (signal_freshness_is_stale(slot->sig))
+      snprintf(value, sizeof(value), "--");
+    else
+      format_value(value, sizeof(value),
+                   ecu_data_get_signal(&data, slot->sig));
+    lv_label_set_text_fmt(slot->legend, "%s %s  [%.0f..%.0f]", value,
+                          ecu_signal_unit(slot->sig), slot->range.min,
+                          slot->range.max);
+  }
+}
+
+static void legend_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  // Only spend time on the legend while it is on screen
+  if (lv_scr_act() != ui_Screen10)
+    return;
+  update_legend();
+}
+
+static void apply_slot(int i) {
+  chart_slot_t *slot = &slots[i];
+  if (slot->sig == ECU_SIG_COUNT) {
+    ui_strip_chart_set_series(i, ECU_SIG_COUNT, 0, 0, lv_color_black());
+    return;
+  }
+  slot->range = range_for(slot->sig);
+  ui_strip_chart_set_series(i, slot->sig, slot->range.min, slot->range.max,
+                            lv_color_hex(series_colors[i]));
+}
+
+static void update_time_labels(uint32_t window_ms) {
+  uint32_t s = window_ms / 1000;
+  lv_label_set_text_fmt(time_labels[0], "-%lu s", (unsigned long)s);
+  lv_label_set_text_fmt(time_labels[1], "-%lu s", (unsigned long)(s / 2));
+  lv_label_set_text(time_labels[2], "now");
+}
+
+static void series_dropdown_event_cb(lv_event_t *e) {
+  int i = (int)(intptr_t)lv_event_get_user_data(e);
+  uint16_t opt = lv_dropdown_get_selected(lv_event_get_target(e));
+  slots[i].sig = opt < option_count ? option_signal[opt] : ECU_SIG_COUNT;
+  apply_slot(i);
+  update_legend();
+}
+
+static void window_dropdown_event_cb(lv_event_t *e) {
+  uint16_t opt = lv_dropdown_get_selected(lv_event_get_target(e));
+  if (opt >= WINDOW_OPTION_COUNT)
+    return;
+  ui_strip_chart_set_window(window_options_ms[opt]);
+  update_time_labels(window_options_ms[opt]);
+}
+
+static lv_obj_t *create_dropdown(lv_obj_t *parent, const char *options,
+                                 uint32_t accent) {
+  lv_obj_t *dd = lv_dropdown_create(parent);
+  lv_dropdown_set_options(dd, options);
+  lv_obj_set_style_bg_color(dd, lv_color_hex(0x1a1a1a), 0);
+  lv_obj_set_style_text_color(dd, lv_color_white(), 0);
+  lv_obj_set_style_text_font(dd, &lv_font_montserrat_20, 0);
+  lv_obj_set_style_border_color(dd, lv_color_hex(accent), 0);
+  lv_obj_set_style_border_width(dd, 2, 0);
+  lv_obj_set_style_radius(dd, 8, 0);
+  return dd;
+}
+
+// "Off" then every defined signal; fills option_signal[]
+static void build_signal_options(char *buf, size_t len) {
+  size_t used = (size_t)snprintf(buf, len, "Off");
+  option_signal[0] = ECU_SIG_COUNT;
+  option_count = 1;
+  for (int i = 0; i < ECU_SIG_COUNT && used < len; i++) {
+    if (!ecu_signal_defined((ecu_signal_id_t)i))
+      continue;
+    used += (size_t)snprintf(buf + used, len - used, "\n%s",
+                             ecu_signal_name((ecu_signal_id_t)i));
+    option_signal[option_count++] = (ecu_signal_id_t)i;
+  }
+}
+
+static int option_for(ecu_signal_id_t sig) {
+  for (int i = 0; i < option_count; i++) {
+    if (option_signal[i] == sig)
+      return i;
+  }
+  return 0;
+}
+
+void ui_Screen10_screen_init(void) {
+  ESP_LOGI("SCREEN10", "Initializing Strip Chart");
+
+  ui_Screen10 = lv_obj_create(NULL);
+  lv_obj_set_size(ui_Screen10, 1280, 720);
+  lv_obj_clear_flag(ui_Screen10, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_style_bg_color(ui_Screen10, lv_color_hex(0x121212), 0);
+  lv_obj_set_style_bg_opa(ui_Screen10, LV_OPA_COVER, 0);
+
+  // --- Header ---
+  lv_obj_t *title = lv_label_create(ui_Screen10);
+  lv_label_set_text(title, "STRIP CHART");
+  lv_obj_set_style_text_color(title, lv_color_hex(0x00D4FF), 0);
+  lv_obj_set_style_text_font(title, &lv_font_montserrat_20, 0);
+  lv_obj_set_style_text_letter_space(title, 2, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+
+  lv_obj_t *window_dd =
+      create_dropdown(ui_Screen10, "10 s\n20 s\n30 s", 0x333333);
+  lv_obj_set_width(window_dd, 110);
+  lv_obj_align(window_dd, LV_ALIGN_TOP_RIGHT, -20, 12);
+  lv_dropdown_set_selected(window_dd, DEFAULT_WINDOW_OPTION);
+  lv_obj_add_event_cb(window_dd, window_dropdown_event_cb,
+                      LV_EVENT_VALUE_CHANGED, NULL);
+
+  // --- Plot ---
+  lv_obj_t *plot = ui_strip_chart_create(ui_Screen10, PLOT_W, PLOT_H);
+  if (plot)
+    lv_obj_set_pos(plot, 0, PLOT_Y);
+
+  static const lv_align_t time_align[3] = {
+      LV_ALIGN_TOP_LEFT, LV_ALIGN_TOP_MID, LV_ALIGN_TOP_RIGHT};
+  static const lv_coord_t time_x[3] = {10, 0, -10};
+  for (int i = 0; i < 3; i++) {
+    time_labels[i] = lv_label_create(ui_Screen10);
+    lv_obj_set_style_text_color(time_labels[i], lv_color_hex(0xAAAAAA), 0);
+    lv_obj_set_style_text_font(time_labels[i], &lv_font_montserrat_14, 0);
+    lv_obj_align(time_labels[i], time_align[i], time_x[i], PLOT_Y + PLOT_H + 8);
+  }
+  update_time_labels(window_options_ms[DEFAULT_WINDOW_OPTION]);
+  ui_strip_chart_set_window(window_options_ms[DEFAULT_WINDOW_OPTION]);
+
+  // --- Series selectors and legend ---
+  static char options[ECU_SIG_COUNT * 17 + 4];
+  build_signal_options(options, sizeof(options));
+  for (int i = 0; i < UI_STRIP_CHART_MAX_SERIES; i++) {
+    chart_slot_t *slot = &slots[i];
+    slot->sig = ecu_signal_defined(default_series[i]) ? default_series[i]
+                                                      : ECU_SIG_COUNT;
+
+    slot->dropdown = create_dropdown(ui_Screen10, options, series_colors[i]);
+    lv_obj_set_size(slot->dropdown, 290, LV_SIZE_CONTENT);
+    lv_obj_set_pos(slot->dropdown, 20 + i * 310, 70);
+    lv_dropdown_set_selected(slot->dropdown, (uint16_t)option_for(slot->sig));
+    lv_obj_add_event_cb(slot->dropdown, series_dropdown_event_cb,
+                        LV_EVENT_VALUE_CHANGED, (void *)(intptr_t)i);
+
+    slot->legend = lv_label_create(ui_Screen10);
+    lv_label_set_text(slot->legend, "");
+    lv_obj_set_style_text_color(slot->legend, lv_color_hex(series_colors[i]),
+                                0);
+    lv_obj_set_style_text_font(slot->legend, &lv_font_montserrat_14, 0);
+    lv_obj_set_pos(slot->legend, 24 + i * 310, 135);
+
+    if (plot)
+      apply_slot(i);
+  }
+
+  // Navigation
+  lv_obj_add_event_cb(ui_Screen10, ui_screen_swipe_event_cb, LV_EVENT_GESTURE,
+                      NULL);
+  ui_create_standard_navigation_buttons(ui_Screen10);
+
+  legend_timer = lv_timer_create(legend_timer_cb, LEGEND_REFRESH_MS, NULL);
+  update_legend();
+}
+
+void ui_Screen10_screen_destroy(void) {
+  if (legend_timer) {
+    lv_timer_del(legend_timer);
+    legend_timer = NULL;
+  }
+  if (ui_Screen10) {
+    // Deletes the chart, which stops its timer and frees the plot buffer
+    lv_obj_del(ui_Screen10);
+    ui_Screen10 = NULL;
+  }
+}
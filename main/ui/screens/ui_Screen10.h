@@ -0,0 +1,22 @@
+// ECU Dashboard Screen 10 - Strip Chart
+// Up to four selectable signals over a scrolling time window
+
+#ifndef UI_SCREEN10_H
+#define UI_SCREEN10_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../ui.h"
+
+extern lv_obj_t *ui_Screen10;
+
+void ui_Screen10_screen_init(void);
+void ui_Screen10_screen_destroy(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
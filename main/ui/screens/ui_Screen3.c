@@ -3,13 +3,16 @@
 
 #include "ui_Screen3.h"
 #include "../ui.h"
+#include "can_filter.h"
 #include "can_logger.h" // Include logger
 #include "can_manager.h"
+#include "can_sniffer.h"
 #include "ui_Screen1.h"
 #include "ui_Screen2.h"
 #include "ui_events.h"
 #include "ui_helpers.h"
 #include "ui_screen_manager.h"
+#include "esp_timer.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,12 +39,17 @@ void *ui_Slider_UpdateSpeed;
 void *ui_TextArea_Search;
 // void * ui_Slider_UpdateSpeed; // Removed
 // void * ui_Label_UpdateSpeed; // Removed
-void *ui_Panel_FilterList; // Container for ID checkboxes
+void *ui_Label_View_Info;   // "IDs / hidden / rows" line
+void *ui_Button_Sort;
+void *ui_Button_Hide;
+void *ui_Label_Bit_Heat;
+void *ui_Table_Bit_Heat; // 8 bytes x 8 bits of the selected ID
 
 // CAN Terminal state
-static int can_message_count = 0;
 static int can_sniffer_active = 1; // Sniffer mode active
-static char search_text[64] = "";
+static char search_text[CAN_FILTER_MAX_EXPR + 1] = "";
+static char filter_text[CAN_FILTER_MAX_EXPR + 1] = ""; // Last valid search
+static can_filter_t search_filter;                    // Compiled filter_text
 // static int update_speed_ms = 100;    // Removed global update speed
 
 // Sniffer state
@@ -49,52 +57,88 @@ static int last_can_id = 0;
 static uint8_t last_can_data[8] = {0};
 static uint8_t last_can_dlc = 0;
 
-// Table state
-#define MAX_CAN_IDS 100 // Increased limit
+// Table refresh. The CAN task only updates the can_sniffer model; this
+// timer applies the IDs whose payload changed, so the LVGL cost per refresh
+// is bounded by the number of IDs, not the bus load.
+#define SNIFFER_REFRESH_MS 100
 
-typedef struct {
-  uint32_t id;
-  int row_index;
-  bool visible;
-  lv_obj_t *checkbox;
-  uint32_t last_update_time;
-} can_row_t;
+// The table is virtual: a fixed window of rows showing a slice of the view
+// (known IDs, minus hidden ones and search misses, in sort order). LVGL
+// cost and object count depend on the window, not on how busy the bus is.
+#define SNIFFER_VIEW_ROWS 16
+
+typedef enum {
+  SORT_BY_ID = 0,
+  SORT_BY_RATE,   // Fastest first
+  SORT_BY_CHANGE, // Most recent payload change first
+  SORT_MODE_COUNT
+} sniffer_sort_t;
+
+static const char *const sort_names[SORT_MODE_COUNT] = {
+    "SORT: ID", "SORT: RATE", "SORT: CHANGE"};
 
-static can_row_t can_rows[MAX_CAN_IDS];
-static int can_row_count = 0;
+typedef struct {
+  uint32_t key;
+  uint16_t index; // Sniffer model index
+} view_item_t;
+
+static lv_timer_t *sniffer_timer = NULL;
+static uint32_t shown_total = UINT32_MAX; // Value on the "Messages" label
+static bool refresh_all = true; // Redraw every row (clear, filter, search)
+static bool view_stale = true;  // Rebuild the view before drawing
+
+static sniffer_sort_t sort_mode = SORT_BY_ID;
+static uint32_t hidden_ids[CAN_SNIFFER_DIRTY_WORDS]; // Bit n = model entry n
+static view_item_t *view = NULL; // CAN_SNIFFER_MAX_IDS items, with the screen
+static int view_len = 0;
+static int view_top = 0;   // View position of the first table row
+static int known_ids = 0;  // Model entries included in the last rebuild
+static int row_entry[SNIFFER_VIEW_ROWS]; // Model index per table row, -1 blank
+
+// RATE/CHANGE order and search hits follow live values; re-sort at this
+// pace so rows do not reshuffle on every refresh
+#define SNIFFER_RESORT_TICKS 5
+static int resort_ticks = 0;
+
+static int shown_info[5] = {-1, -1, -1, -1, -1}; // Values on the info label
+
+// Table columns: ID, DLC, one per payload byte, ASCII
+#define COL_ID 0
+#define COL_DLC 1
+#define COL_BYTE0 2
+#define COL_ASCII (COL_BYTE0 + 8)
+#define COL_COUNT (COL_ASCII + 1)
+
+// Byte highlighting: a changed byte starts hot and cools to the normal
+// colour over SNIFFER_HEAT_MS. The level is cached per cell and the table
+// is only invalidated when one steps, so idle rows cost nothing to keep.
+#define SNIFFER_HEAT_MS 2000
+#define SNIFFER_HEAT_LEVELS 4
+static uint32_t row_byte_ms[SNIFFER_VIEW_ROWS][8]; // Copied from the entry
+static uint8_t row_heat[SNIFFER_VIEW_ROWS][8];     // 0 = cold
+
+// Bit heatmap of the selected ID: bits toggled since the last CLEAR
+static int selected_index = -1; // Model index, -1 = none
+static int heat_index = -1;     // Entry the heatmap currently shows
+static uint64_t heat_data;      // Payload shown in the heatmap cells
+static uint64_t heat_toggled;   // Toggled bits the heatmap is coloured by
+
+static inline bool bit_test(const uint32_t *set, int n) {
+  return (set[n / 32] >> (n % 32)) & 1u;
+}
 
 // ... (structs)
 
 // ...
 
+// Show every hidden ID again, scroll back to the top and start a new
+// toggled-bits window for the heatmap
 void ui_clear_can_terminal(void) {
-  if (ui_Table_CAN_List) {
-    // 1. Reset table to header only
-    lv_table_set_row_cnt((lv_obj_t *)ui_Table_CAN_List, 1);
-
-    // 2. Re-populate with visible rows
-    int new_table_row = 1;
-    for (int i = 0; i < can_row_count; i++) {
-      if (can_rows[i].visible) {
-        // Update index
-        can_rows[i].row_index = new_table_row;
-
-        // Set ID cell (Data cells will be empty until next update)
-        char id_str[16];
-        snprintf(id_str, sizeof(id_str), "%03X", (unsigned int)can_rows[i].id);
-        lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, new_table_row, 0,
-                                id_str);
-
-        new_table_row++;
-      } else {
-        can_rows[i].row_index = -1;
-      }
-    }
-
-    // 3. Do NOT reset message count (per user request)
-    // can_message_count = 0;
-    // lv_label_set_text((lv_obj_t*)ui_Label_CAN_Count, "Messages: 0");
-  }
+  memset(hidden_ids, 0, sizeof(hidden_ids));
+  can_sniffer_reset_changes();
+  view_top = 0;
+  view_stale = true;
+  refresh_all = true;
 }
 
 // Function prototypes
@@ -106,18 +150,15 @@ static void sniffer_button_event_cb(lv_event_t *e);
 static void record_button_event_cb(lv_event_t *e); // New callback
 static void search_text_event_cb(lv_event_t *e);
 // static void update_speed_slider_event_cb(lv_event_t * e); // Removed
-static void filter_checkbox_event_cb(lv_event_t *e);
+static void table_click_event_cb(lv_event_t *e);
+static void sort_button_event_cb(lv_event_t *e);
+static void scroll_button_event_cb(lv_event_t *e);
+static void hide_button_event_cb(lv_event_t *e);
+static void can_table_draw_event_cb(lv_event_t *e);
+static void heat_table_draw_event_cb(lv_event_t *e);
 // static int is_message_matches_search(const char* message);
 
-// CAN Sniffer functions
-// static void can_sniffer_add_message(uint32_t id, uint8_t *data, uint8_t dlc);
-// // Removed unused declaration
-// // Removed static declaration static void can_sniffer_format_message(char
-// *buffer, size_t size, uint32_t id, uint8_t *data, uint8_t dlc);
-static int can_sniffer_is_id_filtered(uint32_t id);
-static int can_sniffer_search_in_data(uint8_t *data, uint8_t dlc,
-                                      const char *search_term);
-static void can_sniffer_update_statistics(uint32_t id);
+static void sniffer_refresh_cb(lv_timer_t *timer);
 
 // Clear button event callback
 static void clear_button_event_cb(lv_event_t *e) {
@@ -155,6 +196,7 @@ static void record_button_event_cb(lv_event_t *e) {
                                 lv_color_hex(0x00FF88), 0); // Green (Idle)
     } else {
       can_logger_set_stop_callback(logger_stop_callback);
+      can_logger_set_filter(filter_text); // Record what the table shows
       can_logger_start();
       lv_obj_set_style_bg_color((lv_obj_t *)ui_Button_Record,
                                 lv_color_hex(0xFF3366), 0); // Red (Recording)
@@ -191,14 +233,31 @@ static void sniffer_button_event_cb(lv_event_t *e) {
   }
 }
 
+// Compile the search box once per edit. Text that does not compile (e.g.
+// half typed) keeps the previous filter and outlines the box in red.
+static void apply_search(const char *text) {
+  snprintf(search_text, sizeof(search_text), "%s", text);
+
+  can_filter_t compiled;
+  bool valid = can_filter_compile(search_text, &compiled) == ESP_OK;
+  if (valid) {
+    search_filter = compiled;
+    snprintf(filter_text, sizeof(filter_text), "%s", search_text);
+    view_top = 0;
+    view_stale = true;
+  }
+  if (ui_TextArea_Search)
+    lv_obj_set_style_border_width((lv_obj_t *)ui_TextArea_Search,
+                                  valid ? 0 : 2, 0);
+}
+
 // Search text event callback
 static void search_text_event_cb(lv_event_t *e) {
   lv_event_code_t code = lv_event_get_code(e);
   if (code == LV_EVENT_VALUE_CHANGED) {
     const char *text = lv_textarea_get_text((lv_obj_t *)ui_TextArea_Search);
-    if (text) {
-      snprintf(search_text, sizeof(search_text), "%s", text);
-    }
+    if (text)
+      apply_search(text);
   }
 }
 
@@ -210,24 +269,109 @@ static void update_speed_slider_event_cb(lv_event_t * e) {
 }
 */
 
-// Filter checkbox event callback
-static void filter_checkbox_event_cb(lv_event_t *e) {
-  lv_event_code_t code = lv_event_get_code(e);
-  if (code == LV_EVENT_VALUE_CHANGED) {
-    lv_obj_t *cb = (lv_obj_t *)e->target;
-    bool checked = lv_obj_has_state(cb, LV_STATE_CHECKED);
-    uint32_t id = (uint32_t)(uintptr_t)lv_obj_get_user_data(cb);
-
-    // Update visibility in tracker
-    for (int i = 0; i < can_row_count; i++) {
-      if (can_rows[i].id == id) {
-        can_rows[i].visible = checked;
-        break;
-      }
-    }
+// Tapping a row selects its ID for the bit heatmap and HIDE
+static void table_click_event_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) != LV_EVENT_VALUE_CHANGED)
+    return;
+
+  uint16_t row, col;
+  lv_table_get_selected_cell((lv_obj_t *)ui_Table_CAN_List, &row, &col);
+  if (row == LV_TABLE_CELL_NONE || row == 0 || row > SNIFFER_VIEW_ROWS)
+    return;
+
+  int index = row_entry[row - 1];
+  if (index >= 0 && index != selected_index) {
+    selected_index = index;
+    lv_obj_invalidate((lv_obj_t *)ui_Table_CAN_List); // Selection highlight
+  }
+}
+
+// Hide the selected ID (CLEAR shows everything again)
+static void hide_button_event_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) != LV_EVENT_CLICKED || selected_index < 0)
+    return;
+
+  hidden_ids[selected_index / 32] |= 1u << (selected_index % 32);
+  selected_index = -1;
+  view_stale = true;
+}
+
+static uint8_t heat_level(uint32_t changed_ms, uint32_t now_ms) {
+  uint32_t age = now_ms - changed_ms;
+  if (age >= SNIFFER_HEAT_MS)
+    return 0;
+  return (uint8_t)(SNIFFER_HEAT_LEVELS -
+                   age * SNIFFER_HEAT_LEVELS / SNIFFER_HEAT_MS);
+}
+
+// Colours byte cells by their cached heat and marks the selected row
+static void can_table_draw_event_cb(lv_event_t *e) {
+  lv_obj_draw_part_dsc_t *dsc = lv_event_get_draw_part_dsc(e);
+  if (dsc->part != LV_PART_ITEMS)
+    return;
+
+  uint32_t row = dsc->id / COL_COUNT;
+  uint32_t col = dsc->id % COL_COUNT;
+  if (row == 0 || row > SNIFFER_VIEW_ROWS)
+    return;
+
+  int r = (int)row - 1;
+  if (selected_index >= 0 && row_entry[r] == selected_index)
+    dsc->rect_dsc->bg_color = lv_color_hex(0x10304A);
+
+  if (col >= COL_BYTE0 && col < COL_ASCII) {
+    uint8_t level = row_heat[r][col - COL_BYTE0];
+    if (level)
+      dsc->label_dsc->color =
+          lv_color_mix(lv_color_hex(0xFF3366), lv_color_hex(0x00FF88),
+                       (uint8_t)(level * 255 / SNIFFER_HEAT_LEVELS));
+  }
+}
+
+// Heatmap cells: row = byte, column 0 = label, columns 1..8 = bit 7..0
+static void heat_table_draw_event_cb(lv_event_t *e) {
+  lv_obj_draw_part_dsc_t *dsc = lv_event_get_draw_part_dsc(e);
+  if (dsc->part != LV_PART_ITEMS || heat_index < 0)
+    return;
+
+  uint32_t byte = dsc->id / 9;
+  uint32_t col = dsc->id % 9;
+  if (col == 0)
+    return;
+
+  uint32_t bit = byte * 8 + (8 - col);
+  if ((heat_toggled >> bit) & 1u) {
+    dsc->rect_dsc->bg_color = lv_color_hex(0xFF3366);
+    dsc->label_dsc->color = lv_color_white();
   }
 }
 
+static void sort_button_event_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) != LV_EVENT_CLICKED)
+    return;
+
+  sort_mode = (sniffer_sort_t)((sort_mode + 1) % SORT_MODE_COUNT);
+  lv_obj_t *label = lv_obj_get_child((lv_obj_t *)ui_Button_Sort, 0);
+  if (label)
+    lv_label_set_text(label, sort_names[sort_mode]);
+  view_top = 0;
+  view_stale = true;
+}
+
+// user_data: -1 = page up, +1 = page down
+static void scroll_button_event_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) != LV_EVENT_CLICKED)
+    return;
+
+  int dir = (int)(intptr_t)lv_event_get_user_data(e);
+  int max_top = view_len > SNIFFER_VIEW_ROWS ? view_len - SNIFFER_VIEW_ROWS : 0;
+  view_top += dir * SNIFFER_VIEW_ROWS;
+  if (view_top > max_top)
+    view_top = max_top;
+  if (view_top < 0)
+    view_top = 0;
+}
+
 /*
 // Check if message matches search text (Search temporarily disabled for static
 table) static int is_message_matches_search(const char* message) { if
@@ -288,8 +432,9 @@ void ui_Screen3_screen_init(void) {
   ui_Table_CAN_List = lv_table_create(terminal_cont);
   lv_obj_set_width((lv_obj_t *)ui_Table_CAN_List, 400); // match container
   lv_obj_set_height((lv_obj_t *)ui_Table_CAN_List,
-                    LV_SIZE_CONTENT); // Allow scrolling
+                    410); // Fixed window, paged with the arrow buttons
   lv_obj_set_pos((lv_obj_t *)ui_Table_CAN_List, 0, 0);
+  lv_obj_clear_flag((lv_obj_t *)ui_Table_CAN_List, LV_OBJ_FLAG_SCROLLABLE);
 
   // Style for the main table background (transparent)
   lv_obj_set_style_bg_color((lv_obj_t *)ui_Table_CAN_List,
@@ -312,24 +457,42 @@ void ui_Screen3_screen_init(void) {
   lv_obj_set_style_border_side((lv_obj_t *)ui_Table_CAN_List,
                                LV_BORDER_SIDE_BOTTOM,
                                LV_PART_ITEMS); // Only bottom border for rows
+  lv_obj_set_style_pad_ver((lv_obj_t *)ui_Table_CAN_List, 3, LV_PART_ITEMS);
 
   lv_obj_set_style_text_font((lv_obj_t *)ui_Table_CAN_List,
                              &lv_font_montserrat_12, 0);
 
   // Configure table columns
-  lv_table_set_col_cnt((lv_obj_t *)ui_Table_CAN_List, 4);
-  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, 0, 60);  // ID
-  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, 1, 40);  // DLC
-  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, 2, 200); // DATA
-  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, 3, 100); // ASCII
+  // One column per data byte so each can be coloured on its own
+  lv_obj_set_style_pad_hor((lv_obj_t *)ui_Table_CAN_List, 2, LV_PART_ITEMS);
+  lv_table_set_col_cnt((lv_obj_t *)ui_Table_CAN_List, COL_COUNT);
+  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, COL_ID, 72);
+  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, COL_DLC, 30);
+  for (int i = 0; i < 8; i++)
+    lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, COL_BYTE0 + i, 27);
+  lv_table_set_col_width((lv_obj_t *)ui_Table_CAN_List, COL_ASCII, 80);
 
   // Set headers
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, 0, "ID");
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, 1, "DLC");
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, 2, "DATA");
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, 3, "ASCII");
-
-  can_row_count = 0;
+  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, COL_ID, "ID");
+  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, COL_DLC, "DLC");
+  for (int i = 0; i < 8; i++) {
+    char hdr[4];
+    snprintf(hdr, sizeof(hdr), "B%d", i);
+    lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, COL_BYTE0 + i,
+                            hdr);
+  }
+  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, 0, COL_ASCII,
+                          "ASCII");
+
+  // Rows are created once; the refresh timer only rewrites their text
+  lv_table_set_row_cnt((lv_obj_t *)ui_Table_CAN_List, 1 + SNIFFER_VIEW_ROWS);
+  for (int r = 0; r < SNIFFER_VIEW_ROWS; r++)
+    row_entry[r] = -1;
+  lv_obj_add_event_cb((lv_obj_t *)ui_Table_CAN_List, table_click_event_cb,
+                      LV_EVENT_VALUE_CHANGED, NULL);
+  lv_obj_add_event_cb((lv_obj_t *)ui_Table_CAN_List, can_table_draw_event_cb,
+                      LV_EVENT_DRAW_PART_BEGIN, NULL);
+  memset(row_heat, 0, sizeof(row_heat));
 
   // RIGHT SIDE PANEL - Controls and Status
   lv_obj_t *right_panel = lv_obj_create(ui_Screen3);
@@ -417,7 +580,9 @@ void ui_Screen3_screen_init(void) {
   ui_Button_Record = lv_btn_create(control_cont);
   lv_obj_set_size((lv_obj_t *)ui_Button_Record, 60, 30);
   lv_obj_set_style_bg_color((lv_obj_t *)ui_Button_Record,
-                            lv_color_hex(0x00FF88), 0); // Green (Idle)
+                            can_logger_is_recording() ? lv_color_hex(0xFF3366)
+                                                      : lv_color_hex(0x00FF88),
+                            0); // Rebuilt screens pick up a running recording
   lv_obj_set_style_radius((lv_obj_t *)ui_Button_Record, 15, 0);
   lv_obj_add_event_cb((lv_obj_t *)ui_Button_Record, record_button_event_cb,
                       LV_EVENT_CLICKED, NULL);
@@ -455,11 +620,15 @@ void ui_Screen3_screen_init(void) {
   lv_obj_set_style_text_color((lv_obj_t *)ui_TextArea_Search, lv_color_white(),
                               0);
   lv_obj_set_style_border_width((lv_obj_t *)ui_TextArea_Search, 0, 0);
+  lv_obj_set_style_border_color((lv_obj_t *)ui_TextArea_Search,
+                                lv_color_hex(0xFF3366), 0); // Invalid filter
   lv_obj_set_style_radius((lv_obj_t *)ui_TextArea_Search, 5, 0);
   lv_obj_set_style_text_font((lv_obj_t *)ui_TextArea_Search,
                              &lv_font_montserrat_12, 0);
+  lv_textarea_set_max_length((lv_obj_t *)ui_TextArea_Search,
+                             CAN_FILTER_MAX_EXPR);
   lv_textarea_set_placeholder_text((lv_obj_t *)ui_TextArea_Search,
-                                   "Enter search text...");
+                                   "280:xx 1F | 200-2FF: | \"text\"");
   lv_obj_add_event_cb((lv_obj_t *)ui_TextArea_Search, search_text_event_cb,
                       LV_EVENT_VALUE_CHANGED, NULL);
 
@@ -468,165 +637,377 @@ void ui_Screen3_screen_init(void) {
   // ... code removed ...
   */
 
-  // --- Filter List Container (Bottom Right) ---
-  lv_obj_t *filter_label = lv_label_create(right_panel);
-  lv_label_set_text(filter_label, "Filter IDs:");
-  lv_obj_set_style_text_color(filter_label, lv_color_hex(0x00D4FF), 0);
-  lv_obj_set_style_text_font(filter_label, &lv_font_montserrat_12, 0);
-  lv_obj_align(filter_label, LV_ALIGN_LEFT_MID, 0, 0);
-
-  ui_Panel_FilterList = lv_obj_create(right_panel);
-  lv_obj_set_width((lv_obj_t *)ui_Panel_FilterList, LV_PCT(100));
-  lv_obj_set_flex_grow((lv_obj_t *)ui_Panel_FilterList,
-                       1); // Fill remaining space
-  lv_obj_set_style_bg_color((lv_obj_t *)ui_Panel_FilterList,
-                            lv_color_hex(0x1a1a1a), 0);
-  lv_obj_set_style_border_width((lv_obj_t *)ui_Panel_FilterList, 0, 0);
-  lv_obj_set_style_pad_all((lv_obj_t *)ui_Panel_FilterList, 5, 0);
-  lv_obj_set_flex_flow((lv_obj_t *)ui_Panel_FilterList, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_style_pad_gap((lv_obj_t *)ui_Panel_FilterList, 5, 0);
-  lv_obj_set_style_radius((lv_obj_t *)ui_Panel_FilterList, 5, 0);
-}
+  // --- View row: paging and sort order ---
+  lv_obj_t *view_cont = lv_obj_create(right_panel);
+  lv_obj_remove_style_all(view_cont);
+  lv_obj_set_width(view_cont, LV_PCT(100));
+  lv_obj_set_height(view_cont, LV_SIZE_CONTENT);
+  lv_obj_set_flex_flow(view_cont, LV_FLEX_FLOW_ROW);
+  lv_obj_set_style_pad_gap(view_cont, 5, 0);
+  lv_obj_set_flex_align(view_cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER,
+                        LV_FLEX_ALIGN_CENTER);
 
-// Destroy Screen3
-void ui_Screen3_screen_destroy(void) { lv_obj_del(ui_Screen3); }
+  static const struct {
+    const char *symbol;
+    int dir;
+  } page_buttons[] = {{LV_SYMBOL_UP, -1}, {LV_SYMBOL_DOWN, 1}};
+  for (size_t i = 0; i < sizeof(page_buttons) / sizeof(page_buttons[0]);
+       i++) {
+    lv_obj_t *btn = lv_btn_create(view_cont);
+    lv_obj_set_size(btn, 50, 30);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(0x333333), 0);
+    lv_obj_set_style_radius(btn, 15, 0);
+    lv_obj_add_event_cb(btn, scroll_button_event_cb, LV_EVENT_CLICKED,
+                        (void *)(intptr_t)page_buttons[i].dir);
+
+    lv_obj_t *label = lv_label_create(btn);
+    lv_label_set_text(label, page_buttons[i].symbol);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_obj_center(label);
+  }
 
-// Add/Update CAN message in table
-void ui_add_can_message(uint32_t id, uint8_t *data, uint8_t dlc) {
-  if (!ui_Table_CAN_List)
-    return;
+  ui_Button_Sort = lv_btn_create(view_cont);
+  lv_obj_set_size((lv_obj_t *)ui_Button_Sort, 100, 30);
+  lv_obj_set_style_bg_color((lv_obj_t *)ui_Button_Sort, lv_color_hex(0x00D4FF),
+                            0);
+  lv_obj_set_style_radius((lv_obj_t *)ui_Button_Sort, 15, 0);
+  lv_obj_add_event_cb((lv_obj_t *)ui_Button_Sort, sort_button_event_cb,
+                      LV_EVENT_CLICKED, NULL);
 
-  // Check search text (if needed, but user wants static rows, so maybe just
-  // highlight?) For now, we'll filter out if it doesn't match search Note: We
-  // need to convert data to string to check search, which is expensive. Let's
-  // skip search for now or implement it later if requested.
+  lv_obj_t *sort_label = lv_label_create((lv_obj_t *)ui_Button_Sort);
+  lv_label_set_text(sort_label, sort_names[sort_mode]);
+  lv_obj_set_style_text_color(sort_label, lv_color_black(), 0);
+  lv_obj_set_style_text_font(sort_label, &lv_font_montserrat_12, 0);
+  lv_obj_center(sort_label);
 
-  int row_idx = -1;
+  ui_Button_Hide = lv_btn_create(view_cont);
+  lv_obj_set_size((lv_obj_t *)ui_Button_Hide, 60, 30);
+  lv_obj_set_style_bg_color((lv_obj_t *)ui_Button_Hide, lv_color_hex(0x333333),
+                            0);
+  lv_obj_set_style_radius((lv_obj_t *)ui_Button_Hide, 15, 0);
+  lv_obj_add_event_cb((lv_obj_t *)ui_Button_Hide, hide_button_event_cb,
+                      LV_EVENT_CLICKED, NULL);
 
-  // Find existing row
-  for (int i = 0; i < can_row_count; i++) {
-    if (can_rows[i].id == id) {
-      // Check if ID is filtered out
-      if (!can_rows[i].visible)
-        return;
+  lv_obj_t *hide_label = lv_label_create((lv_obj_t *)ui_Button_Hide);
+  lv_label_set_text(hide_label, "HIDE");
+  lv_obj_set_style_text_color(hide_label, lv_color_white(), 0);
+  lv_obj_set_style_text_font(hide_label, &lv_font_montserrat_12, 0);
+  lv_obj_center(hide_label);
+
+  ui_Label_View_Info = lv_label_create(right_panel);
+  lv_label_set_text((lv_obj_t *)ui_Label_View_Info, "IDs: 0");
+  lv_obj_set_style_text_color((lv_obj_t *)ui_Label_View_Info,
+                              lv_color_hex(0x00D4FF), 0);
+  lv_obj_set_style_text_font((lv_obj_t *)ui_Label_View_Info,
+                             &lv_font_montserrat_12, 0);
 
-      // Check if ID is in the table (row_index != -1)
-      if (can_rows[i].row_index != -1) {
-        row_idx = can_rows[i].row_index;
+  lv_obj_t *hint_label = lv_label_create(right_panel);
+  lv_label_set_text(hint_label,
+                    "Tap a row to inspect its bits. CLEAR shows hidden IDs\n"
+                    "and restarts the toggled-bit history.");
+  lv_obj_set_style_text_color(hint_label, lv_color_hex(0x888888), 0);
+  lv_obj_set_style_text_font(hint_label, &lv_font_montserrat_10, 0);
+
+  // --- Bit heatmap of the selected ID ---
+  ui_Label_Bit_Heat = lv_label_create(right_panel);
+  lv_label_set_text((lv_obj_t *)ui_Label_Bit_Heat, "Bits: no ID selected");
+  lv_obj_set_style_text_color((lv_obj_t *)ui_Label_Bit_Heat,
+                              lv_color_hex(0x00D4FF), 0);
+  lv_obj_set_style_text_font((lv_obj_t *)ui_Label_Bit_Heat,
+                             &lv_font_montserrat_12, 0);
 
-        // Per-row rate limiting (50ms)
-        uint32_t now = lv_tick_get();
-        if (now - can_rows[i].last_update_time < 50) {
-          return; // Too fast, skip update
-        }
-        can_rows[i].last_update_time = now;
-      } else {
-        // ID exists but was cleared from table. Re-add it.
-        uint32_t table_row_count =
-            lv_table_get_row_cnt((lv_obj_t *)ui_Table_CAN_List);
-        row_idx = table_row_count;
-        can_rows[i].row_index = row_idx;
-        can_rows[i].last_update_time = lv_tick_get();
-
-        // Set ID cell
-        char id_str[16];
-        snprintf(id_str, sizeof(id_str), "%03X",
-                 (unsigned int)id); // Format: 101
-        lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, row_idx, 0,
-                                id_str);
-      }
-      break;
-    }
+  ui_Table_Bit_Heat = lv_table_create(right_panel);
+  lv_obj_clear_flag((lv_obj_t *)ui_Table_Bit_Heat, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag((lv_obj_t *)ui_Table_Bit_Heat, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_set_style_bg_color((lv_obj_t *)ui_Table_Bit_Heat,
+                            lv_color_hex(0x1a1a1a), LV_PART_ITEMS);
+  lv_obj_set_style_text_color((lv_obj_t *)ui_Table_Bit_Heat,
+                              lv_color_hex(0x666666), LV_PART_ITEMS);
+  lv_obj_set_style_border_width((lv_obj_t *)ui_Table_Bit_Heat, 0, 0);
+  lv_obj_set_style_pad_all((lv_obj_t *)ui_Table_Bit_Heat, 0, 0);
+  lv_obj_set_style_border_width((lv_obj_t *)ui_Table_Bit_Heat, 1,
+                                LV_PART_ITEMS);
+  lv_obj_set_style_border_color((lv_obj_t *)ui_Table_Bit_Heat,
+                                lv_color_hex(0x000000), LV_PART_ITEMS);
+  lv_obj_set_style_pad_all((lv_obj_t *)ui_Table_Bit_Heat, 1, LV_PART_ITEMS);
+  lv_obj_set_style_text_align((lv_obj_t *)ui_Table_Bit_Heat,
+                              LV_TEXT_ALIGN_CENTER, LV_PART_ITEMS);
+  lv_obj_set_style_text_font((lv_obj_t *)ui_Table_Bit_Heat,
+                             &lv_font_montserrat_10, 0);
+  lv_table_set_col_cnt((lv_obj_t *)ui_Table_Bit_Heat, 9);
+  lv_table_set_row_cnt((lv_obj_t *)ui_Table_Bit_Heat, 8);
+  lv_table_set_col_width((lv_obj_t *)ui_Table_Bit_Heat, 0, 34);
+  for (int col = 1; col < 9; col++)
+    lv_table_set_col_width((lv_obj_t *)ui_Table_Bit_Heat, col, 30);
+  for (int byte = 0; byte < 8; byte++) {
+    char label[4];
+    snprintf(label, sizeof(label), "B%d", byte);
+    lv_table_set_cell_value((lv_obj_t *)ui_Table_Bit_Heat, byte, 0, label);
   }
+  lv_obj_add_event_cb((lv_obj_t *)ui_Table_Bit_Heat, heat_table_draw_event_cb,
+                      LV_EVENT_DRAW_PART_BEGIN, NULL);
+  selected_index = -1;
+  heat_index = -1;
+
+  view = malloc(CAN_SNIFFER_MAX_IDS * sizeof(view_item_t));
+  view_len = 0;
+  view_top = 0;
+  known_ids = 0;
+  view_stale = true;
+  memset(shown_info, 0xFF, sizeof(shown_info));
+
+  shown_total = UINT32_MAX;
+  refresh_all = true;
+  sniffer_timer = lv_timer_create(sniffer_refresh_cb, SNIFFER_REFRESH_MS, NULL);
+}
 
-  // If not found (New ID), add new row
-  if (row_idx == -1) {
-    // Only add if we haven't reached max tracked IDs
-    if (can_row_count >= MAX_CAN_IDS) {
-      return; // Tracker full
-    }
+// Destroy Screen3
+void ui_Screen3_screen_destroy(void) {
+  if (sniffer_timer) {
+    lv_timer_del(sniffer_timer);
+    sniffer_timer = NULL;
+  }
+  free(view);
+  view = NULL;
+  view_len = 0;
+  if (ui_Screen3)
+    lv_obj_del(ui_Screen3);
+  ui_Screen3 = NULL;
+
+  // The logger's stop callback may still fire for a recording started here
+  ui_Table_CAN_List = NULL;
+  ui_Label_CAN_Status = NULL;
+  ui_Label_CAN_Count = NULL;
+  ui_Button_Clear = NULL;
+  ui_Button_Sniffer = NULL;
+  ui_Button_Record = NULL;
+  ui_TextArea_Search = NULL;
+  ui_Slider_UpdateSpeed = NULL;
+  ui_Label_View_Info = NULL;
+  ui_Button_Sort = NULL;
+  ui_Button_Hide = NULL;
+  ui_Label_Bit_Heat = NULL;
+  ui_Table_Bit_Heat = NULL;
+}
 
-    // Add to tracker
-    can_rows[can_row_count].id = id;
-    can_rows[can_row_count].visible = true; // Visible by default
-    can_rows[can_row_count].last_update_time = lv_tick_get();
-
-    // Add to table
-    uint32_t table_row_count =
-        lv_table_get_row_cnt((lv_obj_t *)ui_Table_CAN_List);
-    row_idx = table_row_count;
-    can_rows[can_row_count].row_index = row_idx;
-
-    // Create checkbox in filter list
-    if (ui_Panel_FilterList) {
-      lv_obj_t *cb = lv_checkbox_create((lv_obj_t *)ui_Panel_FilterList);
-      char cb_text[16];
-      snprintf(cb_text, sizeof(cb_text), "%03X",
-               (unsigned int)id); // Format: 101
-      lv_checkbox_set_text(cb, cb_text);
-      lv_obj_add_state(cb, LV_STATE_CHECKED);
-      lv_obj_set_style_text_color(cb, lv_color_white(), 0);
-      lv_obj_set_style_text_font(cb, &lv_font_montserrat_12, 0);
-      lv_obj_add_event_cb(cb, filter_checkbox_event_cb, LV_EVENT_VALUE_CHANGED,
-                          NULL);
-      lv_obj_set_user_data(cb, (void *)(uintptr_t)id); // Store ID in user data
-      can_rows[can_row_count].checkbox = cb;
+static uint32_t view_key(const can_sniffer_entry_t *e) {
+  switch (sort_mode) {
+  case SORT_BY_RATE:
+    return e->period_ms ? e->period_ms : UINT32_MAX; // Seen once: last
+  case SORT_BY_CHANGE:
+    return ~e->changed_ms;
+  default:
+    return e->id; // Extended IDs carry CAN_SNIFFER_ID_EXT, so sort last
+  }
+}
+
+static int view_item_cmp(const void *a, const void *b) {
+  const view_item_t *x = a, *y = b;
+  if (x->key != y->key)
+    return x->key < y->key ? -1 : 1;
+  return (int)x->index - (int)y->index;
+}
+
+// Collect the visible model entries in sort order. O(IDs); runs only when
+// the set or order can have changed, not per frame.
+static void rebuild_view(int count) {
+  view_len = 0;
+  view_stale = false;
+  for (int i = 0; i < count; i++) {
+    if (bit_test(hidden_ids, i))
+      continue;
+
+    can_sniffer_entry_t e;
+    if (!can_sniffer_read(i, &e)) {
+      view_stale = true; // Producer busy; pick it up next refresh
+      continue;
     }
+    if (!can_filter_match(&search_filter, e.id, e.data, e.dlc))
+      continue;
+    view[view_len].key = view_key(&e);
+    view[view_len].index = (uint16_t)i;
+    view_len++;
+  }
+  qsort(view, view_len, sizeof(view_item_t), view_item_cmp);
+  known_ids = count;
+  resort_ticks = 0;
+}
+
+// Write one model entry into a table row
+static void apply_can_row(int row, const can_sniffer_entry_t *e) {
+  lv_obj_t *table = (lv_obj_t *)ui_Table_CAN_List;
 
-    can_row_count++;
+  char id_str[12];
+  can_sniffer_format_id(e->id, id_str, sizeof(id_str));
+  lv_table_set_cell_value(table, row, COL_ID, id_str);
 
-    // Set ID cell once
-    char id_str[16];
-    snprintf(id_str, sizeof(id_str), "%03X", (unsigned int)id); // Format: 101
-    lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, row_idx, 0, id_str);
+  char dlc_str[4];
+  snprintf(dlc_str, sizeof(dlc_str), "%d", e->dlc);
+  lv_table_set_cell_value(table, row, COL_DLC, dlc_str);
+
+  for (int i = 0; i < 8; i++) {
+    char byte_str[4] = "";
+    if (i < e->dlc)
+      can_sniffer_format_hex(&e->data[i], 1, byte_str, sizeof(byte_str));
+    lv_table_set_cell_value(table, row, COL_BYTE0 + i, byte_str);
   }
+  memcpy(row_byte_ms[row - 1], e->byte_changed_ms, sizeof(row_byte_ms[0]));
+
+  char data_ascii_str[9];
+  can_sniffer_format_ascii(e->data, e->dlc, data_ascii_str,
+                           sizeof(data_ascii_str));
+  lv_table_set_cell_value(table, row, COL_ASCII, data_ascii_str);
 
-  // Check visibility
-  bool is_visible = true;
-  for (int i = 0; i < can_row_count; i++) {
-    if (can_rows[i].id == id) {
-      is_visible = can_rows[i].visible;
-      break;
+  // Store last message for debugging
+  last_can_id = (int)e->id;
+  last_can_dlc = e->dlc;
+  memcpy(last_can_data, e->data, sizeof(last_can_data));
+}
+
+static void clear_can_row(int row) {
+  for (int col = 0; col < COL_COUNT; col++)
+    lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, row, col, "");
+}
+
+static void update_view_info(int count) {
+  int hidden = 0;
+  for (int w = 0; w < CAN_SNIFFER_DIRTY_WORDS; w++)
+    hidden += __builtin_popcount(hidden_ids[w]);
+
+  int first = view_len ? view_top + 1 : 0;
+  int last = view_top + SNIFFER_VIEW_ROWS;
+  if (last > view_len)
+    last = view_len;
+
+  int info[5] = {count, hidden, first, last, view_len};
+  if (memcmp(info, shown_info, sizeof(info)) == 0)
+    return;
+  memcpy(shown_info, info, sizeof(info));
+  lv_label_set_text_fmt((lv_obj_t *)ui_Label_View_Info,
+                        "IDs: %d  Hidden: %d  Rows: %d-%d of %d", count, hidden,
+                        first, last, view_len);
+}
+
+// Step the cached byte heat of the shown rows; true if any level changed
+static bool update_row_heat(uint32_t now_ms) {
+  bool changed = false;
+  for (int r = 0; r < SNIFFER_VIEW_ROWS; r++) {
+    for (int i = 0; i < 8; i++) {
+      uint8_t level =
+          row_entry[r] >= 0 ? heat_level(row_byte_ms[r][i], now_ms) : 0;
+      if (level != row_heat[r][i]) {
+        row_heat[r][i] = level;
+        changed = true;
+      }
     }
   }
+  return changed;
+}
 
-  if (!is_visible)
-    return; // Skip update if filtered out
+// Show the selected entry's bits: cell text is the current bit value, the
+// background marks bits toggled since the last reset
+static void update_bit_heatmap(const uint32_t *dirty) {
+  lv_obj_t *table = (lv_obj_t *)ui_Table_Bit_Heat;
+  bool switched = selected_index != heat_index;
+  if (!table || (!switched && !refresh_all &&
+                 (selected_index < 0 || !bit_test(dirty, selected_index))))
+    return;
 
-  // Update DLC
-  char dlc_str[4];
-  snprintf(dlc_str, sizeof(dlc_str), "%d", dlc);
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, row_idx, 1, dlc_str);
-
-  // Update Data
-  char data_hex_str[32] = {0};
-  for (int i = 0; i < dlc && i < 8; i++) {
-    char byte_str[4];
-    snprintf(byte_str, sizeof(byte_str), "%02X ", data[i]);
-    strncat(data_hex_str, byte_str,
-            sizeof(data_hex_str) - strlen(data_hex_str) - 1);
+  can_sniffer_entry_t e;
+  if (selected_index < 0 || !can_sniffer_read(selected_index, &e)) {
+    if (selected_index >= 0) {
+      can_sniffer_mark_dirty(selected_index); // Producer busy; next refresh
+      return;
+    }
+    memset(&e, 0, sizeof(e));
+  }
+
+  uint64_t data = 0;
+  memcpy(&data, e.data, sizeof(data));
+  uint64_t redraw = switched ? ~0ull : data ^ heat_data;
+  for (; redraw; redraw &= redraw - 1) {
+    int bit = __builtin_ctzll(redraw);
+    const char *text = "";
+    if (selected_index >= 0)
+      text = ((data >> bit) & 1u) ? "1" : "0";
+    lv_table_set_cell_value(table, bit / 8, 8 - bit % 8, text);
   }
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, row_idx, 2,
-                          data_hex_str);
-
-  // Update ASCII
-  char data_ascii_str[9] = {0};
-  for (int i = 0; i < dlc && i < 8; i++) {
-    if (data[i] >= 32 && data[i] <= 126) {
-      data_ascii_str[i] = data[i];
+  if (e.toggled != heat_toggled)
+    lv_obj_invalidate(table);
+
+  if (switched) {
+    if (selected_index < 0) {
+      lv_label_set_text((lv_obj_t *)ui_Label_Bit_Heat, "Bits: no ID selected");
     } else {
-      data_ascii_str[i] = '.';
+      char id_str[12];
+      can_sniffer_format_id(e.id, id_str, sizeof(id_str));
+      lv_label_set_text_fmt((lv_obj_t *)ui_Label_Bit_Heat,
+                            "Bits of %s (red = toggled)", id_str);
     }
   }
-  data_ascii_str[dlc] = '\0';
-  lv_table_set_cell_value((lv_obj_t *)ui_Table_CAN_List, row_idx, 3,
-                          data_ascii_str);
+  heat_index = selected_index;
+  heat_data = data;
+  heat_toggled = e.toggled;
+}
+
+static void sniffer_refresh_cb(lv_timer_t *timer) {
+  (void)timer;
+  if (!ui_Table_CAN_List || !view || !can_sniffer_active ||
+      lv_scr_act() != ui_Screen3)
+    return; // Changes stay in the model's dirty set until we are shown
+
+  uint32_t dirty[CAN_SNIFFER_DIRTY_WORDS];
+  can_sniffer_take_dirty(dirty);
+
+  int count = can_sniffer_get_count();
+  bool live_order =
+      sort_mode != SORT_BY_ID || !can_filter_is_empty(&search_filter);
+  if (view_stale || count != known_ids ||
+      (live_order && ++resort_ticks >= SNIFFER_RESORT_TICKS))
+    rebuild_view(count);
+
+  int max_top = view_len > SNIFFER_VIEW_ROWS ? view_len - SNIFFER_VIEW_ROWS : 0;
+  if (view_top > max_top)
+    view_top = max_top;
+
+  // Only the window is rendered: a row is rewritten when it now shows a
+  // different entry or its entry's payload changed. Dirty bits of entries
+  // outside the window are dropped; scrolling them in redraws them anyway.
+  for (int r = 0; r < SNIFFER_VIEW_ROWS; r++) {
+    int pos = view_top + r;
+    int index = pos < view_len ? view[pos].index : -1;
+    if (index == row_entry[r] && !refresh_all &&
+        (index < 0 || !bit_test(dirty, index)))
+      continue;
+
+    if (index != row_entry[r])
+      memset(row_byte_ms[r], 0, sizeof(row_byte_ms[r]));
+    row_entry[r] = index;
+    if (index < 0) {
+      clear_can_row(r + 1);
+      continue;
+    }
 
-  // Update message count (total)
-  can_message_count++;
-  char count_text[32];
-  snprintf(count_text, sizeof(count_text), "Messages: %d", can_message_count);
-  lv_label_set_text((lv_obj_t *)ui_Label_CAN_Count, count_text);
+    can_sniffer_entry_t e;
+    if (!can_sniffer_read(index, &e)) {
+      can_sniffer_mark_dirty(index); // Producer busy; next refresh
+      continue;
+    }
+    apply_can_row(r + 1, &e);
+  }
+  if (update_row_heat((uint32_t)(esp_timer_get_time() / 1000)))
+    lv_obj_invalidate((lv_obj_t *)ui_Table_CAN_List);
+  update_bit_heatmap(dirty);
+  refresh_all = false;
+
+  update_view_info(count);
+
+  uint32_t total = can_sniffer_get_total();
+  if (total != shown_total) {
+    shown_total = total;
+    lv_label_set_text_fmt((lv_obj_t *)ui_Label_CAN_Count, "Messages: %lu",
+                          (unsigned long)total);
+  }
 }
 
 // Update CAN status and message count
@@ -655,7 +1036,7 @@ void ui_update_can_status(int connected, int message_count) {
 // Set search text
 void ui_set_search_text(const char *search_text_input) {
   if (search_text_input) {
-    snprintf(search_text, sizeof(search_text), "%s", search_text_input);
+    apply_search(search_text_input);
 
     if (ui_TextArea_Search) {
       lv_textarea_set_text((lv_obj_t *)ui_TextArea_Search, search_text);
@@ -682,39 +1063,6 @@ void ui_reset_can_statistics(void) {
 // CAN SNIFFER FUNCTIONS
 // ============================================================================
 
-// Add CAN message to terminal with filtering and search
-// Process CAN message for terminal and logger (Called from CAN task)
-// Add CAN message to terminal with filtering and search
-// Process CAN message for terminal and logger (Called from CAN task)
-void ui_process_real_can_message(uint32_t id, uint8_t *data, uint8_t dlc) {
-  if (!can_sniffer_active)
-    return;
-
-  // Check if ID should be filtered
-  if (!can_sniffer_is_id_filtered(id))
-    return;
-
-  // Log to SD card if recording
-  // Cast const away since can_logger_log might not take const yet (check logger
-  // header) Assuming can_logger_log takes (uint32_t, uint8_t*, uint8_t)
-  can_logger_log(id, (uint8_t *)data, dlc);
-
-  // Check if search term matches
-  if (!can_sniffer_search_in_data((uint8_t *)data, dlc, search_text))
-    return;
-
-  // Add to terminal (Table) - ui_add_can_message takes uint8_t*
-  ui_add_can_message(id, (uint8_t *)data, dlc);
-
-  // Update statistics
-  can_sniffer_update_statistics(id);
-
-  // Store last message for debugging
-  last_can_id = id;
-  last_can_dlc = dlc;
-  memcpy(last_can_data, data, dlc > 8 ? 8 : dlc);
-}
-
 /*
 // Format CAN message for display (Unused in table view)
 static void can_sniffer_format_message(char *buffer, size_t size, uint32_t id,
@@ -760,81 +1108,6 @@ strlen(data_hex_str) - 1);
 }
 */
 
-// Check if CAN ID should be shown (always show all messages now)
-static int can_sniffer_is_id_filtered(uint32_t id) {
-  return 1; // Show all messages
-}
-
-// Search for text in CAN data (supports hex values and ASCII)
-static int can_sniffer_search_in_data(uint8_t *data, uint8_t dlc,
-                                      const char *search_term) {
-  if (!search_term || strlen(search_term) == 0)
-    return 1; // No search term, show all
-
-  char search_lower[64];
-  snprintf(search_lower, sizeof(search_lower), "%s", search_term);
-
-  // Convert search term to lowercase
-  for (int i = 0; search_lower[i]; i++) {
-    if (search_lower[i] >= 'A' && search_lower[i] <= 'Z') {
-      search_lower[i] = search_lower[i] + 32;
-    }
-  }
-
-  // Search for hex values (e.g., "AA", "FF")
-  if (strlen(search_lower) == 2) {
-    uint8_t search_byte;
-    if (sscanf(search_lower, "%2hhx", &search_byte) == 1) {
-      for (int i = 0; i < dlc && i < 8; i++) {
-        if (data[i] == search_byte)
-          return 1;
-      }
-    }
-  }
-
-  // Search for longer hex sequences (e.g., "AABB", "FF0011")
-  if (strlen(search_lower) > 2 && strlen(search_lower) % 2 == 0) {
-    uint8_t search_bytes[8];
-    int num_bytes = strlen(search_lower) / 2;
-    if (num_bytes <= 8) {
-      for (int i = 0; i < num_bytes; i++) {
-        if (sscanf(&search_lower[i * 2], "%2hhx", &search_bytes[i]) != 1) {
-          break; // Invalid hex, try text search
-        }
-      }
-      // Check if data contains this sequence
-      for (int i = 0; i <= dlc - num_bytes; i++) {
-        if (memcmp(&data[i], search_bytes, num_bytes) == 0)
-          return 1;
-      }
-    }
-  }
-
-  // Search for ASCII text in data (simple approach)
-  char data_ascii[9] = "";
-  for (int i = 0; i < dlc && i < 8; i++) {
-    if (data[i] >= 32 && data[i] <= 126) { // Printable ASCII
-      data_ascii[i] = data[i];
-    } else {
-      data_ascii[i] = '.'; // Non-printable
-    }
-  }
-
-  // Convert to lowercase for comparison
-  for (int i = 0; data_ascii[i]; i++) {
-    if (data_ascii[i] >= 'A' && data_ascii[i] <= 'Z') {
-      data_ascii[i] = data_ascii[i] + 32;
-    }
-  }
-
-  return strstr(data_ascii, search_lower) != NULL;
-}
-
-// Update statistics counters (statistics removed)
-static void can_sniffer_update_statistics(uint32_t id) {
-  // Statistics display removed - function simplified
-}
-
 // Enable/disable CAN sniffer
 void ui_set_can_sniffer_active(int active) {
   can_sniffer_active = active;
@@ -4,22 +4,22 @@
 #include "ui_Screen6.h"
 #include "../ui.h"
 #include "ai_manager.h" // Include AI Manager
-#include "ui_Screen1.h"
-#include "ui_Screen2.h"
-#include "ui_Screen4.h"
-#include "ui_Screen5.h"
 #include "ui_screen_manager.h"
+#include "../ui_layout_manager.h"
 
 #include "../background_task.h" // Фоновая задача для асинхронных операций
 #include "can_definitions.h"    // Platform definitions
+#include "can_manager.h"        // For can_manager_set_demo_mode
 #include "can_parser.h"         // For can_parser_set_platform
 #include "ecu_data.h"           // For system_settings_t
 #include "settings_config.h"    // Убедитесь, что этот файл подключен
 #include "ui_events.h"
 #include "ui_helpers.h"
+#include "ui_perf_hud.h"
 
 #include <esp_log.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -36,6 +36,7 @@ void *ui_Button_Nav_Buttons;
 void *ui_Button_Save_Settings;
 void *ui_Button_Reset_Settings;
 void *ui_Button_AI; // AI Button
+static lv_obj_t *ui_Button_Perf_HUD = NULL;
 
 // Touch cursor object
 lv_obj_t *ui_Touch_Cursor_Screen6;
@@ -50,31 +51,6 @@ static int settings_modified = 0;
 static bool demo_mode_enabled = false;
 static bool screen3_enabled = false;
 static bool nav_buttons_enabled = true;
-static bool show_map = true;
-static bool show_wastegate = true;
-static bool show_tps = true;
-static bool show_rpm = true;
-static bool show_boost = true;
-static bool show_tcu = true;
-
-// Screen 2
-static bool show_oil_press = true;
-static bool show_oil_temp = true;
-static bool show_water_temp = true;
-static bool show_fuel_press = true;
-static bool show_battery = true;
-
-// Screen 4
-static bool show_pedal = true;
-static bool show_wg_pos = true;
-static bool show_bov = true;
-static bool show_tcu_req = true;
-static bool show_tcu_act = true;
-static bool show_eng_req = true;
-
-// Screen 5
-static bool show_eng_act = true;
-static bool show_limit_tq = true;
 
 // Function prototypes
 static void screen6_touch_handler(lv_event_t *e);
@@ -88,6 +64,7 @@ static void nav_buttons_event_cb(lv_event_t *e);
 static void gauge_checkbox_event_cb(lv_event_t *e);
 static void platform_checkbox_event_cb(lv_event_t *e);
 static void ai_button_event_cb(lv_event_t *e); // New callback
+static void perf_hud_event_cb(lv_event_t *e);
 
 void ui_update_touch_cursor_screen6(void *point);
 
@@ -142,7 +119,7 @@ static void demo_mode_event_cb(lv_event_t *e) {
     // Update button visuals on this screen
     ui_Screen6_update_button_states();
 
-    // Update animations on all screens
+    // Start/stop the CAN simulator feeding all screens
     ui_set_global_demo_mode(demo_mode_enabled);
 
     settings_modified = 1;
@@ -186,203 +163,48 @@ static void nav_buttons_event_cb(lv_event_t *e) {
   }
 }
 
-// Helper to find gauge ID from text
-static gauge_id_t get_gauge_id_from_text(const char *txt) {
-  if (strcmp(txt, "MAP") == 0)
-    return GAUGE_MAP;
-  if (strcmp(txt, "Wastegate") == 0)
-    return GAUGE_WASTEGATE;
-  if (strcmp(txt, "TPS") == 0)
-    return GAUGE_TPS;
-  if (strcmp(txt, "RPM") == 0)
-    return GAUGE_RPM;
-  if (strcmp(txt, "Boost") == 0)
-    return GAUGE_BOOST;
-  if (strcmp(txt, "TCU") == 0)
-    return GAUGE_TCU;
-
-  if (strcmp(txt, "Oil Press") == 0)
-    return GAUGE_OIL_PRESS;
-  if (strcmp(txt, "Oil Temp") == 0)
-    return GAUGE_OIL_TEMP;
-  if (strcmp(txt, "Water Temp") == 0)
-    return GAUGE_WATER_TEMP;
-  if (strcmp(txt, "Fuel Press") == 0)
-    return GAUGE_FUEL_PRESS;
-  if (strcmp(txt, "Battery") == 0)
-    return GAUGE_BATTERY;
-
-  if (strcmp(txt, "Pedal") == 0)
-    return GAUGE_PEDAL;
-  if (strcmp(txt, "WG Pos") == 0)
-    return GAUGE_WG_POS;
-  if (strcmp(txt, "BOV") == 0)
-    return GAUGE_BOV;
-  if (strcmp(txt, "TCU Req") == 0)
-    return GAUGE_TCU_REQ;
-  if (strcmp(txt, "TCU Act") == 0)
-    return GAUGE_TCU_ACT;
-  if (strcmp(txt, "Eng Req") == 0)
-    return GAUGE_ENG_REQ;
-
-  if (strcmp(txt, "Eng Act") == 0)
-    return GAUGE_ENG_ACT;
-  if (strcmp(txt, "Limit TQ") == 0)
-    return GAUGE_LIMIT_TQ;
-
-  return GAUGE_NONE;
-}
-
-// Helper to add gauge to ordered list
-static void add_gauge_to_list(system_settings_t *settings, gauge_id_t id) {
-  if (!settings || id == GAUGE_NONE)
-    return;
-
-  // Check if already exists
-  for (int i = 0; i < settings->active_gauge_count; i++) {
-    if (settings->active_gauge_ids[i] == id)
-      return;
-  }
-
-  if (settings->active_gauge_count < 24) {
-    settings->active_gauge_ids[settings->active_gauge_count++] = id;
-  }
-}
-
-// Helper to remove gauge from ordered list
-static void remove_gauge_from_list(system_settings_t *settings, gauge_id_t id) {
-  if (!settings || id == GAUGE_NONE)
-    return;
-
-  int found_idx = -1;
-  for (int i = 0; i < settings->active_gauge_count; i++) {
-    if (settings->active_gauge_ids[i] == id) {
-      found_idx = i;
-      break;
-    }
-  }
-
-  if (found_idx != -1) {
-    // Shift remaining items
-    for (int i = found_idx; i < settings->active_gauge_count - 1; i++) {
-      settings->active_gauge_ids[i] = settings->active_gauge_ids[i + 1];
-    }
-    settings->active_gauge_count--;
+// Performance HUD toggle (not persisted: a diagnostic overlay)
+static void perf_hud_event_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+    ui_perf_hud_set_visible(!ui_perf_hud_is_visible());
+    ui_Screen6_update_button_states();
   }
 }
 
-// Gauge checkbox event callback
+// Gauge checkbox event callback; user_data is the layout entry index
 static void gauge_checkbox_event_cb(lv_event_t *e) {
   lv_obj_t *cb = lv_event_get_target(e);
-  const char *txt = lv_checkbox_get_text(cb);
+  int index = (int)(intptr_t)lv_obj_get_user_data(cb);
   bool checked = lv_obj_has_state(cb, LV_STATE_CHECKED);
 
-  if (strcmp(txt, "MAP") == 0)
-    show_map = checked;
-  else if (strcmp(txt, "Wastegate") == 0)
-    show_wastegate = checked;
-  else if (strcmp(txt, "TPS") == 0)
-    show_tps = checked;
-  else if (strcmp(txt, "RPM") == 0)
-    show_rpm = checked;
-  else if (strcmp(txt, "Boost") == 0)
-    show_boost = checked;
-  else if (strcmp(txt, "TCU") == 0)
-    show_tcu = checked;
-
-  // Screen 2
-  else if (strcmp(txt, "Oil Press") == 0)
-    show_oil_press = checked;
-  else if (strcmp(txt, "Oil Temp") == 0)
-    show_oil_temp = checked;
-  else if (strcmp(txt, "Water Temp") == 0)
-    show_water_temp = checked;
-  else if (strcmp(txt, "Fuel Press") == 0)
-    show_fuel_press = checked;
-  else if (strcmp(txt, "Battery") == 0)
-    show_battery = checked;
-
-  // Screen 4
-  else if (strcmp(txt, "Pedal") == 0)
-    show_pedal = checked;
-  else if (strcmp(txt, "WG Pos") == 0)
-    show_wg_pos = checked;
-  else if (strcmp(txt, "BOV") == 0)
-    show_bov = checked;
-  else if (strcmp(txt, "TCU Req") == 0)
-    show_tcu_req = checked;
-  else if (strcmp(txt, "TCU Act") == 0)
-    show_tcu_act = checked;
-  else if (strcmp(txt, "Eng Req") == 0)
-    show_eng_req = checked;
-
-  // Screen 5
-  else if (strcmp(txt, "Eng Act") == 0)
-    show_eng_act = checked;
-  else if (strcmp(txt, "Limit TQ") == 0)
-    show_limit_tq = checked;
-
   settings_modified = 1;
-  ESP_LOGI("SCREEN6", "Gauge %s toggled to: %s", txt, checked ? "ON" : "OFF");
-
-  // Update settings immediately in memory
-  system_settings_t *settings = system_settings_get();
-  if (settings) {
-    if (strcmp(txt, "MAP") == 0)
-      settings->show_map = checked;
-    else if (strcmp(txt, "Wastegate") == 0)
-      settings->show_wastegate = checked;
-    else if (strcmp(txt, "TPS") == 0)
-      settings->show_tps = checked;
-    else if (strcmp(txt, "RPM") == 0)
-      settings->show_rpm = checked;
-    else if (strcmp(txt, "Boost") == 0)
-      settings->show_boost = checked;
-    else if (strcmp(txt, "TCU") == 0)
-      settings->show_tcu = checked;
-
-    else if (strcmp(txt, "Oil Press") == 0)
-      settings->show_oil_press = checked;
-    else if (strcmp(txt, "Oil Temp") == 0)
-      settings->show_oil_temp = checked;
-    else if (strcmp(txt, "Water Temp") == 0)
-      settings->show_water_temp = checked;
-    else if (strcmp(txt, "Fuel Press") == 0)
-      settings->show_fuel_press = checked;
-    else if (strcmp(txt, "Battery") == 0)
-      settings->show_battery = checked;
-
-    else if (strcmp(txt, "Pedal") == 0)
-      settings->show_pedal = checked;
-    else if (strcmp(txt, "WG Pos") == 0)
-      settings->show_wg_pos = checked;
-    else if (strcmp(txt, "BOV") == 0)
-      settings->show_bov = checked;
-    else if (strcmp(txt, "TCU Req") == 0)
-      settings->show_tcu_req = checked;
-    else if (strcmp(txt, "TCU Act") == 0)
-      settings->show_tcu_act = checked;
-    else if (strcmp(txt, "Eng Req") == 0)
-      settings->show_eng_req = checked;
-
-    else if (strcmp(txt, "Eng Act") == 0)
-      settings->show_eng_act = checked;
-    else if (strcmp(txt, "Limit TQ") == 0)
-      settings->show_limit_tq = checked;
-
-    // Update ordered list
-    gauge_id_t id = get_gauge_id_from_text(txt);
-    if (checked) {
-      add_gauge_to_list(settings, id);
-    } else {
-      remove_gauge_from_list(settings, id);
-    }
+  ESP_LOGI("SCREEN6", "Gauge %s toggled to: %s", lv_checkbox_get_text(cb),
+           checked ? "ON" : "OFF");
+
+  // Updates the saved flag and reflows the gauge pages
+  ui_layout_set_shown(index, checked);
+}
+
+// One checkbox per layout entry, in page order
+static void build_gauge_list(void) {
+  lv_obj_clean(ui_Container_GaugeList);
+  int count = ui_layout_count();
+  for (int i = 0; i < count; i++) {
+    const gauge_layout_entry_t *entry = ui_layout_entry(i);
+    lv_obj_t *cb = lv_checkbox_create(ui_Container_GaugeList);
+    lv_checkbox_set_text(cb, entry->title);
+    lv_obj_set_user_data(cb, (void *)(intptr_t)i);
+    lv_obj_set_style_text_color(cb, lv_color_white(), 0);
+    lv_obj_add_event_cb(cb, gauge_checkbox_event_cb, LV_EVENT_VALUE_CHANGED,
+                        NULL);
   }
+}
 
-  // Force global layout update
-  // We need to declare this function or include header
-  extern void ui_update_global_layout(void);
-  ui_update_global_layout();
+void ui_Screen6_layout_changed(void) {
+  if (!ui_Container_GaugeList)
+    return;
+  build_gauge_list();
+  ui_Screen6_update_button_states();
 }
 
 // Platform checkbox event callback (Mutual Exclusion)
@@ -419,6 +241,10 @@ static void platform_checkbox_event_cb(lv_event_t *e) {
   // Apply immediately to parser
   // #include "include/can_parser.h" // Moved to top of file
   can_parser_set_platform(selected_platform);
+  if (demo_mode_enabled) {
+    // Restart the simulator so it emits the new platform's frames
+    can_manager_set_demo_mode(true);
+  }
 
   settings_modified = 1;
   ESP_LOGI("SCREEN6", "Platform switched to: %s (%d)", txt, selected_platform);
@@ -522,6 +348,20 @@ void ui_Screen6_screen_init(void) {
   lv_obj_set_style_text_font(save_label, &lv_font_montserrat_14, 0);
   lv_obj_center(save_label);
 
+  // Performance HUD toggle - Below Save Settings
+  ui_Button_Perf_HUD = lv_btn_create(ui_Screen6);
+  lv_obj_set_size(ui_Button_Perf_HUD, 200, 50);
+  lv_obj_align(ui_Button_Perf_HUD, LV_ALIGN_TOP_LEFT, 50, 450);
+  lv_obj_set_style_radius(ui_Button_Perf_HUD, 25, 0);
+  lv_obj_add_event_cb(ui_Button_Perf_HUD, perf_hud_event_cb, LV_EVENT_CLICKED,
+                      NULL);
+
+  lv_obj_t *perf_label = lv_label_create(ui_Button_Perf_HUD);
+  lv_label_set_text(perf_label, "Perf HUD");
+  lv_obj_set_style_text_color(perf_label, lv_color_white(), 0);
+  lv_obj_set_style_text_font(perf_label, &lv_font_montserrat_14, 0);
+  lv_obj_center(perf_label);
+
   // Gauge Selection Checkboxes - Right Side (Scrollable Container)
   ESP_LOGI("SCREEN6", "Before gauge_label, ui_Screen6=%p", (void *)ui_Screen6);
   lv_obj_t *gauge_label = lv_label_create(ui_Screen6);
@@ -529,11 +369,6 @@ void ui_Screen6_screen_init(void) {
   lv_obj_set_style_text_color(gauge_label, lv_color_hex(0x00D4FF), 0);
   lv_obj_align(gauge_label, LV_ALIGN_TOP_RIGHT, -150, 60);
 
-  // TEMPORARY: Skip GaugeList and PlatformList to debug crash
-  ESP_LOGW("SCREEN6", "SKIPPING GaugeList and PlatformList for debugging");
-
-  /* TEMPORARILY DISABLED - START
-  ESP_LOGI("SCREEN6", "Before GaugeList, ui_Screen6=%p", (void *)ui_Screen6);
   ui_Container_GaugeList = lv_obj_create(ui_Screen6);
   lv_obj_set_size(ui_Container_GaugeList, 250, 350);
   lv_obj_align(ui_Container_GaugeList, LV_ALIGN_TOP_RIGHT, -10, 90);
@@ -545,33 +380,12 @@ void ui_Screen6_screen_init(void) {
   lv_obj_set_style_pad_all(ui_Container_GaugeList, 10, 0);
   lv_obj_set_style_pad_gap(ui_Container_GaugeList, 10, 0);
 
-  const char *gauges[] = {
-      "Screen 1:",  "MAP",        "Wastegate", "TPS",       "RPM",
-      "Boost",      "TCU",        "Screen 2:", "Oil Press", "Oil Temp",
-      "Water Temp", "Fuel Press", "Battery",   "Screen 4:", "Pedal",
-      "WG Pos",     "BOV",        "TCU Req",   "TCU Act",   "Eng Req",
-      "Screen 5:",  "Eng Act",    "Limit TQ"};
-
-  for (int i = 0; i < 23; i++) {
-    if (strchr(gauges[i], ':')) {
-      // Section Header
-      lv_obj_t *header = lv_label_create(ui_Container_GaugeList);
-      lv_label_set_text(header, gauges[i]);
-
-      lv_obj_set_style_text_color(header, lv_color_hex(0x00FF88), 0);
-      lv_obj_set_style_text_font(header, &lv_font_montserrat_14, 0);
-      lv_obj_set_style_pad_top(header, 10, 0);
-    } else {
-      // Checkbox
-      lv_obj_t *cb = lv_checkbox_create(ui_Container_GaugeList);
-      lv_checkbox_set_text(cb, gauges[i]);
+  build_gauge_list();
 
-      lv_obj_set_style_text_color(cb, lv_color_white(), 0);
-      lv_obj_add_event_cb(cb, gauge_checkbox_event_cb, LV_EVENT_VALUE_CHANGED,
-                          NULL);
-    }
-  }
+  // TEMPORARY: Skip PlatformList to debug crash
+  ESP_LOGW("SCREEN6", "SKIPPING PlatformList for debugging");
 
+  /* TEMPORARILY DISABLED - START
   // Platform Selection - Center Logic
   //
   ----------------------------------------------------------------------------------
@@ -659,6 +473,17 @@ void ui_Screen6_screen_destroy(void) {
   if (ui_Screen6) {
     lv_obj_del(ui_Screen6);
     ui_Screen6 = NULL;
+    ui_Label_Device_Title = NULL;
+    ui_Button_Demo_Mode = NULL;
+    ui_Button_Enable_Screen3 = NULL;
+    ui_Button_Nav_Buttons = NULL;
+    ui_Button_Save_Settings = NULL;
+    ui_Button_Reset_Settings = NULL;
+    ui_Button_AI = NULL;
+    ui_Button_Perf_HUD = NULL;
+    ui_Touch_Cursor_Screen6 = NULL;
+    ui_Container_GaugeList = NULL;
+    ui_Container_PlatformList = NULL;
   }
 }
 
@@ -668,79 +493,6 @@ void ui_Screen6_load_settings(void) {
   screen3_enabled = screen3_get_enabled();
   nav_buttons_enabled = nav_buttons_get_enabled();
 
-  // Load gauge settings (assuming getters exist or adding them)
-  system_settings_t *settings = system_settings_get();
-  if (settings) {
-    show_map = settings->show_map;
-    show_wastegate = settings->show_wastegate;
-    show_tps = settings->show_tps;
-    show_rpm = settings->show_rpm;
-    show_boost = settings->show_boost;
-    show_tcu = settings->show_tcu;
-
-    show_oil_press = settings->show_oil_press;
-    show_oil_temp = settings->show_oil_temp;
-    show_water_temp = settings->show_water_temp;
-    show_fuel_press = settings->show_fuel_press;
-    show_battery = settings->show_battery;
-
-    show_pedal = settings->show_pedal;
-    show_wg_pos = settings->show_wg_pos;
-    show_bov = settings->show_bov;
-    show_tcu_req = settings->show_tcu_req;
-    show_tcu_act = settings->show_tcu_act;
-    show_eng_req = settings->show_eng_req;
-
-    show_eng_act = settings->show_eng_act;
-    show_limit_tq = settings->show_limit_tq;
-
-    // Legacy support: If count is 0 but booleans are true, populate list in
-    // default order
-    if (settings->active_gauge_count == 0) {
-      if (show_map)
-        add_gauge_to_list(settings, GAUGE_MAP);
-      if (show_wastegate)
-        add_gauge_to_list(settings, GAUGE_WASTEGATE);
-      if (show_tps)
-        add_gauge_to_list(settings, GAUGE_TPS);
-      if (show_rpm)
-        add_gauge_to_list(settings, GAUGE_RPM);
-      if (show_boost)
-        add_gauge_to_list(settings, GAUGE_BOOST);
-      if (show_tcu)
-        add_gauge_to_list(settings, GAUGE_TCU);
-
-      if (show_oil_press)
-        add_gauge_to_list(settings, GAUGE_OIL_PRESS);
-      if (show_oil_temp)
-        add_gauge_to_list(settings, GAUGE_OIL_TEMP);
-      if (show_water_temp)
-        add_gauge_to_list(settings, GAUGE_WATER_TEMP);
-      if (show_fuel_press)
-        add_gauge_to_list(settings, GAUGE_FUEL_PRESS);
-      if (show_battery)
-        add_gauge_to_list(settings, GAUGE_BATTERY);
-
-      if (show_pedal)
-        add_gauge_to_list(settings, GAUGE_PEDAL);
-      if (show_wg_pos)
-        add_gauge_to_list(settings, GAUGE_WG_POS);
-      if (show_bov)
-        add_gauge_to_list(settings, GAUGE_BOV);
-      if (show_tcu_req)
-        add_gauge_to_list(settings, GAUGE_TCU_REQ);
-      if (show_tcu_act)
-        add_gauge_to_list(settings, GAUGE_TCU_ACT);
-      if (show_eng_req)
-        add_gauge_to_list(settings, GAUGE_ENG_REQ);
-
-      if (show_eng_act)
-        add_gauge_to_list(settings, GAUGE_ENG_ACT);
-      if (show_limit_tq)
-        add_gauge_to_list(settings, GAUGE_LIMIT_TQ);
-    }
-  }
-
   ESP_LOGI("SCREEN6", "Loaded settings - Demo: %s, Screen3: %s",
            demo_mode_enabled ? "ON" : "OFF", screen3_enabled ? "ON" : "OFF");
 }
@@ -751,34 +503,7 @@ void ui_Screen6_save_settings(void) {
   screen3_set_enabled(screen3_enabled);
   nav_buttons_set_enabled(nav_buttons_enabled);
 
-  system_settings_t *settings = system_settings_get();
-  if (settings) {
-    settings->show_map = show_map;
-    settings->show_wastegate = show_wastegate;
-    settings->show_tps = show_tps;
-    settings->show_rpm = show_rpm;
-    settings->show_boost = show_boost;
-    settings->show_tcu = show_tcu;
-
-    settings->show_oil_press = show_oil_press;
-    settings->show_oil_temp = show_oil_temp;
-    settings->show_water_temp = show_water_temp;
-    settings->show_fuel_press = show_fuel_press;
-    settings->show_battery = show_battery;
-
-    settings->show_pedal = show_pedal;
-    settings->show_wg_pos = show_wg_pos;
-    settings->show_bov = show_bov;
-    settings->show_tcu_req = show_tcu_req;
-    settings->show_tcu_act = show_tcu_act;
-    settings->show_eng_req = show_eng_req;
-
-    settings->show_eng_act = show_eng_act;
-    settings->show_limit_tq = show_limit_tq;
-
-    // system_settings_save(settings); // Removed redundant call
-  }
-
+  // Gauge visibility is written to the settings as it is toggled
   trigger_settings_save(); // Use the non-blocking trigger
 
   ESP_LOGI("SCREEN6", "Triggered save settings - Demo: %s, Screen3: %s",
@@ -835,64 +560,26 @@ void ui_Screen6_update_button_states(void) {
     }
   }
 
+  // Update Perf HUD button
+  btn = ui_Button_Perf_HUD;
+  if (btn) {
+    label = lv_obj_get_child(btn, 0);
+    bool hud = ui_perf_hud_is_visible();
+    lv_obj_set_style_bg_color(btn, lv_color_hex(hud ? 0x00FF88 : 0xFF3366), 0);
+    if (label)
+      lv_label_set_text(label, hud ? "Perf HUD: ON" : "Perf HUD: OFF");
+  }
+
   // Update Gauge Checkboxes
   if (ui_Container_GaugeList) {
     uint32_t child_cnt = lv_obj_get_child_cnt(ui_Container_GaugeList);
     for (uint32_t i = 0; i < child_cnt; i++) {
       lv_obj_t *child = lv_obj_get_child(ui_Container_GaugeList, i);
-      if (lv_obj_check_type(child, &lv_checkbox_class)) {
-        // ... (Existing Gauge logic remains) ...
-        const char *txt = lv_checkbox_get_text(child);
-        bool should_check = false;
-
-        if (strcmp(txt, "MAP") == 0)
-          should_check = show_map;
-        // ... (abbreviated for brevity, tool handles context) ...
-        else if (strcmp(txt, "Limit TQ") == 0)
-          should_check = show_limit_tq;
-        else {
-          // Fallback to check full list if abbreviated
-          if (strcmp(txt, "Wastegate") == 0)
-            should_check = show_wastegate;
-          else if (strcmp(txt, "TPS") == 0)
-            should_check = show_tps;
-          else if (strcmp(txt, "RPM") == 0)
-            should_check = show_rpm;
-          else if (strcmp(txt, "Boost") == 0)
-            should_check = show_boost;
-          else if (strcmp(txt, "TCU") == 0)
-            should_check = show_tcu;
-          else if (strcmp(txt, "Oil Press") == 0)
-            should_check = show_oil_press;
-          else if (strcmp(txt, "Oil Temp") == 0)
-            should_check = show_oil_temp;
-          else if (strcmp(txt, "Water Temp") == 0)
-            should_check = show_water_temp;
-          else if (strcmp(txt, "Fuel Press") == 0)
-            should_check = show_fuel_press;
-          else if (strcmp(txt, "Battery") == 0)
-            should_check = show_battery;
-          else if (strcmp(txt, "Pedal") == 0)
-            should_check = show_pedal;
-          else if (strcmp(txt, "WG Pos") == 0)
-            should_check = show_wg_pos;
-          else if (strcmp(txt, "BOV") == 0)
-            should_check = show_bov;
-          else if (strcmp(txt, "TCU Req") == 0)
-            should_check = show_tcu_req;
-          else if (strcmp(txt, "TCU Act") == 0)
-            should_check = show_tcu_act;
-          else if (strcmp(txt, "Eng Req") == 0)
-            should_check = show_eng_req;
-          else if (strcmp(txt, "Eng Act") == 0)
-            should_check = show_eng_act;
-        }
-
-        if (should_check)
-          lv_obj_add_state(child, LV_STATE_CHECKED);
-        else
-          lv_obj_clear_state(child, LV_STATE_CHECKED);
-      }
+      int index = (int)(intptr_t)lv_obj_get_user_data(child);
+      if (ui_layout_is_shown(index))
+        lv_obj_add_state(child, LV_STATE_CHECKED);
+      else
+        lv_obj_clear_state(child, LV_STATE_CHECKED);
     }
   }
 
@@ -35,6 +35,9 @@ extern void ui_Screen6_load_settings(void);
 extern void ui_Screen6_save_settings(void);
 extern void ui_Screen6_update_button_states(void);
 
+// Rebuild the gauge checkboxes after the gauge layout was reloaded
+void ui_Screen6_layout_changed(void);
+
 typedef struct {
   float cpu_freq_mhz;
   float cpu_load_percent;
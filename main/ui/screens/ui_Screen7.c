@@ -18,18 +18,59 @@ static lv_obj_t *label_status;
 #define GRID_W 40
 #define GRID_H 24
 #define CELL_SIZE 20
+#define CELL_FILL (CELL_SIZE - 2) // Painted square, the rest is the grid gap
+#define CANVAS_W 1280
+#define CANVAS_H 720
+#define SNAKE_MAX 100
 
 typedef struct {
   int x, y;
 } Point;
 
-static Point snake[100];
+static Point snake[SNAKE_MAX];
 static int snake_len = 3;
 static Point food;
 static int dir_x = 1, dir_y = 0;
 static bool game_over = false;
 static int score = 0;
 
+// Buffer for canvas (move to PSRAM to avoid DRAM overflow)
+static lv_color_t *cbuf = NULL;
+
+// Paint one cell straight into the buffer and invalidate only that cell;
+// lv_canvas_draw_rect would invalidate the whole canvas every step
+static void draw_cell(Point p, lv_color_t color) {
+  int x0 = p.x * CELL_SIZE;
+  int y0 = p.y * CELL_SIZE;
+  for (int y = 0; y < CELL_FILL; y++) {
+    lv_color_t *row = cbuf + (y0 + y) * CANVAS_W + x0;
+    for (int x = 0; x < CELL_FILL; x++)
+      row[x] = color;
+  }
+
+  lv_area_t a;
+  lv_obj_get_coords(game_canvas, &a);
+  a.x1 += x0;
+  a.y1 += y0;
+  a.x2 = a.x1 + CELL_FILL - 1;
+  a.y2 = a.y1 + CELL_FILL - 1;
+  lv_obj_invalidate_area(game_canvas, &a);
+}
+
+// A vacated cell can hold food that spawned under the snake
+static void clear_cell(Point p) {
+  bool is_food = p.x == food.x && p.y == food.y;
+  draw_cell(p, lv_color_hex(is_food ? 0xFF0000 : 0x000000));
+}
+
+// Full repaint, only when a game starts
+static void draw_board(void) {
+  lv_canvas_fill_bg(game_canvas, lv_color_hex(0x000000), LV_OPA_COVER);
+  for (int i = 0; i < snake_len; i++)
+    draw_cell(snake[i], lv_color_hex(0x00FF00));
+  draw_cell(food, lv_color_hex(0xFF0000));
+}
+
 static void spawn_food() {
   food.x = esp_random() % GRID_W;
   food.y = esp_random() % GRID_H;
@@ -48,6 +89,7 @@ static void reset_game() {
   score = 0;
   game_over = false;
   spawn_food();
+  draw_board();
 }
 
 static void game_loop(lv_timer_t *timer) {
@@ -102,54 +144,34 @@ static void game_loop(lv_timer_t *timer) {
   }
 
   // Move Snake
+  Point tail = snake[snake_len - 1];
   for (int i = snake_len; i > 0; i--) {
     snake[i] = snake[i - 1];
   }
   snake[0] = new_head;
 
+  // Only the cells that changed are drawn: the new head, and either the
+  // vacated tail or, after eating, the new food
+  draw_cell(new_head, lv_color_hex(0x00FF00));
+
   // Eat Food
   if (new_head.x == food.x && new_head.y == food.y) {
-    snake_len++;
+    if (snake_len < SNAKE_MAX - 1)
+      snake_len++;
+    else
+      clear_cell(tail);
     score += 10;
     spawn_food();
+    draw_cell(food, lv_color_hex(0xFF0000));
     char buf[64];
     snprintf(buf, sizeof(buf), "Score: %d | Connect to 'ESP32_GAME_CONTROLLER'",
              score);
     lv_label_set_text(label_status, buf);
+  } else {
+    clear_cell(tail);
   }
-
-  // Draw
-  // Clear canvas (fill black)
-  lv_canvas_fill_bg(game_canvas, lv_color_hex(0x000000), LV_OPA_COVER);
-
-  // Draw Snake
-  lv_draw_rect_dsc_t rect_dsc;
-  lv_draw_rect_dsc_init(&rect_dsc);
-  rect_dsc.bg_color = lv_color_hex(0x00FF00);
-
-  for (int i = 0; i < snake_len; i++) {
-    lv_area_t coords = {.x1 = snake[i].x * CELL_SIZE,
-                        .y1 = snake[i].y * CELL_SIZE,
-                        .x2 = snake[i].x * CELL_SIZE + CELL_SIZE - 2,
-                        .y2 = snake[i].y * CELL_SIZE + CELL_SIZE - 2};
-    // Note: Canvas drawing is complex in LVGL 8/9.
-    // For simplicity/performance in this demo, we might use simple obj creation
-    // or just a single canvas with pixel manipulation. Let's use
-    // lv_canvas_draw_rect if available or just fill buffer. Actually, creating
-    // 100 objs is slow. Canvas is better.
-    lv_canvas_draw_rect(game_canvas, coords.x1, coords.y1, CELL_SIZE - 2,
-                        CELL_SIZE - 2, &rect_dsc);
-  }
-
-  // Draw Food
-  rect_dsc.bg_color = lv_color_hex(0xFF0000);
-  lv_canvas_draw_rect(game_canvas, food.x * CELL_SIZE, food.y * CELL_SIZE,
-                      CELL_SIZE - 2, CELL_SIZE - 2, &rect_dsc);
 }
 
-// Buffer for canvas (move to PSRAM to avoid DRAM overflow)
-static lv_color_t *cbuf = NULL;
-
 void ui_Screen7_update_layout(void) {
   // Placeholder for layout updates
 }
@@ -163,7 +185,7 @@ void ui_Screen7_screen_init(void) {
 
   // Canvas for Game
   // Allocate buffer in PSRAM
-  size_t buf_size = LV_CANVAS_BUF_SIZE_TRUE_COLOR(1280, 720);
+  size_t buf_size = LV_CANVAS_BUF_SIZE_TRUE_COLOR(CANVAS_W, CANVAS_H);
   cbuf = (lv_color_t *)heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
   if (!cbuf) {
     ESP_LOGE("SCREEN7", "Failed to allocate canvas buffer in PSRAM!");
@@ -171,9 +193,9 @@ void ui_Screen7_screen_init(void) {
   }
 
   game_canvas = lv_canvas_create(ui_Screen7);
-  lv_canvas_set_buffer(game_canvas, cbuf, 1280, 720, LV_IMG_CF_TRUE_COLOR);
+  lv_canvas_set_buffer(game_canvas, cbuf, CANVAS_W, CANVAS_H,
+                       LV_IMG_CF_TRUE_COLOR);
   lv_obj_align(game_canvas, LV_ALIGN_CENTER, 0, 0);
-  lv_canvas_fill_bg(game_canvas, lv_color_hex(0x000000), LV_OPA_COVER);
 
   // Status Label
   label_status = lv_label_create(ui_Screen7);
@@ -1,6 +1,9 @@
 #include "ui_Screen8.h"
 #include "../ui.h"
+#include "../ui_gauge_layers.h"
+#include "../ui_gauge_styles.h"
 #include "../ui_screen_manager.h"
+#include "../ui_shift_light.h"
 #include "esp_log.h"
 #include "settings_config.h"
 #include <stdio.h>
@@ -34,83 +37,6 @@ LV_FONT_DECLARE(lv_font_montserrat_20);
 LV_FONT_DECLARE(lv_font_montserrat_24);
 LV_FONT_DECLARE(lv_font_montserrat_48);
 
-// Animation objects
-static lv_anim_t anim_rpm_s8;
-static lv_anim_t anim_speed_s8;
-static lv_anim_t anim_boost_s8;
-
-// Callback for demo animation
-static void anim_rpm_cb_s8(void *var, int32_t v) {
-  if (ui_Gauge_RPM_S8)
-    lv_arc_set_value(ui_Gauge_RPM_S8, v);
-  if (ui_Label_RPM_Val_S8)
-    lv_label_set_text_fmt(ui_Label_RPM_Val_S8, "%d", (int)v);
-}
-static void anim_speed_cb_s8(void *var, int32_t v) {
-  if (ui_Gauge_Speed_S8)
-    lv_arc_set_value(ui_Gauge_Speed_S8, v);
-  if (ui_Label_Speed_Val_S8)
-    lv_label_set_text_fmt(ui_Label_Speed_Val_S8, "%d", (int)v);
-}
-static void anim_boost_cb_s8(void *var, int32_t v) {
-  if (ui_Bar_Boost_S8)
-    lv_bar_set_value(ui_Bar_Boost_S8, v, LV_ANIM_OFF);
-  if (ui_Label_Boost_Val_S8)
-    lv_label_set_text_fmt(ui_Label_Boost_Val_S8, "%d", (int)v);
-}
-
-void ui_Screen8_update_animations(bool demo_enabled) {
-  if (demo_enabled) {
-    // RPM Animation
-    lv_anim_init(&anim_rpm_s8);
-    lv_anim_set_var(&anim_rpm_s8, ui_Gauge_RPM_S8);
-    lv_anim_set_values(&anim_rpm_s8, 0, 7000); // 0-7000 RPM
-    lv_anim_set_time(&anim_rpm_s8, 3000);
-    lv_anim_set_playback_time(&anim_rpm_s8, 3000);
-    lv_anim_set_repeat_count(&anim_rpm_s8, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_set_exec_cb(&anim_rpm_s8, anim_rpm_cb_s8);
-    lv_anim_start(&anim_rpm_s8);
-
-    // Speed Animation
-    lv_anim_init(&anim_speed_s8);
-    lv_anim_set_var(&anim_speed_s8, ui_Gauge_Speed_S8);
-    lv_anim_set_values(&anim_speed_s8, 0, 280); // 0-280 km/h
-    lv_anim_set_time(&anim_speed_s8, 5000);
-    lv_anim_set_playback_time(&anim_speed_s8, 5000);
-    lv_anim_set_repeat_count(&anim_speed_s8, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_set_exec_cb(&anim_speed_s8, anim_speed_cb_s8);
-    lv_anim_start(&anim_speed_s8);
-
-    // Boost Animation
-    lv_anim_init(&anim_boost_s8);
-    lv_anim_set_var(&anim_boost_s8, ui_Bar_Boost_S8);
-    lv_anim_set_values(&anim_boost_s8, 0, 250);
-    lv_anim_set_time(&anim_boost_s8, 4000);
-    lv_anim_set_playback_time(&anim_boost_s8, 4000);
-    lv_anim_set_repeat_count(&anim_boost_s8, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_set_exec_cb(&anim_boost_s8, anim_boost_cb_s8);
-    lv_anim_start(&anim_boost_s8);
-  } else {
-    lv_anim_del(ui_Gauge_RPM_S8, anim_rpm_cb_s8);
-    lv_anim_del(ui_Gauge_Speed_S8, anim_speed_cb_s8);
-    lv_anim_del(ui_Bar_Boost_S8, anim_boost_cb_s8);
-
-    if (ui_Gauge_RPM_S8)
-      lv_arc_set_value(ui_Gauge_RPM_S8, 0);
-    if (ui_Gauge_Speed_S8)
-      lv_arc_set_value(ui_Gauge_Speed_S8, 0);
-    if (ui_Bar_Boost_S8)
-      lv_bar_set_value(ui_Bar_Boost_S8, 0, LV_ANIM_OFF);
-
-    if (ui_Label_RPM_Val_S8)
-      lv_label_set_text(ui_Label_RPM_Val_S8, "0");
-    if (ui_Label_Speed_Val_S8)
-      lv_label_set_text(ui_Label_Speed_Val_S8, "0");
-    if (ui_Label_Boost_Val_S8)
-      lv_label_set_text(ui_Label_Boost_Val_S8, "0");
-  }
-}
-
 // Navigation Button Callback
 static void nav_button_cb_s8(lv_event_t *e) {
   long forward = (long)lv_event_get_user_data(e);
@@ -150,8 +76,7 @@ static void create_center_row(lv_obj_t *parent, const char *title,
 
   *label_obj = lv_label_create(val_cont);
   lv_label_set_text(*label_obj, def_val);
-  lv_obj_set_style_text_color(*label_obj, lv_color_white(), 0);
-  lv_obj_set_style_text_font(*label_obj, &lv_font_montserrat_24, 0);
+  ui_gauge_style_value(*label_obj, &lv_font_montserrat_24);
 
   lv_obj_t *lbl_unit = lv_label_create(val_cont);
   lv_label_set_text(lbl_unit, unit);
@@ -174,13 +99,18 @@ void ui_Screen8_screen_init(void) {
   lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 10);
   lv_obj_set_style_bg_opa(header, 0, 0);
   lv_obj_set_style_border_width(header, 0, 0);
+  lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
 
   lv_obj_t *track_mode_lbl = lv_label_create(header);
   lv_label_set_text(track_mode_lbl, "TRACK MODE");
-  lv_obj_center(track_mode_lbl);
+  lv_obj_align(track_mode_lbl, LV_ALIGN_LEFT_MID, 0, 0);
   lv_obj_set_style_text_color(track_mode_lbl, lv_color_hex(0x666666), 0);
   lv_obj_set_style_text_letter_space(track_mode_lbl, 2, 0);
 
+  // Shift light between the dials, on its own fast timer
+  lv_obj_t *shift_light = ui_shift_light_create(header);
+  lv_obj_center(shift_light);
+
   // --- LEFT: RPM Gauge ---
   lv_obj_t *rpm_cont = lv_obj_create(ui_Screen8);
   lv_obj_set_size(rpm_cont, 300, 300);
@@ -194,21 +124,14 @@ void ui_Screen8_screen_init(void) {
   lv_arc_set_rotation(ui_Gauge_RPM_S8, 135);
   lv_arc_set_bg_angles(ui_Gauge_RPM_S8, 0, 270);
   lv_arc_set_range(ui_Gauge_RPM_S8, 0, 7000); // 0-7000 RPM
-  // Style
-  lv_obj_set_style_arc_color(ui_Gauge_RPM_S8, lv_color_hex(0x333333),
-                             LV_PART_MAIN);
-  lv_obj_set_style_arc_width(ui_Gauge_RPM_S8, 20, LV_PART_MAIN);
-  lv_obj_set_style_arc_color(ui_Gauge_RPM_S8, lv_color_hex(0xFF0000),
-                             LV_PART_INDICATOR); // Primary Red
-  lv_obj_set_style_arc_width(ui_Gauge_RPM_S8, 20, LV_PART_INDICATOR);
+  ui_gauge_style_arc(ui_Gauge_RPM_S8, 0xFF0000, true); // Primary Red
   lv_obj_remove_style(ui_Gauge_RPM_S8, NULL, LV_PART_KNOB);
   lv_obj_clear_flag(ui_Gauge_RPM_S8, LV_OBJ_FLAG_CLICKABLE);
 
   // Inner Value
   ui_Label_RPM_Val_S8 = lv_label_create(rpm_cont);
   lv_label_set_text(ui_Label_RPM_Val_S8, "0");
-  lv_obj_set_style_text_font(ui_Label_RPM_Val_S8, &lv_font_montserrat_48, 0);
-  lv_obj_set_style_text_color(ui_Label_RPM_Val_S8, lv_color_white(), 0);
+  ui_gauge_style_value(ui_Label_RPM_Val_S8, &lv_font_montserrat_48);
   lv_obj_center(ui_Label_RPM_Val_S8);
 
   lv_obj_t *rpm_lbl = lv_label_create(rpm_cont);
@@ -216,6 +139,9 @@ void ui_Screen8_screen_init(void) {
   lv_obj_set_style_text_color(rpm_lbl, lv_color_hex(0xFF0000), 0);
   lv_obj_align(rpm_lbl, LV_ALIGN_CENTER, 0, 40);
 
+  // The 280 px track is the costliest thing on the screen to redraw
+  ui_gauge_layer_bake(rpm_cont, ui_Gauge_RPM_S8, &rpm_lbl, 1);
+
   // --- RIGHT: Speed Gauge ---
   lv_obj_t *speed_cont = lv_obj_create(ui_Screen8);
   lv_obj_set_size(speed_cont, 300, 300);
@@ -229,27 +155,21 @@ void ui_Screen8_screen_init(void) {
   lv_arc_set_rotation(ui_Gauge_Speed_S8, 135);
   lv_arc_set_bg_angles(ui_Gauge_Speed_S8, 0, 270);
   lv_arc_set_range(ui_Gauge_Speed_S8, 0, 300); // 0-300 km/h
-  // Style
-  lv_obj_set_style_arc_color(ui_Gauge_Speed_S8, lv_color_hex(0x333333),
-                             LV_PART_MAIN);
-  lv_obj_set_style_arc_width(ui_Gauge_Speed_S8, 20, LV_PART_MAIN);
-  lv_obj_set_style_arc_color(ui_Gauge_Speed_S8, lv_color_white(),
-                             LV_PART_INDICATOR); // White
-  lv_obj_set_style_arc_width(ui_Gauge_Speed_S8, 20, LV_PART_INDICATOR);
+  ui_gauge_style_arc(ui_Gauge_Speed_S8, 0xFFFFFF, true); // White
   lv_obj_remove_style(ui_Gauge_Speed_S8, NULL, LV_PART_KNOB);
   lv_obj_clear_flag(ui_Gauge_Speed_S8, LV_OBJ_FLAG_CLICKABLE);
 
   // Inner Value
   ui_Label_Speed_Val_S8 = lv_label_create(speed_cont);
   lv_label_set_text(ui_Label_Speed_Val_S8, "0");
-  lv_obj_set_style_text_font(ui_Label_Speed_Val_S8, &lv_font_montserrat_48, 0);
-  lv_obj_set_style_text_color(ui_Label_Speed_Val_S8, lv_color_white(), 0);
+  ui_gauge_style_value(ui_Label_Speed_Val_S8, &lv_font_montserrat_48);
   lv_obj_center(ui_Label_Speed_Val_S8);
 
   lv_obj_t *speed_lbl = lv_label_create(speed_cont);
   lv_label_set_text(speed_lbl, "KM/H");
   lv_obj_set_style_text_color(speed_lbl, lv_color_hex(0x888888), 0);
   lv_obj_align(speed_lbl, LV_ALIGN_CENTER, 0, 40);
+  ui_gauge_layer_bake(speed_cont, ui_Gauge_Speed_S8, &speed_lbl, 1);
 
   // --- CENTER: Data Panel ---
   lv_obj_t *center_panel = lv_obj_create(ui_Screen8);
@@ -282,8 +202,7 @@ void ui_Screen8_screen_init(void) {
 
   ui_Label_Boost_Val_S8 = lv_label_create(boost_header);
   lv_label_set_text(ui_Label_Boost_Val_S8, "0");
-  lv_obj_set_style_text_color(ui_Label_Boost_Val_S8, lv_color_white(), 0);
-  lv_obj_set_style_text_font(ui_Label_Boost_Val_S8, &lv_font_montserrat_24, 0);
+  ui_gauge_style_value(ui_Label_Boost_Val_S8, &lv_font_montserrat_24);
   lv_obj_align(ui_Label_Boost_Val_S8, LV_ALIGN_RIGHT_MID, -30, 0);
 
   lv_obj_t *kuag_lbl = lv_label_create(boost_header);
@@ -296,10 +215,7 @@ void ui_Screen8_screen_init(void) {
   ui_Bar_Boost_S8 = lv_bar_create(boost_row);
   lv_obj_set_size(ui_Bar_Boost_S8, 280, 8);
   lv_bar_set_range(ui_Bar_Boost_S8, 0, 250);
-  lv_obj_set_style_bg_color(ui_Bar_Boost_S8, lv_color_hex(0x333333),
-                            LV_PART_MAIN);
-  lv_obj_set_style_bg_color(ui_Bar_Boost_S8, lv_color_hex(0xFF0000),
-                            LV_PART_INDICATOR);
+  ui_gauge_style_bar(ui_Bar_Boost_S8);
   lv_obj_align(ui_Bar_Boost_S8, LV_ALIGN_BOTTOM_MID, 0, 0);
 
   // Separator line
@@ -346,14 +262,6 @@ void ui_Screen8_screen_init(void) {
       lv_obj_set_style_pad_all(g, 10, 0);
     }
   }
-
-  if (demo_mode_get_enabled()) {
-    ui_Screen8_update_animations(true);
-  }
-
-  if (demo_mode_get_enabled()) {
-    ui_Screen8_update_animations(true);
-  }
 }
 
 void ui_Screen8_update(void) {
@@ -364,4 +272,20 @@ void ui_Screen8_screen_destroy(void) {
   if (ui_Screen8)
     lv_obj_del(ui_Screen8);
   ui_Screen8 = NULL;
+
+  // ui_updates keeps refreshing these while the screen is torn down
+  ui_Gauge_RPM_S8 = NULL;
+  ui_Gauge_Speed_S8 = NULL;
+  ui_Gauge_Boost_S8 = NULL;
+  ui_Gauge_Temp_S8 = NULL;
+  ui_Gauge_Fuel_S8 = NULL;
+  ui_Bar_Boost_S8 = NULL;
+  ui_Label_RPM_Val_S8 = NULL;
+  ui_Label_Speed_Val_S8 = NULL;
+  ui_Label_Gear_S8 = NULL;
+  ui_Label_Boost_Val_S8 = NULL;
+  ui_Label_OilTemp_Val_S8 = NULL;
+  ui_Label_OilPress_Val_S8 = NULL;
+  ui_Label_WaterTemp_Val_S8 = NULL;
+  ui_Label_AirTemp_Val_S8 = NULL;
 }
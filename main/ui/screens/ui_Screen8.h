@@ -36,7 +36,6 @@ void ui_Screen8_screen_destroy(void);
 
 // Update function
 void ui_Screen8_update(void);
-void ui_Screen8_update_animations(bool enabled);
 
 #ifdef __cplusplus
 } /*extern "C"*/
@@ -0,0 +1,294 @@
+#include "ui_Screen9.h"
+#include "../ui.h"
+#include "../ui_screen_manager.h"
+#include "esp_log.h"
+#include "session_stats.h"
+#include <stdio.h>
+
+lv_obj_t *ui_Screen9 = NULL;
+
+LV_FONT_DECLARE(lv_font_montserrat_14);
+LV_FONT_DECLARE(lv_font_montserrat_20);
+LV_FONT_DECLARE(lv_font_montserrat_48);
+
+#define SUMMARY_REFRESH_MS 500
+#define ATMOSPHERIC_KPA 101.3f
+
+// Highlight cards: which extremum of which signal
+typedef struct {
+  const char *title;
+  ecu_signal_id_t sig;
+  bool use_max;
+  uint32_t color;
+} summary_card_def_t;
+
+static const summary_card_def_t card_defs[] = {
+    {"PEAK BOOST", ECU_SIG_MAP, true, 0x00D4FF},
+    {"MAX RPM", ECU_SIG_RPM, true, 0xFF0000},
+    {"MIN OIL PRESS", ECU_SIG_OIL_PRESS, false, 0xFFAA00},
+    {"MAX IAT", ECU_SIG_IAT, true, 0x00FF88},
+};
+#define CARD_COUNT (sizeof(card_defs) / sizeof(card_defs[0]))
+
+typedef struct {
+  lv_obj_t *value;
+  lv_obj_t *when;
+  lv_obj_t *context;
+} summary_card_t;
+
+static summary_card_t cards[CARD_COUNT];
+static lv_obj_t *label_duration = NULL;
+static lv_obj_t *table_stats = NULL;
+// Table row -> signal (row 0 is the header)
+static ecu_signal_id_t row_signal[ECU_SIG_COUNT];
+static int table_rows = 0;
+static lv_timer_t *refresh_timer = NULL;
+
+// Format a session-relative time as mm:ss
+static void format_session_time(char *buf, size_t len, uint32_t ms) {
+  uint32_t s = ms / 1000;
+  snprintf(buf, len, "%02lu:%02lu", (unsigned long)(s / 60),
+           (unsigned long)(s % 60));
+}
+
+static void update_card(int idx, uint32_t start_ms) {
+  const summary_card_def_t *def = &card_defs[idx];
+  summary_card_t *card = &cards[idx];
+  session_signal_stats_t st;
+  char buf[64];
+
+  if (!session_stats_get(def->sig, &st) || st.count == 0) {
+    lv_label_set_text(card->value, "--");
+    lv_label_set_text(card->when, "");
+    lv_label_set_text(card->context, "No data");
+    return;
+  }
+
+  float v = def->use_max ? st.max : st.min;
+  uint32_t t = def->use_max ? st.max_ms : st.min_ms;
+  const session_context_t *ctx = def->use_max ? &st.max_ctx : &st.min_ctx;
+
+  if (def->sig == ECU_SIG_MAP) {
+    snprintf(buf, sizeof(buf), "%.2f bar", (v - ATMOSPHERIC_KPA) / 100.0f);
+  } else if (def->sig == ECU_SIG_RPM) {
+    snprintf(buf, sizeof(buf), "%.0f", v);
+  } else {
+    snprintf(buf, sizeof(buf), "%.0f %s", v, ecu_signal_unit(def->sig));
+  }
+  lv_label_set_text(card->value, buf);
+
+  char when[12];
+  format_session_time(when, sizeof(when), t - start_ms);
+  lv_label_set_text_fmt(card->when, "at %s", when);
+
+  snprintf(buf, sizeof(buf), "G%d  %u rpm  %.0f km/h  TPS %u%%", ctx->gear,
+           ctx->rpm, ctx->speed_x10 / 10.0f, ctx->tps);
+  lv_label_set_text(card->context, buf);
+}
+
+static void update_table(void) {
+  char buf[24];
+
+  for (int r = 0; r < table_rows; r++) {
+    uint16_t row = (uint16_t)(r + 1);
+    session_signal_stats_t st;
+
+    if (!session_stats_get(row_signal[r], &st) || st.count == 0) {
+      for (uint16_t col = 1; col < 6; col++) {
+        lv_table_set_cell_value(table_stats, row, col, "--");
+      }
+      continue;
+    }
+
+    snprintf(buf, sizeof(buf), "%.1f", st.min);
+    lv_table_set_cell_value(table_stats, row, 1, buf);
+    snprintf(buf, sizeof(buf), "%.1f", st.max);
+    lv_table_set_cell_value(table_stats, row, 2, buf);
+    snprintf(buf, sizeof(buf), "%.1f", st.mean);
+    lv_table_set_cell_value(table_stats, row, 3, buf);
+    snprintf(buf, sizeof(buf), "%.2f", session_stats_stddev(&st));
+    lv_table_set_cell_value(table_stats, row, 4, buf);
+
+    if (st.thresh_dir != SESSION_THRESH_NONE) {
+      snprintf(buf, sizeof(buf), "%.1f s (%s%.0f)", st.time_over_ms / 1000.0f,
+               st.thresh_dir == SESSION_THRESH_ABOVE ? ">" : "<",
+               st.threshold);
+    } else {
+      snprintf(buf, sizeof(buf), "-");
+    }
+    lv_table_set_cell_value(table_stats, row, 5, buf);
+  }
+}
+
+void ui_Screen9_update(void) {
+  if (!ui_Screen9)
+    return;
+
+  uint32_t start_ms = session_stats_get_start_ms();
+  char dur[12];
+  format_session_time(dur, sizeof(dur), session_stats_get_duration_ms());
+  lv_label_set_text_fmt(label_duration, "Session %s", dur);
+
+  for (int i = 0; i < (int)CARD_COUNT; i++) {
+    update_card(i, start_ms);
+  }
+  update_table();
+}
+
+static void refresh_timer_cb(lv_timer_t *timer) {
+  // Only spend time on the summary while it is on screen
+  if (lv_scr_act() != ui_Screen9)
+    return;
+  ui_Screen9_update();
+}
+
+static void reset_button_event_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+    session_stats_reset();
+    ui_Screen9_update();
+    ESP_LOGI("SCREEN9", "Session statistics reset from UI");
+  }
+}
+
+static void create_card(lv_obj_t *parent, int idx) {
+  const summary_card_def_t *def = &card_defs[idx];
+
+  lv_obj_t *card = lv_obj_create(parent);
+  lv_obj_set_size(card, 290, 170);
+  lv_obj_set_pos(card, 20 + idx * 310, 70);
+  lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_style_bg_color(card, lv_color_hex(0x1a1a1a), 0);
+  lv_obj_set_style_border_color(card, lv_color_hex(def->color), 0);
+  lv_obj_set_style_border_width(card, 2, 0);
+  lv_obj_set_style_radius(card, 10, 0);
+  lv_obj_set_style_pad_all(card, 10, 0);
+
+  lv_obj_t *title = lv_label_create(card);
+  lv_label_set_text(title, def->title);
+  lv_obj_set_style_text_color(title, lv_color_hex(def->color), 0);
+  lv_obj_set_style_text_font(title, &lv_font_montserrat_14, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_LEFT, 0, 0);
+
+  cards[idx].value = lv_label_create(card);
+  lv_label_set_text(cards[idx].value, "--");
+  lv_obj_set_style_text_color(cards[idx].value, lv_color_white(), 0);
+  lv_obj_set_style_text_font(cards[idx].value, &lv_font_montserrat_48, 0);
+  lv_obj_align(cards[idx].value, LV_ALIGN_TOP_LEFT, 0, 25);
+
+  cards[idx].when = lv_label_create(card);
+  lv_label_set_text(cards[idx].when, "");
+  lv_obj_set_style_text_color(cards[idx].when, lv_color_hex(0xAAAAAA), 0);
+  lv_obj_set_style_text_font(cards[idx].when, &lv_font_montserrat_14, 0);
+  lv_obj_align(cards[idx].when, LV_ALIGN_TOP_LEFT, 0, 95);
+
+  cards[idx].context = lv_label_create(card);
+  lv_label_set_text(cards[idx].context, "No data");
+  lv_obj_set_style_text_color(cards[idx].context, lv_color_hex(0xAAAAAA), 0);
+  lv_obj_set_style_text_font(cards[idx].context, &lv_font_montserrat_14, 0);
+  lv_obj_align(cards[idx].context, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+}
+
+void ui_Screen9_screen_init(void) {
+  ESP_LOGI("SCREEN9", "Initializing Session Summary");
+
+  ui_Screen9 = lv_obj_create(NULL);
+  lv_obj_set_size(ui_Screen9, 1280, 720);
+  lv_obj_clear_flag(ui_Screen9, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_style_bg_color(ui_Screen9, lv_color_hex(0x121212), 0);
+  lv_obj_set_style_bg_opa(ui_Screen9, LV_OPA_COVER, 0);
+
+  // --- Header ---
+  lv_obj_t *title = lv_label_create(ui_Screen9);
+  lv_label_set_text(title, "SESSION SUMMARY");
+  lv_obj_set_style_text_color(title, lv_color_hex(0x00D4FF), 0);
+  lv_obj_set_style_text_font(title, &lv_font_montserrat_20, 0);
+  lv_obj_set_style_text_letter_space(title, 2, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+
+  label_duration = lv_label_create(ui_Screen9);
+  lv_label_set_text(label_duration, "Session 00:00");
+  lv_obj_set_style_text_color(label_duration, lv_color_hex(0xAAAAAA), 0);
+  lv_obj_set_style_text_font(label_duration, &lv_font_montserrat_14, 0);
+  lv_obj_align(label_duration, LV_ALIGN_TOP_LEFT, 20, 25);
+
+  lv_obj_t *reset_btn = lv_btn_create(ui_Screen9);
+  lv_obj_set_size(reset_btn, 120, 40);
+  lv_obj_align(reset_btn, LV_ALIGN_TOP_RIGHT, -20, 15);
+  lv_obj_set_style_bg_color(reset_btn, lv_color_hex(0x333333), 0);
+  lv_obj_set_style_radius(reset_btn, 8, 0);
+  lv_obj_add_event_cb(reset_btn, reset_button_event_cb, LV_EVENT_CLICKED, NULL);
+
+  lv_obj_t *reset_lbl = lv_label_create(reset_btn);
+  lv_label_set_text(reset_lbl, LV_SYMBOL_REFRESH " RESET");
+  lv_obj_set_style_text_color(reset_lbl, lv_color_white(), 0);
+  lv_obj_center(reset_lbl);
+
+  // --- Highlight cards ---
+  for (int i = 0; i < (int)CARD_COUNT; i++) {
+    create_card(ui_Screen9, i);
+  }
+
+  // --- Per-signal table ---
+  table_stats = lv_table_create(ui_Screen9);
+  lv_obj_set_size(table_stats, 1000, 370);
+  lv_obj_align(table_stats, LV_ALIGN_TOP_MID, 0, 260);
+  lv_obj_set_style_bg_color(table_stats, lv_color_hex(0x121212), 0);
+  lv_obj_set_style_border_width(table_stats, 0, 0);
+  lv_obj_set_style_bg_color(table_stats, lv_color_hex(0x121212),
+                            LV_PART_ITEMS);
+  lv_obj_set_style_text_color(table_stats, lv_color_white(), LV_PART_ITEMS);
+  lv_obj_set_style_text_font(table_stats, &lv_font_montserrat_14,
+                             LV_PART_ITEMS);
+  lv_obj_set_style_border_color(table_stats, lv_color_hex(0x333333),
+                                LV_PART_ITEMS);
+  lv_obj_set_style_border_side(table_stats, LV_BORDER_SIDE_BOTTOM,
+                               LV_PART_ITEMS);
+  lv_obj_set_style_pad_ver(table_stats, 6, LV_PART_ITEMS);
+
+  static const char *headers[] = {"Signal", "Min",    "Max",
+                                  "Mean",   "StdDev", "Over threshold"};
+  static const lv_coord_t widths[] = {200, 140, 140, 140, 140, 240};
+  lv_table_set_col_cnt(table_stats, 6);
+  // Unused derived slots get no row
+  table_rows = 0;
+  for (int i = 0; i < ECU_SIG_COUNT; i++) {
+    if (ecu_signal_defined((ecu_signal_id_t)i))
+      row_signal[table_rows++] = (ecu_signal_id_t)i;
+  }
+  lv_table_set_row_cnt(table_stats, (uint16_t)(table_rows + 1));
+  for (uint16_t col = 0; col < 6; col++) {
+    lv_table_set_col_width(table_stats, col, widths[col]);
+    lv_table_set_cell_value(table_stats, 0, col, headers[col]);
+  }
+  for (int r = 0; r < table_rows; r++) {
+    char name[32];
+    ecu_signal_id_t sig = row_signal[r];
+    const char *unit = ecu_signal_unit(sig);
+    if (unit[0])
+      snprintf(name, sizeof(name), "%s (%s)", ecu_signal_name(sig), unit);
+    else
+      snprintf(name, sizeof(name), "%s", ecu_signal_name(sig));
+    lv_table_set_cell_value(table_stats, (uint16_t)(r + 1), 0, name);
+  }
+
+  // Navigation
+  lv_obj_add_event_cb(ui_Screen9, ui_screen_swipe_event_cb, LV_EVENT_GESTURE,
+                      NULL);
+  ui_create_standard_navigation_buttons(ui_Screen9);
+
+  refresh_timer = lv_timer_create(refresh_timer_cb, SUMMARY_REFRESH_MS, NULL);
+  ui_Screen9_update();
+}
+
+void ui_Screen9_screen_destroy(void) {
+  if (refresh_timer) {
+    lv_timer_del(refresh_timer);
+    refresh_timer = NULL;
+  }
+  if (ui_Screen9) {
+    lv_obj_del(ui_Screen9);
+    ui_Screen9 = NULL;
+    label_duration = NULL;
+    table_stats = NULL;
+  }
+}
@@ -0,0 +1,25 @@
+// ECU Dashboard Screen 9 - Session Summary
+// Peak-hold and per-signal statistics for the current session
+
+#ifndef UI_SCREEN9_H
+#define UI_SCREEN9_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../ui.h"
+
+extern lv_obj_t *ui_Screen9;
+
+void ui_Screen9_screen_init(void);
+void ui_Screen9_screen_destroy(void);
+
+// Refresh the summary from session_stats (called periodically while visible)
+void ui_Screen9_update(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
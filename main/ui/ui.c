@@ -4,7 +4,9 @@
 // Project name: Westgate Dashboard
 
 #include "ui.h"
+#include "can_manager.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "screens/ui_Screen2.h"
 #include "screens/ui_Screen3.h"
 #include "screens/ui_Screen4.h"
@@ -12,7 +14,10 @@
 #include "screens/ui_Screen6.h"
 #include "screens/ui_Screen7.h"
 #include "screens/ui_Screen8.h"
+#include "screens/ui_Screen9.h"
+#include "screens/ui_Screen10.h"
 #include "ui_helpers.h"
+#include "ui_layout_manager.h"
 #include "ui_screen_manager.h"
 
 // EVENTS
@@ -58,15 +63,16 @@ void ui_init(void) {
   // Settings are already loaded in main.c, no need to load again
   // settings_load(); // REMOVED: Settings already loaded in main.c
 
-  // Initialize all screens AFTER theme is applied (as in old working version)
-  ui_Screen1_screen_init();
-  ui_Screen2_screen_init(); // Add Screen2 initialization
-  ui_Screen3_screen_init(); // Add Screen3 initialization
-  ui_Screen4_screen_init(); // Add Screen4 initialization
-  ui_Screen5_screen_init(); // Add Screen5 initialization
-  ui_Screen6_screen_init(); // Add Screen6 initialization
-  ui_Screen7_screen_init(); // Add Screen7 initialization
-  ui_Screen8_screen_init(); // Add Screen8 initialization
+  // Build the pinned screens (always the gauge pages) AFTER the theme is
+  // applied; the rest are built by the screen manager on first visit
+  int64_t t0 = esp_timer_get_time();
+  ui_screens_create_pinned();
+  ui_layout_manager_init(); // Gauge cards onto the pages
+  ESP_LOGI("UI", "Pinned screens built in %lu ms",
+           (unsigned long)((esp_timer_get_time() - t0) / 1000));
+
+  // Periodic gauge refresh from the shared ECU snapshot
+  ui_updates_init();
 
   ui____initial_actions0 = lv_obj_create(NULL);
   lv_disp_load_scr(ui_Screen1);
@@ -81,6 +87,8 @@ void ui_destroy(void) {
   ui_Screen6_screen_destroy();
   ui_Screen7_screen_destroy();
   ui_Screen8_screen_destroy();
+  ui_Screen9_screen_destroy();
+  ui_Screen10_screen_destroy();
 }
 
 /**
@@ -89,13 +97,7 @@ void ui_destroy(void) {
  * @param enabled true to enable demo mode, false to disable.
  */
 void ui_set_global_demo_mode(bool enabled) {
-  // Update the data simulation flag
-  ui_updates_set_demo_mode(enabled);
-
-  // Call the animation update function for each screen that supports it.
-  ui_Screen1_update_animations(enabled);
-  ui_Screen2_update_animations(enabled);
-  ui_Screen4_update_animations(enabled);
-  ui_Screen5_update_animations(enabled);
-  ui_Screen8_update_animations(enabled);
+  // Demo data comes from the frame-level CAN simulator, which feeds the same
+  // parser -> ecu_data -> gauges path as the real bus.
+  can_manager_set_demo_mode(enabled);
 }
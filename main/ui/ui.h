@@ -36,39 +36,6 @@ LV_FONT_DECLARE(lv_font_montserrat_48);
 
 ///////////////////// VARIABLES ////////////////////
 
-// SCREEN 1
-extern lv_obj_t * ui_Arc_MAP;
-extern lv_obj_t * ui_Arc_Wastegate;
-extern lv_obj_t * ui_Arc_TPS;
-extern lv_obj_t * ui_Arc_RPM;
-extern lv_obj_t * ui_Arc_Boost;
-extern lv_obj_t * ui_Label_MAP_Value;
-extern lv_obj_t * ui_Label_Wastegate_Value;
-extern lv_obj_t * ui_Label_TPS_Value;
-extern lv_obj_t * ui_Label_RPM_Value;
-extern lv_obj_t * ui_Label_Boost_Value;
-
-// SCREEN 4
-extern lv_obj_t * ui_Arc_Abs_Pedal;
-extern lv_obj_t * ui_Arc_WG_Pos;
-extern lv_obj_t * ui_Arc_BOV;
-extern lv_obj_t * ui_Arc_TCU_TQ_Req;
-extern lv_obj_t * ui_Arc_TCU_TQ_Act;
-extern lv_obj_t * ui_Arc_Eng_TQ_Req;
-extern lv_obj_t * ui_Label_Abs_Pedal_Value;
-extern lv_obj_t * ui_Label_WG_Pos_Value;
-extern lv_obj_t * ui_Label_BOV_Value;
-extern lv_obj_t * ui_Label_TCU_TQ_Req_Value;
-extern lv_obj_t * ui_Label_TCU_TQ_Act_Value;
-extern lv_obj_t * ui_Label_Eng_TQ_Req_Value;
-
-// SCREEN 5
-extern lv_obj_t * ui_Arc_Eng_TQ_Act;
-extern lv_obj_t * ui_Label_Eng_TQ_Act_Value;
-extern lv_obj_t * ui_Arc_Limit_TQ;
-extern lv_obj_t * ui_Arc_Limit_TQ;
-extern lv_obj_t * ui_Label_Limit_TQ_Value;
-
 // SCREEN 7
 extern lv_obj_t * ui_Screen7;
 
@@ -0,0 +1,228 @@
+#include "ui_gauge_layers.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "GAUGE_LAYERS";
+
+// The host build has no sdkconfig; bake there too so ui_bench measures it
+#if !defined(ESP_PLATFORM) && !defined(CONFIG_UI_GAUGE_STATIC_LAYERS)
+#define CONFIG_UI_GAUGE_STATIC_LAYERS 1
+#endif
+
+// Every pooled gauge card (GAUGE_LAYOUT_MAX) plus the two Screen8 dials
+#define MAX_LAYERS 26
+
+typedef struct {
+  lv_obj_t *cont; // NULL = free slot
+  lv_obj_t *arc;
+  lv_obj_t *statics[UI_GAUGE_LAYER_MAX_STATICS];
+  uint8_t static_count;
+  lv_img_dsc_t img;
+  lv_style_t style; // Background image, card background and border hidden
+} gauge_layer_t;
+
+static gauge_layer_t layers[MAX_LAYERS];
+static size_t layer_bytes = 0;
+
+static bool track_style_initialized = false;
+static lv_style_t style_track_baked; // The arc track is in the image
+
+static lv_style_t *track_style(void) {
+  if (!track_style_initialized) {
+    track_style_initialized = true;
+    lv_style_init(&style_track_baked);
+    lv_style_set_arc_opa(&style_track_baked, LV_OPA_TRANSP);
+  }
+  return &style_track_baked;
+}
+
+// Colour the card corners are composed over
+static lv_color_t backdrop_color(lv_obj_t *obj) {
+  for (lv_obj_t *p = lv_obj_get_parent(obj); p; p = lv_obj_get_parent(p)) {
+    if (lv_obj_get_style_bg_opa(p, LV_PART_MAIN) >= LV_OPA_COVER)
+      return lv_obj_get_style_bg_color(p, LV_PART_MAIN);
+  }
+  return lv_color_black();
+}
+
+static void layer_free(gauge_layer_t *l) {
+  if (l->img.data) {
+    heap_caps_free((void *)l->img.data);
+    layer_bytes -= l->img.data_size;
+  }
+  l->img.data = NULL;
+  l->img.data_size = 0;
+}
+
+// Same geometry as the arc widget uses for its background track
+static void draw_track(lv_obj_t *canvas, lv_obj_t *arc,
+                       const lv_area_t *origin) {
+  lv_draw_arc_dsc_t dsc;
+  lv_draw_arc_dsc_init(&dsc);
+  lv_obj_init_draw_arc_dsc(arc, LV_PART_MAIN, &dsc);
+  if (dsc.width <= 0 || dsc.opa <= LV_OPA_MIN)
+    return;
+
+  lv_coord_t left = lv_obj_get_style_pad_left(arc, LV_PART_MAIN);
+  lv_coord_t right = lv_obj_get_style_pad_right(arc, LV_PART_MAIN);
+  lv_coord_t top = lv_obj_get_style_pad_top(arc, LV_PART_MAIN);
+  lv_coord_t bottom = lv_obj_get_style_pad_bottom(arc, LV_PART_MAIN);
+  lv_coord_t r = LV_MIN(lv_obj_get_width(arc) - left - right,
+                        lv_obj_get_height(arc) - top - bottom) / 2;
+  if (dsc.width > r)
+    dsc.width = r;
+
+  lv_area_t coords;
+  lv_obj_get_coords(arc, &coords);
+  uint16_t rotation = ((lv_arc_t *)arc)->rotation;
+  lv_canvas_draw_arc(canvas, coords.x1 - origin->x1 + left + r,
+                     coords.y1 - origin->y1 + top + r, r,
+                     lv_arc_get_bg_angle_start(arc) + rotation,
+                     lv_arc_get_bg_angle_end(arc) + rotation, &dsc);
+}
+
+static void draw_label(lv_obj_t *canvas, lv_obj_t *label,
+                       const lv_area_t *origin) {
+  lv_draw_label_dsc_t dsc;
+  lv_draw_label_dsc_init(&dsc);
+  lv_obj_init_draw_label_dsc(label, LV_PART_MAIN, &dsc);
+
+  lv_area_t a;
+  lv_obj_get_content_coords(label, &a);
+  lv_canvas_draw_text(canvas, a.x1 - origin->x1, a.y1 - origin->y1,
+                      lv_area_get_width(&a), &dsc, lv_label_get_text(label));
+}
+
+static bool layer_render(gauge_layer_t *l) {
+  // Read the live styles, not the baked ones
+  lv_obj_remove_style(l->cont, &l->style, LV_PART_MAIN);
+  if (l->arc)
+    lv_obj_remove_style(l->arc, track_style(), LV_PART_MAIN);
+  lv_obj_update_layout(l->cont);
+
+  lv_area_t origin;
+  lv_obj_get_coords(l->cont, &origin);
+  lv_coord_t w = lv_area_get_width(&origin);
+  lv_coord_t h = lv_area_get_height(&origin);
+  uint32_t size = LV_CANVAS_BUF_SIZE_TRUE_COLOR(w, h);
+
+  if (!l->img.data || l->img.header.w != w || l->img.header.h != h) {
+    layer_free(l);
+    l->img.data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    if (!l->img.data) {
+      ESP_LOGW(TAG, "No PSRAM for a %dx%d layer, drawing it live", w, h);
+      for (uint8_t i = 0; i < l->static_count; i++)
+        lv_obj_clear_flag(l->statics[i], LV_OBJ_FLAG_HIDDEN);
+      return false;
+    }
+    l->img.data_size = size;
+    layer_bytes += size;
+  }
+
+  lv_obj_t *canvas = lv_canvas_create(l->cont);
+  lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_IGNORE_LAYOUT);
+  lv_canvas_set_buffer(canvas, (void *)l->img.data, w, h,
+                       LV_IMG_CF_TRUE_COLOR);
+  lv_canvas_fill_bg(canvas, backdrop_color(l->cont), LV_OPA_COVER);
+
+  lv_draw_rect_dsc_t rect;
+  lv_draw_rect_dsc_init(&rect);
+  lv_obj_init_draw_rect_dsc(l->cont, LV_PART_MAIN, &rect);
+  lv_canvas_draw_rect(canvas, 0, 0, w, h, &rect);
+
+  if (l->arc)
+    draw_track(canvas, l->arc, &origin);
+  for (uint8_t i = 0; i < l->static_count; i++)
+    draw_label(canvas, l->statics[i], &origin);
+  lv_obj_del(canvas);
+
+  l->img.header.always_zero = 0;
+  l->img.header.cf = LV_IMG_CF_TRUE_COLOR;
+  l->img.header.w = w;
+  l->img.header.h = h;
+
+  // The image replaces the card and the border; the border keeps its width
+  // so the children stay where they were laid out
+  lv_style_reset(&l->style);
+  lv_style_init(&l->style);
+  lv_style_set_bg_img_src(&l->style, &l->img);
+  lv_style_set_bg_opa(&l->style, LV_OPA_TRANSP);
+  lv_style_set_border_opa(&l->style, LV_OPA_TRANSP);
+  lv_style_set_shadow_width(&l->style, 0);
+  lv_obj_add_style(l->cont, &l->style, LV_PART_MAIN);
+  if (l->arc)
+    lv_obj_add_style(l->arc, track_style(), LV_PART_MAIN);
+  for (uint8_t i = 0; i < l->static_count; i++)
+    lv_obj_add_flag(l->statics[i], LV_OBJ_FLAG_HIDDEN);
+  return true;
+}
+
+static void layer_delete_cb(lv_event_t *e) {
+  gauge_layer_t *l = lv_event_get_user_data(e);
+  // Nothing is rendered while the container is being deleted
+  layer_free(l);
+  l->cont = NULL;
+}
+
+void ui_gauge_layer_bake(lv_obj_t *cont, lv_obj_t *arc,
+                         lv_obj_t *const statics[], uint8_t count) {
+#if CONFIG_UI_GAUGE_STATIC_LAYERS
+  if (!cont || count > UI_GAUGE_LAYER_MAX_STATICS)
+    return;
+
+  gauge_layer_t *l = NULL;
+  for (int i = 0; i < MAX_LAYERS && !l; i++) {
+    if (!layers[i].cont)
+      l = &layers[i];
+  }
+  if (!l) {
+    ESP_LOGW(TAG, "Layer table full, gauge drawn live");
+    return;
+  }
+
+  l->cont = cont;
+  l->arc = arc;
+  l->static_count = count;
+  for (uint8_t i = 0; i < count; i++)
+    l->statics[i] = statics[i];
+  lv_style_init(&l->style);
+
+  if (!layer_render(l)) {
+    l->cont = NULL;
+    return;
+  }
+  lv_obj_add_event_cb(cont, layer_delete_cb, LV_EVENT_DELETE, l);
+#else
+  (void)cont;
+  (void)arc;
+  (void)statics;
+  (void)count;
+#endif
+}
+
+void ui_gauge_layer_rebake(lv_obj_t *cont) {
+  for (int i = 0; i < MAX_LAYERS; i++) {
+    if (layers[i].cont == cont) {
+      if (layer_render(&layers[i]))
+        lv_obj_invalidate(cont);
+      return;
+    }
+  }
+}
+
+void ui_gauge_layers_refresh(void) {
+  int64_t t0 = esp_timer_get_time();
+  int n = 0;
+  for (int i = 0; i < MAX_LAYERS; i++) {
+    if (layers[i].cont && layer_render(&layers[i])) {
+      lv_obj_invalidate(layers[i].cont);
+      n++;
+    }
+  }
+  ESP_LOGI(TAG, "Re-rendered %d layers in %lu ms (%u KB PSRAM)", n,
+           (unsigned long)((esp_timer_get_time() - t0) / 1000),
+           (unsigned)(layer_bytes / 1024));
+}
+
+size_t ui_gauge_layers_get_bytes(void) { return layer_bytes; }
@@ -0,0 +1,46 @@
+// Pre-rendered static layers for the gauge cards
+
+#ifndef UI_GAUGE_LAYERS_H
+#define UI_GAUGE_LAYERS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// A gauge is mostly static: the card background and border, the arc track,
+// the title and the unit never change, yet LVGL redraws all of them in every
+// area the indicator or the value text invalidates. Baking renders those
+// parts once into an RGB565 image in PSRAM and shows it as the container's
+// background image. The static labels are hidden and the arc only draws its
+// indicator, so a value change costs one image blit plus the live parts.
+//
+// The corners are rendered over the background of the nearest opaque
+// ancestor, so the image is only correct on a solid backdrop of that colour.
+
+#define UI_GAUGE_LAYER_MAX_STATICS 4
+
+// Bake the static layer of `cont`. `arc` (may be NULL) keeps its indicator
+// live; `statics` are labels inside `cont` that never change. The buffer is
+// freed with the container.
+void ui_gauge_layer_bake(lv_obj_t *cont, lv_obj_t *arc,
+                         lv_obj_t *const statics[], uint8_t count);
+
+// Re-render the layer of `cont` after one of its static parts changed (a
+// pooled card given a new title, unit or accent). No-op if not baked.
+void ui_gauge_layer_rebake(lv_obj_t *cont);
+
+// Re-render every baked layer, e.g. after the theme has changed
+void ui_gauge_layers_refresh(void);
+
+// PSRAM held by the baked layers
+size_t ui_gauge_layers_get_bytes(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // UI_GAUGE_LAYERS_H
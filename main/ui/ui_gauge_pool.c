@@ -0,0 +1,215 @@
+#include "ui_gauge_pool.h"
+#include "esp_log.h"
+#include "ui.h"
+#include "ui_gauge_layers.h"
+#include "ui_gauge_styles.h"
+#include <math.h>
+#include <string.h>
+
+static const char *TAG = "GAUGE_POOL";
+
+#define CARD_W 250
+#define CARD_H 225
+#define ARC_SIZE 160
+
+lv_obj_t *ui_LED_TCU = NULL;
+lv_obj_t *ui_Label_TCU_Status = NULL;
+lv_obj_t *ui_Label_Gear_S1 = NULL;
+lv_obj_t *ui_Label_Selector_S1 = NULL;
+
+static ui_gauge_card_t cards[UI_GAUGE_POOL_MAX];
+
+static void card_deleted_cb(lv_event_t *e) {
+  ui_gauge_card_t *c = lv_event_get_user_data(e);
+  if (c->type == GAUGE_WIDGET_TCU) {
+    ui_LED_TCU = NULL;
+    ui_Label_TCU_Status = NULL;
+    ui_Label_Gear_S1 = NULL;
+    ui_Label_Selector_S1 = NULL;
+  }
+  memset(c, 0, sizeof(*c));
+}
+
+static lv_obj_t *create_container(lv_obj_t *parent, uint32_t color) {
+  lv_obj_t *cont = lv_obj_create(parent);
+  lv_obj_add_flag(cont, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_set_size(cont, CARD_W, CARD_H);
+  lv_obj_set_align(cont, LV_ALIGN_TOP_LEFT);
+  lv_obj_clear_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+  ui_gauge_style_container(cont, color);
+  // Keep gauges behind navigation buttons
+  lv_obj_move_background(cont);
+  return cont;
+}
+
+static lv_obj_t *create_title(lv_obj_t *cont, const char *text) {
+  lv_obj_t *title = lv_label_create(cont);
+  lv_label_set_text(title, text);
+  ui_gauge_style_title(title);
+  lv_obj_align(title, LV_ALIGN_BOTTOM_MID, 0, -15);
+  return title;
+}
+
+static void build_arc(ui_gauge_card_t *c, const gauge_layout_entry_t *e) {
+  c->arc = lv_arc_create(c->cont);
+  lv_obj_set_size(c->arc, ARC_SIZE, ARC_SIZE);
+  lv_arc_set_rotation(c->arc, 135);
+  lv_arc_set_bg_angles(c->arc, 0, 270);
+  ui_gauge_style_arc(c->arc, e->color, false);
+  lv_obj_center(c->arc);
+  lv_obj_remove_style(c->arc, NULL, LV_PART_KNOB);
+  lv_obj_clear_flag(c->arc, LV_OBJ_FLAG_CLICKABLE);
+
+  c->value = lv_label_create(c->cont);
+  lv_label_set_text(c->value, "0");
+  ui_gauge_style_value(c->value, &lv_font_montserrat_24);
+  lv_obj_align(c->value, LV_ALIGN_CENTER, 0, -5);
+
+  c->unit = lv_label_create(c->cont);
+  lv_label_set_text(c->unit, e->unit);
+  ui_gauge_style_unit(c->unit);
+  lv_obj_align_to(c->unit, c->value, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
+}
+
+static void build_tcu(ui_gauge_card_t *c) {
+  ui_LED_TCU = lv_led_create(c->cont);
+  lv_obj_set_size(ui_LED_TCU, 30, 30);
+  lv_obj_align(ui_LED_TCU, LV_ALIGN_TOP_RIGHT, -10, 10);
+  lv_led_set_color(ui_LED_TCU, lv_color_hex(0x00FF00));
+  lv_led_on(ui_LED_TCU);
+
+  ui_Label_TCU_Status = lv_label_create(c->cont);
+  lv_label_set_text(ui_Label_TCU_Status, "OK");
+  lv_obj_set_style_text_color(ui_Label_TCU_Status, lv_color_hex(0x00FF00), 0);
+  lv_obj_align(ui_Label_TCU_Status, LV_ALIGN_TOP_RIGHT, -50, 15);
+
+  ui_Label_Gear_S1 = lv_label_create(c->cont);
+  lv_label_set_text(ui_Label_Gear_S1, "Gear: -");
+  lv_obj_set_style_text_color(ui_Label_Gear_S1, lv_color_white(), 0);
+  lv_obj_set_style_text_font(ui_Label_Gear_S1, &lv_font_montserrat_24, 0);
+  lv_obj_align(ui_Label_Gear_S1, LV_ALIGN_LEFT_MID, 10, -20);
+
+  ui_Label_Selector_S1 = lv_label_create(c->cont);
+  lv_label_set_text(ui_Label_Selector_S1, "Sel: -");
+  lv_obj_set_style_text_color(ui_Label_Selector_S1, lv_color_white(), 0);
+  lv_obj_set_style_text_font(ui_Label_Selector_S1, &lv_font_montserrat_24, 0);
+  lv_obj_align(ui_Label_Selector_S1, LV_ALIGN_LEFT_MID, 10, 20);
+}
+
+static void set_range(ui_gauge_card_t *c, const gauge_layout_entry_t *e) {
+  int16_t min = (int16_t)lroundf(e->min);
+  lv_arc_set_range(c->arc, min, (int16_t)lroundf(e->max));
+  lv_arc_set_value(c->arc, min);
+  lv_label_set_text_static(c->value, "0");
+}
+
+static bool build(ui_gauge_card_t *c, const gauge_layout_entry_t *e,
+                  lv_obj_t *parent) {
+  c->cont = create_container(parent, e->color);
+  if (!c->cont)
+    return false;
+  c->type = e->type;
+  c->accent = e->color;
+  c->title = create_title(c->cont, e->title);
+
+  // Card, track, title and unit never change: render them once
+  if (e->type == GAUGE_WIDGET_ARC) {
+    build_arc(c, e);
+    set_range(c, e);
+    lv_obj_t *statics[] = {c->title, c->unit};
+    ui_gauge_layer_bake(c->cont, c->arc, statics, 2);
+  } else {
+    build_tcu(c);
+    ui_gauge_layer_bake(c->cont, NULL, &c->title, 1);
+  }
+  lv_obj_add_event_cb(c->cont, card_deleted_cb, LV_EVENT_DELETE, c);
+  return true;
+}
+
+// Point a free card at e, re-rendering its static layer only if it changed
+static void configure(ui_gauge_card_t *c, const gauge_layout_entry_t *e) {
+  bool restatic = false;
+  if (strcmp(lv_label_get_text(c->title), e->title) != 0) {
+    lv_label_set_text(c->title, e->title);
+    restatic = true;
+  }
+  if (c->accent != e->color) {
+    ui_gauge_set_accent(c->cont, LV_PART_MAIN, c->accent, e->color);
+    if (c->arc)
+      ui_gauge_set_accent(c->arc, LV_PART_INDICATOR, c->accent, e->color);
+    c->accent = e->color;
+    restatic = true;
+  }
+  if (c->arc) {
+    if (strcmp(lv_label_get_text(c->unit), e->unit) != 0) {
+      lv_label_set_text(c->unit, e->unit);
+      lv_obj_align_to(c->unit, c->value, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
+      restatic = true;
+    }
+    set_range(c, e);
+  }
+  if (restatic)
+    ui_gauge_layer_rebake(c->cont);
+}
+
+ui_gauge_card_t *ui_gauge_pool_acquire(const gauge_layout_entry_t *e,
+                                       lv_obj_t *parent) {
+  ui_gauge_card_t *pick = NULL;
+  ui_gauge_card_t *unbuilt = NULL;
+  int best = -1;
+  for (int i = 0; i < UI_GAUGE_POOL_MAX; i++) {
+    ui_gauge_card_t *c = &cards[i];
+    if (!c->cont) {
+      if (!unbuilt)
+        unbuilt = c;
+      continue;
+    }
+    if (c->in_use || c->type != e->type)
+      continue;
+    int score = (strcmp(c->key, e->key) == 0) * 2 +
+                (lv_obj_get_parent(c->cont) == parent);
+    if (score > best) {
+      pick = c;
+      best = score;
+    }
+  }
+
+  if (pick) {
+    configure(pick, e);
+  } else if (unbuilt && build(unbuilt, e, parent)) {
+    pick = unbuilt;
+  } else {
+    ESP_LOGW(TAG, "No card for %s", e->key);
+    return NULL;
+  }
+  snprintf(pick->key, sizeof(pick->key), "%s", e->key);
+  pick->in_use = true;
+  return pick;
+}
+
+void ui_gauge_pool_release(ui_gauge_card_t *card) {
+  if (!card || !card->cont)
+    return;
+  lv_obj_add_flag(card->cont, LV_OBJ_FLAG_HIDDEN);
+  card->in_use = false;
+}
+
+void ui_gauge_pool_place(ui_gauge_card_t *card, lv_obj_t *parent,
+                         lv_coord_t x, lv_coord_t y) {
+  if (!card || !card->cont)
+    return;
+  if (lv_obj_get_parent(card->cont) != parent) {
+    lv_obj_set_parent(card->cont, parent);
+    lv_obj_move_background(card->cont);
+  }
+  lv_obj_set_pos(card->cont, x, y);
+  lv_obj_clear_flag(card->cont, LV_OBJ_FLAG_HIDDEN);
+}
+
+ui_gauge_card_t *ui_gauge_pool_card(int n) {
+  return (n >= 0 && n < UI_GAUGE_POOL_MAX) ? &cards[n] : NULL;
+}
+
+int ui_gauge_pool_index(const ui_gauge_card_t *card) {
+  return card ? (int)(card - cards) : -1;
+}
@@ -0,0 +1,62 @@
+// Pooled gauge cards for the layout-driven gauge pages
+
+#ifndef UI_GAUGE_POOL_H
+#define UI_GAUGE_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gauge_layout.h"
+#include "lvgl.h"
+#include <stdbool.h>
+
+// Cards are built on first use and kept while their page lives. A card
+// released by the layout keeps its objects and baked layer, and the next
+// gauge of the same widget type takes it over: only what differs is
+// touched (a range is one arc call; a new title, unit or accent re-renders
+// the static layer), so toggling gauges or reloading the layout does not
+// create or delete objects.
+
+#define UI_GAUGE_POOL_MAX GAUGE_LAYOUT_MAX
+
+typedef struct {
+  lv_obj_t *cont; // NULL = never built, or deleted with its page
+  lv_obj_t *arc;  // Arc cards only
+  lv_obj_t *value;
+  lv_obj_t *title;
+  lv_obj_t *unit;
+  gauge_widget_t type;
+  uint32_t accent;
+  char key[16]; // Entry it was last configured for
+  bool in_use;
+} ui_gauge_card_t;
+
+// The TCU card's live widgets (NULL until it is built)
+extern lv_obj_t *ui_LED_TCU;
+extern lv_obj_t *ui_Label_TCU_Status;
+extern lv_obj_t *ui_Label_Gear_S1;
+extern lv_obj_t *ui_Label_Selector_S1;
+
+// A free card of e's type configured for e, hidden. Prefers the card that
+// last showed e, then one already on `parent`; builds one on `parent` if
+// none is free. NULL when the pool is full.
+ui_gauge_card_t *ui_gauge_pool_acquire(const gauge_layout_entry_t *e,
+                                       lv_obj_t *parent);
+
+// Hide the card and return it to the pool
+void ui_gauge_pool_release(ui_gauge_card_t *card);
+
+// Show the card at (x, y) on `parent`, reparenting only if it is elsewhere
+void ui_gauge_pool_place(ui_gauge_card_t *card, lv_obj_t *parent,
+                         lv_coord_t x, lv_coord_t y);
+
+// Cards have fixed addresses, so widgets can be bound through them
+ui_gauge_card_t *ui_gauge_pool_card(int n);
+int ui_gauge_pool_index(const ui_gauge_card_t *card);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // UI_GAUGE_POOL_H
@@ -0,0 +1,177 @@
+#include "ui_gauge_styles.h"
+#include "esp_log.h"
+
+static const char *TAG = "GAUGE_STYLES";
+
+// Distinct accent colours and value fonts in use; the screens need 7 and 2
+#define MAX_ACCENTS 12
+#define MAX_FONTS 4
+
+// Style keyed by a colour or font, initialised on first use
+typedef struct {
+  uintptr_t key;
+  lv_style_t style;
+} keyed_style_t;
+
+static bool initialized = false;
+static lv_style_t style_container;
+static lv_style_t style_title;
+static lv_style_t style_track;
+static lv_style_t style_track_wide;
+static lv_style_t style_indicator;
+static lv_style_t style_indicator_wide;
+static lv_style_t style_value;
+static lv_style_t style_unit;
+static lv_style_t style_bar_track;
+static lv_style_t style_bar_indicator;
+static lv_style_t style_level[UI_GAUGE_LEVEL_COUNT]; // [NORMAL] unused
+
+// Border colour for the container and arc colour for the indicator; each
+// part only draws the property that applies to it
+static keyed_style_t accents[MAX_ACCENTS];
+static int accent_count = 0;
+static keyed_style_t fonts[MAX_FONTS];
+static int font_count = 0;
+
+// One overlay serves arcs (arc colour), labels (text) and bars (background)
+static void init_level(ui_gauge_level_t level, uint32_t color) {
+  lv_style_init(&style_level[level]);
+  lv_style_set_arc_color(&style_level[level], lv_color_hex(color));
+  lv_style_set_text_color(&style_level[level], lv_color_hex(color));
+  lv_style_set_bg_color(&style_level[level], lv_color_hex(color));
+}
+
+static void styles_init(void) {
+  if (initialized)
+    return;
+  initialized = true;
+
+  lv_style_init(&style_container);
+  lv_style_set_bg_color(&style_container, lv_color_hex(0x2a2a2a));
+  lv_style_set_border_width(&style_container, 2);
+  lv_style_set_radius(&style_container, 15);
+  lv_style_set_pad_all(&style_container, 10);
+
+  lv_style_init(&style_title);
+  lv_style_set_text_color(&style_title, lv_color_white());
+
+  lv_style_init(&style_track);
+  lv_style_set_arc_color(&style_track, lv_color_hex(0x4a4a4a));
+  lv_style_set_arc_width(&style_track, 15);
+  lv_style_init(&style_indicator);
+  lv_style_set_arc_width(&style_indicator, 15);
+
+  lv_style_init(&style_track_wide);
+  lv_style_set_arc_color(&style_track_wide, lv_color_hex(0x333333));
+  lv_style_set_arc_width(&style_track_wide, 20);
+  lv_style_init(&style_indicator_wide);
+  lv_style_set_arc_width(&style_indicator_wide, 20);
+
+  lv_style_init(&style_value);
+  lv_style_set_text_color(&style_value, lv_color_white());
+
+  lv_style_init(&style_unit);
+  lv_style_set_text_color(&style_unit, lv_color_hex(0xcccccc));
+
+  lv_style_init(&style_bar_track);
+  lv_style_set_bg_color(&style_bar_track, lv_color_hex(0x333333));
+  lv_style_init(&style_bar_indicator);
+  lv_style_set_bg_color(&style_bar_indicator, lv_color_hex(0xFF0000));
+
+  init_level(UI_GAUGE_LEVEL_WARN, 0xFFD700);
+  init_level(UI_GAUGE_LEVEL_CRIT, 0xFF0000);
+  init_level(UI_GAUGE_LEVEL_STALE, 0x555555);
+}
+
+static lv_style_t *accent_style(uint32_t accent) {
+  for (int i = 0; i < accent_count; i++) {
+    if (accents[i].key == accent)
+      return &accents[i].style;
+  }
+  if (accent_count == MAX_ACCENTS) {
+    ESP_LOGW(TAG, "Accent pool full, 0x%06lX uses 0x%06lX",
+             (unsigned long)accent, (unsigned long)accents[0].key);
+    return &accents[0].style;
+  }
+  keyed_style_t *s = &accents[accent_count++];
+  s->key = accent;
+  lv_style_init(&s->style);
+  lv_style_set_border_color(&s->style, lv_color_hex(accent));
+  lv_style_set_arc_color(&s->style, lv_color_hex(accent));
+  return &s->style;
+}
+
+static lv_style_t *font_style(const lv_font_t *font) {
+  for (int i = 0; i < font_count; i++) {
+    if (fonts[i].key == (uintptr_t)font)
+      return &fonts[i].style;
+  }
+  if (font_count == MAX_FONTS) {
+    ESP_LOGW(TAG, "Font pool full");
+    return NULL;
+  }
+  keyed_style_t *s = &fonts[font_count++];
+  s->key = (uintptr_t)font;
+  lv_style_init(&s->style);
+  lv_style_set_text_font(&s->style, font);
+  return &s->style;
+}
+
+void ui_gauge_style_container(lv_obj_t *cont, uint32_t accent) {
+  styles_init();
+  lv_obj_add_style(cont, &style_container, LV_PART_MAIN);
+  lv_obj_add_style(cont, accent_style(accent), LV_PART_MAIN);
+}
+
+void ui_gauge_style_title(lv_obj_t *label) {
+  styles_init();
+  lv_obj_add_style(label, &style_title, LV_PART_MAIN);
+}
+
+void ui_gauge_style_arc(lv_obj_t *arc, uint32_t accent, bool wide) {
+  styles_init();
+  lv_obj_add_style(arc, wide ? &style_track_wide : &style_track, LV_PART_MAIN);
+  lv_obj_add_style(arc, wide ? &style_indicator_wide : &style_indicator,
+                   LV_PART_INDICATOR);
+  lv_obj_add_style(arc, accent_style(accent), LV_PART_INDICATOR);
+}
+
+void ui_gauge_style_value(lv_obj_t *label, const lv_font_t *font) {
+  styles_init();
+  lv_obj_add_style(label, &style_value, LV_PART_MAIN);
+  lv_style_t *f = font ? font_style(font) : NULL;
+  if (f)
+    lv_obj_add_style(label, f, LV_PART_MAIN);
+}
+
+void ui_gauge_style_unit(lv_obj_t *label) {
+  styles_init();
+  lv_obj_add_style(label, &style_unit, LV_PART_MAIN);
+}
+
+void ui_gauge_style_bar(lv_obj_t *bar) {
+  styles_init();
+  lv_obj_add_style(bar, &style_bar_track, LV_PART_MAIN);
+  lv_obj_add_style(bar, &style_bar_indicator, LV_PART_INDICATOR);
+}
+
+void ui_gauge_set_accent(lv_obj_t *obj, lv_style_selector_t part,
+                         uint32_t from, uint32_t to) {
+  if (from == to)
+    return;
+  styles_init();
+  lv_obj_remove_style(obj, accent_style(from), part);
+  lv_obj_add_style(obj, accent_style(to), part);
+}
+
+void ui_gauge_set_level(lv_obj_t *obj, lv_style_selector_t part,
+                        ui_gauge_level_t from, ui_gauge_level_t to) {
+  if (from == to)
+    return;
+  styles_init();
+  // Overlays are added last, so they take precedence over the base styles
+  if (from != UI_GAUGE_LEVEL_NORMAL)
+    lv_obj_remove_style(obj, &style_level[from], part);
+  if (to != UI_GAUGE_LEVEL_NORMAL)
+    lv_obj_add_style(obj, &style_level[to], part);
+}
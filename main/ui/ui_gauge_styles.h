@@ -0,0 +1,59 @@
+// Shared styles for the gauges on Screens 1, 2, 4, 5 and 8
+
+#ifndef UI_GAUGE_STYLES_H
+#define UI_GAUGE_STYLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// The gauge factories attach these statically allocated styles instead of
+// setting local style properties on every container, arc and label. Each
+// local property costs an allocation per object and lengthens the property
+// lists LVGL walks while rendering; a shared style is stored once.
+//
+// Threshold colours are overlay styles added on top of the arc indicator
+// and the value label, so a level change swaps one style pointer.
+
+typedef enum {
+  UI_GAUGE_LEVEL_NORMAL = 0, // No overlay: accent arc, white value
+  UI_GAUGE_LEVEL_WARN,
+  UI_GAUGE_LEVEL_CRIT,
+  UI_GAUGE_LEVEL_STALE,
+  UI_GAUGE_LEVEL_COUNT
+} ui_gauge_level_t;
+
+// Card: dark background, 2 px border in the accent colour
+void ui_gauge_style_container(lv_obj_t *cont, uint32_t accent);
+void ui_gauge_style_title(lv_obj_t *label);
+
+// Track and indicator. `wide` is the 20 px arc of Screen8, otherwise 15 px.
+void ui_gauge_style_arc(lv_obj_t *arc, uint32_t accent, bool wide);
+
+// White value text; font NULL keeps the theme font
+void ui_gauge_style_value(lv_obj_t *label, const lv_font_t *font);
+void ui_gauge_style_unit(lv_obj_t *label);
+
+// Screen8 boost bar: dark track, red indicator
+void ui_gauge_style_bar(lv_obj_t *bar);
+
+// Recolour a card (LV_PART_MAIN) or arc indicator (LV_PART_INDICATOR)
+// styled with accent `from`. Clear the threshold overlay first: the new
+// accent is added above it.
+void ui_gauge_set_accent(lv_obj_t *obj, lv_style_selector_t part,
+                         uint32_t from, uint32_t to);
+
+// Swap the threshold overlay of an arc or bar indicator (LV_PART_INDICATOR)
+// or a value label (LV_PART_MAIN) from one level to another
+void ui_gauge_set_level(lv_obj_t *obj, lv_style_selector_t part,
+                        ui_gauge_level_t from, ui_gauge_level_t to);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // UI_GAUGE_STYLES_H
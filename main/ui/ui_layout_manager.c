@@ -1,187 +1,281 @@
 #include "ui/ui_layout_manager.h"
 #include "ecu_data.h"
 #include "esp_log.h"
-#include "ui/screens/ui_Screen4.h" // Need access to gauge pointers from other screens if not in ui.h
-#include "ui/screens/ui_Screen5.h"
-#include "ui/settings_config.h"
+#include "esp_timer.h"
+#include "main_gui.h"
+#include "ui/screens/ui_Screen6.h"
 #include "ui/ui.h"
+#include "ui/ui_gauge_pool.h"
+#include "ui/ui_updates.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 static const char *TAG = "UI_LAYOUT";
 
-// Track which screens have at least one gauge
-static bool screen_active_flags[8] = {false};
+// Screens a layout page maps to (screen_id_t)
+static lv_obj_t **const pages[GAUGE_LAYOUT_PAGES] = {&ui_Screen1, &ui_Screen2,
+                                                     &ui_Screen4, &ui_Screen5};
+static const int page_screen[GAUGE_LAYOUT_PAGES] = {0, 1, 3, 4};
 
-void ui_layout_manager_init(void) {
-  ESP_LOGI(TAG, "Layout Manager Initialized");
-  // Ensure all flags false initially
-  for (int i = 0; i < 8; i++)
-    screen_active_flags[i] = false;
-  // Settings always active
-  screen_active_flags[5] = true;
-  ui_update_global_layout();
+// 3x2 grid for 1280x720
+static const lv_coord_t slot_x[] = {60, 480, 900};
+static const lv_coord_t slot_y[] = {40, 380};
+
+static gauge_layout_t layout;
+static bool shown[GAUGE_LAYOUT_MAX];
+static ui_gauge_card_t *card_of[GAUGE_LAYOUT_MAX];
+
+// What is on screen now: the slot each entry's card occupies (-1 = none) and
+// the number of cards per page. A reflow compares the new assignment with
+// this and only touches the cards whose slot differs.
+static int8_t placed_at[GAUGE_LAYOUT_MAX];
+static uint8_t page_fill[GAUGE_LAYOUT_PAGES];
+
+// Stock gauges whose visibility is saved with the system settings
+static const struct {
+  const char *key;
+  size_t offset;
+} persisted[] = {
+    {"map", offsetof(system_settings_t, show_map)},
+    {"wastegate", offsetof(system_settings_t, show_wastegate)},
+    {"tps", offsetof(system_settings_t, show_tps)},
+    {"rpm", offsetof(system_settings_t, show_rpm)},
+    {"boost", offsetof(system_settings_t, show_boost)},
+    {"tcu", offsetof(system_settings_t, show_tcu)},
+    {"oil_press", offsetof(system_settings_t, show_oil_press)},
+    {"oil_temp", offsetof(system_settings_t, show_oil_temp)},
+    {"water_temp", offsetof(system_settings_t, show_water_temp)},
+    {"fuel_press", offsetof(system_settings_t, show_fuel_press)},
+    {"battery", offsetof(system_settings_t, show_battery)},
+    {"pedal", offsetof(system_settings_t, show_pedal)},
+    {"wg_pos", offsetof(system_settings_t, show_wg_pos)},
+    {"bov", offsetof(system_settings_t, show_bov)},
+    {"tcu_req", offsetof(system_settings_t, show_tcu_req)},
+    {"tcu_act", offsetof(system_settings_t, show_tcu_act)},
+    {"eng_req", offsetof(system_settings_t, show_eng_req)},
+    {"eng_act", offsetof(system_settings_t, show_eng_act)},
+    {"limit_tq", offsetof(system_settings_t, show_limit_tq)},
+};
+
+static bool *persisted_flag(const char *key) {
+  system_settings_t *settings = system_settings_get();
+  if (!settings)
+    return NULL;
+  for (size_t i = 0; i < sizeof(persisted) / sizeof(persisted[0]); i++) {
+    if (strcmp(persisted[i].key, key) == 0)
+      return (bool *)((char *)settings + persisted[i].offset);
+  }
+  return NULL;
 }
 
 bool ui_layout_is_screen_active(int screen_index) {
-  if (screen_index < 0 || screen_index >= 8)
-    return false;
-  return screen_active_flags[screen_index];
+  for (int p = 0; p < GAUGE_LAYOUT_PAGES; p++) {
+    if (page_screen[p] == screen_index)
+      return page_fill[p] > 0;
+  }
+  return true; // Not a gauge page
 }
 
-// Helper to hide gauge and its container
-static void hide_gauge(lv_obj_t *obj) {
-  if (!obj)
-    return;
-  lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
-
-  lv_obj_t *parent = lv_obj_get_parent(obj);
-  if (parent) {
-    lv_obj_t *grandparent = lv_obj_get_parent(parent);
-    if (grandparent) {
-      lv_obj_add_flag(parent, LV_OBJ_FLAG_HIDDEN);
+// Slot (page * GAUGE_LAYOUT_SLOTS + slot) of every shown entry, -1 if it is
+// hidden or does not fit. Fixed positions are claimed first; the rest flow
+// into the free slots in table order.
+static void assign_slots(int8_t *slot_of) {
+  bool taken[GAUGE_LAYOUT_MAX] = {false};
+  for (int i = 0; i < layout.count; i++) {
+    int8_t at = layout.entries[i].at;
+    slot_of[i] = -1;
+    if (shown[i] && at >= 0 && !taken[at]) {
+      slot_of[i] = at;
+      taken[at] = true;
     }
   }
+  int next = 0;
+  for (int i = 0; i < layout.count; i++) {
+    if (!shown[i] || slot_of[i] >= 0)
+      continue;
+    while (next < GAUGE_LAYOUT_MAX && taken[next])
+      next++;
+    if (next == GAUGE_LAYOUT_MAX) {
+      ESP_LOGW(TAG, "No slot left for %s", layout.entries[i].key);
+      continue;
+    }
+    slot_of[i] = (int8_t)next;
+    taken[next] = true;
+  }
 }
 
-// Helper to position gauge in a specific slot on a specific screen
-static void place_gauge_on_screen(lv_obj_t *obj, lv_obj_t *target_screen,
-                                  int slot_index) {
-  if (!obj || !target_screen)
+static void drop_card(int i) {
+  if (placed_at[i] >= 0) {
+    page_fill[placed_at[i] / GAUGE_LAYOUT_SLOTS]--;
+    placed_at[i] = -1;
+  }
+  if (!card_of[i])
     return;
+  ui_updates_bind_card(ui_gauge_pool_index(card_of[i]), NULL);
+  ui_gauge_pool_release(card_of[i]);
+  card_of[i] = NULL;
+}
 
-  lv_obj_t *container = lv_obj_get_parent(obj);
-  if (!container)
-    return;
+// Show entry i's card in `slot`, taking a card from the pool if it has none
+static bool place(int i, int8_t slot) {
+  int page = slot / GAUGE_LAYOUT_SLOTS;
+  int cell = slot % GAUGE_LAYOUT_SLOTS;
+  lv_obj_t *parent = *pages[page];
+  if (!parent)
+    return false;
 
-  // 1. Reparent if necessary
-  if (lv_obj_get_parent(container) != target_screen) {
-    lv_obj_set_parent(container, target_screen);
-    lv_obj_move_background(container); // Keep gauges behind navigation buttons
+  if (!card_of[i]) {
+    card_of[i] = ui_gauge_pool_acquire(&layout.entries[i], parent);
+    if (!card_of[i])
+      return false;
+    ui_updates_bind_card(ui_gauge_pool_index(card_of[i]), &layout.entries[i]);
   }
+  ui_gauge_pool_place(card_of[i], parent, slot_x[cell % 3], slot_y[cell / 3]);
+  if (placed_at[i] >= 0)
+    page_fill[placed_at[i] / GAUGE_LAYOUT_SLOTS]--;
+  placed_at[i] = slot;
+  page_fill[page]++;
+  return true;
+}
 
-  // 2. Calculate Position (Same 3x2 grid for all logical screens)
-  // Grid Configuration for 1280x720
-  // Row 1 (y=40): 60, 480, 900
-  // Row 2 (y=380): 60, 480, 900
-
-  int row = slot_index / 3;
-  int col = slot_index % 3;
+void ui_update_global_layout(void) {
+  int64_t t0 = esp_timer_get_time();
+  int8_t slot_of[GAUGE_LAYOUT_MAX];
+  assign_slots(slot_of);
 
-  int x = 60;
-  if (col == 1)
-    x = 480;
-  if (col == 2)
-    x = 900;
+  // Release first, so the entries placed below can take those cards over
+  int moves = 0;
+  for (int i = 0; i < layout.count; i++) {
+    if (slot_of[i] < 0 && card_of[i]) {
+      drop_card(i);
+      moves++;
+    }
+  }
+  for (int i = 0; i < layout.count; i++) {
+    if (slot_of[i] >= 0 && slot_of[i] != placed_at[i] && place(i, slot_of[i]))
+      moves++;
+  }
 
-  int y = 40;
-  if (row == 1)
-    y = 380;
+  if (moves)
+    ui_updates_layout_changed();
+  ESP_LOGI(TAG, "Reflow: %d of %d gauges moved in %lld us", moves,
+           layout.count, (long long)(esp_timer_get_time() - t0));
+}
 
-  // 3. Move Container
-  lv_obj_set_pos(container, x, y);
+// Visibility of next's entries: the saved switch, else what the same key
+// showed before, else the entry's default
+static void resolve_shown(const gauge_layout_t *next, bool *out) {
+  for (int i = 0; i < next->count; i++) {
+    const gauge_layout_entry_t *e = &next->entries[i];
+    bool *flag = persisted_flag(e->key);
+    int old = gauge_layout_find(&layout, e->key);
+    out[i] = flag ? *flag : (old >= 0 ? shown[old] : !e->hidden);
+  }
+}
 
-  // 4. Ensure Visible
-  lv_obj_clear_flag(container, LV_OBJ_FLAG_HIDDEN);
-  lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+// Field by field: the struct has padding that memcmp would compare too
+static bool entry_equal(const gauge_layout_entry_t *a,
+                        const gauge_layout_entry_t *b) {
+  return strcmp(a->key, b->key) == 0 && strcmp(a->title, b->title) == 0 &&
+         strcmp(a->unit, b->unit) == 0 && a->type == b->type &&
+         a->sig == b->sig && a->min == b->min && a->max == b->max &&
+         a->warn == b->warn && a->crit == b->crit && a->invert == b->invert &&
+         a->hidden == b->hidden && a->decimals == b->decimals &&
+         a->smooth_ms == b->smooth_ms && a->color == b->color && a->at == b->at;
 }
 
-// Definition of a Gauge Entry
-typedef struct {
-  lv_obj_t **obj_ptr; // Pointer to the global variable holding the object
-  bool *enabled_ptr;  // Pointer to the settings bool
-} gauge_entry_t;
+// Switch to `next`, keeping the card (and its binding) of every entry that
+// did not change
+static void apply_layout(const gauge_layout_t *next) {
+  ui_gauge_card_t *keep[GAUGE_LAYOUT_MAX] = {NULL};
+  int8_t keep_at[GAUGE_LAYOUT_MAX];
+  bool next_shown[GAUGE_LAYOUT_MAX] = {false};
+  memset(keep_at, -1, sizeof(keep_at)); // Not placed
+  resolve_shown(next, next_shown);
 
-void ui_update_global_layout(void) {
-  system_settings_t *settings = system_settings_get();
-  if (!settings)
+  for (int i = 0; i < next->count; i++) {
+    int old = gauge_layout_find(&layout, next->entries[i].key);
+    if (old >= 0 && card_of[old] &&
+        entry_equal(&layout.entries[old], &next->entries[i])) {
+      keep[i] = card_of[old];
+      keep_at[i] = placed_at[old];
+      card_of[old] = NULL;
+      placed_at[old] = -1; // Still counted in page_fill
+    }
+  }
+  for (int i = 0; i < layout.count; i++)
+    drop_card(i);
+
+  layout = *next;
+  memcpy(card_of, keep, sizeof(card_of));
+  memcpy(placed_at, keep_at, sizeof(placed_at));
+  memcpy(shown, next_shown, sizeof(shown));
+  ui_update_global_layout();
+}
+
+void ui_layout_manager_init(void) {
+  memset(placed_at, -1, sizeof(placed_at));
+  gauge_layout_t *next = malloc(sizeof(*next));
+  if (!next) {
+    ESP_LOGE(TAG, "No memory for the gauge layout");
     return;
+  }
+  gauge_layout_defaults(next);
+  esp_err_t err = gauge_layout_load(GAUGE_LAYOUT_PATH, next);
+  if (err == ESP_ERR_NOT_FOUND) {
+    ESP_LOGI(TAG, "No %s, using the built-in layout", GAUGE_LAYOUT_PATH);
+  } else if (next->count == 0) {
+    ESP_LOGW(TAG, "No valid gauge in %s, using the built-in layout",
+             GAUGE_LAYOUT_PATH);
+    gauge_layout_defaults(next);
+  }
+  apply_layout(next);
+  free(next);
+}
 
-  ESP_LOGI(TAG, "Reflowing global layout (Unified Flow)...");
-
-  // Reset screen activity flags (Screens 1, 2, 4, 5 are dynamic)
-  screen_active_flags[0] = false; // Screen 1
-  screen_active_flags[1] = false; // Screen 2
-  screen_active_flags[2] =
-      false; // Screen 3 (Map - handled differently, but default to closed)
-  screen_active_flags[3] = false; // Screen 4
-  screen_active_flags[4] = false; // Screen 5
-  screen_active_flags[6] = false; // Screen 7 (Game)
-  screen_active_flags[7] = false; // Screen 8
-
-  // Static screens (Settings/Game/Lux) might be handled elsewhere or always
-  // active? User requested "flow", so we assume 1, 2, 4, 5 are the buckets.
-  // Screen 3, 6, 7, 8 are special.
-  screen_active_flags[5] = true; // Settings always active
-  if (settings->screen3_enabled)
-    screen_active_flags[2] = true;
-  screen_active_flags[6] =
-      true; // Game always available? Or driven by logic. Keeping true for now.
-  screen_active_flags[7] = true; // Lux mode always available
-
-  // Priority List of Gauges (The "Sequence")
-  // Order: Screen 1 Defaults -> Screen 2 Defaults -> Screen 4 Defaults ->
-  // Screen 5 Defaults
-  gauge_entry_t gauges[] = {
-      {&ui_Arc_MAP, &settings->show_map},
-      {&ui_Arc_Wastegate, &settings->show_wastegate},
-      {&ui_Arc_TPS, &settings->show_tps},
-      {&ui_Arc_RPM, &settings->show_rpm},
-      {&ui_Arc_Boost, &settings->show_boost},
-      {&ui_LED_TCU,
-       &settings->show_tcu}, // LED container behaves like gauge container
-
-      {&ui_Arc_Oil_Pressure, &settings->show_oil_press},
-      {&ui_Arc_Oil_Temp, &settings->show_oil_temp},
-      {&ui_Arc_Water_Temp, &settings->show_water_temp},
-      {&ui_Arc_Fuel_Pressure, &settings->show_fuel_press},
-      {&ui_Arc_Battery_Voltage, &settings->show_battery},
-
-      {&ui_Arc_Abs_Pedal, &settings->show_pedal},
-      {&ui_Arc_WG_Pos, &settings->show_wg_pos},
-      {&ui_Arc_BOV, &settings->show_bov},
-      {&ui_Arc_TCU_TQ_Req, &settings->show_tcu_req},
-      {&ui_Arc_TCU_TQ_Act, &settings->show_tcu_act},
-      {&ui_Arc_Eng_TQ_Req, &settings->show_eng_req},
-
-      {&ui_Arc_Eng_TQ_Act, &settings->show_eng_act},
-      {&ui_Arc_Limit_TQ, &settings->show_limit_tq},
-  };
-  int total_gauges = sizeof(gauges) / sizeof(gauges[0]);
-
-  // Available Screens for Flow
-  lv_obj_t *screens[] = {ui_Screen1, ui_Screen2, ui_Screen4, ui_Screen5};
-  int screen_indices[] = {0, 1, 3, 4}; // Map to screen_id_t
-  int total_screens = 4;
-  int slots_per_screen = 6;
-
-  int current_screen_idx = 0;
-  int current_slot = 0;
-
-  for (int i = 0; i < total_gauges; i++) {
-    lv_obj_t *obj = *gauges[i].obj_ptr;
-    bool enabled = *gauges[i].enabled_ptr;
-
-    if (enabled) {
-      // Find a spot
-      if (current_screen_idx < total_screens) {
-        lv_obj_t *target_scr = screens[current_screen_idx];
-
-        place_gauge_on_screen(obj, target_scr, current_slot);
-
-        // Mark this screen as having content
-        screen_active_flags[screen_indices[current_screen_idx]] = true;
-
-        // Advance cursor
-        current_slot++;
-        if (current_slot >= slots_per_screen) {
-          current_slot = 0;
-          current_screen_idx++;
-        }
-      } else {
-        // No more space on any screen? Hide it (or could dump on last screen)
-        hide_gauge(obj);
-      }
-    } else {
-      hide_gauge(obj);
-    }
+esp_err_t ui_layout_reload(void) {
+  // Parse outside the lock: the SD card is slow
+  gauge_layout_t *next = malloc(sizeof(*next));
+  if (!next)
+    return ESP_ERR_NO_MEM;
+  esp_err_t err = gauge_layout_load(GAUGE_LAYOUT_PATH, next);
+  if (err == ESP_ERR_NOT_FOUND) {
+    gauge_layout_defaults(next);
+    err = ESP_OK;
+  } else if (next->count == 0) {
+    ESP_LOGW(TAG, "No valid gauge in %s, layout kept", GAUGE_LAYOUT_PATH);
+    free(next);
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (!example_lvgl_lock(1000)) {
+    free(next);
+    return ESP_ERR_TIMEOUT;
   }
+  apply_layout(next);
+  ui_Screen6_layout_changed();
+  example_lvgl_unlock();
+  free(next);
+  return err;
+}
+
+int ui_layout_count(void) { return layout.count; }
+
+const gauge_layout_entry_t *ui_layout_entry(int index) {
+  return (index >= 0 && index < layout.count) ? &layout.entries[index] : NULL;
+}
+
+bool ui_layout_is_shown(int index) {
+  return index >= 0 && index < layout.count && shown[index];
+}
+
+void ui_layout_set_shown(int index, bool on) {
+  if (index < 0 || index >= layout.count || shown[index] == on)
+    return;
+  shown[index] = on;
+  bool *flag = persisted_flag(layout.entries[index].key);
+  if (flag)
+    *flag = on;
+  ui_update_global_layout();
 }
@@ -5,13 +5,41 @@
 extern "C" {
 #endif
 
+#include "esp_err.h"
+#include "gauge_layout.h"
 #include "lvgl.h"
 #include <stdbool.h>
 
+// The gauge pages (Screens 1, 2, 4 and 5) show the entries of the current
+// gauge layout (gauge_layout.h), each on a pooled card (ui_gauge_pool.h).
+// Shown entries fill a 3x2 grid per page in table order; pages left empty
+// are skipped by the screen manager.
+
+// Load the layout (GAUGE_LAYOUT_PATH, else the built-in one) and place it.
+// Call with the LVGL lock held, after the gauge pages are built.
 void ui_layout_manager_init(void);
+
+// Re-read GAUGE_LAYOUT_PATH and apply it. Takes the LVGL lock, so call it
+// from any task except the LVGL one. Gauges whose entry is unchanged keep
+// their card; a file without a single valid gauge is not applied.
+esp_err_t ui_layout_reload(void);
+
+// Bring the pages in line with the shown entries. Only cards whose slot
+// changed are touched: hiding a gauge shifts the ones after it by a slot,
+// and the pages before it are left alone.
 void ui_update_global_layout(void);
+
 bool ui_layout_is_screen_active(int screen_index);
 
+// Current layout entries, for the Settings gauge list
+int ui_layout_count(void);
+const gauge_layout_entry_t *ui_layout_entry(int index);
+
+// Visibility of an entry. The stock gauges keep it in the system settings
+// (show_*), which override their "hidden" option; others start from it.
+bool ui_layout_is_shown(int index);
+void ui_layout_set_shown(int index, bool shown);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -0,0 +1,137 @@
+#include "ui_perf_hud.h"
+#include "lvgl.h"
+#include "perf_monitor.h"
+#include <stdio.h>
+
+// Overlay refresh; the frame figures are averaged over the frames since
+// the previous refresh
+#define HUD_REFRESH_MS 500
+#define HUD_TASK_ROWS 5
+#define HUD_WIDTH 460
+
+static lv_obj_t *hud_panel = NULL;
+static lv_obj_t *hud_label = NULL;
+static lv_timer_t *hud_timer = NULL;
+static uint32_t last_frame_ms = 0;
+
+static uint32_t count_objects(lv_obj_t *obj) {
+    uint32_t n = 1;
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++) {
+        n += count_objects(lv_obj_get_child(obj, i));
+    }
+    return n;
+}
+
+static void hud_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    uint32_t objs = count_objects(lv_scr_act()) + count_objects(lv_layer_top());
+    perf_monitor_set_obj_count(objs > UINT16_MAX ? UINT16_MAX : (uint16_t)objs);
+
+    // Frames since the last refresh: averages and worst case
+    static perf_frame_t frames[PERF_HISTORY_FRAMES];
+    int n = perf_monitor_get_history(frames, PERF_HISTORY_FRAMES);
+    uint32_t count = 0, area = 0;
+    uint64_t render = 0, flush = 0, handler = 0;
+    uint32_t render_max = 0;
+    uint32_t latency_n = 0, latency_max = 0;
+    uint64_t latency = 0;
+    for (int i = 0; i < n; i++) {
+        const perf_frame_t *f = &frames[i];
+        if ((int32_t)(f->t_ms - last_frame_ms) <= 0) {
+            continue;
+        }
+        count++;
+        render += f->render_us;
+        flush += f->flush_us;
+        handler += f->handler_us;
+        area += f->area_px;
+        if (f->render_us > render_max) {
+            render_max = f->render_us;
+        }
+        if (f->latency_us) {
+            latency_n++;
+            latency += f->latency_us;
+            if (f->latency_us > latency_max) {
+                latency_max = f->latency_us;
+            }
+        }
+    }
+    if (n > 0) {
+        last_frame_ms = frames[n - 1].t_ms;
+    }
+    uint32_t div = count ? count : 1;
+
+    perf_system_t sys;
+    perf_monitor_sample_system(&sys);
+
+    char text[640];
+    int len = snprintf(text, sizeof(text),
+        "FPS %.1f   render %.1f ms (max %.1f)   flush %.1f ms\n"
+        "handler %.1f ms   area %lu px/frame   objects %lu\n"
+        "CAN %.0f f/s   queues: rx %u  log %u  bg %u\n"
+        "CAN->shift light %.1f ms (max %.1f)\n"
+        "RAM %lu k (min %lu k)   PSRAM %lu k",
+        sys.fps, render / div / 1000.0, render_max / 1000.0,
+        flush / div / 1000.0, handler / div / 1000.0,
+        (unsigned long)(area / div), (unsigned long)objs, sys.can_fps,
+        sys.can_rx_pending, sys.log_pending, sys.bg_pending,
+        latency_n ? latency / latency_n / 1000.0 : 0.0, latency_max / 1000.0,
+        (unsigned long)(sys.internal_free / 1024),
+        (unsigned long)(sys.internal_min / 1024),
+        (unsigned long)(sys.psram_free / 1024));
+    for (int i = 0; i < sys.task_count && i < HUD_TASK_ROWS; i++) {
+        const perf_task_t *t = &sys.tasks[i];
+        if (len < 0 || len >= (int)sizeof(text)) {
+            break;
+        }
+        len += snprintf(text + len, sizeof(text) - len, "%s%-12s %3u%% %s",
+                        (i % 2) ? "   " : "\n", t->name, t->cpu_pct,
+                        t->core == 0 ? "c0" : t->core == 1 ? "c1" : "--");
+    }
+    lv_label_set_text(hud_label, text);
+}
+
+static void hud_create(void) {
+    hud_panel = lv_obj_create(lv_layer_top());
+    lv_obj_set_width(hud_panel, HUD_WIDTH);
+    lv_obj_set_height(hud_panel, LV_SIZE_CONTENT);
+    lv_obj_align(hud_panel, LV_ALIGN_TOP_LEFT, 8, 8);
+    lv_obj_set_style_bg_color(hud_panel, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_opa(hud_panel, LV_OPA_70, 0);
+    lv_obj_set_style_border_color(hud_panel, lv_color_hex(0x00D4FF), 0);
+    lv_obj_set_style_border_width(hud_panel, 1, 0);
+    lv_obj_set_style_radius(hud_panel, 6, 0);
+    lv_obj_set_style_pad_all(hud_panel, 6, 0);
+    // Touches pass through to the screen underneath
+    lv_obj_clear_flag(hud_panel, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+    hud_label = lv_label_create(hud_panel);
+    lv_obj_set_width(hud_label, LV_PCT(100));
+    lv_obj_set_style_text_color(hud_label, lv_color_hex(0x00FF88), 0);
+    lv_obj_set_style_text_font(hud_label, &lv_font_montserrat_12, 0);
+    lv_label_set_text(hud_label, "Profiling...");
+}
+
+void ui_perf_hud_set_visible(bool visible) {
+    if (visible == ui_perf_hud_is_visible()) {
+        return;
+    }
+
+    if (visible) {
+        perf_monitor_set_enabled(true);
+        last_frame_ms = 0;
+        if (!hud_panel) {
+            hud_create();
+        }
+        lv_obj_clear_flag(hud_panel, LV_OBJ_FLAG_HIDDEN);
+        hud_timer = lv_timer_create(hud_timer_cb, HUD_REFRESH_MS, NULL);
+    } else {
+        lv_timer_del(hud_timer);
+        hud_timer = NULL;
+        lv_obj_add_flag(hud_panel, LV_OBJ_FLAG_HIDDEN);
+        perf_monitor_set_enabled(false);
+    }
+}
+
+bool ui_perf_hud_is_visible(void) { return hud_timer != NULL; }
@@ -0,0 +1,20 @@
+#ifndef UI_PERF_HUD_H
+#define UI_PERF_HUD_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Performance overlay on the top layer: frame render/flush profile, CAN
+// rate, queue depths, per-task CPU and heap. Profiling (perf_monitor) runs
+// only while the overlay is shown. Call with the LVGL lock held.
+void ui_perf_hud_set_visible(bool visible);
+bool ui_perf_hud_is_visible(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_PERF_HUD_H
@@ -1,15 +1,21 @@
 // UI Screen Manager - Handles switching between screens
 #include "ui_screen_manager.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "lvgl.h"
+#include "screens/ui_Screen1.h"
+#include "screens/ui_Screen2.h"
 #include "screens/ui_Screen3.h"
 #include "screens/ui_Screen4.h"
 #include "screens/ui_Screen5.h"
 #include "screens/ui_Screen6.h"
 #include "screens/ui_Screen7.h"
 #include "screens/ui_Screen8.h"
+#include "screens/ui_Screen9.h"
+#include "screens/ui_Screen10.h"
 #include "settings_config.h"
 #include "ui.h"
 #include "ui_layout_manager.h"
@@ -30,6 +36,45 @@ static lv_point_t last_touch_point = {0, 0};
 // Current screen tracking
 static screen_id_t current_screen = SCREEN_1;
 
+#ifndef CONFIG_UI_SCREEN_IDLE_TEARDOWN_S
+#define CONFIG_UI_SCREEN_IDLE_TEARDOWN_S 60
+#endif
+#ifndef CONFIG_UI_SCREEN_PINNED_MASK
+#define CONFIG_UI_SCREEN_PINNED_MASK 0x1B
+#endif
+
+// Screens 1, 2, 4 and 5 share their gauges through the layout manager,
+// which moves gauge containers between them, so they live and die together
+#define GAUGE_SCREENS_MASK                                                     \
+  ((1u << SCREEN_1) | (1u << SCREEN_2) | (1u << SCREEN_4) | (1u << SCREEN_5))
+#define IDLE_CHECK_PERIOD_MS 1000
+
+// Screen lifecycle table, indexed by screen_id_t
+static struct {
+  lv_obj_t **obj;
+  void (*init)(void);
+  void (*destroy)(void);
+  bool pinned;
+  bool shown;          // On screen at the last idle check
+  uint32_t hidden_ms;  // lv_tick when it left the screen
+  size_t resident;     // Heap taken by the last build
+} screens[SCREEN_COUNT] = {
+    [SCREEN_1] = {&ui_Screen1, ui_Screen1_screen_init, ui_Screen1_screen_destroy},
+    [SCREEN_2] = {&ui_Screen2, ui_Screen2_screen_init, ui_Screen2_screen_destroy},
+    [SCREEN_3] = {&ui_Screen3, ui_Screen3_screen_init, ui_Screen3_screen_destroy},
+    [SCREEN_4] = {&ui_Screen4, ui_Screen4_screen_init, ui_Screen4_screen_destroy},
+    [SCREEN_5] = {&ui_Screen5, ui_Screen5_screen_init, ui_Screen5_screen_destroy},
+    [SCREEN_6] = {&ui_Screen6, ui_Screen6_screen_init, ui_Screen6_screen_destroy},
+    [SCREEN_7] = {&ui_Screen7, ui_Screen7_screen_init, ui_Screen7_screen_destroy},
+    [SCREEN_8] = {&ui_Screen8, ui_Screen8_screen_init, ui_Screen8_screen_destroy},
+    [SCREEN_9] = {&ui_Screen9, ui_Screen9_screen_init, ui_Screen9_screen_destroy},
+    [SCREEN_10] = {&ui_Screen10, ui_Screen10_screen_init,
+                   ui_Screen10_screen_destroy},
+};
+static uint32_t idle_timeout_ms = CONFIG_UI_SCREEN_IDLE_TEARDOWN_S * 1000u;
+static lv_timer_t *idle_timer = NULL;
+static bool pins_loaded = false;
+
 // Touch screen functions
 void touch_screen_init(void) {
   ESP_LOGI("TOUCH_SCREEN", "touch_screen_init called");
@@ -170,6 +215,109 @@ void ui_screen_swipe_event_cb(lv_event_t *e) {
   }
 }
 
+// --- Screen lifecycle ---
+
+static void load_pins(void) {
+  if (pins_loaded)
+    return;
+  pins_loaded = true;
+  uint32_t mask = CONFIG_UI_SCREEN_PINNED_MASK | GAUGE_SCREENS_MASK;
+  for (int i = 0; i < SCREEN_COUNT; i++)
+    screens[i].pinned = (mask >> i) & 1u;
+}
+
+static size_t heap_free(void) {
+  return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+static void build_screen(screen_id_t id) {
+  size_t free_before = heap_free();
+  int64_t t0 = esp_timer_get_time();
+  screens[id].init();
+  uint32_t build_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+  size_t free_after = heap_free();
+  screens[id].resident = free_before > free_after ? free_before - free_after : 0;
+  screens[id].shown = false;
+  screens[id].hidden_ms = lv_tick_get();
+  ESP_LOGI("SCREEN_MANAGER", "Built screen %d in %lu ms, %u KB resident",
+           id + 1, (unsigned long)build_ms,
+           (unsigned)(screens[id].resident / 1024));
+}
+
+static void teardown_screen(screen_id_t id) {
+  size_t free_before = heap_free();
+  screens[id].destroy();
+  *screens[id].obj = NULL; // Not every destroy clears it
+  size_t free_after = heap_free();
+  ESP_LOGI("SCREEN_MANAGER", "Tore down idle screen %d, %u KB freed", id + 1,
+           (unsigned)((free_after > free_before ? free_after - free_before
+                                                 : 0) /
+                      1024));
+}
+
+void ui_screens_create_pinned(void) {
+  load_pins();
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    if (screens[i].pinned && !*screens[i].obj)
+      build_screen((screen_id_t)i);
+  }
+}
+
+lv_obj_t *ui_screen_get(screen_id_t screen_id) {
+  if ((unsigned)screen_id >= SCREEN_COUNT)
+    return NULL;
+  load_pins();
+  if (!*screens[screen_id].obj)
+    build_screen(screen_id);
+  return *screens[screen_id].obj;
+}
+
+bool ui_screen_is_created(screen_id_t screen_id) {
+  return (unsigned)screen_id < SCREEN_COUNT && *screens[screen_id].obj;
+}
+
+void ui_screen_set_pinned(screen_id_t screen_id, bool pinned) {
+  if ((unsigned)screen_id >= SCREEN_COUNT)
+    return;
+  load_pins();
+  screens[screen_id].pinned = pinned || ((GAUGE_SCREENS_MASK >> screen_id) & 1u);
+}
+
+void ui_screen_set_idle_timeout(uint32_t seconds) {
+  idle_timeout_ms = seconds * 1000u;
+}
+
+size_t ui_screen_get_resident_bytes(screen_id_t screen_id) {
+  return (unsigned)screen_id < SCREEN_COUNT ? screens[screen_id].resident : 0;
+}
+
+// Delete unpinned screens that have been off screen for the idle timeout.
+// A screen being animated in or out counts as shown.
+static void idle_teardown_cb(lv_timer_t *timer) {
+  lv_disp_t *disp = lv_disp_get_default();
+  if (!disp)
+    return;
+  uint32_t now = lv_tick_get();
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    lv_obj_t *scr = *screens[i].obj;
+    if (!scr)
+      continue;
+    if (scr == disp->act_scr || scr == disp->scr_to_load ||
+        scr == disp->prev_scr) {
+      screens[i].shown = true;
+      continue;
+    }
+    if (screens[i].shown) {
+      screens[i].shown = false;
+      screens[i].hidden_ms = now;
+    }
+    if (screens[i].pinned || idle_timeout_ms == 0)
+      continue;
+    if (now - screens[i].hidden_ms >= idle_timeout_ms)
+      teardown_screen((screen_id_t)i);
+  }
+}
+
 // Initialize screen manager
 void ui_screen_manager_init(void) {
   ESP_LOGI("SCREEN_MANAGER", "Initializing UI screen manager...");
@@ -180,6 +328,9 @@ void ui_screen_manager_init(void) {
   // Set initial screen
   current_screen = SCREEN_1;
 
+  if (!idle_timer)
+    idle_timer = lv_timer_create(idle_teardown_cb, IDLE_CHECK_PERIOD_MS, NULL);
+
   ESP_LOGI("SCREEN_MANAGER", "UI screen manager initialized successfully");
 }
 
@@ -207,6 +358,12 @@ static bool ui_is_screen_enabled(screen_id_t screen_id) {
   case SCREEN_8:
     // Lux Dashboard
     return true;
+  case SCREEN_9:
+    // Session summary
+    return true;
+  case SCREEN_10:
+    // Strip chart
+    return true;
   default:
     // Screens 1, 2, 4, 5 are managed by layout manager (empty check)
     // Need to map screen_id enum to layout manager index (which matches enum
@@ -218,8 +375,9 @@ static bool ui_is_screen_enabled(screen_id_t screen_id) {
 // Get next enabled screen in specified direction
 screen_id_t ui_get_next_enabled_screen(screen_id_t current_screen,
                                        bool forward) {
-  screen_id_t screens[] = {SCREEN_1, SCREEN_2, SCREEN_3, SCREEN_4,
-                           SCREEN_5, SCREEN_6, SCREEN_7, SCREEN_8};
+  screen_id_t screens[] = {SCREEN_1, SCREEN_2, SCREEN_3, SCREEN_4, SCREEN_5,
+                           SCREEN_6, SCREEN_7, SCREEN_8, SCREEN_9,
+                           SCREEN_10};
   int num_screens = sizeof(screens) / sizeof(screens[0]);
   int current_index = -1;
 
@@ -305,15 +463,15 @@ void ui_switch_to_screen(screen_id_t screen_id) {
   bool forward = false;
 
   if (screen_id > current_screen) {
-    // Normal increase (1->2), but watch for wrap backward (8->1 is not this,
-    // 1->8 is)
-    if (current_screen == SCREEN_1 && screen_id == SCREEN_8)
+    // Normal increase (1->2), but watch for wrap backward (10->1 is not
+    // this, 1->10 is)
+    if (current_screen == SCREEN_1 && screen_id == SCREEN_10)
       forward = false; // Wrap back
     else
       forward = true;
   } else {
-    // Normal decrease (2->1), but watch for wrap forward (8->1)
-    if (current_screen == SCREEN_8 && screen_id == SCREEN_1)
+    // Normal decrease (2->1), but watch for wrap forward (10->1)
+    if (current_screen == SCREEN_10 && screen_id == SCREEN_1)
       forward = true; // Wrap forward
     else
       forward = false;
@@ -342,72 +500,27 @@ void ui_switch_to_screen(screen_id_t screen_id) {
     }
   }
 
-  switch (screen_id) {
-  case SCREEN_1:
-    lv_scr_load_anim(ui_Screen1, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_1;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_1");
-    break;
-
-  case SCREEN_2:
-    lv_scr_load_anim(ui_Screen2, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_2;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_2");
-    break;
-
-  case SCREEN_3:
-    if (!ui_can_switch_to_screen3()) {
-      ESP_LOGW("SCREEN_MANAGER",
-               "Cannot switch to SCREEN_3: Screen3 is disabled in settings");
-      // Try to find next enabled screen
-      screen_id_t next_enabled =
-          ui_get_next_enabled_screen(current_screen, true);
-      if (next_enabled != SCREEN_3 && ui_is_screen_enabled(next_enabled)) {
-        ESP_LOGI("SCREEN_MANAGER", "Redirecting from disabled SCREEN_3 to: %d",
-                 next_enabled);
-        ui_switch_to_screen(next_enabled);
-      }
-      return;
+  if (screen_id == SCREEN_3 && !ui_can_switch_to_screen3()) {
+    ESP_LOGW("SCREEN_MANAGER",
+             "Cannot switch to SCREEN_3: Screen3 is disabled in settings");
+    // Try to find next enabled screen
+    screen_id_t next_enabled = ui_get_next_enabled_screen(current_screen, true);
+    if (next_enabled != SCREEN_3 && ui_is_screen_enabled(next_enabled)) {
+      ESP_LOGI("SCREEN_MANAGER", "Redirecting from disabled SCREEN_3 to: %d",
+               next_enabled);
+      ui_switch_to_screen(next_enabled);
     }
-    lv_scr_load_anim(ui_Screen3, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_3;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_3");
-    break;
-
-  case SCREEN_4:
-    lv_scr_load_anim(ui_Screen4, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_4;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_4");
-    break;
-
-  case SCREEN_5:
-    lv_scr_load_anim(ui_Screen5, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_5;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_5");
-    break;
-
-  case SCREEN_6:
-    lv_scr_load_anim(ui_Screen6, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_6;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_6");
-    break;
-
-  case SCREEN_7:
-    lv_scr_load_anim(ui_Screen7, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_7;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_7");
-    break;
-
-  case SCREEN_8:
-    lv_scr_load_anim(ui_Screen8, anim_type, anim_time, 0, false);
-    current_screen = SCREEN_8;
-    ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_8");
-    break;
+    return;
+  }
 
-  default:
+  lv_obj_t *target = ui_screen_get(screen_id);
+  if (!target) {
     ESP_LOGW("SCREEN_MANAGER", "Unknown screen ID: %d", screen_id);
-    break;
+    return;
   }
+  lv_scr_load_anim(target, anim_type, anim_time, 0, false);
+  current_screen = screen_id;
+  ESP_LOGI("SCREEN_MANAGER", "Switched to SCREEN_%d", screen_id + 1);
 }
 
 // Get current screen
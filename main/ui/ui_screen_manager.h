@@ -19,7 +19,9 @@ typedef enum {
     SCREEN_5 = 4,      // ECU Data Page 2
     SCREEN_6 = 5,      // Device Parameters Settings
     SCREEN_7 = 6,      // New Screen 7
-    SCREEN_8 = 7       // Luxury Sport Dashboard (New)
+    SCREEN_8 = 7,      // Luxury Sport Dashboard (New)
+    SCREEN_9 = 8,      // Session Summary (peak-hold / statistics)
+    SCREEN_10 = 9      // Strip Chart (signal history)
 } screen_id_t;
 
 // Screen management functions
@@ -31,6 +33,18 @@ screen_id_t ui_get_next_enabled_screen(screen_id_t current_screen, bool forward)
 screen_id_t ui_get_prev_enabled_screen(screen_id_t current_screen, bool forward);
 void ui_switch_to_next_enabled_screen(bool forward);
 
+// Screen lifecycle: pinned screens are built by ui_screens_create_pinned()
+// and stay resident; the rest are built on first visit and deleted after
+// the idle timeout off screen. The gauge pages are always pinned.
+#define SCREEN_COUNT 10
+void ui_screens_create_pinned(void);
+lv_obj_t *ui_screen_get(screen_id_t screen_id); // Builds it if needed
+bool ui_screen_is_created(screen_id_t screen_id);
+void ui_screen_set_pinned(screen_id_t screen_id, bool pinned);
+void ui_screen_set_idle_timeout(uint32_t seconds); // 0 = never tear down
+// Heap taken by the screen when it was last built (0 if never built)
+size_t ui_screen_get_resident_bytes(screen_id_t screen_id);
+
 // Touch screen functions
 void touch_screen_init(void);
 void touch_screen_enable(void);
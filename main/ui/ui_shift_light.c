@@ -0,0 +1,142 @@
+#include "ui_shift_light.h"
+#include "can_parser.h"
+#include "ecu_data.h"
+#include "esp_timer.h"
+#include "perf_monitor.h"
+#include "shift_points.h"
+#include "signal_freshness.h"
+
+#define LED_W 30
+#define LED_H 14
+#define LED_GAP 6
+#define LED_RADIUS 3
+#define FLASH_HALF_PERIOD_MS 60
+
+// lit == LIT_FLASHING: at or past the shift point
+#define LIT_FLASHING (SHIFT_LIGHT_LEDS + 1)
+
+#define LED_OFF_COLOR 0x262626
+#define LED_FLASH_COLOR 0x2E7DFF
+
+// Green, then amber, then red towards the shift point
+static const uint32_t led_colors[SHIFT_LIGHT_LEDS] = {
+    0x00C853, 0x00C853, 0x00C853, 0x00C853, 0x00C853, 0xFFB300,
+    0xFFB300, 0xFFB300, 0xFFB300, 0xFF1744, 0xFF1744, 0xFF1744,
+};
+
+static struct {
+  lv_obj_t *obj;
+  lv_timer_t *timer;
+  uint8_t lit;
+  bool flash_on;
+  int64_t shown_us; // changed_us of the snapshot shown
+} light;
+
+static void led_area(int i, lv_area_t *a) {
+  lv_obj_get_coords(light.obj, a);
+  a->x1 += i * (LED_W + LED_GAP);
+  a->x2 = a->x1 + LED_W - 1;
+  a->y2 = a->y1 + LED_H - 1;
+}
+
+static uint32_t led_color(int i) {
+  if (light.lit == LIT_FLASHING)
+    return light.flash_on ? LED_FLASH_COLOR : LED_OFF_COLOR;
+  return i < light.lit ? led_colors[i] : LED_OFF_COLOR;
+}
+
+// One object draws every LED: a change costs an invalidated rectangle,
+// not a style refresh per LED object
+static void draw_cb(lv_event_t *e) {
+  lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.radius = LED_RADIUS;
+
+  for (int i = 0; i < SHIFT_LIGHT_LEDS; i++) {
+    lv_area_t a;
+    led_area(i, &a);
+    if (!_lv_area_is_on(&a, draw_ctx->clip_area))
+      continue;
+    dsc.bg_color = lv_color_hex(led_color(i));
+    lv_draw_rect(draw_ctx, &dsc, &a);
+  }
+}
+
+// LEDs [from, to) changed colour
+static void invalidate_leds(int from, int to) {
+  if (from >= to)
+    return;
+  lv_area_t a, last;
+  led_area(from, &a);
+  led_area(to - 1, &last);
+  a.x2 = last.x2;
+  lv_obj_invalidate_area(light.obj, &a);
+}
+
+static uint8_t leds_for(float rpm, shift_point_t sp) {
+  if (rpm < sp.start_rpm)
+    return 0;
+  if (rpm >= sp.shift_rpm)
+    return LIT_FLASHING;
+  // First LED at start_rpm, all of them lit for the last 1/12 of the range
+  uint32_t lit = 1 + (uint32_t)(rpm - sp.start_rpm) * SHIFT_LIGHT_LEDS /
+                         (uint32_t)(sp.shift_rpm - sp.start_rpm);
+  return (uint8_t)LV_MIN(lit, SHIFT_LIGHT_LEDS);
+}
+
+static void shift_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  if (lv_obj_get_screen(light.obj) != lv_scr_act())
+    return;
+
+  ecu_fast_data_t d;
+  if (!ecu_data_get_fast(&d))
+    return;
+
+  uint8_t lit = 0;
+  if (!signal_freshness_is_stale(ECU_SIG_RPM))
+    lit = leds_for(d.rpm, shift_points_get(can_parser_get_platform(), d.gear));
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  bool flash_on =
+      lit == LIT_FLASHING && ((now_ms / FLASH_HALF_PERIOD_MS) & 1u) == 0;
+
+  if (lit != light.lit || flash_on != light.flash_on) {
+    if (lit == LIT_FLASHING || light.lit == LIT_FLASHING)
+      invalidate_leds(0, SHIFT_LIGHT_LEDS);
+    else
+      invalidate_leds(LV_MIN(lit, light.lit), LV_MAX(lit, light.lit));
+    // Flash phase changes are not data; only time new data
+    if (lit != light.lit && d.changed_us != light.shown_us)
+      perf_monitor_latency_mark(d.changed_us);
+    light.lit = lit;
+    light.flash_on = flash_on;
+  }
+  light.shown_us = d.changed_us;
+}
+
+static void delete_cb(lv_event_t *e) {
+  (void)e;
+  lv_timer_del(light.timer);
+  light.timer = NULL;
+  light.obj = NULL;
+}
+
+lv_obj_t *ui_shift_light_create(lv_obj_t *parent) {
+  if (light.obj)
+    lv_obj_del(light.obj);
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, SHIFT_LIGHT_LEDS * (LED_W + LED_GAP) - LED_GAP, LED_H);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_add_event_cb(obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, delete_cb, LV_EVENT_DELETE, NULL);
+
+  light.obj = obj;
+  light.lit = 0;
+  light.flash_on = false;
+  light.shown_us = 0;
+  light.timer = lv_timer_create(shift_timer_cb, SHIFT_LIGHT_PERIOD_MS, NULL);
+  return obj;
+}
@@ -0,0 +1,31 @@
+// Shift light: LED bar filled by RPM, flashing at the shift point
+
+#ifndef UI_SHIFT_LIGHT_H
+#define UI_SHIFT_LIGHT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+// The LEDs fill between the start and shift RPM of the current platform and
+// gear (shift_points.h) and all flash from the shift RPM on.
+//
+// The bar bypasses the gauge refresh: its own LVGL timer, created after the
+// display's refresh timer so it runs ahead of it in every handler pass,
+// reads only RPM and gear from the lock-free snapshot (ecu_data_get_fast)
+// and invalidates just the LEDs that changed. With profiling on, the
+// CAN-to-panel latency of each change is reported through perf_monitor.
+
+#define SHIFT_LIGHT_PERIOD_MS 10 // 100 Hz
+#define SHIFT_LIGHT_LEDS 12
+
+// One bar at a time; it stops when deleted with its screen
+lv_obj_t *ui_shift_light_create(lv_obj_t *parent);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // UI_SHIFT_LIGHT_H
@@ -0,0 +1,259 @@
+#include "ui_strip_chart.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "signal_freshness.h"
+#include "signal_history.h"
+
+static const char *TAG = "STRIP_CHART";
+
+#define BG_COLOR 0x0A0A0A
+#define GRID_COLOR 0x2A2A2A
+#define GRID_ROWS 4          // Horizontal divisions
+#define GRID_TIME_MS 5000    // One vertical grid line per interval
+#define LINE_PX 2            // Trace thickness
+
+typedef struct {
+  ecu_signal_id_t sig; // ECU_SIG_COUNT = slot off
+  float min;
+  float scale; // Pixels per unit
+  lv_color_t color;
+  uint32_t cursor;  // signal_history position
+  uint32_t hold_ms; // Last value is drawn across empty columns this long
+  float last;
+  uint32_t last_ms;
+  bool has_last;
+  lv_coord_t prev_y; // Last value of the previous column, -1 = gap
+} chart_series_t;
+
+static struct {
+  lv_obj_t *obj;
+  lv_timer_t *timer;
+  lv_color_t *buf; // Ring column x of row y at buf[y * w + x]
+  lv_img_dsc_t img;
+  lv_coord_t w;
+  lv_coord_t h;
+  lv_coord_t head;  // Newest column, drawn at the right edge
+  uint32_t window_ms;
+  uint32_t t_start; // Start time of column 0
+  uint32_t cols;    // Columns drawn since t_start
+  chart_series_t series[UI_STRIP_CHART_MAX_SERIES];
+} chart;
+
+static inline uint32_t now_ms(void) {
+  return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// Start time of column n
+static inline uint32_t col_time(uint32_t n) {
+  return chart.t_start + (uint32_t)((uint64_t)n * chart.window_ms / chart.w);
+}
+
+static lv_coord_t value_y(const chart_series_t *s, float v) {
+  float y = (float)(chart.h - LINE_PX) - (v - s->min) * s->scale;
+  if (y <= 0.0f)
+    return 0;
+  if (y >= (float)(chart.h - LINE_PX))
+    return chart.h - LINE_PX;
+  return (lv_coord_t)y;
+}
+
+// Render ring column x from the samples in [t0, t1)
+static void draw_column(lv_coord_t x, uint32_t t0, uint32_t t1) {
+  lv_color_t *col = chart.buf + x;
+  lv_coord_t w = chart.w;
+  lv_color_t grid = lv_color_hex(GRID_COLOR);
+  lv_color_t bg = t0 / GRID_TIME_MS != t1 / GRID_TIME_MS
+                      ? grid
+                      : lv_color_hex(BG_COLOR);
+
+  for (lv_coord_t y = 0; y < chart.h; y++)
+    col[y * w] = bg;
+  for (int g = 1; g < GRID_ROWS; g++)
+    col[(chart.h * g / GRID_ROWS) * w] = grid;
+
+  for (int i = 0; i < UI_STRIP_CHART_MAX_SERIES; i++) {
+    chart_series_t *s = &chart.series[i];
+    if (s->sig == ECU_SIG_COUNT)
+      continue;
+
+    signal_history_span_t span;
+    lv_coord_t top, bottom;
+    if (signal_history_reduce(s->sig, &s->cursor, t1, &span)) {
+      top = value_y(s, span.max);
+      bottom = value_y(s, span.min);
+      s->last = span.last;
+      s->last_ms = span.last_ms;
+      s->has_last = true;
+    } else if (s->has_last && t1 - s->last_ms <= s->hold_ms) {
+      // Slower than the column rate: hold until the signal goes stale
+      top = bottom = value_y(s, s->last);
+    } else {
+      s->prev_y = -1;
+      continue;
+    }
+    // Join the previous column so steps stay connected
+    if (s->prev_y >= 0) {
+      top = LV_MIN(top, s->prev_y);
+      bottom = LV_MAX(bottom, s->prev_y);
+    }
+    s->prev_y = value_y(s, s->last);
+
+    for (lv_coord_t y = top; y < bottom + LINE_PX; y++)
+      col[y * w] = s->color;
+  }
+}
+
+// Clear the plot and redraw the whole window from history over the next
+// timer passes
+static void chart_restart(uint32_t now) {
+  chart.t_start = now - chart.window_ms;
+  chart.cols = 0;
+  chart.head = chart.w - 1;
+  lv_color_fill(chart.buf, lv_color_hex(BG_COLOR),
+                (uint32_t)chart.w * chart.h);
+  for (int i = 0; i < UI_STRIP_CHART_MAX_SERIES; i++) {
+    chart_series_t *s = &chart.series[i];
+    if (s->sig != ECU_SIG_COUNT)
+      s->cursor = signal_history_seek(s->sig, chart.t_start);
+    s->has_last = false;
+    s->prev_y = -1;
+  }
+  lv_obj_invalidate(chart.obj);
+}
+
+static void chart_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  if (lv_obj_get_screen(chart.obj) != lv_scr_act())
+    return;
+
+  uint32_t now = now_ms();
+  uint32_t due =
+      (uint32_t)((uint64_t)(now - chart.t_start) * chart.w / chart.window_ms);
+  if (due - chart.cols > (uint32_t)chart.w) {
+    // Hidden for longer than the window: nothing on the plot is current
+    chart_restart(now);
+    due = chart.w;
+  }
+
+  for (int i = 0; i < UI_STRIP_CHART_MAX_SERIES; i++) {
+    chart_series_t *s = &chart.series[i];
+    signal_freshness_t f;
+    if (s->sig != ECU_SIG_COUNT && signal_freshness_get(s->sig, now, &f))
+      s->hold_ms = f.timeout_ms;
+  }
+
+  uint32_t n = LV_MIN(due - chart.cols, UI_STRIP_CHART_MAX_COLS_PER_PASS);
+  for (uint32_t i = 0; i < n; i++) {
+    chart.head = chart.head + 1 == chart.w ? 0 : chart.head + 1;
+    draw_column(chart.head, col_time(chart.cols), col_time(chart.cols + 1));
+    // Rebase every window so col_time() stays exact
+    if (++chart.cols == (uint32_t)chart.w) {
+      chart.t_start += chart.window_ms;
+      chart.cols = 0;
+    }
+  }
+  // Every pixel on screen moved
+  if (n)
+    lv_obj_invalidate(chart.obj);
+}
+
+// Blit the ring with its oldest column (head + 1) at the left edge: ring
+// [head + 1, w) first, then [0, head]
+static void draw_cb(lv_event_t *e) {
+  lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+  const lv_area_t *clip_orig = draw_ctx->clip_area;
+  lv_area_t coords;
+  lv_obj_get_coords(chart.obj, &coords);
+  lv_coord_t split = coords.x1 + chart.w - chart.head - 1;
+
+  lv_draw_img_dsc_t dsc;
+  lv_draw_img_dsc_init(&dsc);
+
+  for (int piece = 0; piece < 2; piece++) {
+    lv_area_t part = coords;
+    lv_area_t img_area = coords;
+    if (piece == 0) {
+      part.x2 = split - 1;
+      img_area.x1 = coords.x1 - chart.head - 1;
+    } else {
+      part.x1 = split;
+      img_area.x1 = split;
+    }
+    img_area.x2 = img_area.x1 + chart.w - 1;
+
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, clip_orig, &part))
+      continue;
+    draw_ctx->clip_area = &clip;
+    lv_draw_img(draw_ctx, &dsc, &img_area, &chart.img);
+  }
+  draw_ctx->clip_area = clip_orig;
+}
+
+static void delete_cb(lv_event_t *e) {
+  (void)e;
+  lv_timer_del(chart.timer);
+  heap_caps_free(chart.buf);
+  chart.timer = NULL;
+  chart.buf = NULL;
+  chart.obj = NULL;
+}
+
+lv_obj_t *ui_strip_chart_create(lv_obj_t *parent, lv_coord_t w, lv_coord_t h) {
+  if (chart.obj)
+    lv_obj_del(chart.obj);
+
+  size_t bytes = (size_t)w * h * sizeof(lv_color_t);
+  lv_color_t *buf = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+  if (!buf) {
+    ESP_LOGE(TAG, "No PSRAM for a %dx%d plot (%u KB)", w, h,
+             (unsigned)(bytes / 1024));
+    return NULL;
+  }
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, w, h);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_add_event_cb(obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, delete_cb, LV_EVENT_DELETE, NULL);
+
+  chart.obj = obj;
+  chart.buf = buf;
+  chart.w = w;
+  chart.h = h;
+  chart.img.header.cf = LV_IMG_CF_TRUE_COLOR;
+  chart.img.header.always_zero = 0;
+  chart.img.header.w = w;
+  chart.img.header.h = h;
+  chart.img.data_size = bytes;
+  chart.img.data = (const uint8_t *)buf;
+  chart.window_ms = UI_STRIP_CHART_DEFAULT_WINDOW_MS;
+  for (int i = 0; i < UI_STRIP_CHART_MAX_SERIES; i++)
+    chart.series[i].sig = ECU_SIG_COUNT;
+
+  chart.timer = lv_timer_create(chart_timer_cb, UI_STRIP_CHART_PERIOD_MS, NULL);
+  chart_restart(now_ms());
+  return obj;
+}
+
+void ui_strip_chart_set_series(int slot, ecu_signal_id_t sig, float min,
+                               float max, lv_color_t color) {
+  if (!chart.obj || slot < 0 || slot >= UI_STRIP_CHART_MAX_SERIES)
+    return;
+  chart_series_t *s = &chart.series[slot];
+  s->sig = (unsigned)sig < ECU_SIG_COUNT ? sig : ECU_SIG_COUNT;
+  s->min = min;
+  s->scale = max > min ? (float)(chart.h - LINE_PX) / (max - min) : 0.0f;
+  s->color = color;
+  s->hold_ms = 0;
+  chart_restart(now_ms());
+}
+
+void ui_strip_chart_set_window(uint32_t window_ms) {
+  if (!chart.obj || window_ms < (uint32_t)chart.w)
+    return;
+  chart.window_ms = window_ms;
+  chart_restart(now_ms());
+}
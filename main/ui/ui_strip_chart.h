@@ -0,0 +1,44 @@
+// Strip chart: scrolling time-series plot of up to four signals
+
+#ifndef UI_STRIP_CHART_H
+#define UI_STRIP_CHART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ecu_data.h"
+#include "lvgl.h"
+
+// Each pixel column covers window_ms / width of signal history and is drawn
+// once, as a min/max bar per series joined to the previous column, so the
+// cost per column does not depend on the signals' sample rates.
+//
+// The plot is a ring of columns in PSRAM: scrolling advances the ring's
+// start instead of moving pixels, and the draw event blits the ring in two
+// pieces. Only new columns are rendered, at most
+// UI_STRIP_CHART_MAX_COLS_PER_PASS per timer pass; a chart that falls a
+// whole window behind (screen hidden) is rebuilt from history.
+
+#define UI_STRIP_CHART_MAX_SERIES 4
+#define UI_STRIP_CHART_PERIOD_MS 33 // 30 fps
+#define UI_STRIP_CHART_MAX_COLS_PER_PASS 256
+#define UI_STRIP_CHART_DEFAULT_WINDOW_MS 30000
+
+// One chart at a time; it stops and frees its buffer when deleted with its
+// screen. NULL if the plot buffer cannot be allocated.
+lv_obj_t *ui_strip_chart_create(lv_obj_t *parent, lv_coord_t w, lv_coord_t h);
+
+// Plot sig in slot, scaled so [min, max] spans the plot height.
+// sig = ECU_SIG_COUNT clears the slot. Redraws the window from history.
+void ui_strip_chart_set_series(int slot, ecu_signal_id_t sig, float min,
+                               float max, lv_color_t color);
+
+// Time span across the plot. Redraws the window from history.
+void ui_strip_chart_set_window(uint32_t window_ms);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // UI_STRIP_CHART_H
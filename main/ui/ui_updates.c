@@ -1,212 +1,402 @@
 #include "ui_updates.h"
 #include "ui.h"
+#include "ui_gauge_pool.h"
+#include "ui_gauge_styles.h"
 #include "screens/ui_Screen8.h"
 #include "ecu_data.h"
+#include "esp_timer.h"
+#include "gauge_filter.h"
+#include "signal_freshness.h"
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-static bool global_demo_mode = false;
+// Gauges are stepped once per display refresh: the needle filters
+// interpolate between CAN samples, so there is something new to draw every
+// frame. Demo mode feeds the same ecu_data snapshot through the CAN
+// simulator, so there is a single data path for both.
+#define GAUGE_REFRESH_MS LV_DISP_DEF_REFR_PERIOD
 
-void ui_updates_set_demo_mode(bool enabled) {
-    global_demo_mode = enabled;
+static lv_timer_t *gauge_timer = NULL;
+
+// Each bound widget caches what it currently shows: level (colour overlay),
+// arc position and the displayed value in fixed point. LVGL is only called
+// when one of those changes, so a steady signal costs a compare per refresh
+// instead of a re-layout, a style write and an invalidation.
+//
+// Arc and value follow the gauge's needle filter (gauge_filter.h) rather
+// than the raw sample; the threshold colour follows the raw sample so a
+// warning is never delayed by smoothing. The arc is only moved once the
+// filter output has travelled at least a pixel along it.
+
+// Gauges that no platform feeds yet (always drawn as 0)
+#define GAUGE_UNBOUND ECU_SIG_COUNT
+
+// Cached value meaning the label shows the stale placeholder
+#define SHOWN_STALE INT32_MIN
+
+typedef struct {
+    lv_obj_t **arc;   // Address of the screen's widget pointer (may be NULL)
+    lv_obj_t **label;
+    ecu_signal_id_t sig;
+    uint8_t decimals; // Digits after the point in the value label
+    bool plain;       // Value label only: no threshold colours
+    bool invert;      // Thresholds are lower limits
+    float warn;
+    float crit;
+    uint16_t smooth_ms; // Needle settle time, 0 = zero lag (gauge_filter.h)
+} gauge_binding_t;
+
+// Screen a widget sits on, re-resolved when the layout manager reparents
+typedef struct {
+    lv_obj_t *screen;
+    uint16_t layout_gen;
+} screen_ref_t;
+
+typedef struct {
+    lv_obj_t *arc;    // Widgets the cached state belongs to
+    lv_obj_t *label;
+    screen_ref_t where;
+    int32_t shown;    // Label value * 10^decimals, or SHOWN_STALE
+    int16_t arc_value;
+    int16_t arc_deadband; // Arc units per pixel, 0 = not measured yet
+    uint8_t level;    // ui_gauge_level_t overlay on the widgets
+    bool valid;
+    gauge_filter_t filter;
+} gauge_cache_t;
+
+typedef struct {
+    lv_obj_t *label;
+    screen_ref_t where;
+    char text[16];
+} text_cache_t;
+
+static const gauge_binding_t gauges[] = {
+    // --- Screen 8 (Classic Sports) ---
+    {&ui_Gauge_RPM_S8, &ui_Label_RPM_Val_S8, ECU_SIG_RPM, 0, false, false, 7500, 9000, 0},
+    {&ui_Gauge_Speed_S8, &ui_Label_Speed_Val_S8, ECU_SIG_SPEED, 0, false, false, 250, 280, 100},
+    {.label = &ui_Label_Boost_Val_S8, .sig = ECU_SIG_MAP, .plain = true, .smooth_ms = 60},
+    {.label = &ui_Label_OilTemp_Val_S8, .sig = ECU_SIG_OIL_TEMP, .plain = true, .smooth_ms = 400},
+    {.label = &ui_Label_OilPress_Val_S8, .sig = ECU_SIG_OIL_PRESS, .plain = true, .smooth_ms = 150},
+    {.label = &ui_Label_WaterTemp_Val_S8, .sig = ECU_SIG_CLT, .plain = true, .smooth_ms = 400},
+    {.label = &ui_Label_AirTemp_Val_S8, .sig = ECU_SIG_IAT, .plain = true, .smooth_ms = 400},
+};
+#define GAUGE_COUNT (sizeof(gauges) / sizeof(gauges[0]))
+
+static gauge_cache_t gauge_cache[GAUGE_COUNT];
+
+// Gauge pages: one binding per pooled card, set by the layout manager
+static gauge_binding_t card_bindings[UI_GAUGE_POOL_MAX];
+static gauge_cache_t card_cache[UI_GAUGE_POOL_MAX];
+
+enum { TEXT_GEAR, TEXT_GEAR_S1, TEXT_SELECTOR_S1, TEXT_GEAR_S8, TEXT_COUNT };
+static text_cache_t text_cache[TEXT_COUNT];
+
+// Screen 8 boost bar: value plus a grey/red indicator
+static struct {
+    lv_obj_t *bar;
+    screen_ref_t where;
+    int32_t value;
+    bool active; // Red indicator (fresh and above atmospheric)
+} bar_cache;
+
+static ecu_signal_mask_t stale_now = 0;
+static uint32_t stamps_now[ECU_SIG_COUNT]; // Set with the values they date
+
+// Only widgets on the active screen (and the one being loaded during a
+// transition) are refreshed. Skipped widgets keep their cache, so the first
+// refresh after they become visible catches up with just the changed parts.
+// layout_gen starts at 1 so zeroed caches always resolve their screen.
+static lv_obj_t *shown_screens[2];
+static uint16_t layout_gen = 1;
+
+// Screens can be destroyed and rebuilt; a new widget may even reuse the old
+// address. Forget the cached state as soon as a bound widget is deleted.
+static void cache_obj_deleted_cb(lv_event_t *e) {
+    void *cache = lv_event_get_user_data(e);
+    if (cache == &bar_cache) {
+        memset(&bar_cache, 0, sizeof(bar_cache));
+    } else if ((text_cache_t *)cache >= text_cache && (text_cache_t *)cache < text_cache + TEXT_COUNT) {
+        memset(cache, 0, sizeof(text_cache_t));
+    } else {
+        memset(cache, 0, sizeof(gauge_cache_t));
+    }
 }
 
-// This function is called periodically by the LVGL task.
-// It reads the latest data from the global ECU data struct
-// and updates all the gauge widgets on all screens.
-// Helper function to update gauge value, text, and color
-// Helper function to update gauge value, text, and color
-static void update_gauge(lv_obj_t *arc, lv_obj_t *label, float value, const char *fmt, 
-                        float warn_thr, float crit_thr, bool invert_logic, lv_color_t normal_color) {
+static bool widget_visible(lv_obj_t *obj, screen_ref_t *where) {
+    if (where->layout_gen != layout_gen) {
+        where->screen = lv_obj_get_screen(obj);
+        where->layout_gen = layout_gen;
+    }
+    if (where->screen != shown_screens[0] && where->screen != shown_screens[1]) return false;
+
+    // Gauges disabled in the layout are hidden along with their container
+    lv_obj_t *parent = lv_obj_get_parent(obj);
+    return !lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) && !(parent && lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN));
+}
+
+static void watch_delete(lv_obj_t *obj, void *cache) {
+    if (obj != NULL) {
+        lv_obj_add_event_cb(obj, cache_obj_deleted_cb, LV_EVENT_DELETE, cache);
+    }
+}
+
+// Write v / 10^decimals (decimals 0..2) into buf without going through printf.
+// Matches "%.<decimals>f" except that halves round away from zero.
+static void format_fixed(char *buf, int32_t v, uint8_t decimals) {
+    char tmp[12];
+    int n = 0;
+    uint32_t u = (v < 0) ? (uint32_t)(-(int64_t)v) : (uint32_t)v;
+
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+        if (n == decimals) tmp[n++] = '.';
+    } while (u != 0 || n < decimals + (decimals ? 2 : 1)); // "0.x" for |v| < 1
+
+    char *p = buf;
+    if (v < 0) *p++ = '-';
+    while (n > 0) *p++ = tmp[--n];
+    *p = '\0';
+}
+
+static int32_t to_fixed(float value, uint8_t decimals) {
+    static const float scale[] = {1.0f, 10.0f, 100.0f};
+    float scaled = value * scale[decimals];
+    if (scaled > (float)INT32_MAX - 1) return INT32_MAX - 1;
+    if (scaled < (float)(INT32_MIN + 1)) return INT32_MIN + 1;
+    return (int32_t)lroundf(scaled);
+}
+
+// Arc units that move the indicator end by one pixel, 0 before layout
+static int16_t arc_deadband(lv_obj_t *arc) {
+    lv_coord_t r = LV_MIN(lv_obj_get_width(arc), lv_obj_get_height(arc)) / 2;
+    int32_t span = (int32_t)lv_arc_get_bg_angle_end(arc) - lv_arc_get_bg_angle_start(arc);
+    if (span <= 0) span += 360;
+    int32_t range = lv_arc_get_max_value(arc) - lv_arc_get_min_value(arc);
+    if (r <= 0 || range <= 0) return 0;
+    float px = (float)r * (float)span * ((float)M_PI / 180.0f);
+    int32_t units = (int32_t)((float)range / px);
+    return (int16_t)(units < 1 ? 1 : (units > INT16_MAX ? INT16_MAX : units));
+}
+
+static ui_gauge_level_t classify(const gauge_binding_t *g, float value) {
+    if (g->plain) return UI_GAUGE_LEVEL_NORMAL;
+    bool is_crit = g->invert ? (value <= g->crit) : (value >= g->crit);
+    bool is_warn = g->invert ? (value <= g->warn && value > g->crit) : (value >= g->warn && value < g->crit);
+    if (is_crit) return UI_GAUGE_LEVEL_CRIT;
+    if (is_warn) return UI_GAUGE_LEVEL_WARN;
+    return UI_GAUGE_LEVEL_NORMAL;
+}
+
+static void update_gauge(const gauge_binding_t *g, gauge_cache_t *c, const ecu_data_t *data, uint32_t now_ms) {
+    lv_obj_t *arc = g->arc ? *g->arc : NULL;
+    lv_obj_t *label = g->label ? *g->label : NULL;
     if (arc == NULL && label == NULL) return;
 
-    // Determine Color
-    lv_color_t text_color = lv_color_white();
-    lv_color_t arc_color = normal_color;
-    
-    // Check thresholds
-    bool is_warn = invert_logic ? (value <= warn_thr && value > crit_thr) : (value >= warn_thr && value < crit_thr);
-    bool is_crit = invert_logic ? (value <= crit_thr) : (value >= crit_thr);
+    if (c->arc != arc || c->label != label) {
+        memset(c, 0, sizeof(*c));
+        c->arc = arc;
+        c->label = label;
+        watch_delete(arc, c);
+        watch_delete(label, c);
+    }
+    if (!widget_visible(arc ? arc : label, &c->where)) return;
+
+    bool bound = g->sig != GAUGE_UNBOUND;
+    bool stale = bound && (stale_now & ECU_SIG_BIT(g->sig));
+    float value = bound ? ecu_data_get_signal(data, g->sig) : 0.0f;
+    ui_gauge_level_t level = stale ? UI_GAUGE_LEVEL_STALE : classify(g, value);
 
-    if (is_crit) {
-        text_color = lv_color_hex(0xFF0000); // Red
-        arc_color = lv_color_hex(0xFF0000);
-    } else if (is_warn) {
-        text_color = lv_color_hex(0xFFD700); // Yellow
-        arc_color = lv_color_hex(0xFFD700);
+    // Swap the shared threshold overlay; a freshly bound widget has none.
+    // Plain value labels keep the text colour the screen gave them.
+    if (!g->plain && c->level != level) {
+        ui_gauge_level_t from = (ui_gauge_level_t)c->level;
+        if (arc != NULL) ui_gauge_set_level(arc, LV_PART_INDICATOR, from, level);
+        if (label != NULL) ui_gauge_set_level(label, LV_PART_MAIN, from, level);
+        c->level = (uint8_t)level;
     }
 
-    // Update Arc
-    if (arc != NULL) {
-        lv_arc_set_value(arc, (int16_t)value);
-        lv_obj_set_style_arc_color(arc, arc_color, LV_PART_INDICATOR);
+    // A stale signal restarts its filter, so the needle does not sweep in
+    // from the old value when data returns
+    if (stale) {
+        gauge_filter_reset(&c->filter);
+    } else {
+        gauge_filter_sample(&c->filter, value,
+                            bound ? stamps_now[g->sig] : 0);
+        value = gauge_filter_step(&c->filter, g->smooth_ms, now_ms);
     }
-    
-    // Update Label
-    if (label != NULL && fmt != NULL) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), fmt, value);
-        lv_label_set_text(label, buf);
-        lv_obj_set_style_text_color(label, text_color, 0);
+
+    // The arc keeps its last position while stale
+    if (arc != NULL && !stale) {
+        int16_t arc_value = (int16_t)lroundf(value);
+        if (c->arc_deadband == 0) c->arc_deadband = arc_deadband(arc);
+        int16_t deadband = c->arc_deadband ? c->arc_deadband : 1;
+        if (!c->valid || abs(arc_value - c->arc_value) >= deadband) {
+            lv_arc_set_value(arc, arc_value);
+            c->arc_value = arc_value;
+        }
     }
+
+    if (label != NULL) {
+        int32_t shown = stale ? SHOWN_STALE : to_fixed(value, g->decimals);
+        if (!c->valid || c->shown != shown) {
+            char buf[16];
+            if (stale) {
+                lv_label_set_text_static(label, "--");
+            } else {
+                format_fixed(buf, shown, g->decimals);
+                lv_label_set_text(label, buf);
+            }
+            c->shown = shown;
+        }
+    }
+
+    c->valid = true;
 }
 
-void update_all_gauges(void) {
+// Plain text bound to a signal; set only when the text differs
+static void update_text(int slot, lv_obj_t *label, ecu_signal_id_t sig, const char *text, const char *stale_text) {
+    if (label == NULL) return;
+    text_cache_t *c = &text_cache[slot];
+    if (c->label != label) {
+        memset(c, 0, sizeof(*c));
+        c->label = label;
+        watch_delete(label, c);
+    }
+    if (!widget_visible(label, &c->where)) return;
 
+    if (stale_now & ECU_SIG_BIT(sig)) text = stale_text;
+    if (strcmp(c->text, text) == 0 && c->text[0] != '\0') return;
+    snprintf(c->text, sizeof(c->text), "%s", text);
+    lv_label_set_text(label, c->text);
+}
+
+static void update_boost_bar(const ecu_data_t *data) {
+    lv_obj_t *bar = ui_Bar_Boost_S8;
+    if (bar == NULL) return;
+    if (bar_cache.bar != bar) {
+        memset(&bar_cache, 0, sizeof(bar_cache));
+        bar_cache.bar = bar;
+        bar_cache.value = -1;
+        bar_cache.active = true; // Screen creates the indicator red
+        watch_delete(bar, &bar_cache);
+    }
+    if (!widget_visible(bar, &bar_cache.where)) return;
 
+    bool stale = (stale_now & ECU_SIG_BIT(ECU_SIG_MAP)) != 0;
+    int32_t value = stale ? 0 : (int32_t)data->map_kpa;
+    bool active = !stale && data->map_kpa >= 100;
+
+    if (value != bar_cache.value) {
+        lv_bar_set_value(bar, value, LV_ANIM_OFF);
+        bar_cache.value = value;
+    }
+    if (active != bar_cache.active) {
+        ui_gauge_set_level(bar, LV_PART_INDICATOR, active ? UI_GAUGE_LEVEL_STALE : UI_GAUGE_LEVEL_NORMAL,
+                           active ? UI_GAUGE_LEVEL_NORMAL : UI_GAUGE_LEVEL_STALE);
+        bar_cache.active = active;
+    }
+}
+
+static void format_gear(char *buf, size_t size, const char *prefix, int8_t gear) {
+    if (gear == 0) snprintf(buf, size, "%sP", prefix);
+    else if (gear == 13) snprintf(buf, size, "%sR", prefix); // 13 is often Reverse in ZF/VAG
+    else if (gear == 14) snprintf(buf, size, "%sN", prefix); // 14 is often Neutral
+    else snprintf(buf, size, "%s%d", prefix, gear);
+}
+
+void update_all_gauges(void) {
     ecu_data_t data;
-    
-    if (global_demo_mode) {
-        ecu_data_simulate(&data);
-    } else {
-        ecu_data_get_copy(&data);
-    }
-
-    // --- Screen 1 ---
-    // MAP: Cyan. Warn: 1500, Crit: 1800
-    update_gauge(ui_Arc_MAP, ui_Label_MAP_Value, data.map_kpa, "%.0f", 1500, 1800, false, lv_color_hex(0x00D4FF));
-    
-    // RPM: Cyan. Warn: 7500, Crit: 9000
-    update_gauge(ui_Arc_RPM, ui_Label_RPM_Value, data.engine_rpm, "%.0f", 7500, 9000, false, lv_color_hex(0x00D4FF));
-    
-    // TPS: Cyan. Warn: 80, Crit: 90
-    update_gauge(ui_Arc_TPS, ui_Label_TPS_Value, data.tps_position, "%.1f", 80, 90, false, lv_color_hex(0x00D4FF));
-    
-    // Wastegate: Cyan. Warn: 110, Crit: 120
-    update_gauge(ui_Arc_Wastegate, ui_Label_Wastegate_Value, data.wg_pos_percent, "%.1f", 110, 120, false, lv_color_hex(0x00D4FF));
-    
-    // Boost (Target): Cyan.
-    if (ui_Arc_Boost && ui_Label_Boost_Value) {
-         update_gauge(ui_Arc_Boost, ui_Label_Boost_Value, data.map_kpa, "%.0f", 200, 230, false, lv_color_hex(0x00D4FF));
-    }
-
-    // --- Screen 2 ---
-    // Oil Pressure: Orange (0xFF6B35). Warn: < 2.0, Crit: < 1.0
-    update_gauge(ui_Arc_Oil_Pressure, ui_Label_Oil_Pressure_Value, 0, "%.1f", 2.0, 1.0, true, lv_color_hex(0xFF6B35));
-    
-    // Oil Temp: Gold (0xFFD700). Warn: 110, Crit: 120
-    update_gauge(ui_Arc_Oil_Temp, ui_Label_Oil_Temp_Value, data.oil_temp, "%.0f", 110, 120, false, lv_color_hex(0xFFD700));
-    
-    // Water Temp: Cyan (0x00D4FF). Warn: 105, Crit: 115
-    update_gauge(ui_Arc_Water_Temp, ui_Label_Water_Temp_Value, data.clt_temp, "%.0f", 105, 115, false, lv_color_hex(0x00D4FF));
-    
-    // Fuel Pressure: Green (0x00FF88). Warn: < 3.0, Crit: < 2.0
-    update_gauge(ui_Arc_Fuel_Pressure, ui_Label_Fuel_Pressure_Value, 0, "%.1f", 3.0, 2.0, true, lv_color_hex(0x00FF88));
-    
-    // Battery: Gold (0xFFD700). Warn: < 12.0, Crit: < 11.5
-    update_gauge(ui_Arc_Battery_Voltage, ui_Label_Battery_Voltage_Value, data.battery_voltage, "%.1f", 12.0, 11.5, true, lv_color_hex(0xFFD700));
-
-    // --- Screen 4 ---
-    // Abs Pedal: Cyan
-    update_gauge(ui_Arc_Abs_Pedal, ui_Label_Abs_Pedal_Value, data.abs_pedal_pos, "%.1f", 110, 120, false, lv_color_hex(0x00D4FF));
-    
-    // WG Pos: Green
-    update_gauge(ui_Arc_WG_Pos, ui_Label_WG_Pos_Value, data.wg_pos_percent, "%.1f", 110, 120, false, lv_color_hex(0x00FF88));
-    
-    // BOV: Gold
-    update_gauge(ui_Arc_BOV, ui_Label_BOV_Value, data.bov_percent, "%.1f", 110, 120, false, lv_color_hex(0xFFD700));
-    
-    // TCU TQ: Orange
-    update_gauge(ui_Arc_TCU_TQ_Req, ui_Label_TCU_TQ_Req_Value, data.tcu_tq_req_nm, "%.0f", 450, 500, false, lv_color_hex(0xFF6B35));
-    update_gauge(ui_Arc_TCU_TQ_Act, ui_Label_TCU_TQ_Act_Value, data.tcu_tq_act_nm, "%.0f", 450, 500, false, lv_color_hex(0xFF3366));
-    update_gauge(ui_Arc_Eng_TQ_Req, ui_Label_Eng_TQ_Req_Value, data.eng_trg_nm, "%.0f", 450, 500, false, lv_color_hex(0x8A2BE2));
-
-    // --- Screen 5 ---
-    // Eng Tq Act: Cyan
-    update_gauge(ui_Arc_Eng_TQ_Act, ui_Label_Eng_TQ_Act_Value, data.eng_act_nm, "%.0f", 450, 500, false, lv_color_hex(0x00D4FF));
-    // Limit Tq: Green
-    update_gauge(ui_Arc_Limit_TQ, ui_Label_Limit_TQ_Value, data.limit_tq_nm, "%.0f", 450, 500, false, lv_color_hex(0x00FF88));
-
-    // --- Gear Display (Screen 4) ---
-    if (ui_Label_Gear) {
-        char gear_buf[16];
-        if (data.gear == 0) snprintf(gear_buf, sizeof(gear_buf), "Gear: P");
-        else if (data.gear == 13) snprintf(gear_buf, sizeof(gear_buf), "Gear: R"); // 13 is often Reverse in ZF/VAG
-        else if (data.gear == 14) snprintf(gear_buf, sizeof(gear_buf), "Gear: N"); // 14 is often Neutral
-        else snprintf(gear_buf, sizeof(gear_buf), "Gear: %d", data.gear);
-        lv_label_set_text(ui_Label_Gear, gear_buf);
-    }
-
-    // --- Screen 1 TCU Box ---
-    if (ui_Label_Gear_S1) {
-        char gear_buf[16];
-        if (data.gear == 0) snprintf(gear_buf, sizeof(gear_buf), "Gear: P");
-        else if (data.gear == 13) snprintf(gear_buf, sizeof(gear_buf), "Gear: R");
-        else if (data.gear == 14) snprintf(gear_buf, sizeof(gear_buf), "Gear: N");
-        else snprintf(gear_buf, sizeof(gear_buf), "Gear: %d", data.gear);
-        lv_label_set_text(ui_Label_Gear_S1, gear_buf);
+    ecu_data_get_stamped(&data, stamps_now);
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    stale_now = signal_freshness_get_stale_mask();
+
+    lv_disp_t *disp = lv_disp_get_default();
+    shown_screens[0] = lv_scr_act();
+    shown_screens[1] = disp ? disp->scr_to_load : NULL;
+
+    for (size_t i = 0; i < GAUGE_COUNT; i++) {
+        update_gauge(&gauges[i], &gauge_cache[i], &data, now_ms);
+    }
+    for (size_t i = 0; i < UI_GAUGE_POOL_MAX; i++) {
+        update_gauge(&card_bindings[i], &card_cache[i], &data, now_ms);
     }
 
+    update_boost_bar(&data);
+
+    // --- Gear / selector text (Screens 1, 4, 8) ---
+    char gear_buf[16];
+    format_gear(gear_buf, sizeof(gear_buf), "Gear: ", data.gear);
+    update_text(TEXT_GEAR, ui_Label_Gear, ECU_SIG_GEAR, gear_buf, "Gear: --");
+    update_text(TEXT_GEAR_S1, ui_Label_Gear_S1, ECU_SIG_GEAR, gear_buf, "Gear: --");
+
     if (ui_Label_Selector_S1) {
-        char sel_buf[16];
         // Selector mapping (example VAG): P=0, R=1, N=2, D=3, S=4
         // If unknown, show raw
-        if (data.selector_position == 0) snprintf(sel_buf, sizeof(sel_buf), "Sel: P");
-        else if (data.selector_position == 1) snprintf(sel_buf, sizeof(sel_buf), "Sel: R");
-        else if (data.selector_position == 2) snprintf(sel_buf, sizeof(sel_buf), "Sel: N");
-        else if (data.selector_position == 3) snprintf(sel_buf, sizeof(sel_buf), "Sel: D");
-        else if (data.selector_position == 4) snprintf(sel_buf, sizeof(sel_buf), "Sel: S");
-        else snprintf(sel_buf, sizeof(sel_buf), "Sel: %d", data.selector_position);
-        lv_label_set_text(ui_Label_Selector_S1, sel_buf);
+        static const char *const sel_names[] = {"Sel: P", "Sel: R", "Sel: N", "Sel: D", "Sel: S"};
+        char sel_buf[16];
+        if (data.selector_position >= 0 && data.selector_position <= 4) {
+            snprintf(sel_buf, sizeof(sel_buf), "%s", sel_names[data.selector_position]);
+        } else {
+            snprintf(sel_buf, sizeof(sel_buf), "Sel: %d", data.selector_position);
+        }
+        update_text(TEXT_SELECTOR_S1, ui_Label_Selector_S1, ECU_SIG_SELECTOR, sel_buf, "Sel: --");
     }
 
-    // --- Screen 8 (Classic Sports) ---
-    // RPM (Left) - Red
-    update_gauge(ui_Gauge_RPM_S8, ui_Label_RPM_Val_S8, data.engine_rpm, "%.0f", 7500, 9000, false, lv_color_hex(0xFF0000));
-    
-    // Speed (Right) - White
-    // Assuming data.vehicle_speed exists (or derive from RPM/Gear)
-    // If vehicle_speed not in struct, use RPM * ratio for demo or default 0
-    // float simul_speed = data.engine_rpm * 0.04; // Approximated
-    update_gauge(ui_Gauge_Speed_S8, ui_Label_Speed_Val_S8, data.vehicle_speed, "%.0f", 250, 280, false, lv_color_white());
-
-    // Boost (Bar)
-    if (ui_Bar_Boost_S8) {
-        lv_bar_set_value(ui_Bar_Boost_S8, (int32_t)data.map_kpa, LV_ANIM_OFF);
-        // Color Change based on threshold
-        lv_color_t bar_col = lv_color_hex(0xFF0000); // Default Red
-        if (data.map_kpa < 100) bar_col = lv_color_hex(0x555555);
-        lv_obj_set_style_bg_color(ui_Bar_Boost_S8, bar_col, LV_PART_INDICATOR);
-    }
-    if (ui_Label_Boost_Val_S8) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%.0f", data.map_kpa);
-        lv_label_set_text(ui_Label_Boost_Val_S8, buf);
-    }
-
-    // Temperatures & Pressures (Center Panel)
-    if(ui_Label_OilTemp_Val_S8) {
-        char buf[16]; snprintf(buf, sizeof(buf), "%.0f", data.oil_temp);
-        lv_label_set_text(ui_Label_OilTemp_Val_S8, buf);
-    }
-    if(ui_Label_OilPress_Val_S8) {
-        char buf[16]; snprintf(buf, sizeof(buf), "%.0f", data.oil_pressure); // Assuming oil_pressure exists
-        lv_label_set_text(ui_Label_OilPress_Val_S8, buf);
-    }
-    if(ui_Label_WaterTemp_Val_S8) {
-        char buf[16]; snprintf(buf, sizeof(buf), "%.0f", data.clt_temp);
-        lv_label_set_text(ui_Label_WaterTemp_Val_S8, buf);
-    }
-    if(ui_Label_AirTemp_Val_S8) {
-        char buf[16]; snprintf(buf, sizeof(buf), "%.0f", data.iat_temp); // Assuming iat_temp exists
-        lv_label_set_text(ui_Label_AirTemp_Val_S8, buf);
-    }
-
-    // Gear (Footer) - Simplified Text Update? 
-    // The Footer has 3 labels (P, N, D). This logic needs to highlight the active one.
-    // However, recreating that logic here is complex since we don't have pointers to the individual footer labels in 'ui_Screen8.h',
-    // only a single 'ui_Label_Gear_S8' which we repurposed or didn't fully expose.
-    // In ui_Screen8.c we made local variables for P/N/D.
-    // We should probably rely on a separate update function in ui_Screen8.c for complex UI state, or just stick to the simple logical label if exposed.
-    // Ideally, ui_Screen8_update() should handle local widget logic.
-    // But for now, we'll leave it as is.
-    if (ui_Label_Gear_S8) {
-        char gear_buf[8];
-        if (data.gear == 0) snprintf(gear_buf, sizeof(gear_buf), "P");
-        else if (data.gear == 13) snprintf(gear_buf, sizeof(gear_buf), "R");
-        else if (data.gear == 14) snprintf(gear_buf, sizeof(gear_buf), "N");
-        else snprintf(gear_buf, sizeof(gear_buf), "%d", data.gear);
-        lv_label_set_text(ui_Label_Gear_S8, gear_buf);
+    // Screen 8 footer: P/N/D highlighting is handled in ui_Screen8.c, this is
+    // the single exposed gear label.
+    format_gear(gear_buf, sizeof(gear_buf), "", data.gear);
+    update_text(TEXT_GEAR_S8, ui_Label_Gear_S8, ECU_SIG_GEAR, gear_buf, "-");
+}
+
+void ui_updates_bind_card(int n, const gauge_layout_entry_t *e) {
+    ui_gauge_card_t *card = ui_gauge_pool_card(n);
+    if (card == NULL) return;
+    gauge_binding_t *g = &card_bindings[n];
+    gauge_cache_t *c = &card_cache[n];
+
+    // The card goes back to its accent colours; the delete watches stay
+    // installed, so keep the widgets the cache belongs to
+    if (c->level != UI_GAUGE_LEVEL_NORMAL) {
+        if (c->arc != NULL) ui_gauge_set_level(c->arc, LV_PART_INDICATOR, (ui_gauge_level_t)c->level, UI_GAUGE_LEVEL_NORMAL);
+        if (c->label != NULL) ui_gauge_set_level(c->label, LV_PART_MAIN, (ui_gauge_level_t)c->level, UI_GAUGE_LEVEL_NORMAL);
     }
+    lv_obj_t *arc = c->arc;
+    lv_obj_t *label = c->label;
+    memset(c, 0, sizeof(*c));
+    c->arc = arc;
+    c->label = label;
 
+    if (e == NULL || e->type != GAUGE_WIDGET_ARC) {
+        memset(g, 0, sizeof(*g));
+        return;
+    }
+    *g = (gauge_binding_t){
+        .arc = &card->arc,
+        .label = &card->value,
+        .sig = e->sig,
+        .decimals = e->decimals,
+        .invert = e->invert,
+        .warn = e->warn,
+        .crit = e->crit,
+        .smooth_ms = e->smooth_ms,
+    };
+}
 
+void ui_updates_layout_changed(void) {
+    if (++layout_gen == 0) layout_gen = 1;
+}
+
+static void gauge_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    signal_freshness_sweep((uint32_t)(esp_timer_get_time() / 1000));
+    update_all_gauges();
+}
+
+void ui_updates_init(void) {
+    if (gauge_timer == NULL) {
+        gauge_timer = lv_timer_create(gauge_timer_cb, GAUGE_REFRESH_MS, NULL);
+    }
 }
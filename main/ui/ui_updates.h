@@ -1,6 +1,7 @@
 #ifndef UI_UPDATES_H
 #define UI_UPDATES_H
 
+#include "gauge_layout.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -9,9 +10,20 @@ extern "C" {
 
 // This function is called periodically by the LVGL task.
 // It reads the latest data from the global ECU data struct
-// and updates all the gauge widgets on all screens.
+// and updates the gauge widgets on the visible screen.
 void update_all_gauges(void);
-void ui_updates_set_demo_mode(bool enabled);
+
+// Widgets were moved between screens (layout reflow); re-resolve which
+// screen each bound widget is on before the next refresh.
+void ui_updates_layout_changed(void);
+
+// Bind pooled card n (ui_gauge_pool.h) to layout entry e, or unbind it with
+// NULL. Drops the card's threshold overlay and cached state.
+void ui_updates_bind_card(int n, const gauge_layout_entry_t *e);
+
+// Start the LVGL timer that calls update_all_gauges() periodically.
+// Must be called with the LVGL lock held (from ui_init).
+void ui_updates_init(void);
 
 #ifdef __cplusplus
 }
@@ -1,13 +1,22 @@
 #include "web_server.h"
+#include "can_filter.h"
+#include "can_sniffer.h"
 #include "dirent.h"
 #include "ecu_data.h"
 #include "esp_http_server.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_vfs.h"
+#include "gauge_layout.h"
 #include "include/can_websocket.h"
+#include "perf_monitor.h"
 #include "sd_card_manager.h"
+#include "signal_freshness.h"
+#include "signal_search.h"
+#include "ui/ui_layout_manager.h"
 #include <ctype.h>
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "WEB_SERVER";
@@ -164,6 +173,15 @@ static esp_err_t download_get_handler(httpd_req_t *req) {
   return ESP_OK;
 }
 
+/* A new or removed gauge layout takes effect without a restart */
+static void reload_if_layout(const char *path) {
+  if (strcmp(path, GAUGE_LAYOUT_PATH) != 0)
+    return;
+  esp_err_t err = ui_layout_reload();
+  if (err != ESP_OK)
+    ESP_LOGW(TAG, "Gauge layout reload: %s", esp_err_to_name(err));
+}
+
 /* Handler to upload a file */
 static esp_err_t upload_post_handler(httpd_req_t *req) {
   char buf[512];
@@ -218,6 +236,7 @@ static esp_err_t upload_post_handler(httpd_req_t *req) {
   }
   fclose(f);
   free(chunk);
+  reload_if_layout(full_path);
   httpd_resp_sendstr(req, "File uploaded successfully");
   return ESP_OK;
 }
@@ -245,6 +264,7 @@ static esp_err_t delete_post_handler(httpd_req_t *req) {
 
   if (unlink(full_path) == 0) {
     ESP_LOGI(TAG, "Deleted file: %s", full_path);
+    reload_if_layout(full_path); // Back to the built-in layout
     httpd_resp_sendstr(req, "File deleted successfully");
   } else {
     ESP_LOGE(TAG, "Failed to delete file: %s", full_path);
@@ -356,14 +376,11 @@ static esp_err_t ecu_data_api_handler(httpd_req_t *req) {
   ecu_data_t data;
   ecu_data_get_copy(&data);
 
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  ecu_signal_mask_t stale = signal_freshness_sweep(now_ms);
+
   char json[512];
-  snprintf(
-      json, sizeof(json),
-      "{\"rpm\":%.0f,\"speed\":%.1f,\"clt\":%.1f,\"iat\":%.1f,\"oil\":%.1f,"
-      "\"volt\":%.2f,\"gear\":%d,\"boost\":%.1f,\"tps\":%.1f}",
-      data.engine_rpm, data.vehicle_speed, data.clt_temp, data.iat_temp,
-      data.oil_temp, data.battery_voltage, data.gear, data.map_kpa,
-      data.tps_position);
+  ecu_data_to_json(&data, stale, json, sizeof(json));
 
   httpd_resp_set_type(req, "application/json");
   httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
@@ -371,6 +388,251 @@ static esp_err_t ecu_data_api_handler(httpd_req_t *req) {
   return ESP_OK;
 }
 
+/* Handler for per-signal freshness */
+static esp_err_t signals_api_handler(httpd_req_t *req) {
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  signal_freshness_sweep(now_ms);
+
+  ecu_data_t data;
+  ecu_data_get_copy(&data);
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_sendstr_chunk(req, "[");
+
+  bool first = true;
+  for (int i = 0; i < ECU_SIG_COUNT; i++) {
+    if (!ecu_signal_defined((ecu_signal_id_t)i))
+      continue;
+
+    signal_freshness_t f;
+    signal_freshness_get((ecu_signal_id_t)i, now_ms, &f);
+
+    char entry[192];
+    snprintf(entry, sizeof(entry),
+             "%s{\"name\":\"%s\",\"unit\":\"%s\",\"value\":%.2f,"
+             "\"state\":\"%s\",\"age_ms\":%lu,\"period_ms\":%u,"
+             "\"timeout_ms\":%u,\"declared\":%s}",
+             first ? "" : ",", ecu_signal_name((ecu_signal_id_t)i),
+             ecu_signal_unit((ecu_signal_id_t)i),
+             ecu_data_get_signal(&data, (ecu_signal_id_t)i),
+             signal_state_name(f.state), (unsigned long)f.age_ms, f.period_ms,
+             f.timeout_ms, f.period_declared ? "true" : "false");
+    httpd_resp_sendstr_chunk(req, entry);
+    first = false;
+  }
+
+  httpd_resp_sendstr_chunk(req, "]");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
+
+/* Sniffer snapshot: latest payload per CAN ID, narrowed server-side by an
+ * optional ?filter= can_filter expression (e.g. filter=280:xx%20xx%201F) */
+static esp_err_t can_frames_api_handler(httpd_req_t *req) {
+  char query[256];
+  char expr_enc[192];
+  char expr[192] = "";
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+      httpd_query_key_value(query, "filter", expr_enc, sizeof(expr_enc)) ==
+          ESP_OK) {
+    url_decode(expr, expr_enc);
+  }
+
+  can_filter_t filter;
+  if (can_filter_compile(expr, &filter) != ESP_OK) {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid filter");
+    return ESP_FAIL;
+  }
+
+  uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_sendstr_chunk(req, "[");
+
+  bool first = true;
+  int count = can_sniffer_get_count();
+  for (int i = 0; i < count; i++) {
+    can_sniffer_entry_t e;
+    if (!can_sniffer_read(i, &e) ||
+        !can_filter_match(&filter, e.id, e.data, e.dlc))
+      continue;
+
+    char id_str[12];
+    char data_str[32];
+    can_sniffer_format_id(e.id, id_str, sizeof(id_str));
+    can_sniffer_format_hex(e.data, e.dlc, data_str, sizeof(data_str));
+
+    char entry[192];
+    snprintf(entry, sizeof(entry),
+             "%s{\"id\":\"%s\",\"ext\":%s,\"dlc\":%u,\"data\":\"%s\","
+             "\"count\":%lu,\"period_ms\":%lu,\"age_ms\":%lu}",
+             first ? "" : ",", id_str,
+             (e.id & CAN_SNIFFER_ID_EXT) ? "true" : "false", e.dlc, data_str,
+             (unsigned long)e.count, (unsigned long)e.period_ms,
+             (unsigned long)(now_ms - e.last_ms));
+    httpd_resp_sendstr_chunk(req, entry);
+    first = false;
+  }
+
+  httpd_resp_sendstr_chunk(req, "]");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
+
+/* Correlation search: ?start=<signal key> begins a capture against that
+ * signal, ?run=1 scores it in the background, ?end=1 frees it. Every call
+ * returns the state, progress and (once done) the ranked candidates. */
+static esp_err_t signal_search_api_handler(httpd_req_t *req) {
+  char query[96];
+  char value[32];
+  esp_err_t err = ESP_OK;
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    if (httpd_query_key_value(query, "start", value, sizeof(value)) ==
+        ESP_OK) {
+      ecu_signal_id_t sig = ecu_signal_find(value);
+      err = (sig < ECU_SIG_COUNT) ? signal_search_begin(sig)
+                                  : ESP_ERR_NOT_FOUND;
+    } else if (httpd_query_key_value(query, "run", value, sizeof(value)) ==
+               ESP_OK) {
+      err = signal_search_run(SIGNAL_SEARCH_WORKERS);
+    } else if (httpd_query_key_value(query, "end", value, sizeof(value)) ==
+               ESP_OK) {
+      signal_search_end();
+    }
+  }
+  if (err != ESP_OK) {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, esp_err_to_name(err));
+    return ESP_FAIL;
+  }
+
+  ecu_signal_id_t ref = signal_search_get_reference();
+  char head[160];
+  snprintf(head, sizeof(head),
+           "{\"state\":\"%s\",\"reference\":\"%s\",\"samples\":%lu,"
+           "\"progress\":%d,\"results\":[",
+           signal_search_state_name(signal_search_get_state()),
+           ref < ECU_SIG_COUNT ? ecu_signal_key(ref) : "",
+           (unsigned long)signal_search_get_sample_count(),
+           signal_search_get_progress());
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_sendstr_chunk(req, head);
+
+  signal_candidate_t results[SIGNAL_SEARCH_TOP];
+  int n = signal_search_get_results(results, SIGNAL_SEARCH_TOP);
+  for (int i = 0; i < n; i++) {
+    const signal_candidate_t *c = &results[i];
+    char id_str[12];
+    can_sniffer_format_id(c->id, id_str, sizeof(id_str));
+
+    char entry[192];
+    snprintf(entry, sizeof(entry),
+             "%s{\"id\":\"%s\",\"start\":%u,\"length\":%u,"
+             "\"endian\":\"%s\",\"signed\":%s,\"r\":%.5f,"
+             "\"scale\":%g,\"offset\":%g,\"samples\":%lu}",
+             i ? "," : "", id_str, c->start, c->length,
+             c->big_endian ? "big" : "little", c->is_signed ? "true" : "false",
+             c->correlation, c->scale, c->offset, (unsigned long)c->samples);
+    httpd_resp_sendstr_chunk(req, entry);
+  }
+
+  httpd_resp_sendstr_chunk(req, "]}");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
+
+/* Frame history as CSV, oldest first */
+static esp_err_t perf_history_csv(httpd_req_t *req) {
+  perf_frame_t *frames = malloc(PERF_HISTORY_FRAMES * sizeof(*frames));
+  if (!frames) {
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No memory");
+    return ESP_FAIL;
+  }
+  int n = perf_monitor_get_history(frames, PERF_HISTORY_FRAMES);
+
+  httpd_resp_set_type(req, "text/csv");
+  httpd_resp_set_hdr(req, "Content-Disposition",
+                     "attachment; filename=\"perf.csv\"");
+  char line[96];
+  perf_monitor_format_csv_header(line, sizeof(line));
+  httpd_resp_sendstr_chunk(req, line);
+  for (int i = 0; i < n; i++) {
+    perf_monitor_format_csv_row(line, sizeof(line), &frames[i]);
+    httpd_resp_sendstr_chunk(req, line);
+  }
+  httpd_resp_sendstr_chunk(req, NULL);
+  free(frames);
+  return ESP_OK;
+}
+
+/* Performance figures: system sample (CAN rate, queues, heap, per-task CPU)
+ * and the last profiled frame. ?enable=1|0 switches frame profiling,
+ * ?history=csv downloads the recorded frames. */
+static esp_err_t perf_api_handler(httpd_req_t *req) {
+  char query[64];
+  char value[8];
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    if (httpd_query_key_value(query, "enable", value, sizeof(value)) ==
+        ESP_OK)
+      perf_monitor_set_enabled(value[0] == '1');
+    if (httpd_query_key_value(query, "history", value, sizeof(value)) ==
+            ESP_OK &&
+        strcmp(value, "csv") == 0)
+      return perf_history_csv(req);
+  }
+
+  perf_system_t *sys = malloc(sizeof(*sys));
+  if (!sys) {
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No memory");
+    return ESP_FAIL;
+  }
+  perf_monitor_sample_system(sys);
+  perf_frame_t f;
+  bool have_frame = perf_monitor_get_last_frame(&f);
+
+  char buf[320];
+  snprintf(buf, sizeof(buf),
+           "{\"profiling\":%s,\"fps\":%.1f,\"can_fps\":%.0f,"
+           "\"queues\":{\"can_rx\":%u,\"log\":%u,\"bg\":%u},"
+           "\"heap\":{\"internal\":%lu,\"internal_min\":%lu,"
+           "\"psram\":%lu},\"frame\":",
+           perf_monitor_enabled() ? "true" : "false", sys->fps, sys->can_fps,
+           sys->can_rx_pending, sys->log_pending, sys->bg_pending,
+           (unsigned long)sys->internal_free, (unsigned long)sys->internal_min,
+           (unsigned long)sys->psram_free);
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_sendstr_chunk(req, buf);
+
+  if (have_frame) {
+    snprintf(buf, sizeof(buf),
+             "{\"t_ms\":%lu,\"render_us\":%lu,\"flush_us\":%lu,"
+             "\"area_px\":%lu,\"handler_us\":%lu,\"objects\":%u,"
+             "\"latency_us\":%lu}",
+             (unsigned long)f.t_ms, (unsigned long)f.render_us,
+             (unsigned long)f.flush_us, (unsigned long)f.area_px,
+             (unsigned long)f.handler_us, f.obj_count,
+             (unsigned long)f.latency_us);
+    httpd_resp_sendstr_chunk(req, buf);
+  } else {
+    httpd_resp_sendstr_chunk(req, "null");
+  }
+
+  httpd_resp_sendstr_chunk(req, ",\"tasks\":[");
+  for (int i = 0; i < sys->task_count; i++) {
+    const perf_task_t *t = &sys->tasks[i];
+    snprintf(buf, sizeof(buf),
+             "%s{\"name\":\"%s\",\"core\":%d,\"cpu\":%u}", i ? "," : "",
+             t->name, t->core < 2 ? t->core : -1, t->cpu_pct);
+    httpd_resp_sendstr_chunk(req, buf);
+  }
+  httpd_resp_sendstr_chunk(req, "]}");
+  httpd_resp_sendstr_chunk(req, NULL);
+  free(sys);
+  return ESP_OK;
+}
+
 /* Handler for Dashboard redirect (Temporary until web dashboard is built) */
 static esp_err_t dashboard_get_handler(httpd_req_t *req) {
   httpd_resp_set_status(req, "302 Found");
@@ -382,7 +644,7 @@ static esp_err_t dashboard_get_handler(httpd_req_t *req) {
 esp_err_t web_server_start(void) {
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.uri_match_fn = httpd_uri_match_wildcard;
-  config.max_uri_handlers = 12; // Increased for extra handlers
+  config.max_uri_handlers = 16; // 12 registered, room for a few more
 
   ESP_LOGI(TAG, "Starting server on port: '%d'", config.server_port);
   if (httpd_start(&s_server, &config) == ESP_OK) {
@@ -424,6 +686,25 @@ esp_err_t web_server_start(void) {
                             .handler = ecu_data_api_handler};
     httpd_register_uri_handler(s_server, &data_uri);
 
+    httpd_uri_t signals_uri = {.uri = "/api/signals",
+                               .method = HTTP_GET,
+                               .handler = signals_api_handler};
+    httpd_register_uri_handler(s_server, &signals_uri);
+
+    httpd_uri_t can_frames_uri = {.uri = "/api/can-frames",
+                                  .method = HTTP_GET,
+                                  .handler = can_frames_api_handler};
+    httpd_register_uri_handler(s_server, &can_frames_uri);
+
+    httpd_uri_t signal_search_uri = {.uri = "/api/signal-search",
+                                     .method = HTTP_GET,
+                                     .handler = signal_search_api_handler};
+    httpd_register_uri_handler(s_server, &signal_search_uri);
+
+    httpd_uri_t perf_uri = {
+        .uri = "/api/perf", .method = HTTP_GET, .handler = perf_api_handler};
+    httpd_register_uri_handler(s_server, &perf_uri);
+
     return ESP_OK;
   }
   return ESP_FAIL;